@@ -0,0 +1,491 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "AsyncFileReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <system_error>
+
+#include "ImportProfiler.h"
+#include "ThreadPool.h"
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define BLOODLINE_ASYNCFILEREADER_IO_URING
+        #include <cstring>
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+namespace
+{
+  //! io_uring reads and preadv() are limited to < 2 GiB per call; longer requests continue as short reads
+  constexpr std::size_t MAX_NUM_BYTES_PER_CALL = std::size_t(1) << 30;
+} // anonymous namespace
+
+//====================================================================================================
+//===== DEFINITIONS
+//====================================================================================================
+struct AsyncFileReader::Ring
+{
+  #ifdef BLOODLINE_ASYNCFILEREADER_IO_URING
+    int fd = -1;
+    void* sq_ptr = MAP_FAILED;
+    std::size_t sq_num_bytes = 0;
+    void* cq_ptr = MAP_FAILED;
+    std::size_t cq_num_bytes = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    std::size_t sqes_num_bytes = 0;
+
+    unsigned int* sq_tail = nullptr;
+    unsigned int* sq_mask = nullptr;
+    unsigned int* sq_array = nullptr;
+    unsigned int* cq_head = nullptr;
+    unsigned int* cq_tail = nullptr;
+    unsigned int* cq_mask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    ~Ring()
+    {
+        if (sqes != MAP_FAILED)
+        { munmap(sqes, sqes_num_bytes); }
+
+        if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr)
+        { munmap(cq_ptr, cq_num_bytes); }
+
+        if (sq_ptr != MAP_FAILED)
+        { munmap(sq_ptr, sq_num_bytes); }
+
+        if (fd >= 0)
+        { ::close(fd); }
+    }
+
+    [[nodiscard]] bool setup(unsigned int numEntries)
+    {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, numEntries, &p));
+        if (fd < 0)
+        { return false; }
+
+        //------------------------------------------------------------------------------------------------------
+        // map the rings; kernels with IORING_FEAT_SINGLE_MMAP share one mapping for SQ and CQ
+        //------------------------------------------------------------------------------------------------------
+        sq_num_bytes = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+        cq_num_bytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+        const bool singleMap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap)
+        { sq_num_bytes = cq_num_bytes = std::max(sq_num_bytes, cq_num_bytes); }
+
+        sq_ptr = mmap(nullptr, sq_num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq_ptr == MAP_FAILED)
+        { return false; }
+
+        cq_ptr = singleMap ? sq_ptr : mmap(nullptr, cq_num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED)
+        { return false; }
+
+        sqes_num_bytes = p.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED)
+        { return false; }
+
+        char* sq = static_cast<char*>(sq_ptr);
+        sq_tail = reinterpret_cast<unsigned int*>(sq + p.sq_off.tail);
+        sq_mask = reinterpret_cast<unsigned int*>(sq + p.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned int*>(sq + p.sq_off.array);
+
+        char* cq = static_cast<char*>(cq_ptr);
+        cq_head = reinterpret_cast<unsigned int*>(cq + p.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned int*>(cq + p.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned int*>(cq + p.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+        return true;
+    }
+
+    //! the caller guarantees that the number of reads in flight does not exceed the ring size
+    [[nodiscard]] bool submit_read(int fileFd, std::uint64_t offset, char* dst, std::size_t numBytes, std::uint64_t userData)
+    {
+        const unsigned int tail = *sq_tail;
+        const unsigned int index = tail & *sq_mask;
+
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fileFd;
+        sqe.off = offset;
+        sqe.addr = reinterpret_cast<std::uint64_t>(dst);
+        sqe.len = static_cast<std::uint32_t>(std::min(numBytes, MAX_NUM_BYTES_PER_CALL));
+        sqe.user_data = userData;
+
+        sq_array[index] = index;
+        __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        for (;;)
+        {
+            const long res = syscall(__NR_io_uring_enter, fd, 1U, 0U, 0U, nullptr, 0);
+            if (res >= 0)
+            { return res == 1; }
+
+            if (errno != EINTR && errno != EAGAIN)
+            { return false; }
+        }
+    }
+
+    [[nodiscard]] bool reap(std::uint64_t& userData, std::int64_t& result)
+    {
+        for (;;)
+        {
+            const unsigned int head = *cq_head;
+
+            if (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE))
+            {
+                const io_uring_cqe& cqe = cqes[head & *cq_mask];
+                userData = cqe.user_data;
+                result = cqe.res;
+
+                __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+
+            const long res = syscall(__NR_io_uring_enter, fd, 0U, 1U, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (res < 0 && errno != EINTR && errno != EAGAIN)
+            { return false; }
+        }
+    }
+  #endif
+}; // struct AsyncFileReader::Ring
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+AsyncFileReader::AsyncFileReader()
+    : _backend(Backend::ThreadPool),
+      _queue_depth(0),
+      _file_num_bytes(0),
+      _fd(-1),
+      _num_in_flight(0)
+{ /* do nothing */ }
+
+AsyncFileReader::~AsyncFileReader()
+{ close(); }
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+bool AsyncFileReader::is_open() const
+{ return _queue_depth != 0; }
+
+AsyncFileReader::Backend AsyncFileReader::backend() const
+{ return _backend; }
+
+unsigned int AsyncFileReader::queue_depth() const
+{ return _queue_depth; }
+
+std::uint64_t AsyncFileReader::file_num_bytes() const
+{ return _file_num_bytes; }
+
+std::size_t AsyncFileReader::num_in_flight() const
+{ return _num_in_flight; }
+
+bool AsyncFileReader::is_io_uring_available()
+{
+  #ifdef BLOODLINE_ASYNCFILEREADER_IO_URING
+    Ring ring;
+    return ring.setup(1);
+  #else
+    return false;
+  #endif
+}
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool AsyncFileReader::open(std::string_view filepath, Backend backend, unsigned int queueDepth)
+{
+    close();
+
+    std::error_code ec;
+    const std::uintmax_t fileNumBytes = std::filesystem::file_size(filepath, ec);
+    if (ec)
+    { return false; }
+
+    _path = filepath;
+    _file_num_bytes = fileNumBytes;
+
+  #ifndef _WIN32
+    _fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0)
+    {
+        close();
+        return false;
+    }
+  #endif
+
+    queueDepth = std::max(1U, queueDepth);
+
+  #ifdef BLOODLINE_ASYNCFILEREADER_IO_URING
+    if (backend == Backend::IoUring)
+    {
+        _ring = std::make_unique<Ring>();
+
+        if (!_ring->setup(queueDepth))
+        { _ring.reset(); }
+    }
+  #endif
+
+    if (_ring)
+    { _backend = Backend::IoUring; }
+    else
+    {
+        _backend = Backend::ThreadPool;
+        _pool = std::make_unique<ThreadPool>(queueDepth);
+    }
+
+    _queue_depth = queueDepth;
+    _requests.assign(queueDepth, Request());
+
+    return true;
+}
+
+void AsyncFileReader::close()
+{
+    // in-flight reads write into the callers' buffers -> finish them first; every wait() retires one read
+    while (_num_in_flight != 0)
+    {
+        std::uint64_t tag = 0;
+        std::size_t numBytesRead = 0;
+        static_cast<void>(wait(tag, numBytesRead));
+    }
+
+    _pool.reset();
+    _ring.reset();
+
+  #ifndef _WIN32
+    if (_fd >= 0)
+    { ::close(_fd); }
+  #endif
+
+    _fd = -1;
+    _path.clear();
+    _queue_depth = 0;
+    _file_num_bytes = 0;
+    _requests.clear();
+    _completions.clear();
+}
+
+bool AsyncFileReader::submit(std::uint64_t offset, void* dst, std::size_t numBytes, std::uint64_t tag)
+{
+    if (!is_open())
+    { return false; }
+
+    const auto it = std::find_if(_requests.begin(), _requests.end(), [](const Request& r)
+    { return !r.in_use; });
+
+    if (it == _requests.end())
+    { return false; }
+
+    *it = Request{tag, offset, static_cast<char*>(dst), numBytes, 0, true};
+
+    if (!_start(static_cast<std::size_t>(it - _requests.begin())))
+    {
+        it->in_use = false;
+        return false;
+    }
+
+    ++_num_in_flight;
+    return true;
+}
+
+bool AsyncFileReader::_start(std::size_t requestId)
+{
+    Request& r = _requests[requestId];
+
+    const std::uint64_t offset = r.offset + r.num_bytes_read;
+    char* dst = r.dst + r.num_bytes_read;
+    const std::size_t numBytes = r.num_bytes - r.num_bytes_read;
+
+  #ifdef BLOODLINE_ASYNCFILEREADER_IO_URING
+    if (_ring)
+    { return _ring->submit_read(_fd, offset, dst, numBytes, requestId); }
+  #endif
+
+    // the task reads until the request is complete, the file ends or an error occurs
+    static_cast<void>(_pool->enqueue([this, requestId, offset, dst, numBytes]()
+                                     {
+                                         std::int64_t result = 0;
+
+                                       #ifdef _WIN32
+                                         std::ifstream file(_path, std::ios_base::in | std::ios_base::binary);
+                                         file.seekg(static_cast<std::streamoff>(offset));
+                                         file.read(dst, static_cast<std::streamsize>(numBytes));
+                                         result = file.bad() ? -EIO : static_cast<std::int64_t>(file.gcount());
+                                       #else
+                                         while (static_cast<std::size_t>(result) < numBytes)
+                                         {
+                                             iovec iov{dst + result, std::min(numBytes - result, MAX_NUM_BYTES_PER_CALL)};
+                                             const ssize_t n = preadv(_fd, &iov, 1, static_cast<off_t>(offset + result));
+
+                                             if (n < 0 && errno == EINTR)
+                                             { continue; }
+
+                                             if (n < 0)
+                                             {
+                                                 result = -errno;
+                                                 break;
+                                             }
+
+                                             if (n == 0)
+                                             { break; } // end of file
+
+                                             result += n;
+                                         }
+                                       #endif
+
+                                         {
+                                             std::lock_guard<std::mutex> lock(_completions_mutex);
+                                             _completions.push_back({requestId, result});
+                                         }
+
+                                         _completions_cv.notify_one();
+                                     }));
+
+    return true;
+}
+
+AsyncFileReader::Completion AsyncFileReader::_next_completion()
+{
+    Completion c;
+
+  #ifdef BLOODLINE_ASYNCFILEREADER_IO_URING
+    if (_ring)
+    {
+        std::uint64_t userData = 0;
+        if (!_ring->reap(userData, c.result))
+        {
+            // ring is broken: fail one request so the caller does not wait forever
+            const auto it = std::find_if(_requests.begin(), _requests.end(), [](const Request& r)
+            { return r.in_use; });
+
+            c.request_id = static_cast<std::size_t>(it - _requests.begin());
+            c.result = -EIO;
+            return c;
+        }
+
+        c.request_id = static_cast<std::size_t>(userData);
+        return c;
+    }
+  #endif
+
+    std::unique_lock<std::mutex> lock(_completions_mutex);
+    _completions_cv.wait(lock, [this]()
+    { return !_completions.empty(); });
+
+    c = _completions.front();
+    _completions.pop_front();
+
+    return c;
+}
+
+bool AsyncFileReader::wait(std::uint64_t& tag, std::size_t& numBytesRead)
+{
+    if (_num_in_flight == 0)
+    { return false; }
+
+    for (;;)
+    {
+        const Completion c = _next_completion();
+        Request& r = _requests[c.request_id];
+
+        if (c.result > 0)
+        {
+            r.num_bytes_read += static_cast<std::size_t>(c.result);
+
+            // not a read() of this thread
+            ImportProfiler::count_read(static_cast<std::uint64_t>(c.result));
+        }
+
+        // short read before the end of the file (e.g. > MAX_NUM_BYTES_PER_CALL) -> read the rest
+        const bool isShort = c.result > 0 && r.num_bytes_read < r.num_bytes && r.offset + r.num_bytes_read < _file_num_bytes;
+        if (isShort && _start(c.request_id))
+        { continue; }
+
+        tag = r.tag;
+        numBytesRead = r.num_bytes_read;
+        r.in_use = false;
+        --_num_in_flight;
+
+        return c.result >= 0 && !isShort;
+    }
+}
+
+bool AsyncFileReader::read(std::uint64_t offset, void* dst, std::size_t numBytes, std::size_t rangeNumBytes)
+{
+    if (!is_open() || _num_in_flight != 0 || offset > _file_num_bytes || numBytes > _file_num_bytes - offset)
+    { return false; }
+
+    rangeNumBytes = std::max<std::size_t>(1, rangeNumBytes);
+    const std::size_t numRanges = (numBytes + rangeNumBytes - 1) / rangeNumBytes;
+
+    char* d = static_cast<char*>(dst);
+    std::size_t nextRange = 0;
+    bool success = true;
+
+    while (nextRange < numRanges || _num_in_flight != 0)
+    {
+        while (success && nextRange < numRanges && _num_in_flight < _queue_depth)
+        {
+            const std::size_t first = nextRange * rangeNumBytes;
+            success = submit(offset + first, d + first, std::min(rangeNumBytes, numBytes - first), nextRange);
+            ++nextRange;
+        }
+
+        if (_num_in_flight == 0)
+        { break; }
+
+        std::uint64_t range = 0;
+        std::size_t numBytesRead = 0;
+        const bool ok = wait(range, numBytesRead);
+
+        success = success && ok && numBytesRead == std::min(rangeNumBytes, numBytes - range * rangeNumBytes);
+    } // while
+
+    return success;
+}
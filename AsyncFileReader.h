@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_ASYNCFILEREADER_H
+#define BLOODLINE_ASYNCFILEREADER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+/*
+ * Keeps a queue of positional reads of one file in flight.
+ *
+ * Backends:
+ *  - IoUring: Linux >= 5.6; one submission/completion ring (raw syscalls, no liburing)
+ *  - ThreadPool: every read is a preadv() task (or a seek + read of an own stream on Windows)
+ *
+ * open() falls back to ThreadPool if io_uring is not available (old kernel, seccomp, ...).
+ * Reads complete in any order; wait() returns the tag that was passed to submit().
+ * Submitting and waiting must happen in one thread.
+ */
+class AsyncFileReader
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    enum class Backend
+    {
+        IoUring,
+        ThreadPool
+    };
+
+    static constexpr unsigned int DEFAULT_QUEUE_DEPTH = 8;
+    static constexpr std::size_t DEFAULT_RANGE_NUM_BYTES = std::size_t(4) << 20;
+
+  private:
+    struct Ring; // io_uring state (AsyncFileReader.cpp)
+
+    struct Request
+    {
+        std::uint64_t tag = 0;
+        std::uint64_t offset = 0;
+        char* dst = nullptr;
+        std::size_t num_bytes = 0;
+        std::size_t num_bytes_read = 0;
+        bool in_use = false;
+    }; // struct Request
+
+    struct Completion
+    {
+        std::size_t request_id = 0;
+        std::int64_t result = 0; // bytes read or -errno
+    }; // struct Completion
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    std::string _path;
+    Backend _backend;
+    unsigned int _queue_depth;
+    std::uint64_t _file_num_bytes;
+    int _fd;
+    std::vector<Request> _requests;
+    std::size_t _num_in_flight;
+    std::unique_ptr<Ring> _ring;
+    std::unique_ptr<ThreadPool> _pool;
+    std::mutex _completions_mutex;
+    std::condition_variable _completions_cv;
+    std::deque<Completion> _completions;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    AsyncFileReader();
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader(AsyncFileReader&&) = delete;
+
+    ~AsyncFileReader();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] Backend backend() const;
+    [[nodiscard]] unsigned int queue_depth() const;
+    [[nodiscard]] std::uint64_t file_num_bytes() const;
+    [[nodiscard]] std::size_t num_in_flight() const;
+
+    //! io_uring can be set up in this process
+    [[nodiscard]] static bool is_io_uring_available();
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+    [[maybe_unused]] AsyncFileReader& operator=(AsyncFileReader&&) = delete;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    [[nodiscard]] bool open(std::string_view filepath, Backend backend = Backend::IoUring, unsigned int queueDepth = DEFAULT_QUEUE_DEPTH);
+    void close();
+
+    //! starts reading numBytes at offset into dst; false if queue_depth() reads are in flight
+    [[nodiscard]] bool submit(std::uint64_t offset, void* dst, std::size_t numBytes, std::uint64_t tag);
+
+    /*!
+     * blocks until one read has finished; numBytesRead < numBytes only at the end of the file;
+     * false if nothing is in flight or on I/O errors (tag is set anyway)
+     */
+    [[nodiscard]] bool wait(std::uint64_t& tag, std::size_t& numBytesRead);
+
+    //! reads [offset, offset + numBytes) into dst as concurrent ranges; false on I/O errors or if the file is too short
+    [[nodiscard]] bool read(std::uint64_t offset, void* dst, std::size_t numBytes, std::size_t rangeNumBytes = DEFAULT_RANGE_NUM_BYTES);
+
+  private:
+    [[nodiscard]] bool _start(std::size_t requestId);
+    [[nodiscard]] Completion _next_completion();
+}; // class AsyncFileReader
+
+#endif //BLOODLINE_ASYNCFILEREADER_H
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_BULKREAD_H
+#define BLOODLINE_BULKREAD_H
+
+#include <cstdint>
+#include <istream>
+
+/*
+ * Reads of payloads that may exceed 2 GiB.
+ *
+ * The file formats store extents as uint32; a payload of e.g. a 4D flow field easily has more than
+ * 2^31 bytes. read(2) transfers at most ~2 GiB per call and not every standard library splits a
+ * single istream::read accordingly, so large payloads are read in chunks of MAX_CHUNK_NUM_BYTES.
+ */
+class BulkRead
+{
+  public:
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+    static constexpr std::uint64_t MAX_CHUNK_NUM_BYTES = std::uint64_t(1) << 30;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! false if the stream fails before numBytes were read (truncated file)
+    static bool read(std::istream& file, void* dst, std::uint64_t numBytes);
+}; // class BulkRead
+
+#endif //BLOODLINE_BULKREAD_H
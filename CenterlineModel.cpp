@@ -0,0 +1,377 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "CenterlineModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "ThreadPool.h"
+
+namespace
+{
+  constexpr std::size_t BLOCK_NUM_QUERIES = 4096;
+  constexpr unsigned int MAX_STACK_SIZE = 96; // k-d tree depth is log2(num points)
+
+  inline double distance_squared(const double* a, const double* b)
+  {
+      const double dx = a[0] - b[0];
+      const double dy = a[1] - b[1];
+      const double dz = a[2] - b[2];
+      return dx * dx + dy * dy + dz * dz;
+  }
+
+  //! false if v is (almost) zero
+  inline bool normalize(double* v)
+  {
+      const double len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+      if (!(len > 1e-12))
+      { return false; }
+
+      v[0] /= len;
+      v[1] /= len;
+      v[2] /= len;
+      return true;
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+CenterlineModel::CenterlineModel()
+    : _offsets{0},
+      _max_segment_length(0)
+{ /* do nothing */ }
+
+CenterlineModel::CenterlineModel(const CenterlinesData& cls)
+    : CenterlineModel()
+{ build(cls); }
+
+CenterlineModel::~CenterlineModel() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::size_t CenterlineModel::num_centerlines() const
+{ return _offsets.size() - 1; }
+
+std::size_t CenterlineModel::num_points() const
+{ return _offsets.back(); }
+
+std::size_t CenterlineModel::num_points(std::size_t centerlineId) const
+{ return _offsets[centerlineId + 1] - _offsets[centerlineId]; }
+
+double CenterlineModel::length(std::size_t centerlineId) const
+{ return num_points(centerlineId) != 0 ? _arc_length[_offsets[centerlineId + 1] - 1] : 0; }
+
+double CenterlineModel::arc_length(std::size_t centerlineId, std::size_t pointId) const
+{ return _arc_length[_offsets[centerlineId] + pointId]; }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void CenterlineModel::build(const CenterlinesData& cls)
+{
+    _offsets.assign(1, 0);
+    _points.clear();
+    _radii.clear();
+    _frames.clear();
+    _arc_length.clear();
+    _max_segment_length = 0;
+
+    for (const Centerline& cl: cls.centerlines)
+    {
+        const std::uint32_t numPoints = static_cast<std::uint32_t>(std::min<std::size_t>({cl.num_points, cl.points.size() / 3, cl.radii.size(), cl.local_coordinate_systems.size() / 9}));
+
+        _points.insert(_points.end(), cl.points.begin(), cl.points.begin() + static_cast<std::size_t>(numPoints) * 3);
+        _radii.insert(_radii.end(), cl.radii.begin(), cl.radii.begin() + numPoints);
+        _frames.insert(_frames.end(), cl.local_coordinate_systems.begin(), cl.local_coordinate_systems.begin() + static_cast<std::size_t>(numPoints) * 9);
+
+        double s = 0;
+        for (std::uint32_t i = 0; i < numPoints; ++i)
+        {
+            if (i != 0)
+            {
+                const double segmentLength = std::sqrt(distance_squared(cl.points.data() + static_cast<std::size_t>(i) * 3, cl.points.data() + static_cast<std::size_t>(i - 1) * 3));
+                _max_segment_length = std::max(_max_segment_length, segmentLength);
+                s += segmentLength;
+            }
+
+            _arc_length.push_back(s);
+        }
+
+        _offsets.push_back(_offsets.back() + numPoints);
+    }
+
+    _tree_ids.resize(num_points());
+    std::iota(_tree_ids.begin(), _tree_ids.end(), 0);
+    _tree_axis.assign(num_points(), 0);
+
+    _build_tree(0, static_cast<std::uint32_t>(num_points()));
+}
+
+void CenterlineModel::_build_tree(std::uint32_t first, std::uint32_t last)
+{
+    if (last - first <= 1)
+    { return; }
+
+    // split along the axis of largest extent at the median
+    std::array<double, 3> lower{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    std::array<double, 3> upper{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (std::uint32_t i = first; i < last; ++i)
+    {
+        for (unsigned int a = 0; a < 3; ++a)
+        {
+            lower[a] = std::min(lower[a], _points[static_cast<std::size_t>(_tree_ids[i]) * 3 + a]);
+            upper[a] = std::max(upper[a], _points[static_cast<std::size_t>(_tree_ids[i]) * 3 + a]);
+        }
+    }
+
+    std::uint8_t axis = 0;
+    for (std::uint8_t a = 1; a < 3; ++a)
+    {
+        if (upper[a] - lower[a] > upper[axis] - lower[axis])
+        { axis = a; }
+    }
+
+    const std::uint32_t mid = first + (last - first) / 2;
+    std::nth_element(_tree_ids.begin() + first, _tree_ids.begin() + mid, _tree_ids.begin() + last, [&](std::uint32_t a, std::uint32_t b)
+    { return _points[static_cast<std::size_t>(a) * 3 + axis] < _points[static_cast<std::size_t>(b) * 3 + axis]; });
+
+    _tree_axis[mid] = axis;
+
+    _build_tree(first, mid);
+    _build_tree(mid + 1, last);
+}
+
+std::uint32_t CenterlineModel::_nearest_point(const double* position) const
+{
+    double best = std::numeric_limits<double>::infinity();
+    std::uint32_t bestId = 0;
+
+    // ranges still to visit and the squared distance of the query to their splitting plane
+    struct Range
+    {
+        std::uint32_t first;
+        std::uint32_t last;
+        double plane_distance_squared;
+    };
+
+    Range stack[MAX_STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = {0, static_cast<std::uint32_t>(_tree_ids.size()), 0};
+
+    while (stackSize != 0)
+    {
+        const Range r = stack[--stackSize];
+        if (r.first >= r.last || r.plane_distance_squared >= best)
+        { continue; }
+
+        const std::uint32_t mid = r.first + (r.last - r.first) / 2;
+        const std::uint32_t id = _tree_ids[mid];
+
+        const double d2 = distance_squared(position, _points.data() + static_cast<std::size_t>(id) * 3);
+        if (d2 < best)
+        {
+            best = d2;
+            bestId = id;
+        }
+
+        const std::uint8_t axis = _tree_axis[mid];
+        const double diff = position[axis] - _points[static_cast<std::size_t>(id) * 3 + axis];
+
+        // far side first so the near side is visited next
+        if (diff < 0)
+        {
+            stack[stackSize++] = {mid + 1, r.last, diff * diff};
+            stack[stackSize++] = {r.first, mid, 0};
+        }
+        else
+        {
+            stack[stackSize++] = {r.first, mid, diff * diff};
+            stack[stackSize++] = {mid + 1, r.last, 0};
+        }
+    } // while stack
+
+    return bestId;
+}
+
+template<typename F>
+void CenterlineModel::_for_each_point_within(const double* position, double radiusSquared, F&& f) const
+{
+    struct Range
+    {
+        std::uint32_t first;
+        std::uint32_t last;
+        double plane_distance_squared;
+    };
+
+    Range stack[MAX_STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = {0, static_cast<std::uint32_t>(_tree_ids.size()), 0};
+
+    while (stackSize != 0)
+    {
+        const Range r = stack[--stackSize];
+        if (r.first >= r.last || r.plane_distance_squared > radiusSquared)
+        { continue; }
+
+        const std::uint32_t mid = r.first + (r.last - r.first) / 2;
+        const std::uint32_t id = _tree_ids[mid];
+
+        if (distance_squared(position, _points.data() + static_cast<std::size_t>(id) * 3) <= radiusSquared)
+        { f(id); }
+
+        const std::uint8_t axis = _tree_axis[mid];
+        const double diff = position[axis] - _points[static_cast<std::size_t>(id) * 3 + axis];
+
+        stack[stackSize++] = {r.first, mid, diff < 0 ? 0 : diff * diff};
+        stack[stackSize++] = {mid + 1, r.last, diff < 0 ? diff * diff : 0};
+    } // while stack
+}
+
+void CenterlineModel::_project(const double* position, std::uint32_t nearestPointId, CenterlinePosition& res) const
+{
+    //------------------------------------------------------------------------------------------------------
+    // closest point on the segments adjacent to all points that may end the closest segment
+    //------------------------------------------------------------------------------------------------------
+    std::uint32_t bestA = nearestPointId;
+    std::uint32_t bestB = nearestPointId;
+    double bestT = 0;
+    double best = distance_squared(position, _points.data() + static_cast<std::size_t>(nearestPointId) * 3);
+
+    const auto project_segment = [&](std::uint32_t a)
+    {
+        const double* pa = _points.data() + static_cast<std::size_t>(a) * 3;
+        const double* pb = pa + 3;
+
+        const double ab[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+        const double abLen2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+        if (!(abLen2 > 0))
+        { return; }
+
+        const double t = std::clamp(((position[0] - pa[0]) * ab[0] + (position[1] - pa[1]) * ab[1] + (position[2] - pa[2]) * ab[2]) / abLen2, 0.0, 1.0);
+        const double q[3] = {pa[0] + t * ab[0], pa[1] + t * ab[1], pa[2] + t * ab[2]};
+
+        // a segment wins over a point at the same distance, the later segment over an earlier one
+        const double d2 = distance_squared(position, q);
+        if (d2 < best || (d2 == best && (bestA == bestB || a > bestA)))
+        {
+            best = d2;
+            bestA = a;
+            bestB = a + 1;
+            bestT = t;
+        }
+    };
+
+    // the closest point of a segment is at most half its length away from one of its end points
+    const double radius = std::sqrt(best) + 0.5 * _max_segment_length;
+
+    _for_each_point_within(position, radius * radius, [&](std::uint32_t pointId)
+    {
+        const std::uint32_t c = static_cast<std::uint32_t>(std::upper_bound(_offsets.begin(), _offsets.end(), pointId) - _offsets.begin() - 1);
+
+        if (pointId > _offsets[c])
+        { project_segment(pointId - 1); }
+
+        if (pointId + 1 < _offsets[c + 1])
+        { project_segment(pointId); }
+    });
+
+    const std::uint32_t c = static_cast<std::uint32_t>(std::upper_bound(_offsets.begin(), _offsets.end(), bestA) - _offsets.begin() - 1);
+    const std::uint32_t first = _offsets[c];
+    const std::uint32_t last = _offsets[c + 1];
+
+    res.centerline = c;
+    res.segment = std::min(bestA, last >= first + 2 ? last - 2 : first) - first;
+    res.arc_length = _arc_length[bestA] + bestT * (_arc_length[bestB] - _arc_length[bestA]);
+    res.radial_distance = std::sqrt(best);
+    res.radius = _radii[bestA] + bestT * (_radii[bestB] - _radii[bestA]);
+
+    //------------------------------------------------------------------------------------------------------
+    // frame: interpolate, then orthonormalize (z first, keeps the handedness of the input)
+    //------------------------------------------------------------------------------------------------------
+    const double* fa = _frames.data() + static_cast<std::size_t>(bestA) * 9;
+    const double* fb = _frames.data() + static_cast<std::size_t>(bestB) * 9;
+    for (unsigned int i = 0; i < 9; ++i)
+    { res.local_frame[i] = fa[i] + bestT * (fb[i] - fa[i]); }
+
+    double* x = res.local_frame.data();
+    double* y = x + 3;
+    double* z = x + 6;
+
+    const double xz = x[0] * z[0] + x[1] * z[1] + x[2] * z[2];
+    for (unsigned int i = 0; i < 3; ++i)
+    { x[i] -= xz * z[i]; }
+
+    if (!normalize(z) || !normalize(x))
+    {
+        // opposite frames cancel out
+        std::copy_n(bestT < 0.5 ? fa : fb, 9, res.local_frame.begin());
+        return;
+    }
+
+    y[0] = z[1] * x[2] - z[2] * x[1];
+    y[1] = z[2] * x[0] - z[0] * x[2];
+    y[2] = z[0] * x[1] - z[1] * x[0];
+}
+
+bool CenterlineModel::closest_position(const double* position, CenterlinePosition& res) const
+{
+    if (_tree_ids.empty())
+    { return false; }
+
+    _project(position, _nearest_point(position), res);
+    return true;
+}
+
+void CenterlineModel::closest_positions(std::size_t numQueries, const double* positions, CenterlinePosition* results, unsigned int numThreads) const
+{
+    if (_tree_ids.empty())
+    { return; }
+
+    ThreadPool::parallel_for(numQueries, BLOCK_NUM_QUERIES, numThreads, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { closest_position(positions + i * 3, results[i]); }
+    });
+}
+
+void CenterlineModel::closest_positions(std::size_t numQueries, const double* x, const double* y, const double* z, CenterlinePosition* results, unsigned int numThreads) const
+{
+    if (_tree_ids.empty())
+    { return; }
+
+    ThreadPool::parallel_for(numQueries, BLOCK_NUM_QUERIES, numThreads, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const double position[3] = {x[i], y[i], z[i]};
+            closest_position(position, results[i]);
+        }
+    });
+}
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_CENTERLINEMODEL_H
+#define BLOODLINE_CENTERLINEMODEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ImporterScientificData.h"
+
+//! closest centerline position of a query point
+struct CenterlinePosition
+{
+    std::uint32_t centerline = 0;
+    std::uint32_t segment = 0; // between points segment and segment + 1 of the centerline
+    double arc_length = 0; // [mm] from the first point of the centerline
+    double radial_distance = 0; // [mm] between query point and centerline
+    double radius = 0; // vessel radius at the centerline position (interpolated)
+    std::array<double, 9> local_frame{}; // x, y, z vector (z is the tangent); interpolated and orthonormalized
+}; // struct CenterlinePosition
+
+/*
+ * All centerlines of a vessel with cumulative arc length per point and a k-d tree over all
+ * centerline points.
+ *
+ * A query finds the nearest centerline point via the k-d tree. The closest segment has an end
+ * point within that distance plus half the longest segment, so the query is projected onto the
+ * segments adjacent to all points in this radius. Radius and local frame are interpolated along
+ * the chosen segment.
+ */
+class CenterlineModel
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    // all centerline points concatenated; the points of centerline c are [_offsets[c], _offsets[c + 1])
+    std::vector<std::uint32_t> _offsets;
+    std::vector<double> _points; // * 3
+    std::vector<double> _radii;
+    std::vector<double> _frames; // * 9
+    std::vector<double> _arc_length;
+    double _max_segment_length;
+
+    // implicit k-d tree: node of range [first, last) is (first + last) / 2
+    std::vector<std::uint32_t> _tree_ids;
+    std::vector<std::uint8_t> _tree_axis;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    CenterlineModel();
+    explicit CenterlineModel(const CenterlinesData& cls);
+    CenterlineModel(const CenterlineModel&) = default;
+    CenterlineModel(CenterlineModel&&) noexcept = default;
+
+    ~CenterlineModel();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] std::size_t num_centerlines() const;
+    [[nodiscard]] std::size_t num_points() const;
+    [[nodiscard]] std::size_t num_points(std::size_t centerlineId) const;
+
+    //! [mm]
+    [[nodiscard]] double length(std::size_t centerlineId) const;
+    //! cumulative arc length [mm] of point pointId of the centerline
+    [[nodiscard]] double arc_length(std::size_t centerlineId, std::size_t pointId) const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] CenterlineModel& operator=(const CenterlineModel&) = default;
+    [[maybe_unused]] CenterlineModel& operator=(CenterlineModel&&) noexcept = default;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    void build(const CenterlinesData& cls);
+
+    //! false if the model has no points; position: 3 values
+    bool closest_position(const double* position, CenterlinePosition& res) const;
+
+    //! positions: numQueries * 3; numThreads == 0 -> std::thread::hardware_concurrency()
+    void closest_positions(std::size_t numQueries, const double* positions, CenterlinePosition* results, unsigned int numThreads = 0) const;
+    //! separate coordinate arrays (e.g. PathlinesData::x, y, z)
+    void closest_positions(std::size_t numQueries, const double* x, const double* y, const double* z, CenterlinePosition* results, unsigned int numThreads = 0) const;
+
+  private:
+    void _build_tree(std::uint32_t first, std::uint32_t last);
+    [[nodiscard]] std::uint32_t _nearest_point(const double* position) const;
+    //! f(pointId) for every point within sqrt(radiusSquared) of position
+    template<typename F>
+    void _for_each_point_within(const double* position, double radiusSquared, F&& f) const;
+    void _project(const double* position, std::uint32_t nearestPointId, CenterlinePosition& res) const;
+}; // class CenterlineModel
+
+#endif //BLOODLINE_CENTERLINEMODEL_H
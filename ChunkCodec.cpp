@@ -0,0 +1,279 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ChunkCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  constexpr std::uint8_t METHOD_STORED = 0;
+  constexpr std::uint8_t METHOD_LZ = 1;
+
+  constexpr std::size_t MIN_MATCH = 4;
+  constexpr std::size_t MAX_OFFSET = 65535;
+  constexpr unsigned int HASH_BITS = 16;
+  constexpr std::size_t LAST_LITERALS = 8; // the tail is always stored as literals
+  constexpr unsigned int SKIP_STRENGTH = 6; // incompressible data is skipped faster the longer no match was found
+
+  inline std::uint32_t read_u32(const std::uint8_t* p)
+  {
+      std::uint32_t v;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+  }
+
+  inline std::uint32_t hash(std::uint32_t v)
+  { return (v * 2654435761U) >> (32 - HASH_BITS); }
+
+  //! 15 in the token nibble is followed by bytes of 255 and the remainder
+  inline void write_length(std::vector<std::uint8_t>& dst, std::size_t len)
+  {
+      for (; len >= 255; len -= 255)
+      { dst.push_back(255); }
+
+      dst.push_back(static_cast<std::uint8_t>(len));
+  }
+
+  inline bool read_length(const std::uint8_t*& ip, const std::uint8_t* end, std::size_t& len)
+  {
+      for (;;)
+      {
+          if (ip >= end)
+          { return false; }
+
+          const std::uint8_t b = *ip++;
+          len += b;
+
+          if (b != 255)
+          { return true; }
+      }
+  }
+
+  void write_sequence(std::vector<std::uint8_t>& dst, const std::uint8_t* literals, std::size_t numLiterals, std::size_t offset, std::size_t matchLength)
+  {
+      const std::size_t m = matchLength != 0 ? matchLength - MIN_MATCH : 0;
+
+      dst.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(numLiterals, 15) << 4) | std::min<std::size_t>(m, 15)));
+
+      if (numLiterals >= 15)
+      { write_length(dst, numLiterals - 15); }
+
+      dst.insert(dst.end(), literals, literals + numLiterals);
+
+      if (matchLength == 0)
+      { return; } // last sequence
+
+      dst.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+      dst.push_back(static_cast<std::uint8_t>(offset >> 8));
+
+      if (m >= 15)
+      { write_length(dst, m - 15); }
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void ChunkCodec::shuffle(const void* src, std::size_t numElements, std::size_t elementNumBytes, void* dst)
+{
+    const std::uint8_t* s = static_cast<const std::uint8_t*>(src);
+    std::uint8_t* d = static_cast<std::uint8_t*>(dst);
+
+    // one plane at a time: sequential writes
+    for (std::size_t k = 0; k < elementNumBytes; ++k)
+    {
+        std::uint8_t* plane = d + k * numElements;
+        const std::uint8_t* b = s + k;
+
+        for (std::size_t i = 0; i < numElements; ++i)
+        { plane[i] = b[i * elementNumBytes]; }
+    }
+}
+
+void ChunkCodec::unshuffle(const void* src, std::size_t numElements, std::size_t elementNumBytes, void* dst)
+{
+    const std::uint8_t* s = static_cast<const std::uint8_t*>(src);
+    std::uint8_t* d = static_cast<std::uint8_t*>(dst);
+
+    for (std::size_t k = 0; k < elementNumBytes; ++k)
+    {
+        const std::uint8_t* plane = s + k * numElements;
+        std::uint8_t* b = d + k;
+
+        for (std::size_t i = 0; i < numElements; ++i)
+        { b[i * elementNumBytes] = plane[i]; }
+    }
+}
+
+void ChunkCodec::compress(const std::uint8_t* src, std::size_t n, std::vector<std::uint8_t>& dst)
+{
+    std::size_t anchor = 0;
+
+    if (n > LAST_LITERALS + MIN_MATCH)
+    {
+        std::vector<std::uint32_t> table(std::size_t(1) << HASH_BITS, 0); // position + 1; 0 = empty
+
+        const std::size_t matchLimit = n - LAST_LITERALS;
+        std::size_t ip = 0;
+
+        while (ip + MIN_MATCH <= matchLimit)
+        {
+            const std::uint32_t v = read_u32(src + ip);
+            const std::uint32_t h = hash(v);
+            const std::size_t ref = table[h];
+            table[h] = static_cast<std::uint32_t>(ip + 1);
+
+            if (ref == 0 || ip - (ref - 1) > MAX_OFFSET || read_u32(src + ref - 1) != v)
+            {
+                ip += 1 + ((ip - anchor) >> SKIP_STRENGTH);
+                continue;
+            }
+
+            const std::size_t matchPos = ref - 1;
+
+            std::size_t len = MIN_MATCH;
+            while (ip + len < matchLimit && src[matchPos + len] == src[ip + len])
+            { ++len; }
+
+            write_sequence(dst, src + anchor, ip - anchor, ip - matchPos, len);
+
+            ip += len;
+            anchor = ip;
+        } // while ip
+    }
+
+    write_sequence(dst, src + anchor, n - anchor, 0, 0);
+}
+
+bool ChunkCodec::decompress(const std::uint8_t* src, std::size_t n, std::uint8_t* dst, std::size_t dstNumBytes)
+{
+    const std::uint8_t* ip = src;
+    const std::uint8_t* const end = src + n;
+    std::size_t op = 0;
+
+    while (ip < end)
+    {
+        const std::uint8_t token = *ip++;
+
+        std::size_t numLiterals = token >> 4;
+        if (numLiterals == 15 && !read_length(ip, end, numLiterals))
+        { return false; }
+
+        if (numLiterals > static_cast<std::size_t>(end - ip) || numLiterals > dstNumBytes - op)
+        { return false; }
+
+        std::memcpy(dst + op, ip, numLiterals);
+        ip += numLiterals;
+        op += numLiterals;
+
+        if (ip == end)
+        { break; } // last sequence
+
+        if (end - ip < 2)
+        { return false; }
+
+        const std::size_t offset = ip[0] | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+
+        std::size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !read_length(ip, end, matchLength))
+        { return false; }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > op || matchLength > dstNumBytes - op)
+        { return false; }
+
+        /*
+         * offset < length repeats the last offset bytes;
+         * [op - offset, op + copied) is periodic, so the copied part doubles in every step without overlapping
+         */
+        const std::uint8_t* match = dst + op - offset;
+        for (std::size_t copied = 0; copied < matchLength;)
+        {
+            const std::size_t num = std::min(copied + offset, matchLength - copied);
+            std::memcpy(dst + op + copied, match, num);
+            copied += num;
+        }
+
+        op += matchLength;
+    } // while ip
+
+    return op == dstNumBytes;
+}
+
+std::vector<std::uint8_t> ChunkCodec::encode(const double* values, std::size_t numValues)
+{
+    const std::size_t numBytes = numValues * sizeof(double);
+
+    std::vector<std::uint8_t> shuffled(numBytes);
+    shuffle(values, numValues, sizeof(double), shuffled.data());
+
+    std::vector<std::uint8_t> chunk;
+    chunk.reserve(numBytes / 2 + 16);
+    chunk.push_back(METHOD_LZ);
+    compress(shuffled.data(), numBytes, chunk);
+
+    // incompressible: store
+    if (chunk.size() > numBytes + 1)
+    {
+        chunk.assign(1, METHOD_STORED);
+        chunk.insert(chunk.end(), shuffled.begin(), shuffled.end());
+    }
+
+    return chunk;
+}
+
+bool ChunkCodec::decode(const std::uint8_t* chunk, std::size_t chunkNumBytes, double* values, std::size_t numValues)
+{
+    if (chunkNumBytes == 0)
+    { return false; }
+
+    const std::size_t numBytes = numValues * sizeof(double);
+    std::vector<std::uint8_t> shuffled;
+
+    switch (chunk[0])
+    {
+        case METHOD_STORED:
+        {
+            if (chunkNumBytes - 1 != numBytes)
+            { return false; }
+
+            unshuffle(chunk + 1, numValues, sizeof(double), values);
+            return true;
+        }
+        case METHOD_LZ:
+        {
+            shuffled.resize(numBytes);
+            if (!decompress(chunk + 1, chunkNumBytes - 1, shuffled.data(), numBytes))
+            { return false; }
+
+            unshuffle(shuffled.data(), numValues, sizeof(double), values);
+            return true;
+        }
+        default: return false;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_CHUNKCODEC_H
+#define BLOODLINE_CHUNKCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Self-contained lossless codec for chunks of doubles (FlowFieldChunkedCache).
+ *
+ * encode():
+ *  1. byte shuffle: byte k of every value is stored in plane k, so the slowly varying sign/exponent
+ *     bytes and the noisy mantissa bytes end up in separate runs
+ *  2. LZ77 compression with a 64 KiB window (LZ4-like sequences)
+ *
+ * encoded chunk:
+ *          [1] x [uint8] : method (0 = stored shuffled, 1 = LZ)
+ *     [remaining] x [char] : payload
+ *
+ * LZ sequence:
+ *          [1] x [uint8] : token (literal length << 4 | (match length - 4))
+ *          [*] x [uint8] : literal length extension (only if nibble == 15; bytes of 255 + remainder)
+ *  [literal length] x [char] : literals
+ *          [2] x [uint8] : match offset (little endian; absent after the last literals)
+ *          [*] x [uint8] : match length extension (only if nibble == 15)
+ */
+class ChunkCodec
+{
+  public:
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! dst[k * numElements + i] = byte k of element i
+    static void shuffle(const void* src, std::size_t numElements, std::size_t elementNumBytes, void* dst);
+    static void unshuffle(const void* src, std::size_t numElements, std::size_t elementNumBytes, void* dst);
+
+    //! appends the LZ compressed src to dst
+    static void compress(const std::uint8_t* src, std::size_t n, std::vector<std::uint8_t>& dst);
+    //! false if src is corrupt or does not decompress to exactly dstNumBytes
+    [[nodiscard]] static bool decompress(const std::uint8_t* src, std::size_t n, std::uint8_t* dst, std::size_t dstNumBytes);
+
+    [[nodiscard]] static std::vector<std::uint8_t> encode(const double* values, std::size_t numValues);
+    //! false if the chunk is corrupt or does not contain exactly numValues values
+    [[nodiscard]] static bool decode(const std::uint8_t* chunk, std::size_t chunkNumBytes, double* values, std::size_t numValues);
+}; // class ChunkCodec
+
+#endif //BLOODLINE_CHUNKCODEC_H
@@ -0,0 +1,275 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "CohortImporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <system_error>
+
+#include "ImportProfiler.h"
+#include "ImporterScientific.h"
+#include "ThreadPool.h"
+
+namespace
+{
+  //! admitted datasets per thread; bounds the datasets that wait for their readers (see ThreadPool::wait())
+  constexpr std::size_t DATASETS_PER_THREAD = 2;
+
+  [[nodiscard]] std::size_t count_occurrences(std::string_view s, std::string_view pattern)
+  {
+      std::size_t n = 0;
+      for (std::size_t pos = s.find(pattern); pos != std::string_view::npos; pos = s.find(pattern, pos + pattern.size()))
+      { ++n; }
+
+      return n;
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+CohortImporter::CohortImporter()
+    : _num_threads(0),
+      _memory_budget(0),
+      _flowfield_memory_mapped(false)
+{ /* do nothing */ }
+
+CohortImporter::~CohortImporter() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+unsigned int CohortImporter::num_threads() const
+{ return _num_threads; }
+
+std::uint64_t CohortImporter::memory_budget() const
+{ return _memory_budget; }
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+void CohortImporter::set_num_threads(unsigned int n)
+{ _num_threads = n; }
+
+void CohortImporter::set_memory_budget(std::uint64_t numBytes)
+{ _memory_budget = numBytes; }
+
+void CohortImporter::set_flowfield_memory_mapped(bool b)
+{ _flowfield_memory_mapped = b; }
+
+void CohortImporter::set_report_callback(ReportCallback f)
+{ _report_callback = std::move(f); }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+std::vector<std::string> CohortImporter::find_datasets(std::string_view root)
+{
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> datasets;
+    std::error_code ec;
+
+    if (fs::is_regular_file(fs::path(root) / "flowfield", ec))
+    {
+        datasets.emplace_back(root);
+        return datasets;
+    }
+
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec))
+    {
+        if (!it->is_directory(ec))
+        { continue; }
+
+        if (fs::is_regular_file(it->path() / "flowfield", ec))
+        {
+            datasets.emplace_back(it->path().string());
+            it.disable_recursion_pending(); // vessel directories
+        }
+    }
+
+    std::sort(datasets.begin(), datasets.end());
+
+    return datasets;
+}
+
+MemoryPlan CohortImporter::plan_memory(std::string_view dir) const
+{
+    ImporterScientific im;
+    im.set_dir(dir);
+    im.set_flowfield_memory_mapped(_flowfield_memory_mapped);
+
+    return im.plan_memory();
+}
+
+std::vector<CohortDatasetRecord> CohortImporter::run(const std::vector<std::string>& datasets) const
+{
+    const auto tStart = std::chrono::steady_clock::now();
+
+    /*
+     * the dataset tasks only wait for their reader tasks -> they run on threads of their own;
+     * waiting outside the reader pool blocks instead of running another dataset's readers
+     */
+    ThreadPool pool(_num_threads);
+    const std::size_t maxRunning = pool.num_threads() * DATASETS_PER_THREAD;
+
+    ThreadPool datasetPool(static_cast<unsigned int>(std::max<std::size_t>(1, std::min(maxRunning, datasets.size()))));
+
+    // a dataset whose planning throws is not imported; its record keeps status Error
+    std::vector<CohortDatasetRecord> records(datasets.size());
+    std::vector<bool> planned(datasets.size(), false);
+
+    for (std::size_t i = 0; i < datasets.size(); ++i)
+    {
+        records[i].dir = datasets[i];
+
+        try
+        {
+            const MemoryPlan plan = plan_memory(datasets[i]);
+
+            records[i].num_truncated_files = plan.num_truncated();
+            records[i].estimated_num_bytes = plan.peak_num_bytes(pool.num_threads());
+            planned[i] = true;
+        }
+        catch (const std::exception& e)
+        {
+            records[i].status = CohortDatasetStatus::Error;
+            records[i].error = e.what();
+        }
+    }
+
+    // largest first: the long datasets start early and the small ones fill the gaps
+    std::vector<std::size_t> order(datasets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+    { return records[a].estimated_num_bytes > records[b].estimated_num_bytes; });
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::uint64_t numBytesInUse = 0;
+    std::size_t numRunning = 0;
+
+    std::mutex callbackMutex;
+
+    std::vector<std::future<void>> jobs;
+    jobs.reserve(datasets.size());
+
+    for (const std::size_t id: order)
+    {
+        CohortDatasetRecord& rec = records[id];
+
+        if (!planned[id])
+        {
+            if (_report_callback)
+            {
+                std::lock_guard<std::mutex> lock(callbackMutex);
+                _report_callback(rec, std::string());
+            }
+
+            continue;
+        }
+
+        //------------------------------------------------------------------------------------------------------
+        // admission: wait until the dataset fits into the budget or nothing else is running
+        //------------------------------------------------------------------------------------------------------
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]()
+            {
+                if (numRunning == 0)
+                { return true; }
+
+                return numRunning < maxRunning && (_memory_budget == 0 || numBytesInUse + rec.estimated_num_bytes <= _memory_budget);
+            });
+
+            numBytesInUse += rec.estimated_num_bytes;
+            ++numRunning;
+        }
+
+        rec.wait_seconds = ImportProfiler::seconds_since(tStart);
+
+        jobs.emplace_back(datasetPool.enqueue([&, id]()
+                                              {
+                                                  CohortDatasetRecord& r = records[id];
+                                                  const auto t0 = std::chrono::steady_clock::now();
+
+                                                  std::string report;
+                                                  std::stringstream console;
+
+                                                  try
+                                                  {
+                                                      ImporterScientific im;
+                                                      im.set_dir(r.dir);
+                                                      im.set_flowfield_memory_mapped(_flowfield_memory_mapped);
+                                                      im.set_thread_pool(&pool);
+                                                      im.set_console(console);
+
+                                                      r.num_vessels = im._find_vessel_names().size();
+                                                      report = im.read_all();
+                                                      report += console.str();
+
+                                                      r.num_failed_reads = count_occurrences(report, "FAILED!");
+                                                      r.status = r.num_failed_reads == 0 && r.num_truncated_files == 0 ? CohortDatasetStatus::Complete : CohortDatasetStatus::Incomplete;
+                                                  }
+                                                  catch (const std::exception& e)
+                                                  {
+                                                      r.status = CohortDatasetStatus::Error;
+                                                      r.error = e.what();
+                                                  }
+
+                                                  r.seconds = ImportProfiler::seconds_since(t0);
+
+                                                  if (_report_callback)
+                                                  {
+                                                      std::lock_guard<std::mutex> lock(callbackMutex);
+                                                      _report_callback(r, report);
+                                                  }
+
+                                                  {
+                                                      std::lock_guard<std::mutex> lock(mutex);
+                                                      numBytesInUse -= r.estimated_num_bytes;
+                                                      --numRunning;
+                                                  }
+
+                                                  cv.notify_all();
+                                              }));
+    } // for order
+
+    for (std::future<void>& job: jobs)
+    { job.get(); }
+
+    return records;
+}
+
+std::vector<CohortDatasetRecord> CohortImporter::run(std::string_view root) const
+{ return run(find_datasets(root)); }
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_COHORTIMPORTER_H
+#define BLOODLINE_COHORTIMPORTER_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ImporterScientificData.h"
+
+enum class CohortDatasetStatus
+{
+    Complete, // every reader succeeded
+    Incomplete, // some readers reported "FAILED!" or the memory plan found truncated files (missing files are not failures)
+    Error // the memory planning or the import threw
+}; // enum class CohortDatasetStatus
+
+struct CohortDatasetRecord
+{
+    std::string dir;
+    CohortDatasetStatus status = CohortDatasetStatus::Error;
+    std::string error; // status == Error only
+    std::size_t num_vessels = 0;
+    std::size_t num_failed_reads = 0;
+    std::size_t num_truncated_files = 0; // see MemoryPlanComponent::truncated
+    std::uint64_t estimated_num_bytes = 0; // peak of the memory plan; charged against the memory budget
+    double wait_seconds = 0; // start of run() until admission (memory budget)
+    double seconds = 0; // import
+}; // struct CohortDatasetRecord
+
+/*
+ * Runs ImporterScientific::read_all() over all datasets below a cohort root.
+ *
+ * The per-file and per-vessel reader tasks of all datasets share one work-stealing ThreadPool,
+ * so idle threads steal from a large dataset instead of waiting for it. The dataset tasks, which
+ * only wait for their readers, run on separate threads; a waiting dataset never runs another
+ * dataset's import on its stack. Datasets are started largest first.
+ *
+ * A dataset is admitted only while the estimated memory of all running datasets stays within the
+ * budget and at most two datasets per thread are running. The estimate is the peak of the
+ * pre-flight memory plan (ImporterScientific::plan_memory()): one reader task per thread holds its
+ * parsed file. A dataset that is larger than the budget on its own runs alone.
+ */
+class CohortImporter
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    //! called once per dataset, serialized, in completion order; report is the result of read_all()
+    using ReportCallback = std::function<void(const CohortDatasetRecord& record, const std::string& report)>;
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+  private:
+    unsigned int _num_threads;
+    std::uint64_t _memory_budget;
+    bool _flowfield_memory_mapped;
+    ReportCallback _report_callback;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    CohortImporter();
+    CohortImporter(const CohortImporter&) = default;
+    CohortImporter(CohortImporter&&) = default;
+
+    ~CohortImporter();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] unsigned int num_threads() const;
+    [[nodiscard]] std::uint64_t memory_budget() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] CohortImporter& operator=(const CohortImporter&) = default;
+    [[maybe_unused]] CohortImporter& operator=(CohortImporter&&) = default;
+
+    //! 0 = std::thread::hardware_concurrency()
+    void set_num_threads(unsigned int n);
+
+    //! in bytes; 0 = unlimited
+    void set_memory_budget(std::uint64_t numBytes);
+
+    //! see ImporterScientific::set_flowfield_memory_mapped()
+    void set_flowfield_memory_mapped(bool b);
+
+    void set_report_callback(ReportCallback f);
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! directories below root (or root itself) that contain a "flowfield" file; vessel subdirectories are not searched; sorted
+    [[nodiscard]] static std::vector<std::string> find_datasets(std::string_view root);
+
+    //! ImporterScientific::plan_memory() of the dataset with the settings of this importer
+    [[nodiscard]] MemoryPlan plan_memory(std::string_view dir) const;
+
+    //! one record per dataset in the order of datasets
+    [[nodiscard]] std::vector<CohortDatasetRecord> run(const std::vector<std::string>& datasets) const;
+
+    //! run(find_datasets(root))
+    [[nodiscard]] std::vector<CohortDatasetRecord> run(std::string_view root) const;
+}; // class CohortImporter
+
+#endif //BLOODLINE_COHORTIMPORTER_H
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "FloatNarrowing.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BLOODLINE_FLOATNARROWING_AVX
+    #include <immintrin.h>
+#endif
+
+namespace
+{
+#ifdef BLOODLINE_FLOATNARROWING_AVX
+  __attribute__((target("avx")))
+  void narrow_avx(const double* src, std::size_t n, float* dst, FloatNarrowing::Error& err)
+  {
+      const __m256d signMask = _mm256_set1_pd(-0.0);
+      const __m256d zero = _mm256_setzero_pd();
+
+      __m256d maxAbs = _mm256_set1_pd(err.max_abs);
+      __m256d maxRel = _mm256_set1_pd(err.max_rel);
+
+      std::size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+          const __m256d d = _mm256_loadu_pd(src + i);
+          const __m128 f = _mm256_cvtpd_ps(d);
+          _mm_storeu_ps(dst + i, f);
+
+          const __m256d absDiff = _mm256_andnot_pd(signMask, _mm256_sub_pd(_mm256_cvtps_pd(f), d));
+          const __m256d absValue = _mm256_andnot_pd(signMask, d);
+
+          // relative error only where |d| > 0
+          const __m256d rel = _mm256_and_pd(_mm256_div_pd(absDiff, absValue), _mm256_cmp_pd(absValue, zero, _CMP_GT_OQ));
+
+          // max_pd returns the 2nd operand if one is NaN -> NaN differences are ignored
+          maxAbs = _mm256_max_pd(absDiff, maxAbs);
+          maxRel = _mm256_max_pd(rel, maxRel);
+      }
+
+      alignas(32) double a[4];
+      alignas(32) double r[4];
+      _mm256_store_pd(a, maxAbs);
+      _mm256_store_pd(r, maxRel);
+
+      err.max_abs = std::max({a[0], a[1], a[2], a[3]});
+      err.max_rel = std::max({r[0], r[1], r[2], r[3]});
+
+      FloatNarrowing::narrow_scalar(src + i, n - i, dst + i, err);
+  }
+#endif
+
+  [[nodiscard]] bool has_avx()
+  {
+    #ifdef BLOODLINE_FLOATNARROWING_AVX
+      static const bool b = __builtin_cpu_supports("avx");
+      return b;
+    #else
+      return false;
+    #endif
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void FloatNarrowing::Error::merge(const Error& other)
+{
+    max_abs = std::max(max_abs, other.max_abs);
+    max_rel = std::max(max_rel, other.max_rel);
+}
+
+void FloatNarrowing::narrow_scalar(const double* src, std::size_t n, float* dst, Error& err)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float f = static_cast<float>(src[i]);
+        dst[i] = f;
+
+        const double absDiff = std::abs(static_cast<double>(f) - src[i]);
+        const double absValue = std::abs(src[i]);
+
+        if (absDiff > err.max_abs)
+        { err.max_abs = absDiff; }
+
+        if (absValue > 0 && absDiff / absValue > err.max_rel)
+        { err.max_rel = absDiff / absValue; }
+    }
+}
+
+void FloatNarrowing::narrow(const double* src, std::size_t n, float* dst, Error& err)
+{
+  #ifdef BLOODLINE_FLOATNARROWING_AVX
+    if (has_avx())
+    {
+        narrow_avx(src, n, dst, err);
+        return;
+    }
+  #endif
+
+    narrow_scalar(src, n, dst, err);
+}
+
+bool FloatNarrowing::read(std::istream& file, std::size_t n, std::vector<float>& dst, Error& err, std::size_t blockNumValues)
+{
+    dst.assign(n, 0);
+
+    blockNumValues = std::max<std::size_t>(1, blockNumValues);
+    std::vector<double> block(std::min(blockNumValues, n));
+
+    std::size_t numConverted = 0;
+    while (numConverted < n)
+    {
+        const std::size_t numValues = std::min(blockNumValues, n - numConverted);
+
+        file.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(numValues * sizeof(double)));
+        const std::size_t numRead = static_cast<std::size_t>(file.gcount()) / sizeof(double);
+
+        narrow(block.data(), numRead, dst.data() + numConverted, err);
+        numConverted += numRead;
+
+        if (numRead != numValues)
+        { return false; } // truncated file
+    } // while numConverted < n
+
+    return true;
+}
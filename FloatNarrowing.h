@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_FLOATNARROWING_H
+#define BLOODLINE_FLOATNARROWING_H
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+
+/*
+ * Conversion of double payloads to float while reading (single precision loading mode of
+ * ImporterScientific).
+ *
+ * The kernel converts 4 values per iteration with AVX (cvtpd_ps) if the CPU supports it and
+ * tracks the maximum absolute and relative rounding error on the way. NaN values are ignored
+ * by the error; values outside the float range become +-inf and yield an infinite error.
+ */
+class FloatNarrowing
+{
+  public:
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+    static constexpr std::size_t DEFAULT_BLOCK_NUM_VALUES = 1 << 16;
+
+    struct Error
+    {
+        double max_abs = 0;
+        double max_rel = 0; // |float - double| / |double|; zeros are skipped
+
+        void merge(const Error& other);
+    }; // struct Error
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! dst[i] = float(src[i]); err is extended by the conversion error
+    static void narrow(const double* src, std::size_t n, float* dst, Error& err);
+    static void narrow_scalar(const double* src, std::size_t n, float* dst, Error& err);
+
+    /*!
+     * reads n doubles from file in blocks of blockNumValues and stores them narrowed in dst (resized to n)
+     * @return false if the stream ended early (the missing values stay zero)
+     */
+    static bool read(std::istream& file, std::size_t n, std::vector<float>& dst, Error& err, std::size_t blockNumValues = DEFAULT_BLOCK_NUM_VALUES);
+}; // class FloatNarrowing
+
+#endif //BLOODLINE_FLOATNARROWING_H
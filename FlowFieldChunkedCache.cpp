@@ -0,0 +1,518 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "FlowFieldChunkedCache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "BulkRead.h"
+#include "ChunkCodec.h"
+#include "ImportProfiler.h"
+#include "ThreadPool.h"
+
+namespace
+{
+  constexpr char MAGIC[8] = {'B', 'L', 'F', 'F', 'C', 'H', 'N', 'K'};
+  constexpr std::uint64_t HEADER_NUM_BYTES = sizeof(MAGIC) + FlowFieldHeader::num_bytes + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+  //! chunks compressed per batch and thread while building; bounds the memory of the pending chunks
+  constexpr std::size_t CHUNKS_PER_THREAD_AND_BATCH = 4;
+
+  using Layout = FlowFieldChunkedCache::Layout;
+
+  [[nodiscard]] std::array<std::uint32_t, 3> num_bricks(const FlowFieldHeader& header, std::uint32_t brickSize)
+  {
+      std::array<std::uint32_t, 3> n{};
+      for (unsigned int d = 0; d < 3; ++d)
+      { n[d] = (header.size[d] + brickSize - 1) / brickSize; }
+
+      return n;
+  }
+
+  [[nodiscard]] std::size_t num_chunks(const FlowFieldHeader& header, Layout layout, std::uint32_t brickSize)
+  {
+      if (layout == Layout::TimeFrame)
+      { return header.size[3]; }
+
+      const std::array<std::uint32_t, 3> n = num_bricks(header, brickSize);
+      return static_cast<std::size_t>(n[0]) * n[1] * n[2];
+  }
+
+  //! {x0, y0, z0, x1, y1, z1}
+  [[nodiscard]] std::array<std::uint32_t, 6> brick_box(const FlowFieldHeader& header, std::uint32_t brickSize, std::size_t chunkId)
+  {
+      const std::array<std::uint32_t, 3> n = num_bricks(header, brickSize);
+
+      std::array<std::uint32_t, 3> b{};
+      b[2] = static_cast<std::uint32_t>(chunkId % n[2]);
+      b[1] = static_cast<std::uint32_t>((chunkId / n[2]) % n[1]);
+      b[0] = static_cast<std::uint32_t>(chunkId / (static_cast<std::size_t>(n[1]) * n[2]));
+
+      std::array<std::uint32_t, 6> box{};
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+          box[d] = b[d] * brickSize;
+          box[d + 3] = std::min(header.size[d], box[d] + brickSize);
+      }
+
+      return box;
+  }
+
+  [[nodiscard]] std::size_t chunk_num_values(const FlowFieldHeader& header, Layout layout, std::uint32_t brickSize, std::size_t chunkId)
+  {
+      if (layout == Layout::TimeFrame)
+      { return header.frame_num_values(); }
+
+      const std::array<std::uint32_t, 6> box = brick_box(header, brickSize, chunkId);
+      return static_cast<std::size_t>(box[3] - box[0]) * (box[4] - box[1]) * (box[5] - box[2]) * header.size[3] * 3;
+  }
+
+  //! calls f(offset of the row in the payload, offset of the row in the chunk, row length) for every contiguous z row of a brick (all doubles)
+  template<typename F>
+  void for_each_brick_row(const FlowFieldHeader& header, std::uint32_t brickSize, std::size_t chunkId, F f)
+  {
+      const std::array<std::uint32_t, 6> box = brick_box(header, brickSize, chunkId);
+      const std::size_t voxelNumValues = static_cast<std::size_t>(header.size[3]) * 3;
+      const std::size_t rowNumValues = (box[5] - box[2]) * voxelNumValues;
+
+      std::size_t chunkOffset = 0;
+      for (std::uint32_t x = box[0]; x < box[3]; ++x)
+      {
+          for (std::uint32_t y = box[1]; y < box[4]; ++y)
+          {
+              const std::size_t voxel = (static_cast<std::size_t>(x) * header.size[1] + y) * header.size[2] + box[2];
+              f(voxel * voxelNumValues, chunkOffset, rowNumValues);
+              chunkOffset += rowNumValues;
+          }
+      }
+  }
+
+  void gather_chunk(const FlowFieldView& view, Layout layout, std::uint32_t brickSize, std::size_t chunkId, double* dst)
+  {
+      if (layout == Layout::TimeFrame)
+      {
+          view.copy_time_frame(static_cast<std::uint32_t>(chunkId), dst);
+          return;
+      }
+
+      const double* vectors = view.data();
+      for_each_brick_row(view.header(), brickSize, chunkId, [&](std::size_t payloadOffset, std::size_t chunkOffset, std::size_t num)
+      { std::memcpy(dst + chunkOffset, vectors + payloadOffset, num * sizeof(double)); });
+  }
+
+  //! vectors: whole payload (x y z t component)
+  void scatter_chunk(const FlowFieldHeader& header, Layout layout, std::uint32_t brickSize, std::size_t chunkId, const double* src, double* vectors)
+  {
+      if (layout == Layout::TimeFrame)
+      {
+          const std::size_t numVoxels = static_cast<std::size_t>(header.size[0]) * header.size[1] * header.size[2];
+          const std::size_t sizeT = header.size[3];
+
+          for (std::size_t i = 0; i < numVoxels; ++i)
+          { std::memcpy(vectors + (i * sizeT + chunkId) * 3, src + i * 3, 3 * sizeof(double)); }
+
+          return;
+      }
+
+      for_each_brick_row(header, brickSize, chunkId, [&](std::size_t payloadOffset, std::size_t chunkOffset, std::size_t num)
+      { std::memcpy(vectors + payloadOffset, src + chunkOffset, num * sizeof(double)); });
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+FlowFieldChunkedCache::FlowFieldChunkedCache()
+    : _layout(Layout::TimeFrame),
+      _brick_size(0)
+{ /* do nothing */ }
+
+FlowFieldChunkedCache::FlowFieldChunkedCache(FlowFieldChunkedCache&&) = default;
+FlowFieldChunkedCache::~FlowFieldChunkedCache() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+bool FlowFieldChunkedCache::is_open() const
+{ return _file.is_open(); }
+
+const FlowFieldHeader& FlowFieldChunkedCache::header() const
+{ return _header; }
+
+FlowFieldChunkedCache::Layout FlowFieldChunkedCache::layout() const
+{ return _layout; }
+
+std::uint32_t FlowFieldChunkedCache::brick_size() const
+{ return _brick_size; }
+
+const std::vector<FlowFieldChunkedCache::Chunk>& FlowFieldChunkedCache::chunks() const
+{ return _chunks; }
+
+std::size_t FlowFieldChunkedCache::chunk_num_values(std::size_t chunkId) const
+{ return ::chunk_num_values(_header, _layout, _brick_size, chunkId); }
+
+std::string FlowFieldChunkedCache::default_path(std::string_view flowfieldPath)
+{ return FlowFieldCacheFile::default_path(flowfieldPath, ".zcache"); }
+
+bool FlowFieldChunkedCache::is_up_to_date(std::string_view flowfieldPath, std::string_view cachePath)
+{
+    FlowFieldChunkedCache cache;
+    return FlowFieldCacheFile::is_newer(flowfieldPath, cachePath) && cache.open(cachePath);
+}
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+FlowFieldChunkedCache& FlowFieldChunkedCache::operator=(FlowFieldChunkedCache&&) = default;
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool FlowFieldChunkedCache::build(const FlowFieldView& view, std::string_view cachePath, Layout layout, std::uint32_t brickSize, unsigned int numThreads)
+{
+    if (!view.is_open() || (layout == Layout::Brick && brickSize == 0))
+    { return false; }
+
+    if (layout == Layout::TimeFrame)
+    { brickSize = 0; }
+
+    if (numThreads == 0)
+    { numThreads = std::max(1U, std::thread::hardware_concurrency()); }
+
+    const FlowFieldHeader& header = view.header();
+    const std::size_t numChunks = num_chunks(header, layout, brickSize);
+
+    const std::string tmpPath = FlowFieldCacheFile::temp_path(cachePath);
+
+    bool success = true;
+    {
+        std::ofstream file(tmpPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!file.good())
+        { return false; }
+
+        //------------------------------------------------------------------------------------------------------
+        // header; the chunk table is written once all offsets are known
+        //------------------------------------------------------------------------------------------------------
+        const std::uint32_t layoutId = static_cast<std::uint32_t>(layout);
+        const std::uint64_t numChunks64 = numChunks;
+
+        file.write(MAGIC, sizeof(MAGIC));
+        header.write(file);
+        file.write(reinterpret_cast<const char*>(&layoutId), sizeof(layoutId));
+        file.write(reinterpret_cast<const char*>(&brickSize), sizeof(brickSize));
+        file.write(reinterpret_cast<const char*>(&numChunks64), sizeof(numChunks64));
+
+        std::vector<Chunk> table(numChunks);
+        const std::uint64_t tableNumBytes = numChunks * 2 * sizeof(std::uint64_t);
+        std::uint64_t offset = HEADER_NUM_BYTES + tableNumBytes;
+        file.seekp(static_cast<std::streamoff>(offset));
+
+        //------------------------------------------------------------------------------------------------------
+        // chunks
+        // - each batch is compressed in parallel and then appended in chunk order
+        //------------------------------------------------------------------------------------------------------
+        const std::size_t batchSize = static_cast<std::size_t>(numThreads) * CHUNKS_PER_THREAD_AND_BATCH;
+        std::vector<std::vector<std::uint8_t>> encoded(std::min(batchSize, numChunks));
+
+        ThreadPool pool(numThreads);
+
+        for (std::size_t batchBegin = 0; batchBegin < numChunks && file.good(); batchBegin += batchSize)
+        {
+            const std::size_t batchEnd = std::min(numChunks, batchBegin + batchSize);
+
+            ThreadPool::parallel_for(pool, batchEnd - batchBegin, 1, [&](std::size_t first, std::size_t last)
+            {
+                std::vector<double> values;
+
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    const std::size_t chunkId = batchBegin + i;
+
+                    values.resize(::chunk_num_values(header, layout, brickSize, chunkId));
+                    gather_chunk(view, layout, brickSize, chunkId, values.data());
+                    encoded[i] = ChunkCodec::encode(values.data(), values.size());
+                }
+            });
+
+            for (std::size_t chunkId = batchBegin; chunkId < batchEnd; ++chunkId)
+            {
+                const std::vector<std::uint8_t>& chunk = encoded[chunkId - batchBegin];
+                file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+
+                table[chunkId] = {offset, chunk.size()};
+                offset += chunk.size();
+            }
+        } // for batchBegin
+
+        file.seekp(static_cast<std::streamoff>(HEADER_NUM_BYTES));
+        for (const Chunk& c: table)
+        {
+            file.write(reinterpret_cast<const char*>(&c.offset), sizeof(c.offset));
+            file.write(reinterpret_cast<const char*>(&c.num_bytes), sizeof(c.num_bytes));
+        }
+
+        success = file.good();
+    }
+
+    return FlowFieldCacheFile::finish(cachePath, success);
+}
+
+bool FlowFieldChunkedCache::open(std::string_view cachePath)
+{
+    close();
+
+    _file.open(std::string(cachePath), std::ios_base::in | std::ios_base::binary);
+    if (!_file.good())
+    {
+        close();
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)] = {};
+    _file.read(magic, sizeof(magic));
+
+    _header.read(_file);
+
+    std::uint32_t layoutId = 0;
+    std::uint64_t numChunks = 0;
+    _file.read(reinterpret_cast<char*>(&layoutId), sizeof(layoutId));
+    _file.read(reinterpret_cast<char*>(&_brick_size), sizeof(_brick_size));
+    _file.read(reinterpret_cast<char*>(&numChunks), sizeof(numChunks));
+
+    _layout = static_cast<Layout>(layoutId);
+
+    std::error_code ec;
+    const std::uintmax_t fileNumBytes = std::filesystem::file_size(cachePath, ec);
+
+    const bool validLayout = (_layout == Layout::TimeFrame && _brick_size == 0) || (_layout == Layout::Brick && _brick_size != 0);
+
+    if (!_file.good() || ec || !std::equal(magic, magic + sizeof(magic), MAGIC) || !validLayout || numChunks != num_chunks(_header, _layout, _brick_size))
+    {
+        close();
+        return false;
+    }
+
+    //------------------------------------------------------------------------------------------------------
+    // chunk table; every chunk has to lie behind the table and inside the file
+    //------------------------------------------------------------------------------------------------------
+    const std::uint64_t payloadBegin = HEADER_NUM_BYTES + numChunks * 2 * sizeof(std::uint64_t);
+    bool validTable = payloadBegin <= fileNumBytes;
+
+    if (validTable)
+    {
+        _chunks.resize(numChunks);
+        for (Chunk& c: _chunks)
+        {
+            _file.read(reinterpret_cast<char*>(&c.offset), sizeof(c.offset));
+            _file.read(reinterpret_cast<char*>(&c.num_bytes), sizeof(c.num_bytes));
+
+            validTable = validTable && c.offset >= payloadBegin && c.offset <= fileNumBytes && c.num_bytes <= fileNumBytes - c.offset;
+        }
+    }
+
+    if (!_file.good() || !validTable)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void FlowFieldChunkedCache::close()
+{
+    if (_file.is_open())
+    { _file.close(); }
+
+    _file.clear();
+    _header = FlowFieldHeader();
+    _layout = Layout::TimeFrame;
+    _brick_size = 0;
+    _chunks.clear();
+}
+
+bool FlowFieldChunkedCache::read_chunk(std::size_t chunkId, double* dst)
+{
+    if (!is_open() || chunkId >= _chunks.size())
+    { return false; }
+
+    const Chunk& c = _chunks[chunkId];
+    std::vector<std::uint8_t> encoded(c.num_bytes);
+
+    _file.seekg(static_cast<std::streamoff>(c.offset));
+    _file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(c.num_bytes));
+
+    if (!_file.good())
+    {
+        _file.clear();
+        return false;
+    }
+
+    return ChunkCodec::decode(encoded.data(), encoded.size(), dst, chunk_num_values(chunkId));
+}
+
+std::optional<FlowFieldData> FlowFieldChunkedCache::read(unsigned int numThreads)
+{
+    if (!is_open())
+    { return std::nullopt; }
+
+    //------------------------------------------------------------------------------------------------------
+    // all chunks in one sequential read
+    //------------------------------------------------------------------------------------------------------
+    std::uint64_t payloadBegin = HEADER_NUM_BYTES + _chunks.size() * 2 * sizeof(std::uint64_t);
+    std::uint64_t payloadEnd = payloadBegin;
+    for (const Chunk& c: _chunks)
+    { payloadEnd = std::max(payloadEnd, c.offset + c.num_bytes); }
+
+    std::vector<std::uint8_t> encoded(payloadEnd - payloadBegin);
+
+    _file.seekg(static_cast<std::streamoff>(payloadBegin));
+    BulkRead::read(_file, encoded.data(), encoded.size());
+
+    if (!_file.good())
+    {
+        _file.clear();
+        return std::nullopt;
+    }
+
+    //------------------------------------------------------------------------------------------------------
+    // decode + scatter; chunks write disjoint parts of the payload
+    //------------------------------------------------------------------------------------------------------
+    FlowFieldData ff;
+    ff.header = _header;
+    ff.vectors.resize(_header.num_vectors() * 3);
+
+    std::atomic<bool> success(true);
+
+    ThreadPool::parallel_for(_chunks.size(), 1, numThreads, [&](std::size_t first, std::size_t last)
+    {
+        std::vector<double> values;
+
+        for (std::size_t chunkId = first; chunkId < last && success; ++chunkId)
+        {
+            const Chunk& c = _chunks[chunkId];
+            values.resize(chunk_num_values(chunkId));
+
+            if (!ChunkCodec::decode(encoded.data() + (c.offset - payloadBegin), c.num_bytes, values.data(), values.size()))
+            {
+                success = false;
+                return;
+            }
+
+            scatter_chunk(_header, _layout, _brick_size, chunkId, values.data(), ff.vectors.data());
+        }
+    });
+
+    if (!success)
+    { return std::nullopt; }
+
+    return ff;
+}
+
+FlowFieldChunkedCacheBenchmark FlowFieldChunkedCache::benchmark(const FlowFieldView& view, Layout layout, std::uint32_t brickSize, unsigned int numThreads)
+{
+    FlowFieldChunkedCacheBenchmark res;
+
+    if (!view.is_open() || (layout == Layout::Brick && brickSize == 0))
+    { return res; }
+
+    if (layout == Layout::TimeFrame)
+    { brickSize = 0; }
+
+    const FlowFieldHeader& header = view.header();
+    const std::size_t numChunks = num_chunks(header, layout, brickSize);
+    std::vector<std::vector<std::uint8_t>> encoded(numChunks);
+
+    // touch the payload once so that page faults of the mapping are not timed
+    std::vector<double> vectors(header.num_vectors() * 3);
+    std::memcpy(vectors.data(), view.data(), vectors.size() * sizeof(double));
+
+    // created up front, so that starting the threads is not timed
+    ThreadPool pool(numThreads);
+
+    //------------------------------------------------------------------------------------------------------
+    // compress
+    //------------------------------------------------------------------------------------------------------
+    auto t0 = std::chrono::steady_clock::now();
+
+    ThreadPool::parallel_for(pool, numChunks, 1, [&](std::size_t first, std::size_t last)
+    {
+        std::vector<double> values;
+
+        for (std::size_t chunkId = first; chunkId < last; ++chunkId)
+        {
+            values.resize(::chunk_num_values(header, layout, brickSize, chunkId));
+            gather_chunk(view, layout, brickSize, chunkId, values.data());
+            encoded[chunkId] = ChunkCodec::encode(values.data(), values.size());
+        }
+    });
+
+    const double compressSeconds = ImportProfiler::seconds_since(t0);
+
+    //------------------------------------------------------------------------------------------------------
+    // decompress
+    //------------------------------------------------------------------------------------------------------
+    std::fill(vectors.begin(), vectors.end(), 0.0);
+    std::atomic<bool> success(true);
+
+    t0 = std::chrono::steady_clock::now();
+
+    ThreadPool::parallel_for(pool, numChunks, 1, [&](std::size_t first, std::size_t last)
+    {
+        std::vector<double> values;
+
+        for (std::size_t chunkId = first; chunkId < last; ++chunkId)
+        {
+            values.resize(::chunk_num_values(header, layout, brickSize, chunkId));
+
+            if (!ChunkCodec::decode(encoded[chunkId].data(), encoded[chunkId].size(), values.data(), values.size()))
+            { success = false; }
+            else
+            { scatter_chunk(header, layout, brickSize, chunkId, values.data(), vectors.data()); }
+        }
+    });
+
+    const double decompressSeconds = ImportProfiler::seconds_since(t0);
+
+    //------------------------------------------------------------------------------------------------------
+    // results
+    //------------------------------------------------------------------------------------------------------
+    res.raw_num_bytes = header.payload_num_bytes();
+    for (const std::vector<std::uint8_t>& chunk: encoded)
+    { res.compressed_num_bytes += chunk.size(); }
+
+    res.compression_ratio = res.compressed_num_bytes != 0 ? static_cast<double>(res.raw_num_bytes) / res.compressed_num_bytes : 0;
+    res.compress_gb_per_second = compressSeconds > 0 ? res.raw_num_bytes / compressSeconds * 1e-9 : 0;
+    res.decompress_gb_per_second = decompressSeconds > 0 ? res.raw_num_bytes / decompressSeconds * 1e-9 : 0;
+    res.lossless = success && std::memcmp(vectors.data(), view.data(), vectors.size() * sizeof(double)) == 0;
+
+    return res;
+}
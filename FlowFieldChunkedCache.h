@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_FLOWFIELDCHUNKEDCACHE_H
+#define BLOODLINE_FLOWFIELDCHUNKEDCACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FlowFieldView.h"
+#include "ImporterScientificData.h"
+
+struct FlowFieldChunkedCacheBenchmark
+{
+    std::uint64_t raw_num_bytes = 0;
+    std::uint64_t compressed_num_bytes = 0;
+    double compression_ratio = 0; // raw / compressed
+    double compress_gb_per_second = 0; // raw bytes
+    double decompress_gb_per_second = 0; // raw bytes
+    bool lossless = false;
+}; // struct FlowFieldChunkedCacheBenchmark
+
+/*
+ * Compressed sidecar of a "flowfield" file.
+ *
+ * The payload is split into independent chunks (one per time frame or one per brick of voxels
+ * over all time frames) that are byte-shuffled and compressed with ChunkCodec. Chunks are
+ * compressed and decompressed in parallel; read() restores the exact payload of the flowfield.
+ *
+ * chunk contents:
+ *  - TimeFrame: frame t; layout x y z component
+ *  - Brick: voxels [x0, x1) x [y0, y1) x [z0, z1) of all time frames; layout x y z t component;
+ *           bricks are numbered x outermost
+ *
+ * file layout:
+ *                                  [8] x [char] : "BLFFCHNK"
+ *           [FlowFieldHeader::num_bytes] x [char] : header (same as in the flowfield file)
+ *                           [1] x [uint32] : layout (0 = time frame, 1 = brick)
+ *                           [1] x [uint32] : brick edge length in voxels (0 for time frames)
+ *                           [1] x [uint64] : number of chunks
+ *              [number of chunks * 2] x [uint64] : chunk table (file offset, number of bytes)
+ *                                  [*] x [char] : chunks (ChunkCodec::encode())
+ */
+class FlowFieldChunkedCache
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    enum class Layout : std::uint32_t
+    {
+        TimeFrame = 0,
+        Brick = 1
+    };
+
+    static constexpr std::uint32_t DEFAULT_BRICK_SIZE = 32;
+
+    struct Chunk
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t num_bytes = 0;
+    }; // struct Chunk
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+  private:
+    FlowFieldHeader _header;
+    Layout _layout;
+    std::uint32_t _brick_size;
+    std::vector<Chunk> _chunks;
+    std::ifstream _file;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    FlowFieldChunkedCache();
+    FlowFieldChunkedCache(const FlowFieldChunkedCache&) = delete;
+    FlowFieldChunkedCache(FlowFieldChunkedCache&&);
+
+    ~FlowFieldChunkedCache();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] const FlowFieldHeader& header() const;
+    [[nodiscard]] Layout layout() const;
+    [[nodiscard]] std::uint32_t brick_size() const;
+    [[nodiscard]] const std::vector<Chunk>& chunks() const;
+
+    //! number of doubles of the decoded chunk
+    [[nodiscard]] std::size_t chunk_num_values(std::size_t chunkId) const;
+
+    //! "<flowfield path>.zcache"
+    [[nodiscard]] static std::string default_path(std::string_view flowfieldPath);
+
+    //! cache exists, is complete and is not older than the flowfield file
+    [[nodiscard]] static bool is_up_to_date(std::string_view flowfieldPath, std::string_view cachePath);
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] FlowFieldChunkedCache& operator=(const FlowFieldChunkedCache&) = delete;
+    [[maybe_unused]] FlowFieldChunkedCache& operator=(FlowFieldChunkedCache&&);
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! compresses the payload of view; numThreads == 0 -> hardware concurrency
+    [[nodiscard]] static bool build(const FlowFieldView& view, std::string_view cachePath, Layout layout = Layout::TimeFrame, std::uint32_t brickSize = DEFAULT_BRICK_SIZE, unsigned int numThreads = 0);
+
+    [[nodiscard]] bool open(std::string_view cachePath);
+    void close();
+
+    //! decodes chunk chunkId into dst (chunk_num_values() doubles; see chunk contents)
+    [[nodiscard]] bool read_chunk(std::size_t chunkId, double* dst);
+
+    //! the whole field (same as ImporterScientific::load_flowfield()); chunks are decoded in parallel
+    [[nodiscard]] std::optional<FlowFieldData> read(unsigned int numThreads = 0);
+
+    //! compresses and decompresses the payload of view in memory; GB = 1e9 bytes
+    [[nodiscard]] static FlowFieldChunkedCacheBenchmark benchmark(const FlowFieldView& view, Layout layout = Layout::TimeFrame, std::uint32_t brickSize = DEFAULT_BRICK_SIZE, unsigned int numThreads = 0);
+}; // class FlowFieldChunkedCache
+
+#endif //BLOODLINE_FLOWFIELDCHUNKEDCACHE_H
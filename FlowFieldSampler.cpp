@@ -0,0 +1,370 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "FlowFieldSampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BLOODLINE_FLOWFIELDSAMPLER_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace
+{
+  //! out = m * [in, 1] (m is 5x5 row-major; in/out have 4 values)
+  void transform(const std::array<double, 25>& m, const double* in, double* out)
+  {
+      for (unsigned int r = 0; r < 4; ++r)
+      {
+          const double* row = m.data() + r * 5;
+          out[r] = row[0] * in[0] + row[1] * in[1] + row[2] * in[2] + row[3] * in[3] + row[4];
+      }
+  }
+
+  //! interpolation corners + weight along one axis
+  struct AxisSample
+  {
+      std::size_t i0;
+      std::size_t i1;
+      double f;
+  };
+
+  [[nodiscard]] AxisSample clamped_axis(double g, std::uint32_t size)
+  {
+      const double maxg = static_cast<double>(size) - 1;
+
+      // NaN -> 0 (as _mm256_max_pd in the AVX2 path); std::clamp would pass it on to the size_t cast
+      if (!(g >= 0))
+      { g = 0; }
+
+      g = std::min(g, maxg);
+
+      const double fl = std::floor(g);
+      return {static_cast<std::size_t>(fl), static_cast<std::size_t>(std::min(fl + 1, maxg)), g - fl};
+  }
+
+  [[nodiscard]] AxisSample periodic_axis(double g, std::uint32_t size)
+  {
+      const double n = size;
+      const double tt = std::max(0.0, g - std::floor(g / n) * n);
+      const double fl = std::min(std::floor(tt), n - 1);
+      const std::size_t i0 = static_cast<std::size_t>(fl);
+
+      return {i0, i0 + 1 == size ? 0 : i0 + 1, tt - fl};
+  }
+
+  [[nodiscard]] bool cpu_has_avx2()
+  {
+    #ifdef BLOODLINE_FLOWFIELDSAMPLER_AVX2
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    #else
+      return false;
+    #endif
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+FlowFieldSampler::FlowFieldSampler()
+    : _header(),
+      _vectors(nullptr),
+      _stride{0, 0, 0, 0},
+      _use_avx2(cpu_has_avx2())
+{ /* do nothing */ }
+
+FlowFieldSampler::FlowFieldSampler(const FlowFieldView& view)
+    : FlowFieldSampler(view.header(), view.data())
+{ /* do nothing */ }
+
+FlowFieldSampler::FlowFieldSampler(const FlowFieldHeader& header, const double* vectors)
+    : _header(header),
+      _vectors(vectors),
+      _use_avx2(cpu_has_avx2())
+{
+    _stride[3] = 3;
+    _stride[2] = _stride[3] * _header.size[3];
+    _stride[1] = _stride[2] * _header.size[2];
+    _stride[0] = _stride[1] * _header.size[1];
+}
+
+FlowFieldSampler::~FlowFieldSampler() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+const FlowFieldHeader& FlowFieldSampler::header() const
+{ return _header; }
+
+bool FlowFieldSampler::uses_avx2() const
+{ return _use_avx2; }
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+void FlowFieldSampler::set_avx2_enabled(bool b)
+{ _use_avx2 = b && cpu_has_avx2(); }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void FlowFieldSampler::world_to_grid(const double* worldPos, double* gridPos) const
+{
+    transform(_header.inverse_world_matrix_with_time, worldPos, gridPos);
+
+    for (unsigned int i = 0; i < 4; ++i)
+    { gridPos[i] /= _header.scale[i]; }
+}
+
+void FlowFieldSampler::grid_to_world(const double* gridPos, double* worldPos) const
+{
+    double scaled[4];
+    for (unsigned int i = 0; i < 4; ++i)
+    { scaled[i] = gridPos[i] * _header.scale[i]; }
+
+    transform(_header.world_matrix_with_time, scaled, worldPos);
+}
+
+void FlowFieldSampler::sample_world(std::size_t numSamples, const double* worldPositions, double* velocities) const
+{
+    // convert in small blocks so that the grid positions stay in cache
+    constexpr std::size_t blockSize = 256;
+    double gridPositions[blockSize * 4];
+
+    for (std::size_t first = 0; first < numSamples; first += blockSize)
+    {
+        const std::size_t n = std::min(blockSize, numSamples - first);
+
+        for (std::size_t i = 0; i < n; ++i)
+        { world_to_grid(worldPositions + (first + i) * 4, gridPositions + i * 4); }
+
+        sample_grid(n, gridPositions, velocities + first * 3);
+    }
+}
+
+void FlowFieldSampler::sample_grid(std::size_t numSamples, const double* gridPositions, double* velocities) const
+{
+    if (_vectors == nullptr || _header.num_vectors() == 0)
+    {
+        std::fill(velocities, velocities + numSamples * 3, 0.0);
+        return;
+    }
+
+    // the AVX2 kernel builds offsets from 32 bit index * 32 bit stride products
+    if (_use_avx2 && _stride[0] <= std::numeric_limits<std::uint32_t>::max())
+    { _sample_grid_avx2(numSamples, gridPositions, velocities); }
+    else
+    { _sample_grid_scalar(numSamples, gridPositions, velocities); }
+}
+
+void FlowFieldSampler::_sample_grid_scalar(std::size_t numSamples, const double* gridPositions, double* velocities) const
+{
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        const double* p = gridPositions + i * 4;
+        const AxisSample ax[4] = {clamped_axis(p[0], _header.size[0]), clamped_axis(p[1], _header.size[1]), clamped_axis(p[2], _header.size[2]), periodic_axis(p[3], _header.size[3])};
+
+        double v[3] = {0, 0, 0};
+
+        for (unsigned int corner = 0; corner < 16; ++corner)
+        {
+            std::size_t off = 0;
+            double w = 1;
+
+            for (unsigned int a = 0; a < 4; ++a)
+            {
+                const bool upper = (corner >> a) & 1;
+                off += (upper ? ax[a].i1 : ax[a].i0) * _stride[a];
+                w *= upper ? ax[a].f : 1 - ax[a].f;
+            }
+
+            for (unsigned int c = 0; c < 3; ++c)
+            { v[c] += w * _vectors[off + c]; }
+        } // for corner
+
+        std::copy(v, v + 3, velocities + i * 3);
+    } // for i : numSamples
+}
+
+#ifdef BLOODLINE_FLOWFIELDSAMPLER_AVX2
+namespace
+{
+  //! integral grid index (as double) * stride -> 64 bit offset
+  __attribute__((target("avx2,fma")))
+  inline __m256i to_offset(__m256d idx, __m256i stride)
+  { return _mm256_mul_epu32(_mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(idx)), stride); }
+} // anonymous namespace
+
+__attribute__((target("avx2,fma")))
+void FlowFieldSampler::_sample_grid_avx2(std::size_t numSamples, const double* gridPositions, double* velocities) const
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1);
+
+    __m256d maxg[3];
+    __m256i stride[4];
+    for (unsigned int a = 0; a < 3; ++a)
+    { maxg[a] = _mm256_set1_pd(static_cast<double>(_header.size[a]) - 1); }
+    for (unsigned int a = 0; a < 4; ++a)
+    { stride[a] = _mm256_set1_epi64x(static_cast<long long>(_stride[a])); }
+
+    const __m256d numTimes = _mm256_set1_pd(_header.size[3]);
+    const __m256d maxt = _mm256_set1_pd(static_cast<double>(_header.size[3]) - 1);
+
+    std::size_t i = 0;
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        //------------------------------------------------------------------------------------------------------
+        // 4 x (x y z t) -> x[4] y[4] z[4] t[4]
+        //------------------------------------------------------------------------------------------------------
+        const double* p = gridPositions + i * 4;
+        const __m256d r0 = _mm256_loadu_pd(p);
+        const __m256d r1 = _mm256_loadu_pd(p + 4);
+        const __m256d r2 = _mm256_loadu_pd(p + 8);
+        const __m256d r3 = _mm256_loadu_pd(p + 12);
+        const __m256d lo01 = _mm256_unpacklo_pd(r0, r1); // x0 x1 z0 z1
+        const __m256d hi01 = _mm256_unpackhi_pd(r0, r1); // y0 y1 t0 t1
+        const __m256d lo23 = _mm256_unpacklo_pd(r2, r3);
+        const __m256d hi23 = _mm256_unpackhi_pd(r2, r3);
+
+        const __m256d g[4] = {_mm256_permute2f128_pd(lo01, lo23, 0x20), _mm256_permute2f128_pd(hi01, hi23, 0x20), _mm256_permute2f128_pd(lo01, lo23, 0x31), _mm256_permute2f128_pd(hi01, hi23, 0x31)};
+
+        //------------------------------------------------------------------------------------------------------
+        // per axis: lower/upper offset and weights
+        //------------------------------------------------------------------------------------------------------
+        __m256i off[4][2];
+        __m256d w[4][2];
+
+        for (unsigned int a = 0; a < 3; ++a)
+        {
+            const __m256d ga = _mm256_min_pd(_mm256_max_pd(g[a], zero), maxg[a]);
+            const __m256d fl = _mm256_floor_pd(ga);
+            const __m256d f = _mm256_sub_pd(ga, fl);
+
+            off[a][0] = to_offset(fl, stride[a]);
+            off[a][1] = to_offset(_mm256_min_pd(_mm256_add_pd(fl, one), maxg[a]), stride[a]);
+            w[a][0] = _mm256_sub_pd(one, f);
+            w[a][1] = f;
+        }
+
+        {
+            const __m256d q = _mm256_floor_pd(_mm256_div_pd(g[3], numTimes));
+            const __m256d tt = _mm256_max_pd(_mm256_fnmadd_pd(q, numTimes, g[3]), zero);
+            const __m256d fl = _mm256_min_pd(_mm256_floor_pd(tt), maxt);
+            const __m256d f = _mm256_sub_pd(tt, fl);
+
+            __m256d upper = _mm256_add_pd(fl, one);
+            upper = _mm256_blendv_pd(upper, zero, _mm256_cmp_pd(upper, numTimes, _CMP_GE_OQ)); // periodic
+
+            off[3][0] = to_offset(fl, stride[3]);
+            off[3][1] = to_offset(upper, stride[3]);
+            w[3][0] = _mm256_sub_pd(one, f);
+            w[3][1] = f;
+        }
+
+        //------------------------------------------------------------------------------------------------------
+        // 16 corners x 3 components
+        //------------------------------------------------------------------------------------------------------
+        __m256d v[3] = {zero, zero, zero};
+
+        for (unsigned int cx = 0; cx < 2; ++cx)
+        {
+            for (unsigned int cy = 0; cy < 2; ++cy)
+            {
+                const __m256i offxy = _mm256_add_epi64(off[0][cx], off[1][cy]);
+                const __m256d wxy = _mm256_mul_pd(w[0][cx], w[1][cy]);
+
+                for (unsigned int cz = 0; cz < 2; ++cz)
+                {
+                    const __m256i offxyz = _mm256_add_epi64(offxy, off[2][cz]);
+                    const __m256d wxyz = _mm256_mul_pd(wxy, w[2][cz]);
+
+                    for (unsigned int ct = 0; ct < 2; ++ct)
+                    {
+                        const __m256i o = _mm256_add_epi64(offxyz, off[3][ct]);
+                        const __m256d wc = _mm256_mul_pd(wxyz, w[3][ct]);
+
+                        v[0] = _mm256_fmadd_pd(wc, _mm256_i64gather_pd(_vectors, o, 8), v[0]);
+                        v[1] = _mm256_fmadd_pd(wc, _mm256_i64gather_pd(_vectors + 1, o, 8), v[1]);
+                        v[2] = _mm256_fmadd_pd(wc, _mm256_i64gather_pd(_vectors + 2, o, 8), v[2]);
+                    } // for ct
+                } // for cz
+            } // for cy
+        } // for cx
+
+        //------------------------------------------------------------------------------------------------------
+        // x[4] y[4] z[4] -> 4 x (x y z)
+        //------------------------------------------------------------------------------------------------------
+        alignas(32) double vc[3][4];
+        for (unsigned int c = 0; c < 3; ++c)
+        { _mm256_store_pd(vc[c], v[c]); }
+
+        double* dst = velocities + i * 3;
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+            for (unsigned int c = 0; c < 3; ++c)
+            { *dst++ = vc[c][k]; }
+        }
+    } // for i : numSamples
+
+    _sample_grid_scalar(numSamples - i, gridPositions + i * 4, velocities + i * 3);
+}
+#else
+void FlowFieldSampler::_sample_grid_avx2(std::size_t numSamples, const double* gridPositions, double* velocities) const
+{ _sample_grid_scalar(numSamples, gridPositions, velocities); }
+#endif
+
+double FlowFieldSampler::benchmark(std::size_t numSamples, unsigned int seed) const
+{
+    std::mt19937_64 rng(seed);
+
+    std::vector<double> worldPositions(numSamples * 4);
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        double gridPos[4];
+        for (unsigned int a = 0; a < 4; ++a)
+        {
+            // space: [0, size-1], time: [0, size) (periodic)
+            const double upper = a < 3 ? _header.size[a] - 1.0 : _header.size[a];
+            gridPos[a] = upper > 0 ? std::uniform_real_distribution<double>(0, upper)(rng) : 0;
+        }
+
+        grid_to_world(gridPos, worldPositions.data() + i * 4);
+    }
+
+    std::vector<double> velocities(numSamples * 3);
+
+    const auto start = std::chrono::steady_clock::now();
+    sample_world(numSamples, worldPositions.data(), velocities.data());
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    return seconds.count() > 0 ? numSamples / seconds.count() : 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_FLOWFIELDSAMPLER_H
+#define BLOODLINE_FLOWFIELDSAMPLER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "FlowFieldView.h"
+
+/*
+ * Batched velocity sampler over a flow field payload (x y z t component).
+ *
+ * World positions (x y z [mm], t [ms]) are mapped to grid positions via the inverse 5x5 world
+ * matrix (row-major, time in the 4th row/col) followed by the inverse voxel scale. Velocities
+ * are interpolated trilinearly in space and linearly in time:
+ * - space is clamped to the grid
+ * - time is periodic (the last frame is interpolated towards the first one)
+ *
+ * The batch functions use AVX2 gathers (4 samples per iteration) if the CPU supports it and
+ * fall back to scalar code otherwise.
+ *
+ * The sampler does not own the payload; the view/data it was created from must outlive it.
+ */
+class FlowFieldSampler
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    FlowFieldHeader _header;
+    const double* _vectors;
+    std::array<std::size_t, 4> _stride; // in doubles
+    bool _use_avx2;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    FlowFieldSampler();
+    explicit FlowFieldSampler(const FlowFieldView& view);
+    FlowFieldSampler(const FlowFieldHeader& header, const double* vectors);
+    FlowFieldSampler(const FlowFieldSampler&) = default;
+    FlowFieldSampler(FlowFieldSampler&&) = default;
+
+    ~FlowFieldSampler();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] const FlowFieldHeader& header() const;
+
+    //! false if the CPU has no AVX2/FMA or it was disabled via set_avx2_enabled()
+    [[nodiscard]] bool uses_avx2() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] FlowFieldSampler& operator=(const FlowFieldSampler&) = default;
+    [[maybe_unused]] FlowFieldSampler& operator=(FlowFieldSampler&&) = default;
+
+    //! enabling has no effect if the CPU does not support AVX2/FMA
+    void set_avx2_enabled(bool b);
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! 4 values x y z t each
+    void world_to_grid(const double* worldPos, double* gridPos) const;
+    void grid_to_world(const double* gridPos, double* worldPos) const;
+
+    //! positions: numSamples * 4 (x y z t); velocities: numSamples * 3
+    void sample_world(std::size_t numSamples, const double* worldPositions, double* velocities) const;
+    void sample_grid(std::size_t numSamples, const double* gridPositions, double* velocities) const;
+
+    //! samples numSamples random world positions inside the grid and returns the throughput in samples/s
+    [[nodiscard]] double benchmark(std::size_t numSamples, unsigned int seed = 0) const;
+
+  private:
+    void _sample_grid_scalar(std::size_t numSamples, const double* gridPositions, double* velocities) const;
+    void _sample_grid_avx2(std::size_t numSamples, const double* gridPositions, double* velocities) const;
+}; // class FlowFieldSampler
+
+#endif //BLOODLINE_FLOWFIELDSAMPLER_H
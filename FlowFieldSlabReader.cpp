@@ -0,0 +1,237 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "FlowFieldSlabReader.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <system_error>
+
+#include "ImporterScientific.h"
+
+namespace
+{
+  //! header of a flowfield file whose payload is complete
+  [[nodiscard]] std::optional<FlowFieldHeader> read_header(std::string_view filepath)
+  {
+      std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+      if (!file.good())
+      { return std::nullopt; }
+
+      const FlowFieldHeader header = ImporterScientific::_parse_flowfield_header(file);
+
+      std::error_code ec;
+      const std::uintmax_t fileNumBytes = std::filesystem::file_size(filepath.data(), ec);
+
+      if (!file.good() || ec || fileNumBytes < FlowFieldHeader::num_bytes || !header.payload_fits(fileNumBytes - FlowFieldHeader::num_bytes))
+      { return std::nullopt; }
+
+      return header;
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+FlowFieldSlabReader::FlowFieldSlabReader()
+    : _header(),
+      _slab_thickness(0),
+      _num_slabs(0),
+      _stride{0, 0, 0, 0},
+      _done{false, false},
+      _num_submitted(0),
+      _num_delivered(0),
+      _slab(),
+      _failed(false)
+{ /* do nothing */ }
+
+FlowFieldSlabReader::~FlowFieldSlabReader()
+{ close(); }
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+bool FlowFieldSlabReader::is_open() const
+{ return _file.is_open(); }
+
+const FlowFieldHeader& FlowFieldSlabReader::header() const
+{ return _header; }
+
+std::uint32_t FlowFieldSlabReader::slab_thickness() const
+{ return _slab_thickness; }
+
+std::uint32_t FlowFieldSlabReader::num_slabs() const
+{ return _num_slabs; }
+
+std::uint64_t FlowFieldSlabReader::slab_num_bytes() const
+{ return static_cast<std::uint64_t>(_slab_thickness) * _stride[0] * sizeof(double); }
+
+bool FlowFieldSlabReader::failed() const
+{ return _failed; }
+
+std::uint32_t FlowFieldSlabReader::slab_thickness_for(std::string_view filepath, std::uint64_t memoryBudget)
+{
+    const std::optional<FlowFieldHeader> header = read_header(filepath);
+
+    if (!header)
+    { return 0; }
+
+    const std::uint64_t numBytesPerX = static_cast<std::uint64_t>(header->size[1]) * header->size[2] * header->size[3] * 3 * sizeof(double);
+    const std::uint64_t thickness = numBytesPerX != 0 ? memoryBudget / (NUM_BUFFERS * numBytesPerX) : header->size[0];
+
+    return static_cast<std::uint32_t>(std::clamp<std::uint64_t>(thickness, 1, std::max<std::uint32_t>(header->size[0], 1)));
+}
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool FlowFieldSlabReader::open(std::string_view filepath, std::uint32_t slabThickness, AsyncFileReader::Backend backend)
+{
+    close();
+
+    const std::optional<FlowFieldHeader> header = read_header(filepath);
+
+    if (!header || !_file.open(filepath, backend, NUM_BUFFERS))
+    { return false; }
+
+    _header = *header;
+
+    const std::array<std::uint32_t, 4>& size = _header.size;
+    _stride[3] = 3;
+    _stride[2] = _stride[3] * size[3];
+    _stride[1] = _stride[2] * size[2];
+    _stride[0] = _stride[1] * size[1];
+
+    _slab_thickness = std::clamp<std::uint32_t>(slabThickness, 1, std::max<std::uint32_t>(size[0], 1));
+    _num_slabs = (size[0] + _slab_thickness - 1) / _slab_thickness;
+
+    const std::size_t bufferNumValues = static_cast<std::size_t>(std::min(_slab_thickness, size[0])) * _stride[0];
+    for (std::uint32_t i = 0; i < std::min<std::uint32_t>(NUM_BUFFERS, _num_slabs); ++i)
+    { _buffers[i].resize(bufferNumValues); }
+
+    // fill both buffers
+    while (!_failed && _num_submitted < std::min<std::uint32_t>(NUM_BUFFERS, _num_slabs))
+    { _submit(_num_submitted); }
+
+    return !_failed;
+}
+
+void FlowFieldSlabReader::close()
+{
+    // in-flight reads write into the buffers
+    _file.close();
+
+    for (std::vector<double>& buffer: _buffers)
+    {
+        buffer.clear();
+        buffer.shrink_to_fit();
+    }
+
+    _header = FlowFieldHeader();
+    _slab_thickness = 0;
+    _num_slabs = 0;
+    _stride = {0, 0, 0, 0};
+    _done = {false, false};
+    _num_submitted = 0;
+    _num_delivered = 0;
+    _slab = FlowFieldSlab();
+    _failed = false;
+}
+
+std::uint32_t FlowFieldSlabReader::_slab_num_x(std::uint32_t slabId) const
+{ return std::min(_slab_thickness, _header.size[0] - slabId * _slab_thickness); }
+
+void FlowFieldSlabReader::_submit(std::uint32_t slabId)
+{
+    const std::uint32_t bufferId = slabId % NUM_BUFFERS;
+    const std::uint64_t offset = FlowFieldHeader::num_bytes + static_cast<std::uint64_t>(slabId) * _slab_thickness * _stride[0] * sizeof(double);
+    const std::size_t numBytes = _slab_num_x(slabId) * _stride[0] * sizeof(double);
+
+    _done[bufferId] = false;
+    _failed = _failed || !_file.submit(offset, _buffers[bufferId].data(), numBytes, slabId);
+    ++_num_submitted;
+}
+
+const FlowFieldSlab* FlowFieldSlabReader::next()
+{
+    if (!is_open() || _failed || _num_delivered == _num_slabs)
+    { return nullptr; }
+
+    // the consumer is done with the previous slab -> read ahead into its buffer
+    if (_num_delivered != 0 && _num_submitted < _num_slabs)
+    { _submit(_num_submitted); }
+
+    const std::uint32_t slabId = _num_delivered;
+    const std::uint32_t bufferId = slabId % NUM_BUFFERS;
+
+    while (!_failed && !_done[bufferId])
+    {
+        std::uint64_t tag = 0;
+        std::size_t numBytesRead = 0;
+        const bool ok = _file.wait(tag, numBytesRead);
+
+        const std::uint32_t doneSlabId = static_cast<std::uint32_t>(tag);
+        _failed = !ok || numBytesRead != _slab_num_x(doneSlabId) * _stride[0] * sizeof(double);
+        _done[doneSlabId % NUM_BUFFERS] = true;
+    }
+
+    if (_failed)
+    { return nullptr; }
+
+    _slab.id = slabId;
+    _slab.x_begin = slabId * _slab_thickness;
+    _slab.num_x = _slab_num_x(slabId);
+    _slab.data = _buffers[bufferId].data();
+    _slab.stride = _stride;
+
+    ++_num_delivered;
+
+    return &_slab;
+}
+
+FlowFieldSlabReader::Iterator FlowFieldSlabReader::begin()
+{ return Iterator(this, next()); }
+
+FlowFieldSlabReader::Iterator FlowFieldSlabReader::end()
+{ return Iterator(this, nullptr); }
+
+bool FlowFieldSlabReader::for_each(std::string_view filepath, std::uint32_t slabThickness, const Consumer& consumer)
+{
+    FlowFieldSlabReader reader;
+
+    if (!reader.open(filepath, slabThickness))
+    { return false; }
+
+    while (const FlowFieldSlab* slab = reader.next())
+    {
+        if (!consumer(*slab))
+        { return false; }
+    }
+
+    return !reader.failed();
+}
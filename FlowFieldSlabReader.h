@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_FLOWFIELDSLABREADER_H
+#define BLOODLINE_FLOWFIELDSLABREADER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "AsyncFileReader.h"
+#include "FlowFieldView.h"
+
+//! voxels [x_begin, x_begin + num_x) of all y z t; layout x y z t component (as FlowFieldView)
+struct FlowFieldSlab
+{
+    std::uint32_t id = 0;
+    std::uint32_t x_begin = 0;
+    std::uint32_t num_x = 0;
+    const double* data = nullptr;
+    std::array<std::size_t, 4> stride{}; // in doubles: x y z t
+
+    [[nodiscard]] std::size_t num_values() const
+    { return num_x * stride[0]; }
+
+    //! x is the global grid position
+    [[nodiscard]] const double* vector_ptr(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t t) const
+    { return data + (x - x_begin) * stride[0] + y * stride[1] + z * stride[2] + t * stride[3]; }
+}; // struct FlowFieldSlab
+
+/*
+ * Streams the payload of a "flowfield" file as x-slabs without loading the whole field.
+ *
+ * x is the outermost dimension of the payload, so every slab is one contiguous range of the file.
+ * Two slab buffers are used: while the consumer works on one slab, the next one is read by an
+ * AsyncFileReader (io_uring or preadv pool), so the disk stays busy. Peak memory is
+ * 2 * slab_num_bytes() regardless of the grid size.
+ *
+ *     FlowFieldSlabReader reader;
+ *     if (reader.open(path, FlowFieldSlabReader::slab_thickness_for(path, budget)))
+ *     {
+ *         for (const FlowFieldSlab& slab: reader)
+ *         { ... }
+ *     }
+ */
+class FlowFieldSlabReader
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    static constexpr unsigned int NUM_BUFFERS = 2;
+    static constexpr std::uint32_t DEFAULT_SLAB_THICKNESS = 4;
+
+    //! single pass; iterators are invalidated by next()
+    class Iterator
+    {
+        FlowFieldSlabReader* _reader;
+        const FlowFieldSlab* _slab;
+
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = FlowFieldSlab;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const FlowFieldSlab*;
+        using reference = const FlowFieldSlab&;
+
+        Iterator(FlowFieldSlabReader* reader, const FlowFieldSlab* slab)
+            : _reader(reader),
+              _slab(slab)
+        { /* do nothing */ }
+
+        [[nodiscard]] reference operator*() const
+        { return *_slab; }
+
+        [[nodiscard]] pointer operator->() const
+        { return _slab; }
+
+        Iterator& operator++()
+        {
+            _slab = _reader->next();
+            return *this;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator& other) const
+        { return _slab == other._slab; }
+
+        [[nodiscard]] bool operator!=(const Iterator& other) const
+        { return _slab != other._slab; }
+    }; // class Iterator
+
+    //! returns false to stop
+    using Consumer = std::function<bool(const FlowFieldSlab& slab)>;
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+  private:
+    FlowFieldHeader _header;
+    std::uint32_t _slab_thickness;
+    std::uint32_t _num_slabs;
+    std::array<std::size_t, 4> _stride;
+    AsyncFileReader _file;
+    std::array<std::vector<double>, NUM_BUFFERS> _buffers;
+    std::array<bool, NUM_BUFFERS> _done; // read of the buffer's slab has finished
+    std::uint32_t _num_submitted; // slabs
+    std::uint32_t _num_delivered;
+    FlowFieldSlab _slab;
+    bool _failed;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    FlowFieldSlabReader();
+    FlowFieldSlabReader(const FlowFieldSlabReader&) = delete;
+    FlowFieldSlabReader(FlowFieldSlabReader&&) = delete;
+
+    ~FlowFieldSlabReader();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] const FlowFieldHeader& header() const;
+    [[nodiscard]] std::uint32_t slab_thickness() const;
+    [[nodiscard]] std::uint32_t num_slabs() const;
+
+    //! of a full slab (the last one may be thinner)
+    [[nodiscard]] std::uint64_t slab_num_bytes() const;
+
+    //! a read failed or the file is shorter than its header says
+    [[nodiscard]] bool failed() const;
+
+    //! thickest slab for which both buffers fit into memoryBudget bytes; at least 1; 0 if the file cannot be read
+    [[nodiscard]] static std::uint32_t slab_thickness_for(std::string_view filepath, std::uint64_t memoryBudget);
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] FlowFieldSlabReader& operator=(const FlowFieldSlabReader&) = delete;
+    [[maybe_unused]] FlowFieldSlabReader& operator=(FlowFieldSlabReader&&) = delete;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! parses the header and starts reading the first slabs
+    [[nodiscard]] bool open(std::string_view filepath, std::uint32_t slabThickness = DEFAULT_SLAB_THICKNESS, AsyncFileReader::Backend backend = AsyncFileReader::Backend::IoUring);
+    void close();
+
+    //! the next slab in x order; valid until the next call; nullptr at the end or on failure
+    [[nodiscard]] const FlowFieldSlab* next();
+
+    //! starts with the next slab
+    [[nodiscard]] Iterator begin();
+    [[nodiscard]] Iterator end();
+
+    //! passes all slabs to consumer in x order; false if the file could not be read completely or consumer stopped
+    [[nodiscard]] static bool for_each(std::string_view filepath, std::uint32_t slabThickness, const Consumer& consumer);
+
+  private:
+    [[nodiscard]] std::uint32_t _slab_num_x(std::uint32_t slabId) const;
+    void _submit(std::uint32_t slabId);
+}; // class FlowFieldSlabReader
+
+#endif //BLOODLINE_FLOWFIELDSLABREADER_H
@@ -0,0 +1,206 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "FlowFieldTimeCache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <future>
+#include <system_error>
+
+#include "BulkRead.h"
+#include "ThreadPool.h"
+
+namespace
+{
+  constexpr char MAGIC[8] = {'B', 'L', 'F', 'F', 'T', 'I', 'M', 'E'};
+  constexpr std::uint64_t HEADER_NUM_BYTES = sizeof(MAGIC) + FlowFieldHeader::num_bytes;
+
+  [[nodiscard]] std::uint64_t frame_num_bytes(const FlowFieldHeader& header)
+  { return header.frame_num_values() * sizeof(double); }
+
+  [[nodiscard]] std::uint64_t cache_num_bytes(const FlowFieldHeader& header)
+  { return HEADER_NUM_BYTES + frame_num_bytes(header) * header.size[3]; }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+FlowFieldTimeCache::FlowFieldTimeCache() = default;
+FlowFieldTimeCache::FlowFieldTimeCache(FlowFieldTimeCache&&) = default;
+FlowFieldTimeCache::~FlowFieldTimeCache() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+bool FlowFieldTimeCache::is_open() const
+{ return _file.is_open(); }
+
+const FlowFieldHeader& FlowFieldTimeCache::header() const
+{ return _header; }
+
+std::string FlowFieldTimeCache::default_path(std::string_view flowfieldPath)
+{ return FlowFieldCacheFile::default_path(flowfieldPath, ".tcache"); }
+
+bool FlowFieldTimeCache::is_up_to_date(std::string_view flowfieldPath, std::string_view cachePath)
+{
+    FlowFieldTimeCache cache;
+    return FlowFieldCacheFile::is_newer(flowfieldPath, cachePath) && cache.open(cachePath);
+}
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+FlowFieldTimeCache& FlowFieldTimeCache::operator=(FlowFieldTimeCache&&) = default;
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool FlowFieldTimeCache::build(const FlowFieldView& view, std::string_view cachePath, unsigned int numThreads)
+{
+    if (!view.is_open())
+    { return false; }
+
+    const FlowFieldHeader& header = view.header();
+
+    const std::string tmpPath = FlowFieldCacheFile::temp_path(cachePath);
+
+    //------------------------------------------------------------------------------------------------------
+    // header + preallocate
+    //------------------------------------------------------------------------------------------------------
+    {
+        std::ofstream file(tmpPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!file.good())
+        { return false; }
+
+        file.write(MAGIC, sizeof(MAGIC));
+        header.write(file);
+
+        if (!file.good())
+        { return false; }
+    }
+
+    std::error_code ec;
+    std::filesystem::resize_file(tmpPath, cache_num_bytes(header), ec);
+    if (ec)
+    { return FlowFieldCacheFile::finish(cachePath, false); }
+
+    //------------------------------------------------------------------------------------------------------
+    // frames
+    // - every task gathers one frame and writes it at its own offset through its own stream
+    //------------------------------------------------------------------------------------------------------
+    bool success = true;
+    {
+        ThreadPool pool(numThreads);
+
+        std::vector<std::future<bool>> frames;
+        frames.reserve(header.size[3]);
+
+        for (std::uint32_t t = 0; t < header.size[3]; ++t)
+        {
+            frames.emplace_back(pool.enqueue([&view, &tmpPath, t]()
+                                             {
+                                                 const std::vector<double> frame = view.get_time_frame(t);
+
+                                                 std::fstream file(tmpPath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+                                                 file.seekp(static_cast<std::streamoff>(HEADER_NUM_BYTES + t * frame_num_bytes(view.header())));
+                                                 file.write(reinterpret_cast<const char*>(frame.data()), frame.size() * sizeof(double));
+
+                                                 return file.good();
+                                             }));
+        }
+
+        for (std::future<bool>& f: frames)
+        { success = f.get() && success; }
+    }
+
+    return FlowFieldCacheFile::finish(cachePath, success);
+}
+
+bool FlowFieldTimeCache::open(std::string_view cachePath)
+{
+    close();
+
+    _file.open(std::string(cachePath), std::ios_base::in | std::ios_base::binary);
+    if (!_file.good())
+    {
+        close();
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)] = {};
+    _file.read(magic, sizeof(magic));
+
+    _header.read(_file);
+
+    std::error_code ec;
+    const std::uintmax_t fileNumBytes = std::filesystem::file_size(cachePath, ec);
+
+    if (!_file.good() || ec || !std::equal(magic, magic + sizeof(magic), MAGIC) || fileNumBytes != cache_num_bytes(_header))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void FlowFieldTimeCache::close()
+{
+    if (_file.is_open())
+    { _file.close(); }
+
+    _file.clear();
+    _header = FlowFieldHeader();
+}
+
+bool FlowFieldTimeCache::read_time_frame(std::uint32_t t, double* dst)
+{
+    if (!is_open() || t >= _header.size[3])
+    { return false; }
+
+    const std::uint64_t numBytes = frame_num_bytes(_header);
+
+    _file.seekg(static_cast<std::streamoff>(HEADER_NUM_BYTES + t * numBytes));
+    BulkRead::read(_file, dst, numBytes);
+
+    if (!_file.good())
+    {
+        _file.clear();
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<double> FlowFieldTimeCache::get_time_frame(std::uint32_t t)
+{
+    std::vector<double> frame(_header.frame_num_values());
+
+    if (!read_time_frame(t, frame.data()))
+    { frame.clear(); }
+
+    return frame;
+}
@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_FLOWFIELDTIMECACHE_H
+#define BLOODLINE_FLOWFIELDTIMECACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FlowFieldView.h"
+
+/*
+ * Time-major sidecar of a "flowfield" file.
+ *
+ * The flowfield payload is stored x y z t component, so one time frame is a strided gather
+ * across the whole file. The cache stores the same vectors t x y z component; loading a
+ * frame is then a single sequential read.
+ *
+ * file layout:
+ *                                  [8] x [char] : "BLFFTIME"
+ *           [FlowFieldHeader::num_bytes] x [char] : header (same as in the flowfield file)
+ *  [sizeT * sizeX * sizeY * sizeZ * 3] x [double] : flow vectors (time outermost)
+ */
+class FlowFieldTimeCache
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    FlowFieldHeader _header;
+    std::ifstream _file;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    FlowFieldTimeCache();
+    FlowFieldTimeCache(const FlowFieldTimeCache&) = delete;
+    FlowFieldTimeCache(FlowFieldTimeCache&&);
+
+    ~FlowFieldTimeCache();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] const FlowFieldHeader& header() const;
+
+    //! "<flowfield path>.tcache"
+    [[nodiscard]] static std::string default_path(std::string_view flowfieldPath);
+
+    //! cache exists, is complete and is not older than the flowfield file
+    [[nodiscard]] static bool is_up_to_date(std::string_view flowfieldPath, std::string_view cachePath);
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] FlowFieldTimeCache& operator=(const FlowFieldTimeCache&) = delete;
+    [[maybe_unused]] FlowFieldTimeCache& operator=(FlowFieldTimeCache&&);
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! writes the transposed payload of view; one task per time frame; numThreads == 0 -> hardware concurrency
+    [[nodiscard]] static bool build(const FlowFieldView& view, std::string_view cachePath, unsigned int numThreads = 0);
+
+    [[nodiscard]] bool open(std::string_view cachePath);
+    void close();
+
+    //! reads time frame t into dst (header().frame_num_values() doubles; layout x y z component)
+    [[nodiscard]] bool read_time_frame(std::uint32_t t, double* dst);
+
+    //! empty on failure
+    [[nodiscard]] std::vector<double> get_time_frame(std::uint32_t t);
+}; // class FlowFieldTimeCache
+
+#endif //BLOODLINE_FLOWFIELDTIMECACHE_H
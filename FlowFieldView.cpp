@@ -0,0 +1,330 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "FlowFieldView.h"
+
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+//====================================================================================================
+//===== FlowFieldHeader
+//====================================================================================================
+void FlowFieldHeader::write(std::ostream& file) const
+{
+    for_each_array(*this, [&](const auto& arr)
+    { file.write(reinterpret_cast<const char*>(arr.data()), arr.size() * sizeof(arr[0])); });
+}
+
+void FlowFieldHeader::read(std::istream& file)
+{
+    for_each_array(*this, [&](auto& arr)
+    { file.read(reinterpret_cast<char*>(arr.data()), arr.size() * sizeof(arr[0])); });
+}
+
+//====================================================================================================
+//===== FlowFieldCacheFile
+//====================================================================================================
+std::string FlowFieldCacheFile::default_path(std::string_view flowfieldPath, std::string_view extension)
+{ return std::string(flowfieldPath) + std::string(extension); }
+
+bool FlowFieldCacheFile::is_newer(std::string_view flowfieldPath, std::string_view cachePath)
+{
+    std::error_code ec;
+
+    const auto tFlowfield = std::filesystem::last_write_time(flowfieldPath, ec);
+    if (ec)
+    { return false; }
+
+    const auto tCache = std::filesystem::last_write_time(cachePath, ec);
+    return !ec && tCache >= tFlowfield;
+}
+
+std::string FlowFieldCacheFile::temp_path(std::string_view cachePath)
+{ return std::string(cachePath) + ".tmp"; }
+
+bool FlowFieldCacheFile::finish(std::string_view cachePath, bool success)
+{
+    const std::string tmpPath = temp_path(cachePath);
+    std::error_code ec;
+
+    if (success)
+    { std::filesystem::rename(tmpPath, cachePath, ec); }
+
+    if (!success || ec)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+FlowFieldView::FlowFieldView()
+    : _header(),
+      _mapping(nullptr),
+      _mapping_num_bytes(0),
+      _vectors(nullptr),
+      _stride{0, 0, 0, 0},
+  #ifdef _WIN32
+      _file_handle(INVALID_HANDLE_VALUE),
+      _mapping_handle(nullptr)
+  #else
+      _fd(-1)
+  #endif
+{ /* do nothing */ }
+
+FlowFieldView::FlowFieldView(FlowFieldView&& other) noexcept
+    : FlowFieldView()
+{ *this = std::move(other); }
+
+FlowFieldView::~FlowFieldView()
+{ close(); }
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+bool FlowFieldView::is_open() const
+{ return _vectors != nullptr; }
+
+const FlowFieldHeader& FlowFieldView::header() const
+{ return _header; }
+
+const std::array<std::uint32_t, 4>& FlowFieldView::size() const
+{ return _header.size; }
+
+const std::array<double, 4>& FlowFieldView::scale() const
+{ return _header.scale; }
+
+const std::array<std::size_t, 4>& FlowFieldView::stride() const
+{ return _stride; }
+
+std::size_t FlowFieldView::num_vectors() const
+{ return _header.num_vectors(); }
+
+const double* FlowFieldView::data() const
+{ return _vectors; }
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+FlowFieldView& FlowFieldView::operator=(FlowFieldView&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+
+        _header = other._header;
+        std::swap(_mapping, other._mapping);
+        std::swap(_mapping_num_bytes, other._mapping_num_bytes);
+        std::swap(_vectors, other._vectors);
+        std::swap(_stride, other._stride);
+      #ifdef _WIN32
+        std::swap(_file_handle, other._file_handle);
+        std::swap(_mapping_handle, other._mapping_handle);
+      #else
+        std::swap(_fd, other._fd);
+      #endif
+    }
+
+    return *this;
+}
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool FlowFieldView::open(std::string_view filepath)
+{
+    close();
+
+    const std::string path(filepath);
+
+    //------------------------------------------------------------------------------------------------------
+    // map the whole file
+    //------------------------------------------------------------------------------------------------------
+  #ifdef _WIN32
+    _file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (_file_handle == INVALID_HANDLE_VALUE)
+    { return false; }
+
+    LARGE_INTEGER filesize;
+    if (!GetFileSizeEx(_file_handle, &filesize) || static_cast<std::size_t>(filesize.QuadPart) < FlowFieldHeader::num_bytes)
+    {
+        close();
+        return false;
+    }
+    _mapping_num_bytes = static_cast<std::size_t>(filesize.QuadPart);
+
+    _mapping_handle = CreateFileMappingA(_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mapping_handle == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    _mapping = MapViewOfFile(_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (_mapping == nullptr)
+    {
+        close();
+        return false;
+    }
+  #else
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0)
+    { return false; }
+
+    struct stat st{};
+    if (fstat(_fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < FlowFieldHeader::num_bytes)
+    {
+        close();
+        return false;
+    }
+    _mapping_num_bytes = static_cast<std::size_t>(st.st_size);
+
+    // no MAP_POPULATE: pages are faulted in on first access
+    _mapping = mmap(nullptr, _mapping_num_bytes, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (_mapping == MAP_FAILED)
+    {
+        _mapping = nullptr;
+        close();
+        return false;
+    }
+
+    madvise(_mapping, _mapping_num_bytes, MADV_RANDOM);
+  #endif
+
+    //------------------------------------------------------------------------------------------------------
+    // header
+    //------------------------------------------------------------------------------------------------------
+    const char* p = static_cast<const char*>(_mapping);
+
+    const auto read = [&](auto& arr)
+    {
+        const std::size_t n = arr.size() * sizeof(arr[0]);
+        std::memcpy(arr.data(), p, n);
+        p += n;
+    };
+
+    FlowFieldHeader::for_each_array(_header, read);
+
+    //------------------------------------------------------------------------------------------------------
+    // payload
+    //------------------------------------------------------------------------------------------------------
+    if (!_header.payload_fits(_mapping_num_bytes - FlowFieldHeader::num_bytes))
+    {
+        // truncated file
+        close();
+        return false;
+    }
+
+    // header size is a multiple of 8 and the mapping is page-aligned -> payload is aligned for double
+    _vectors = reinterpret_cast<const double*>(p);
+
+    _stride[3] = 3;
+    _stride[2] = _stride[3] * _header.size[3];
+    _stride[1] = _stride[2] * _header.size[2];
+    _stride[0] = _stride[1] * _header.size[1];
+
+    return true;
+}
+
+void FlowFieldView::close()
+{
+  #ifdef _WIN32
+    if (_mapping != nullptr)
+    { UnmapViewOfFile(_mapping); }
+
+    if (_mapping_handle != nullptr)
+    { CloseHandle(_mapping_handle); }
+
+    if (_file_handle != INVALID_HANDLE_VALUE)
+    { CloseHandle(_file_handle); }
+
+    _mapping_handle = nullptr;
+    _file_handle = INVALID_HANDLE_VALUE;
+  #else
+    if (_mapping != nullptr)
+    { munmap(_mapping, _mapping_num_bytes); }
+
+    if (_fd >= 0)
+    { ::close(_fd); }
+
+    _fd = -1;
+  #endif
+
+    _mapping = nullptr;
+    _mapping_num_bytes = 0;
+    _vectors = nullptr;
+    _stride = {0, 0, 0, 0};
+    _header = FlowFieldHeader();
+}
+
+void FlowFieldView::advise_sequential() const
+{
+  #ifndef _WIN32
+    if (_mapping != nullptr)
+    { madvise(_mapping, _mapping_num_bytes, MADV_SEQUENTIAL); }
+  #endif
+}
+
+void FlowFieldView::copy_time_frame(std::uint32_t t, double* dst) const
+{
+    // time is the second-fastest axis -> one 3-vector per (x,y,z), _stride[2] apart
+    for (std::uint32_t x = 0; x < _header.size[0]; ++x)
+    {
+        for (std::uint32_t y = 0; y < _header.size[1]; ++y)
+        {
+            const double* src = vector_ptr(x, y, 0, t);
+
+            for (std::uint32_t z = 0; z < _header.size[2]; ++z, src += _stride[2], dst += 3)
+            { std::memcpy(dst, src, 3 * sizeof(double)); }
+        } // for y
+    } // for x
+}
+
+std::vector<double> FlowFieldView::get_time_frame(std::uint32_t t) const
+{
+    std::vector<double> frame(_header.frame_num_values());
+    copy_time_frame(t, frame.data());
+
+    return frame;
+}
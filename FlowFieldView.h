@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLOODLINE_FLOWFIELDVIEW_H
+#define BLOODLINE_FLOWFIELDVIEW_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * fixed-size header of the "flowfield" file (see ImporterScientific::read_flowfield)
+ */
+struct FlowFieldHeader
+{
+    std::array<std::uint32_t, 4> size{}; // x y z t
+    std::array<double, 4> scale{}; // x y z [mm], t [ms]
+    std::array<double, 16> world_matrix{}; // 4x4 from dicom
+    std::array<double, 16> inverse_world_matrix{};
+    std::array<double, 25> world_matrix_with_time{}; // 5x5 including time in 4th row/col
+    std::array<double, 25> inverse_world_matrix_with_time{};
+    std::array<double, 9> rotation_matrix{}; // rotational part of world matrix (3x3)
+    std::array<double, 9> inverse_rotation_matrix{};
+
+    static constexpr std::size_t num_bytes = 4 * sizeof(std::uint32_t) + (4 + 16 + 16 + 25 + 25 + 9 + 9) * sizeof(double);
+
+    //! applies f to the arrays of header in file order
+    template<typename Header, typename F>
+    static void for_each_array(Header& header, F f)
+    {
+        f(header.size);
+        f(header.scale);
+        f(header.world_matrix);
+        f(header.inverse_world_matrix);
+        f(header.world_matrix_with_time);
+        f(header.inverse_world_matrix_with_time);
+        f(header.rotation_matrix);
+        f(header.inverse_rotation_matrix);
+    }
+
+    //! num_bytes in file order
+    void write(std::ostream& file) const;
+    void read(std::istream& file);
+
+    [[nodiscard]] std::size_t num_vectors() const
+    { return static_cast<std::size_t>(size[0]) * size[1] * size[2] * size[3]; }
+
+    //! wraps for corrupt sizes; check payload_fits() first
+    [[nodiscard]] std::size_t payload_num_bytes() const
+    { return num_vectors() * 3 * sizeof(double); }
+
+    //! true if the payload fits into numBytes (the bytes after the header); the sizes are checked factor by factor, so the product cannot wrap
+    [[nodiscard]] bool payload_fits(std::uint64_t numBytes) const
+    {
+        const std::uint64_t maxNumVectors = numBytes / (3 * sizeof(double));
+
+        std::uint64_t numVectors = 1;
+        for (const std::uint32_t s: size)
+        {
+            if (s != 0 && numVectors > maxNumVectors / s)
+            { return false; }
+
+            numVectors *= s;
+        }
+
+        return true;
+    }
+
+    //! number of doubles of one time frame (x y z component)
+    [[nodiscard]] std::size_t frame_num_values() const
+    { return static_cast<std::size_t>(size[0]) * size[1] * size[2] * 3; }
+}; // struct FlowFieldHeader
+
+/*
+ * Files derived from a flowfield file (FlowFieldTimeCache, FlowFieldChunkedCache).
+ *
+ * A cache is built under temp_path() and renamed by finish() only if the build succeeded, so that
+ * a crashed build never leaves a valid-looking cache.
+ */
+struct FlowFieldCacheFile
+{
+    //! flowfieldPath + extension
+    [[nodiscard]] static std::string default_path(std::string_view flowfieldPath, std::string_view extension);
+
+    //! the cache exists and is not older than the flowfield; its content is not checked
+    [[nodiscard]] static bool is_newer(std::string_view flowfieldPath, std::string_view cachePath);
+
+    [[nodiscard]] static std::string temp_path(std::string_view cachePath);
+
+    //! renames temp_path() to cachePath if success, removes it otherwise; true if the cache was replaced
+    static bool finish(std::string_view cachePath, bool success);
+}; // struct FlowFieldCacheFile
+
+/*
+ * Read-only view of a "flowfield" file that maps the file into memory instead of reading it.
+ *
+ * Only the header is parsed on open(). The velocity payload is accessed in place, so pages
+ * are faulted in by the OS as voxels are actually read.
+ *
+ * payload layout (x outermost, component innermost):
+ *      [sizeX * sizeY * sizeZ * sizeT * 3] x [double]
+ */
+class FlowFieldView
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    FlowFieldHeader _header;
+    void* _mapping;
+    std::size_t _mapping_num_bytes;
+    const double* _vectors;
+    std::array<std::size_t, 4> _stride; // in doubles: x y z t (component stride is 1)
+  #ifdef _WIN32
+    void* _file_handle;
+    void* _mapping_handle;
+  #else
+    int _fd;
+  #endif
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    FlowFieldView();
+    FlowFieldView(const FlowFieldView&) = delete;
+    FlowFieldView(FlowFieldView&& other) noexcept;
+
+    ~FlowFieldView();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] bool is_open() const;
+
+    [[nodiscard]] const FlowFieldHeader& header() const;
+    [[nodiscard]] const std::array<std::uint32_t, 4>& size() const;
+    [[nodiscard]] const std::array<double, 4>& scale() const;
+    [[nodiscard]] const std::array<std::size_t, 4>& stride() const;
+    [[nodiscard]] std::size_t num_vectors() const;
+
+    //! raw payload; x y z t component
+    [[nodiscard]] const double* data() const;
+
+    [[nodiscard]] std::size_t offset(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t t) const
+    { return x * _stride[0] + y * _stride[1] + z * _stride[2] + t * _stride[3]; }
+
+    //! pointer to the 3 components of the flow vector at grid pos xyzt
+    [[nodiscard]] const double* vector_ptr(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t t) const
+    { return _vectors + offset(x, y, z, t); }
+
+    [[nodiscard]] double operator()(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t t, std::uint32_t component) const
+    { return _vectors[offset(x, y, z, t) + component]; }
+
+    [[nodiscard]] std::array<double, 3> operator()(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t t) const
+    {
+        std::array<double, 3> v;
+        std::memcpy(v.data(), vector_ptr(x, y, z, t), 3 * sizeof(double));
+        return v;
+    }
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] FlowFieldView& operator=(const FlowFieldView&) = delete;
+    [[maybe_unused]] FlowFieldView& operator=(FlowFieldView&& other) noexcept;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    [[nodiscard]] bool open(std::string_view filepath);
+    void close();
+
+    //! hint the OS that the payload will be read front to back (default access pattern is random)
+    void advise_sequential() const;
+
+    //! gathers time frame t into dst (frame_num_values() doubles; layout x y z component)
+    void copy_time_frame(std::uint32_t t, double* dst) const;
+    [[nodiscard]] std::vector<double> get_time_frame(std::uint32_t t) const;
+}; // class FlowFieldView
+
+#endif //BLOODLINE_FLOWFIELDVIEW_H
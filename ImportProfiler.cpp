@@ -0,0 +1,401 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ImportProfiler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <new>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+  // written by operator new (if counted) and count_read(); plain integers, so they need no dynamic initialization
+  thread_local std::uint64_t t_num_bytes_allocated = 0;
+  thread_local std::uint64_t t_num_allocations = 0;
+  thread_local std::uint64_t t_num_bytes_read = 0;
+  thread_local std::uint64_t t_num_reads = 0;
+
+  struct Counters
+  {
+      std::uint64_t num_bytes_read = 0;
+      std::uint64_t num_reads = 0;
+      std::uint64_t num_page_faults = 0;
+      std::uint64_t num_bytes_allocated = 0;
+      std::uint64_t num_allocations = 0;
+      std::uint64_t own_num_bytes_read = 0; // reading /proc/thread-self/io shows up in the next snapshot
+      std::uint64_t own_num_reads = 0;
+  }; // struct Counters
+
+  [[nodiscard]] std::uint64_t parse_proc_value(const char* text, const char* key)
+  {
+      const char* p = std::strstr(text, key);
+      return p != nullptr ? std::strtoull(p + std::strlen(key), nullptr, 10) : 0;
+  }
+
+  [[nodiscard]] Counters snapshot()
+  {
+      Counters c;
+      c.num_bytes_read = t_num_bytes_read;
+      c.num_reads = t_num_reads;
+      c.num_bytes_allocated = t_num_bytes_allocated;
+      c.num_allocations = t_num_allocations;
+
+    #ifdef __linux__
+      const int fd = ::open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+      if (fd >= 0)
+      {
+          char text[512];
+          const ssize_t n = ::pread(fd, text, sizeof(text) - 1, 0);
+          ::close(fd);
+
+          if (n > 0)
+          {
+              text[n] = '\0';
+              c.num_bytes_read += parse_proc_value(text, "rchar:");
+              c.num_reads += parse_proc_value(text, "syscr:");
+              c.own_num_bytes_read = static_cast<std::uint64_t>(n);
+              c.own_num_reads = 1;
+          }
+      }
+    #endif
+
+    #if !defined(_WIN32) && defined(RUSAGE_THREAD)
+      rusage ru{};
+      if (::getrusage(RUSAGE_THREAD, &ru) == 0)
+      { c.num_page_faults = static_cast<std::uint64_t>(ru.ru_minflt) + static_cast<std::uint64_t>(ru.ru_majflt); }
+    #endif
+
+      return c;
+  }
+
+  [[nodiscard]] std::uint64_t peak_rss_bytes()
+  {
+    #ifndef _WIN32
+      rusage ru{};
+      if (::getrusage(RUSAGE_SELF, &ru) != 0)
+      { return 0; }
+
+      #ifdef __APPLE__
+      return static_cast<std::uint64_t>(ru.ru_maxrss); // bytes
+      #else
+      return static_cast<std::uint64_t>(ru.ru_maxrss) * 1024; // KiB
+      #endif
+    #else
+      return 0;
+    #endif
+  }
+
+  //! as a JSON string literal
+  void write_json_string(std::ostream& os, std::string_view s)
+  {
+      os << '"';
+
+      for (const char c: s)
+      {
+          if (c == '"' || c == '\\')
+          { os << '\\' << c; }
+          else if (static_cast<unsigned char>(c) < 0x20)
+          { os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' '); }
+          else
+          { os << c; }
+      }
+
+      os << '"';
+  }
+} // anonymous namespace
+
+#ifdef BLOODLINE_IMPORTPROFILER_ALLOCATION_COUNTING
+//====================================================================================================
+//===== ALLOCATION COUNTING
+//====================================================================================================
+namespace
+{
+  //! alignment == 0: default alignment
+  [[nodiscard]] void* counted_allocate(std::size_t numBytes, std::size_t alignment)
+  {
+      t_num_bytes_allocated += numBytes;
+      ++t_num_allocations;
+
+      numBytes = std::max<std::size_t>(1, numBytes);
+
+      for (;;)
+      {
+          void* p = nullptr;
+
+          if (alignment == 0)
+          { p = std::malloc(numBytes); }
+          else
+          {
+            #ifdef _WIN32
+              p = _aligned_malloc(numBytes, alignment);
+            #else
+              // aligned_alloc requires a multiple of the alignment
+              p = std::aligned_alloc(alignment, (numBytes + alignment - 1) / alignment * alignment);
+            #endif
+          }
+
+          if (p != nullptr)
+          { return p; }
+
+          const std::new_handler handler = std::get_new_handler();
+          if (handler == nullptr)
+          { throw std::bad_alloc(); }
+
+          handler();
+      }
+  }
+
+  [[nodiscard]] void* counted_allocate_nothrow(std::size_t numBytes, std::size_t alignment) noexcept
+  {
+      try
+      { return counted_allocate(numBytes, alignment); }
+      catch (...)
+      { return nullptr; }
+  }
+
+  void aligned_free(void* p) noexcept
+  {
+    #ifdef _WIN32
+      _aligned_free(p);
+    #else
+      std::free(p);
+    #endif
+  }
+} // anonymous namespace
+
+// the complete set of replaceable forms, so that every new is paired with the matching delete
+void* operator new(std::size_t numBytes)
+{ return counted_allocate(numBytes, 0); }
+
+void* operator new[](std::size_t numBytes)
+{ return counted_allocate(numBytes, 0); }
+
+void* operator new(std::size_t numBytes, const std::nothrow_t&) noexcept
+{ return counted_allocate_nothrow(numBytes, 0); }
+
+void* operator new[](std::size_t numBytes, const std::nothrow_t&) noexcept
+{ return counted_allocate_nothrow(numBytes, 0); }
+
+void* operator new(std::size_t numBytes, std::align_val_t alignment)
+{ return counted_allocate(numBytes, static_cast<std::size_t>(alignment)); }
+
+void* operator new[](std::size_t numBytes, std::align_val_t alignment)
+{ return counted_allocate(numBytes, static_cast<std::size_t>(alignment)); }
+
+void* operator new(std::size_t numBytes, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{ return counted_allocate_nothrow(numBytes, static_cast<std::size_t>(alignment)); }
+
+void* operator new[](std::size_t numBytes, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{ return counted_allocate_nothrow(numBytes, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* p) noexcept
+{ std::free(p); }
+
+void operator delete[](void* p) noexcept
+{ std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept
+{ std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept
+{ std::free(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{ std::free(p); }
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{ std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept
+{ aligned_free(p); }
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{ aligned_free(p); }
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{ aligned_free(p); }
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{ aligned_free(p); }
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{ aligned_free(p); }
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{ aligned_free(p); }
+#endif
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+ImportProfiler::Scope::Scope(ImportProfiler* profiler, std::string_view reader, std::string_view path)
+    : _profiler(profiler)
+{
+    if (_profiler == nullptr)
+    { return; }
+
+    _profile.reader = reader;
+    _profile.path = path;
+
+    // after the allocations above
+    const Counters c = snapshot();
+    _profile.num_bytes_read = c.num_bytes_read + c.own_num_bytes_read;
+    _profile.num_reads = c.num_reads + c.own_num_reads;
+    _profile.num_page_faults = c.num_page_faults;
+    _profile.num_bytes_allocated = c.num_bytes_allocated;
+    _profile.num_allocations = c.num_allocations;
+    _profile.peak_rss_growth_bytes = peak_rss_bytes();
+
+    _t0 = std::chrono::steady_clock::now();
+}
+
+ImportProfiler::Scope::~Scope()
+{
+    if (_profiler == nullptr)
+    { return; }
+
+    const auto t1 = std::chrono::steady_clock::now();
+    const Counters c = snapshot();
+    const std::uint64_t peakRss = peak_rss_bytes();
+
+    // the begin snapshot holds the start values
+    _profile.seconds = std::chrono::duration<double>(t1 - _t0).count();
+    _profile.num_bytes_read = c.num_bytes_read - std::min(c.num_bytes_read, _profile.num_bytes_read);
+    _profile.num_reads = c.num_reads - std::min(c.num_reads, _profile.num_reads);
+    _profile.num_page_faults = c.num_page_faults - _profile.num_page_faults;
+    _profile.num_bytes_allocated = c.num_bytes_allocated - _profile.num_bytes_allocated;
+    _profile.num_allocations = c.num_allocations - _profile.num_allocations;
+    _profile.peak_rss_growth_bytes = peakRss - std::min(peakRss, _profile.peak_rss_growth_bytes);
+
+    _profiler->_add(std::move(_profile), _t0);
+}
+
+ImportProfiler::ImportProfiler()
+    : _t0(std::chrono::steady_clock::now())
+{ /* do nothing */ }
+
+ImportProfiler::~ImportProfiler() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::vector<ReaderProfile> ImportProfiler::profiles() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _profiles;
+}
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void ImportProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _t0 = std::chrono::steady_clock::now();
+    _profiles.clear();
+    _threads.clear();
+}
+
+void ImportProfiler::count_read(std::uint64_t numBytes)
+{
+    t_num_bytes_read += numBytes;
+    ++t_num_reads;
+}
+
+double ImportProfiler::seconds_since(std::chrono::steady_clock::time_point t0)
+{ return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); }
+
+void ImportProfiler::_add(ReaderProfile profile, std::chrono::steady_clock::time_point t0)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const std::thread::id id = std::this_thread::get_id();
+    const auto it = std::find(_threads.begin(), _threads.end(), id);
+
+    profile.thread = static_cast<std::uint32_t>(it - _threads.begin());
+    if (it == _threads.end())
+    { _threads.push_back(id); }
+
+    profile.start_seconds = std::chrono::duration<double>(t0 - _t0).count();
+
+    _profiles.push_back(std::move(profile));
+}
+
+void ImportProfiler::write_chrome_trace(std::ostream& os) const
+{
+    const std::vector<ReaderProfile> profiles = this->profiles();
+
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (std::size_t i = 0; i < profiles.size(); ++i)
+    {
+        const ReaderProfile& p = profiles[i];
+
+        os << (i == 0 ? "\n" : ",\n");
+        os << "{\"name\":";
+        write_json_string(os, p.reader);
+        os << ",\"cat\":\"reader\",\"ph\":\"X\",\"pid\":0,\"tid\":" << p.thread
+           << ",\"ts\":" << p.start_seconds * 1e6 << ",\"dur\":" << p.seconds * 1e6
+           << ",\"args\":{\"path\":";
+        write_json_string(os, p.path);
+        os << ",\"num_bytes_read\":" << p.num_bytes_read
+           << ",\"num_reads\":" << p.num_reads
+           << ",\"num_page_faults\":" << p.num_page_faults
+           << ",\"num_bytes_allocated\":" << p.num_bytes_allocated
+           << ",\"num_allocations\":" << p.num_allocations
+           << ",\"peak_rss_growth_bytes\":" << p.peak_rss_growth_bytes << "}}";
+    }
+
+    os << "\n]}" << std::endl;
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+bool ImportProfiler::write_chrome_trace(std::string_view filepath) const
+{
+    std::ofstream file(std::string(filepath), std::ios_base::out | std::ios_base::trunc);
+
+    if (!file.good())
+    { return false; }
+
+    write_chrome_trace(file);
+
+    return file.good();
+}
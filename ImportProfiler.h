@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_IMPORTPROFILER_H
+#define BLOODLINE_IMPORTPROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+//! one call of an ImporterScientific::read_*() function; counters are those of the calling thread during the call
+struct ReaderProfile
+{
+    std::string reader; // function name
+    std::string path; // file, or dataset directory
+    std::uint32_t thread = 0; // dense id in order of first use
+    double start_seconds = 0; // since the profiler was created or cleared
+    double seconds = 0;
+    std::uint64_t num_bytes_read = 0; // read syscalls + completed AsyncFileReader reads
+    std::uint64_t num_reads = 0;
+    std::uint64_t num_page_faults = 0; // memory-mapped files are read through page faults
+    std::uint64_t num_bytes_allocated = 0; // operator new; BLOODLINE_IMPORTPROFILER_ALLOCATION_COUNTING only
+    std::uint64_t num_allocations = 0;
+    std::uint64_t peak_rss_growth_bytes = 0; // rise of the process high-water mark during the call; approximate if other threads allocate concurrently
+}; // struct ReaderProfile
+
+/*
+ * Opt-in instrumentation of ImporterScientific (see ImporterScientific::set_profiler()).
+ *
+ * Bytes and reads come from /proc/thread-self/io, page faults from getrusage(RUSAGE_THREAD);
+ * both are Linux only and 0 elsewhere. Allocations are only counted if ImportProfiler.cpp is
+ * compiled with BLOODLINE_IMPORTPROFILER_ALLOCATION_COUNTING, which replaces the global operator
+ * new / delete (all forms) of the program; otherwise they stay 0.
+ *
+ * Calls that nest (read_all() around the readers) report inclusive counters.
+ *
+ * The resident set size is only known per process (getrusage(RUSAGE_SELF)), so the peak RSS growth
+ * of a call includes whatever concurrent calls allocate meanwhile, and is 0 if the process peak was
+ * already reached before the call.
+ */
+class ImportProfiler
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    //! records the enclosing call when it goes out of scope; does nothing if profiler is nullptr
+    class Scope
+    {
+        ImportProfiler* _profiler;
+        ReaderProfile _profile;
+        std::chrono::steady_clock::time_point _t0;
+
+      public:
+        Scope(ImportProfiler* profiler, std::string_view reader, std::string_view path);
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+
+        ~Scope();
+
+        [[maybe_unused]] Scope& operator=(const Scope&) = delete;
+        [[maybe_unused]] Scope& operator=(Scope&&) = delete;
+    }; // class Scope
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+  private:
+    mutable std::mutex _mutex;
+    std::chrono::steady_clock::time_point _t0;
+    std::vector<ReaderProfile> _profiles;
+    std::vector<std::thread::id> _threads;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    ImportProfiler();
+    ImportProfiler(const ImportProfiler&) = delete;
+    ImportProfiler(ImportProfiler&&) = delete;
+
+    ~ImportProfiler();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    //! in order of completion
+    [[nodiscard]] std::vector<ReaderProfile> profiles() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] ImportProfiler& operator=(const ImportProfiler&) = delete;
+    [[maybe_unused]] ImportProfiler& operator=(ImportProfiler&&) = delete;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! removes all profiles and restarts the clock
+    void clear();
+
+    //! reads done on behalf of the calling thread that no syscall of it accounts for (e.g. io_uring)
+    static void count_read(std::uint64_t numBytes);
+
+    //! wall time since t0
+    [[nodiscard]] static double seconds_since(std::chrono::steady_clock::time_point t0);
+
+    //! trace event format ("X" events, one row per thread); open in chrome://tracing or Perfetto
+    void write_chrome_trace(std::ostream& os) const;
+    [[maybe_unused]] bool write_chrome_trace(std::string_view filepath) const;
+
+  private:
+    void _add(ReaderProfile profile, std::chrono::steady_clock::time_point t0);
+}; // class ImportProfiler
+
+#endif //BLOODLINE_IMPORTPROFILER_H
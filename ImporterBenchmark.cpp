@@ -0,0 +1,368 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ImporterBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include "FlowFieldSlabReader.h"
+#include "FlowFieldView.h"
+#include "ImporterScientific.h"
+
+namespace
+{
+  using Reader = bool (ImporterScientific::*)(std::string_view);
+
+  const std::pair<std::string_view, Reader> READERS[] = {
+      {"read_mesh",                                          &ImporterScientific::read_mesh},
+      {"read_centerlines",                                   &ImporterScientific::read_centerlines},
+      {"read_landmark_measuring_planes",                     &ImporterScientific::read_landmark_measuring_planes},
+      {"read_pathlines",                                     &ImporterScientific::read_pathlines},
+      {"read_flowfield",                                     &ImporterScientific::read_flowfield},
+      {"read_pressure_map",                                  &ImporterScientific::read_pressure_map},
+      {"read_rotation_direction_map",                        &ImporterScientific::read_rotation_direction_map},
+      {"read_axial_velocity_map",                            &ImporterScientific::read_axial_velocity_map},
+      {"read_cos_angle_to_centerline_map",                   &ImporterScientific::read_cos_angle_to_centerline_map},
+      {"read_turbulent_kinetic_energy_map",                  &ImporterScientific::read_turbulent_kinetic_energy_map},
+      {"read_flow_jet",                                      &ImporterScientific::read_flow_jet},
+      {"read_ivsd",                                          &ImporterScientific::read_ivsd},
+      {"read_magnitude_tmip",                                &ImporterScientific::read_magnitude_tmip},
+      {"read_flow_statistics",                               &ImporterScientific::read_flow_statistics},
+      {"read_segmentation",                                  &ImporterScientific::read_segmentation},
+      {"read_segmentation_info",                             &ImporterScientific::read_segmentation_info},
+      {"read_segmentation_graphcut_inside_outside_ids",      &ImporterScientific::read_segmentation_graphcut_inside_outside_ids},
+      {"read_segmentation_in_flowfield_size",                &ImporterScientific::read_segmentation_in_flowfield_size},
+      {"read_vessel_section_segmentation_in_flowfield_size", &ImporterScientific::read_vessel_section_segmentation_in_flowfield_size},
+      {"read_vessel_section_segmentation_semantics",         &ImporterScientific::read_vessel_section_segmentation_semantics},
+      {"read_centerline_start_end_ids_on_mesh",              &ImporterScientific::read_centerline_start_end_ids_on_mesh},
+      {"read_static_tissue_mask",                            &ImporterScientific::read_static_tissue_mask},
+      {"read_static_tissue_ivsd_thresholds",                 &ImporterScientific::read_static_tissue_ivsd_thresholds},
+      {"read_dataset_filter_tags",                           &ImporterScientific::read_dataset_filter_tags},
+      {"read_phase_wrapped_voxels",                          &ImporterScientific::read_phase_wrapped_voxels},
+      {"read_velocity_offset_correction_3dt",                &ImporterScientific::read_velocity_offset_correction_3dt},
+      {"read_dicom_tags",                                    &ImporterScientific::read_dicom_tags},
+      {"read_cardiac_cycle_definition",                      &ImporterScientific::read_cardiac_cycle_definition},
+      {"read_venc",                                          &ImporterScientific::read_venc}};
+
+  //! readers that find their files in the dataset directory themselves
+  [[nodiscard]] bool is_directory_reader(std::string_view reader)
+  { return reader == "read_anatomical_images" || reader == "read_flow2dt_images"; }
+
+  //! one timed unit: a reader and all files it touches
+  struct Measurement
+  {
+      ReaderBenchmark result;
+      std::vector<std::string> filepaths; // absolute
+      std::function<bool(ImporterScientific&)> read;
+  }; // struct Measurement
+
+  [[nodiscard]] double rate(std::uint64_t n, double seconds)
+  { return seconds > 0 && seconds < std::numeric_limits<double>::infinity() ? static_cast<double>(n) / seconds : 0; }
+} // anonymous namespace
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool ImporterBenchmark::drop_page_cache(std::string_view filepath)
+{
+  #if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+    const int fd = ::open(std::string(filepath).c_str(), O_RDONLY);
+    if (fd < 0)
+    { return false; }
+
+    // dirty pages are not evicted
+    ::fdatasync(fd);
+    const bool success = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+
+    ::close(fd);
+
+    return success;
+  #else
+    (void) filepath;
+    return false;
+  #endif
+}
+
+std::vector<ReaderBenchmark> ImporterBenchmark::run(std::string_view dir, const std::vector<SyntheticFile>& files, unsigned int numRepetitions)
+{
+    namespace fs = std::filesystem;
+
+    numRepetitions = std::max(numRepetitions, 1U);
+
+    /*
+     * group files by measurement
+     */
+    std::vector<Measurement> measurements;
+
+    for (const SyntheticFile& f: files)
+    {
+        const std::string filepath = (fs::path(dir) / f.path).string();
+
+        if (is_directory_reader(f.reader))
+        {
+            const auto it = std::find_if(measurements.begin(), measurements.end(), [&](const Measurement& m)
+            { return m.result.reader == f.reader; });
+
+            if (it != measurements.end())
+            {
+                it->result.path += ", " + f.path;
+                it->result.num_items += f.num_items;
+                it->filepaths.push_back(filepath);
+                continue;
+            }
+        }
+
+        Measurement m;
+        m.result.reader = f.reader;
+        m.result.path = f.path;
+        m.result.item_name = f.item_name;
+        m.result.num_items = f.num_items;
+        m.filepaths.push_back(filepath);
+
+        if (f.reader == "read_anatomical_images")
+        {
+            m.read = [](ImporterScientific& im)
+            { return im.read_anatomical_images(); };
+        }
+        else if (f.reader == "read_flow2dt_images")
+        {
+            m.read = [](ImporterScientific& im)
+            { return im.read_flow2dt_images(); };
+        }
+        else
+        {
+            const auto it = std::find_if(std::begin(READERS), std::end(READERS), [&](const std::pair<std::string_view, Reader>& r)
+            { return r.first == f.reader; });
+
+            if (it != std::end(READERS))
+            {
+                const Reader read = it->second;
+                m.read = [read, filepath](ImporterScientific& im)
+                { return (im.*read)(filepath); };
+            }
+        }
+
+        measurements.push_back(std::move(m));
+    }
+
+    /*
+     * time
+     */
+    std::vector<ReaderBenchmark> results;
+    results.reserve(measurements.size());
+
+    for (Measurement& m: measurements)
+    {
+        ReaderBenchmark& r = m.result;
+
+        for (const std::string& filepath: m.filepaths)
+        {
+            std::error_code ec;
+            const std::uintmax_t numBytes = fs::file_size(filepath, ec);
+
+            if (!ec)
+            { r.num_bytes += numBytes; }
+        }
+
+        if (!m.read)
+        {
+            results.push_back(std::move(r));
+            continue;
+        }
+
+        // fresh importer per run; the parsed data is released with it
+        const auto time_once = [&](bool& success)
+        {
+            std::ostream nullConsole(nullptr);
+
+            ImporterScientific im;
+            im.set_dir(dir);
+            im.set_console(nullConsole);
+
+            const auto t0 = std::chrono::steady_clock::now();
+            const bool read = m.read(im);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+            success = success && read && im.result().find("FAILED!") == std::string::npos;
+
+            return seconds;
+        };
+
+        r.success = true;
+        time_once(r.success); // warm-up
+
+        double warmSeconds = std::numeric_limits<double>::infinity();
+        for (unsigned int i = 0; i < numRepetitions; ++i)
+        { warmSeconds = std::min(warmSeconds, time_once(r.success)); }
+
+        r.cold_cache = true;
+        double coldSeconds = std::numeric_limits<double>::infinity();
+        for (unsigned int i = 0; i < numRepetitions && r.cold_cache; ++i)
+        {
+            for (const std::string& filepath: m.filepaths)
+            { r.cold_cache = drop_page_cache(filepath) && r.cold_cache; }
+
+            if (r.cold_cache)
+            { coldSeconds = std::min(coldSeconds, time_once(r.success)); }
+        }
+
+        r.warm_mb_per_second = rate(r.num_bytes, warmSeconds) * 1e-6;
+        r.warm_items_per_second = rate(r.num_items, warmSeconds);
+
+        if (r.cold_cache)
+        {
+            r.cold_mb_per_second = rate(r.num_bytes, coldSeconds) * 1e-6;
+            r.cold_items_per_second = rate(r.num_items, coldSeconds);
+        }
+
+        results.push_back(std::move(r));
+    }
+
+    return results;
+}
+
+void ImporterBenchmark::write(std::ostream& os, const std::vector<ReaderBenchmark>& results)
+{
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << std::fixed << std::setprecision(1);
+    os << std::left << std::setw(52) << "reader" << std::right
+       << std::setw(11) << "MB" << std::setw(12) << "items"
+       << std::setw(12) << "warm MB/s" << std::setw(16) << "warm items/s"
+       << std::setw(12) << "cold MB/s" << std::setw(16) << "cold items/s"
+       << "  status" << std::endl;
+
+    for (const ReaderBenchmark& r: results)
+    {
+        os << std::left << std::setw(52) << r.reader << std::right
+           << std::setw(11) << static_cast<double>(r.num_bytes) * 1e-6 << std::setw(12) << r.num_items
+           << std::setw(12) << r.warm_mb_per_second << std::setw(16) << r.warm_items_per_second;
+
+        if (r.cold_cache)
+        { os << std::setw(12) << r.cold_mb_per_second << std::setw(16) << r.cold_items_per_second; }
+        else
+        { os << std::setw(12) << "-" << std::setw(16) << "-"; }
+
+        os << "  " << (r.success ? "ok" : "FAILED!") << " (" << r.path << ", " << r.item_name << ")" << std::endl;
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+bool ImporterBenchmark::check_wrapped_flowfield_size(std::string_view workDir, std::ostream& os)
+{
+    namespace fs = std::filesystem;
+
+    const fs::path filepath = fs::path(workDir) / "bloodline_wrapped_flowfield";
+
+    os << "Wrapped flow field size (path \"" << filepath.string() << "\")" << std::endl;
+
+    // 65536^4 * 3 * 8 bytes wraps to 0 in 64 bit; the file holds the header and one vector
+    {
+        FlowFieldHeader header;
+        header.size = {65536, 65536, 65536, 65536};
+
+        std::vector<char> bytes(FlowFieldHeader::num_bytes + 3 * sizeof(double), 0);
+        std::memcpy(bytes.data(), header.size.data(), sizeof(header.size));
+
+        std::ofstream file(filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+        if (!file.good())
+        {
+            os << "\tFAILED! Could not write file!" << std::endl;
+            return false;
+        }
+    }
+
+    FlowFieldView view;
+    const bool viewRejected = !view.open(filepath.string());
+
+    FlowFieldSlabReader slabs;
+    const bool slabsRejected = !slabs.open(filepath.string(), 1) && FlowFieldSlabReader::slab_thickness_for(filepath.string(), 1 << 20) == 0;
+
+    view.close();
+    slabs.close();
+
+    os << "\t- FlowFieldView: " << (viewRejected ? "rejected" : "FAILED! accepted") << std::endl;
+    os << "\t- FlowFieldSlabReader: " << (slabsRejected ? "rejected" : "FAILED! accepted") << std::endl;
+
+    std::error_code ec;
+    fs::remove(filepath, ec);
+
+    return viewRejected && slabsRejected;
+}
+
+bool ImporterBenchmark::run_suite(std::string_view workDir, const std::vector<SyntheticScale>& scales, std::ostream& os, unsigned int numRepetitions, std::uint64_t seed)
+{
+    namespace fs = std::filesystem;
+
+    bool success = true;
+
+    for (const SyntheticScale scale: scales)
+    {
+        const fs::path dir = fs::path(workDir) / ("bloodline_benchmark_" + std::string(SyntheticDataset::name(scale)));
+
+        os << "Benchmark \"" << SyntheticDataset::name(scale) << "\" (path \"" << dir.string() << "\")" << std::endl;
+
+        const std::vector<SyntheticFile> files = SyntheticDataset::generate(dir.string(), scale, seed);
+
+        if (files.empty())
+        { os << "\tFAILED! Could not generate dataset!" << std::endl; }
+        else
+        {
+            const std::vector<ReaderBenchmark> results = run(dir.string(), files, numRepetitions);
+            write(os, results);
+
+            success = success && std::all_of(results.begin(), results.end(), [](const ReaderBenchmark& r)
+            { return r.success; });
+        }
+
+        success = success && !files.empty();
+
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    success = check_wrapped_flowfield_size(workDir, os) && success;
+
+    return success;
+}
@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_IMPORTERBENCHMARK_H
+#define BLOODLINE_IMPORTERBENCHMARK_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SyntheticDataset.h"
+
+//! timings of one ImporterScientific::read_*() function; rates are best of all repetitions, MB = 10^6 bytes
+struct ReaderBenchmark
+{
+    std::string reader;
+    std::string path; // relative to the dataset directory; directory-based readers list all their files
+    std::string item_name;
+    std::uint64_t num_bytes = 0;
+    std::uint64_t num_items = 0;
+    bool success = false; // the reader returned true and reported no failure
+    bool cold_cache = false; // the page cache could be dropped before every cold run; the cold rates are 0 otherwise
+    double warm_mb_per_second = 0;
+    double warm_items_per_second = 0;
+    double cold_mb_per_second = 0;
+    double cold_items_per_second = 0;
+}; // struct ReaderBenchmark
+
+/*
+ * Times every reader of ImporterScientific separately on a dataset from SyntheticDataset.
+ *
+ * Warm runs follow one untimed run that loads the files into the page cache. Before every cold run
+ * the files are evicted from the page cache with posix_fadvise(POSIX_FADV_DONTNEED); this is only
+ * a request to the kernel, which keeps pages that are mapped elsewhere.
+ */
+class ImporterBenchmark
+{
+  public:
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! flushes and evicts the file from the page cache; false if not supported or the file cannot be opened
+    [[maybe_unused]] static bool drop_page_cache(std::string_view filepath);
+
+    //! one entry per reader in the order of files; the files of read_anatomical_images() and read_flow2dt_images() are timed together
+    [[nodiscard]] static std::vector<ReaderBenchmark> run(std::string_view dir, const std::vector<SyntheticFile>& files, unsigned int numRepetitions = 3);
+
+    static void write(std::ostream& os, const std::vector<ReaderBenchmark>& results);
+
+    /*
+     * regression check: a flowfield in workDir whose size product wraps in 64 bit (65536 per axis)
+     * has to be rejected by FlowFieldView and FlowFieldSlabReader; the file is removed again
+     */
+    [[maybe_unused]] static bool check_wrapped_flowfield_size(std::string_view workDir, std::ostream& os);
+
+    /*
+     * generates a dataset per scale in a subdirectory of workDir, runs and writes the benchmark
+     * and removes the dataset again; runs check_wrapped_flowfield_size();
+     * false if a dataset could not be generated, a reader failed or the check failed
+     */
+    [[maybe_unused]] static bool run_suite(std::string_view workDir, const std::vector<SyntheticScale>& scales, std::ostream& os, unsigned int numRepetitions = 3, std::uint64_t seed = 0);
+}; // class ImporterBenchmark
+
+#endif //BLOODLINE_IMPORTERBENCHMARK_H
@@ -23,18 +23,470 @@
  */
 
 #include "ImporterScientific.h"
+#include "BulkRead.h"
+#include "FloatNarrowing.h"
+#include "ImportProfiler.h"
+#include "PrefetchStreamBuf.h"
+#include "SparseImageDecoder.h"
+#include "ThreadPool.h"
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <filesystem>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <utility>
 
 #include <bk/StringUtils>
 
+namespace
+{
+  //====================================================================================================
+  //===== HELPERS
+  //====================================================================================================
+  template<typename T>
+  void read_value(std::istream& file, T& value)
+  { file.read(reinterpret_cast<char*>(&value), sizeof(T)); }
+
+  template<typename T, std::size_t N>
+  void read_array(std::istream& file, std::array<T, N>& arr)
+  { file.read(reinterpret_cast<char*>(arr.data()), N * sizeof(T)); }
+
+  //! number of values of a payload; the files store the extents as uint32, so their product is formed in 64 bit
+  template<typename... Ts>
+  [[nodiscard]] constexpr std::uint64_t num_values(Ts... extents)
+  { return (std::uint64_t(1) * ... * static_cast<std::uint64_t>(extents)); }
+
+  //! resizes the vector to n elements and fills it (in chunks of BulkRead::MAX_CHUNK_NUM_BYTES)
+  template<typename T>
+  void read_vector(std::istream& file, std::vector<T>& vec, std::uint64_t n)
+  {
+      if (n > vec.max_size())
+      {
+          file.setstate(std::ios_base::failbit);
+          return;
+      }
+
+      vec.resize(static_cast<std::size_t>(n));
+      BulkRead::read(file, vec.data(), n * sizeof(T));
+  }
+
+  //! payload arrays: doubles are read as is, floats are narrowed while reading and their error is recorded
+  void read_payload(std::istream& file, std::vector<double>& vec, std::uint64_t n, std::string_view /*name*/, std::vector<NarrowingError>& /*errors*/)
+  { read_vector(file, vec, n); }
+
+  void read_payload(std::istream& file, std::vector<float>& vec, std::uint64_t n, std::string_view name, std::vector<NarrowingError>& errors)
+  {
+      if (n > vec.max_size())
+      {
+          file.setstate(std::ios_base::failbit);
+          return;
+      }
+
+      FloatNarrowing::Error err;
+      FloatNarrowing::read(file, static_cast<std::size_t>(n), vec, err);
+      errors.push_back({std::string(name), err.max_abs, err.max_rel});
+  }
+
+  //! grid pos + value of all non-zero entries of an nd scalar image in sparse matrix style
+  [[nodiscard]] std::uint64_t sparse_image_values_num_bytes(const SparseImageMetadata& img)
+  { return num_values(img.num_values) * (img.num_dims * sizeof(std::uint32_t) + sizeof(double)); }
+
+  [[nodiscard]] std::uint64_t sparse_image_file_num_bytes(const SparseImageMetadata& img)
+  { return 2 * sizeof(std::uint32_t) + img.num_dims * (sizeof(std::uint32_t) + sizeof(double)) + (16 + 16 + 25 + 25) * sizeof(double) + sparse_image_values_num_bytes(img); }
+
+  //! for task importers of a disabled report; stateless
+  [[nodiscard]] NullReportSink& null_report_sink()
+  {
+      static NullReportSink sink;
+      return sink;
+  }
+
+  //! moves the read position forward without reading
+  void skip(std::istream& file, std::uint64_t numBytes)
+  { file.seekg(static_cast<std::streamoff>(numBytes), std::ios_base::cur); }
+
+  //! bytes between the read position and the end of the stream; 0 if the stream is not seekable
+  [[nodiscard]] std::uint64_t remaining_num_bytes(std::istream& file)
+  {
+      const std::streampos pos = file.tellg();
+      if (pos < 0)
+      { return 0; }
+
+      file.seekg(0, std::ios_base::end);
+      const std::streampos end = file.tellg();
+      file.seekg(pos);
+
+      return end > pos ? static_cast<std::uint64_t>(end - pos) : 0;
+  }
+
+  template<typename F>
+  auto load_file(std::string_view filepath, F&& parse, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary) -> std::optional<decltype(parse(std::declval<std::ifstream&>()))>
+  {
+      std::ifstream file(filepath.data(), mode);
+
+      if (!file.good())
+      { return std::nullopt; }
+
+      return parse(file);
+  }
+
+  //! std::ifstream or, with async I/O, a stream that fetches the next ranges of the file while the current one is parsed
+  class InputFile
+  {
+      std::ifstream _file;
+      PrefetchStreamBuf _buf;
+      std::istream _prefetched;
+      bool _async;
+
+    public:
+      InputFile(std::string_view filepath, bool async)
+          : _prefetched(nullptr),
+            _async(async)
+      {
+          if (!async)
+          { _file.open(filepath.data(), std::ios_base::in | std::ios_base::binary); }
+          else if (_buf.open(filepath))
+          { _prefetched.rdbuf(&_buf); }
+      }
+
+      [[nodiscard]] std::istream& stream()
+      { return _async ? _prefetched : static_cast<std::istream&>(_file); }
+
+      [[nodiscard]] bool good()
+      { return stream().good(); }
+  }; // class InputFile
+
+  template<typename F>
+  auto load_file(std::string_view filepath, F&& parse, bool async) -> std::optional<decltype(parse(std::declval<std::istream&>()))>
+  {
+      InputFile file(filepath, async);
+
+      if (!file.good())
+      { return std::nullopt; }
+
+      return parse(file.stream());
+  }
+
+  //! name and whether it is a per-time vector; in file order (see ImporterScientific::_parse_flow_statistics)
+  constexpr std::pair<std::string_view, bool> FLOW_STATISTICS[] = {
+        {"vortex pressure threshold", false},
+        {"volume total in ml", false},
+        {"section volume in ml", false},
+        {"section volume in percent", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // diameter
+        //------------------------------------------------------------------------------------------------------
+        {"min diameter in mm", false},
+        {"max diameter in mm", false},
+        {"mean diameter in mm", false},
+        {"median diameter in mm", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // cross-sectional area
+        //------------------------------------------------------------------------------------------------------
+        {"min cross sectional area in mm2", false},
+        {"max cross sectional area in mm2", false},
+        {"mean cross sectional area in mm2", false},
+        {"median cross sectional area in mm2", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // vortex volume
+        //------------------------------------------------------------------------------------------------------
+        {"vortex volume in ml per time", true},
+        {"vortex volume in percent per time", true},
+
+        {"max vortex volume in ml", false},
+        {"max vortex volume in percent", false},
+        {"max vortex volume time in ms", false},
+        {"mean vortex volume in ml", false},
+        {"mean vortex volume in percent", false},
+        {"median vortex volume in ml", false},
+        {"median vortex volume in percent", false},
+        {"systolic max vortex volume in ml", false},
+        {"systolic max vortex volume in percent", false},
+        {"systolic max vortex volume time in ms", false},
+        {"systolic mean vortex volume in ml", false},
+        {"systolic mean vortex volume in percent", false},
+        {"systolic median vortex volume in ml", false},
+        {"systolic median vortex volume in percent", false},
+        {"diastolic max vortex volume in ml", false},
+        {"diastolic max vortex volume in percent", false},
+        {"diastolic max vortex volume time in ms", false},
+        {"diastolic mean vortex volume in ml", false},
+        {"diastolic mean vortex volume in percent", false},
+        {"diastolic median vortex volume in ml", false},
+        {"diastolic median vortex volume in percent", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // vortex coverage
+        //------------------------------------------------------------------------------------------------------
+        {"vortex coverage in ml", false},
+        {"vortex coverage in percent", false},
+        {"systolic vortex coverage in ml", false},
+        {"systolic vortex coverage in percent", false},
+        {"diastolic vortex coverage in ml", false},
+        {"diastolic vortex coverage in percent", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // velocity
+        //------------------------------------------------------------------------------------------------------
+        {"max velocity per time", true},
+        {"max axial velocity per time", true},
+        {"max circumferential velocity per time", true},
+        {"mean velocity per time", true},
+        {"mean axial velocity per time", true},
+        {"mean circumferential velocity per time", true},
+        {"median velocity per time", true},
+        {"median axial velocity per time", true},
+        {"median circumferential velocity per time", true},
+
+        {"max mean velocity", false},
+        {"max mean velocity time in ms", false},
+        {"max mean axial velocity", false},
+        {"max mean axial velocity time in ms", false},
+        {"max mean circumferential velocity", false},
+        {"max mean circumferential velocity time in ms", false},
+        {"mean mean velocity", false},
+        {"mean mean axial velocity", false},
+        {"mean mean circumferential velocity", false},
+        {"median mean velocity", false},
+        {"median mean axial velocity", false},
+        {"median mean circumferential velocity", false},
+        {"max overall velocity", false},
+        {"max overall velocity time in ms", false},
+        {"max overall velocity q99", false},
+        {"max overall velocity q99 time in ms", false},
+        {"max overall axial velocity", false},
+        {"max overall axial velocity time in ms", false},
+        {"max overall axial velocity q99", false},
+        {"max overall axial velocity q99 time in ms", false},
+        {"max overall circumferential velocity", false},
+        {"max overall circumferential velocity time in ms", false},
+        {"max overall circumferential velocity q99", false},
+        {"max overall circumferential velocity q99 time in ms", false},
+        {"systolic max mean velocity", false},
+        {"systolic max mean velocity time in ms", false},
+        {"systolic max mean axial velocity", false},
+        {"systolic max mean axial velocity time in ms", false},
+        {"systolic max mean circumferential velocity", false},
+        {"systolic max mean circumferential velocity time in ms", false},
+        {"systolic mean mean velocity", false},
+        {"systolic mean mean axial velocity", false},
+        {"systolic mean mean circumferential velocity", false},
+        {"systolic median mean velocity", false},
+        {"systolic median mean axial velocity", false},
+        {"systolic median mean circumferential velocity", false},
+        {"systolic max overall velocity", false},
+        {"systolic max overall velocity time in ms", false},
+        {"systolic max overall velocity q99", false},
+        {"systolic max overall velocity q99 time in ms", false},
+        {"systolic max overall axial velocity", false},
+        {"systolic max overall axial velocity time in ms", false},
+        {"systolic max overall axial velocity q99", false},
+        {"systolic max overall axial velocity q99 time in ms", false},
+        {"systolic max overall circumferential velocity", false},
+        {"systolic max overall circumferential velocity time in ms", false},
+        {"systolic max overall circumferential velocity q99", false},
+        {"systolic max overall circumferential velocity q99 time in ms", false},
+        {"diastolic max mean velocity", false},
+        {"diastolic max mean velocity time in ms", false},
+        {"diastolic max mean axial velocity", false},
+        {"diastolic max mean axial velocity time in ms", false},
+        {"diastolic max mean circumferential velocity", false},
+        {"diastolic max mean circumferential velocity time in ms", false},
+        {"diastolic mean mean velocity", false},
+        {"diastolic mean mean axial velocity", false},
+        {"diastolic mean mean circumferential velocity", false},
+        {"diastolic median mean velocity", false},
+        {"diastolic median mean axial velocity", false},
+        {"diastolic median mean circumferential velocity", false},
+        {"diastolic max overall velocity", false},
+        {"diastolic max overall velocity time in ms", false},
+        {"diastolic max overall velocity q99", false},
+        {"diastolic max overall velocity q99 time in ms", false},
+        {"diastolic max overall axial velocity", false},
+        {"diastolic max overall axial velocity time in ms", false},
+        {"diastolic max overall axial velocity q99", false},
+        {"diastolic max overall axial velocity q99 time in ms", false},
+        {"diastolic max overall circumferential velocity", false},
+        {"diastolic max overall circumferential velocity time in ms", false},
+        {"diastolic max overall circumferential velocity q99", false},
+        {"diastolic max overall circumferential velocity q99 time in ms", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // rotation
+        //------------------------------------------------------------------------------------------------------
+        {"left rotation volume in ml per time", true},
+        {"left rotation volume in percent per time", true},
+
+        {"max left rotation volume in ml", false},
+        {"max left rotation volume in percent", false},
+        {"max left rotation volume time in ms", false},
+        {"mean left rotation volume in ml", false},
+        {"mean left rotation volume in percent", false},
+        {"median left rotation volume in ml", false},
+        {"median left rotation volume in percent", false},
+        {"systolic max left rotation volume in ml", false},
+        {"systolic max left rotation volume in percent", false},
+        {"systolic max left rotation volume time in ms", false},
+        {"systolic mean left rotation volume in ml", false},
+        {"systolic mean left rotation volume in percent", false},
+        {"systolic median left rotation volume in ml", false},
+        {"systolic median left rotation volume in percent", false},
+        {"diastolic max left rotation volume in ml", false},
+        {"diastolic max left rotation volume in percent", false},
+        {"diastolic max left rotation volume time in ms", false},
+        {"diastolic mean left rotation volume in ml", false},
+        {"diastolic mean left rotation volume in percent", false},
+        {"diastolic median left rotation volume in ml", false},
+        {"diastolic median left rotation volume in percent", false},
+
+        {"right rotation volume in ml per time", true},
+        {"right rotation volume in percent per time", true},
+
+        {"max right rotation volume in ml", false},
+        {"max right rotation volume in percent", false},
+        {"max right rotation volume time in ms", false},
+        {"mean right rotation volume in ml", false},
+        {"mean right rotation volume in percent", false},
+        {"median right rotation volume in ml", false},
+        {"median right rotation volume in percent", false},
+        {"systolic max right rotation volume in ml", false},
+        {"systolic max right rotation volume in percent", false},
+        {"systolic max right rotation volume time in ms", false},
+        {"systolic mean right rotation volume in ml", false},
+        {"systolic mean right rotation volume in percent", false},
+        {"systolic median right rotation volume in ml", false},
+        {"systolic median right rotation volume in percent", false},
+        {"diastolic max right rotation volume in ml", false},
+        {"diastolic max right rotation volume in percent", false},
+        {"diastolic max right rotation volume time in ms", false},
+        {"diastolic mean right rotation volume in ml", false},
+        {"diastolic mean right rotation volume in percent", false},
+        {"diastolic median right rotation volume in ml", false},
+        {"diastolic median right rotation volume in percent", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // pressure
+        //------------------------------------------------------------------------------------------------------
+        /*
+         * mean pressure per time
+         */
+        {"mean pressure per time", true},
+
+        /*
+         * min max mean median
+         */
+        {"min mean pressure", false},
+        {"min mean pressure time in ms", false},
+        {"max mean pressure", false},
+        {"max mean pressure time in ms", false},
+        {"mean mean pressure", false},
+        {"median mean pressure", false},
+
+        /*
+         * min max mean median : systolic
+         */
+        {"systolic min mean pressure", false},
+        {"systolic min mean pressure time in ms", false},
+        {"systolic max mean pressure", false},
+        {"systolic max mean pressure time in ms", false},
+        {"systolic mean mean pressure", false},
+        {"systolic median mean pressure", false},
+
+        /*
+         * min max mean median : diastolic
+         */
+        {"diastolic min mean pressure", false},
+        {"diastolic min mean pressure time in ms", false},
+        {"diastolic max mean pressure", false},
+        {"diastolic max mean pressure time in ms", false},
+        {"diastolic mean mean pressure", false},
+        {"diastolic median mean pressure", false},
+
+        /*
+         * mean pressure per time in vortex region
+         */
+        {"mean pressure in vortex region per time", true},
+
+        /*
+         * min max mean median in vortex region
+         */
+        {"min mean pressure in vortex region", false},
+        {"min mean pressure in vortex region time in ms", false},
+        {"max mean pressure in vortex region", false},
+        {"max mean pressure in vortex region time in ms", false},
+        {"mean mean pressure in vortex region", false},
+        {"median mean pressure in vortex region", false},
+
+        /*
+         * min max mean median in vortex region : systolic
+         */
+        {"systolic min mean pressure in vortex region", false},
+        {"systolic min mean pressure in vortex region time in ms", false},
+        {"systolic max mean pressure in vortex region", false},
+        {"systolic max mean pressure in vortex region time in ms", false},
+        {"systolic mean mean pressure in vortex region", false},
+        {"systolic median mean pressure in vortex region", false},
+
+        /*
+         * min max mean median in vortex region : diastolic
+         */
+        {"diastolic min mean pressure in vortex region", false},
+        {"diastolic min mean pressure in vortex region time in ms", false},
+        {"diastolic max mean pressure in vortex region", false},
+        {"diastolic max mean pressure in vortex region time in ms", false},
+        {"diastolic mean mean pressure in vortex region", false},
+        {"diastolic median mean pressure in vortex region", false},
+
+        //------------------------------------------------------------------------------------------------------
+        // flow displacement
+        //------------------------------------------------------------------------------------------------------
+        /*
+         * min max mean median displacement (velocity-weighted)
+         */
+        {"max flow jet displacement velocity weighted", false},
+        {"min flow jet displacement velocity weighted", false},
+        {"mean flow jet displacement velocity weighted", false},
+        {"median flow jet displacement velocity weighted", false},
+
+        /*
+         * min max mean median angle to centerline (velocity-weighted)
+         */
+        {"max flow jet angle velocity weighted", false},
+        {"min flow jet angle velocity weighted", false},
+        {"mean flow jet angle velocity weighted", false},
+        {"median flow jet angle velocity weighted", false},
+
+        /*
+         * min max mean median high-velocity area percent of cross-section (velocity-weighted)
+         */
+        {"max flow jet high velocity area percent velocity weighted", false},
+        {"min flow jet high velocity area percent velocity weighted", false},
+        {"mean flow jet high velocity area percent velocity weighted", false},
+        {"median flow jet high velocity area percent velocity weighted", false},
+  };
+} // anonymous namespace
+
 //====================================================================================================
 //===== CONSTRUCTORS & DESTRUCTOR
 //====================================================================================================
-ImporterScientific::ImporterScientific() = default;
+ImporterScientific::ImporterScientific()
+    : _console(&std::cout),
+      _flowfield_memory_mapped(false),
+      _single_precision(false),
+      _async_io(false),
+      _num_threads(0),
+      _thread_pool(nullptr),
+      _profiler(nullptr)
+{ /* do nothing */ }
 //ImporterScientific::ImporterScientific(const ImporterScientific&) = default;
 ImporterScientific::ImporterScientific(ImporterScientific&&) = default;
 ImporterScientific::~ImporterScientific() = default;
@@ -45,6 +497,9 @@ ImporterScientific::~ImporterScientific() = default;
 std::string ImporterScientific::result() const
 { return _res.str(); }
 
+std::vector<std::pair<std::string_view, bool>> ImporterScientific::flow_statistics_layout()
+{ return {std::begin(FLOW_STATISTICS), std::end(FLOW_STATISTICS)}; }
+
 //====================================================================================================
 //===== SETTER
 //====================================================================================================
@@ -54,10 +509,48 @@ std::string ImporterScientific::result() const
 void ImporterScientific::set_dir(std::string_view dir)
 { _dir = dir; }
 
+void ImporterScientific::set_flowfield_memory_mapped(bool b)
+{ _flowfield_memory_mapped = b; }
+
+void ImporterScientific::set_single_precision(bool b)
+{ _single_precision = b; }
+
+void ImporterScientific::set_async_io(bool b)
+{ _async_io = b; }
+
+void ImporterScientific::set_num_threads(unsigned int n)
+{ _num_threads = n; }
+
+void ImporterScientific::set_thread_pool(ThreadPool* pool)
+{ _thread_pool = pool; }
+
+void ImporterScientific::set_profiler(ImportProfiler* profiler)
+{ _profiler = profiler; }
+
+void ImporterScientific::set_report_sink(ReportSink* sink)
+{ _res.set_sink(sink); }
+
+void ImporterScientific::set_console(std::ostream& console)
+{ _console = &console; }
+
 //====================================================================================================
 //===== FUNCTIONS
 //====================================================================================================
-void ImporterScientific::_read_nd_scalar_image_in_sparse_matrix_style(std::ifstream& file)
+void ImporterScientific::_report_matrix(std::string_view indent, std::string_view name, const double* m, unsigned int numRows)
+{
+    unsigned int cnt = 0;
+    _res << indent << "- " << name << ":" << std::endl;
+    for (unsigned int rowid = 0; rowid < numRows; ++rowid)
+    {
+        _res << indent << "\t";
+        for (unsigned int colid = 0; colid < numRows; ++colid)
+        { _res << m[cnt++] << " "; }
+
+        _res << std::endl;
+    }
+}
+
+SparseImageData ImporterScientific::_parse_nd_scalar_image_in_sparse_matrix_style(std::istream& file)
 {
     /*
      *       [1] x [uint32] : numDims
@@ -73,144 +566,202 @@ void ImporterScientific::_read_nd_scalar_image_in_sparse_matrix_style(std::ifstr
      *                     [1] x [double] : value
      */
 
-    /*
-     * num dimensions
-     */
-    std::uint32_t numDims = 0;
-    file.read(reinterpret_cast<char*>(&numDims), sizeof(std::uint32_t));
-    _res << "\t\t- num. dimensions: " << numDims << std::endl;
+    SparseImageData img = _parse_sparse_image_header(file);
 
-    /*
-     * grid size
-     */
-    std::vector<std::uint32_t> gridsize(numDims);
-    file.read(reinterpret_cast<char*>(gridsize.data()), numDims * sizeof(std::uint32_t));
+    //------------------------------------------------------------------------------------------------------
+    // non-zero values
+    //------------------------------------------------------------------------------------------------------
+    SparseImageDecoder::decode(file, img.num_dims, img.num_values, img.grid_pos, img.values);
+
+    return img;
+}
+
+SparseImageData ImporterScientific::_parse_sparse_image_header(std::istream& file)
+{
+    // see _parse_nd_scalar_image_in_sparse_matrix_style(); stops before the first entry
+    SparseImageData img;
+
+    read_value(file, img.num_dims);
+
+    // a corrupt dimension count must not allocate more than the file holds
+    if (num_values(img.num_dims, sizeof(std::uint32_t) + sizeof(double)) > remaining_num_bytes(file))
+    {
+        file.setstate(std::ios_base::failbit);
+        img.num_dims = 0;
+        return img;
+    }
+
+    read_vector(file, img.grid_size, img.num_dims);
+    read_vector(file, img.voxel_scale, img.num_dims);
+    read_array(file, img.world_matrix);
+    read_array(file, img.inverse_world_matrix);
+    read_array(file, img.world_matrix_with_time);
+    read_array(file, img.inverse_world_matrix_with_time);
+    read_value(file, img.num_values);
+
+    return img;
+}
+
+void ImporterScientific::report(const SparseImageData& img)
+{
+    _report_sparse_image_header(img);
+
+    for (unsigned int i = 0; i < std::min(NUM_DEMO, img.num_values); ++i)
+    {
+        _res << "\t\t\t- " << i << ": [";
+        for (unsigned int k = 0; k < img.num_dims; ++k)
+        {
+            _res << img.grid_pos[k][i];
+            if (k < img.num_dims - 1)
+            { _res << ", "; }
+        }
+        _res << "] = " << img.values[i] << std::endl;
+    }
+    _res << "\t\t\t- ..." << std::endl;
+}
+
+void ImporterScientific::_report_sparse_image_header(const SparseImageData& img)
+{
+    _res << "\t\t- num. dimensions: " << img.num_dims << std::endl;
 
     _res << "\t\t- grid size: ";
-    for (unsigned int i = 0; i < numDims; ++i)
+    for (unsigned int i = 0; i < img.num_dims; ++i)
     {
-        _res << gridsize[i];
-        if (i < numDims - 1)
+        _res << img.grid_size[i];
+        if (i < img.num_dims - 1)
         { _res << " x "; }
     }
     _res << std::endl;
 
-    /*
-     * voxel scale
-     */
-    std::vector<double> voxelscale(numDims);
-    file.read(reinterpret_cast<char*>(voxelscale.data()), numDims * sizeof(double));
-
     _res << "\t\t- voxel scale: ";
-    for (unsigned int i = 0; i < numDims; ++i)
+    for (unsigned int i = 0; i < img.num_dims; ++i)
     {
-        _res << voxelscale[i];
-        if (i < numDims - 1)
+        _res << img.voxel_scale[i];
+        if (i < img.num_dims - 1)
         { _res << " x "; }
     }
     _res << std::endl;
 
-    /*
-     * - world matrix (4x4 from dicom)
-     * - inverse world matrix (4x4 from dicom)
-     *
-     * - world matrix (5x5 including time in 4th row/col)
-     * - inverse world matrix (5x5 including time in 4th row/col)
-     */
-    std::vector<double> dbuffer(16);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    _report_matrix("\t\t", "world matrix", img.world_matrix.data(), 4);
+    _report_matrix("\t\t", "inverse world matrix", img.inverse_world_matrix.data(), 4);
+    _report_matrix("\t\t", "world matrix with time", img.world_matrix_with_time.data(), 5);
+    _report_matrix("\t\t", "inverse world matrix with time", img.inverse_world_matrix_with_time.data(), 5);
 
-    unsigned int cnt = 0;
-    _res << "\t\t- world matrix:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 4; ++rowid)
-    {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 4; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+    _res << "\t\t- num. non-zero values: " << img.num_values << std::endl;
+}
 
-        _res << std::endl;
-    }
+VoxelMask ImporterScientific::_parse_voxel_mask(std::istream& file)
+{
+    // see _parse_nd_scalar_image_in_sparse_matrix_style()
+    std::uint32_t numDims = 0;
+    read_value(file, numDims);
 
-    //dbuffer.resize(16);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    std::vector<std::uint32_t> size;
+    read_vector(file, size, numDims);
+    skip(file, (numDims + 16 + 16 + 25 + 25) * sizeof(double)); // voxel scale + matrices
 
-    cnt = 0;
-    _res << "\t\t- inverse world matrix:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 4; ++rowid)
-    {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 4; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+    std::uint32_t numValues = 0;
+    read_value(file, numValues);
 
-        _res << std::endl;
-    }
+    return _parse_voxel_mask_entries(file, std::move(size), numValues);
+}
 
-    dbuffer.resize(25);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+VoxelMask ImporterScientific::_parse_voxel_mask_entries(std::istream& file, std::vector<std::uint32_t> size, std::uint32_t numValues)
+{
+    // the entries are read in blocks and only set bits
+    if (!file.good())
+    { return VoxelMask(); }
 
-    cnt = 0;
-    _res << "\t\t- world matrix with time:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 5; ++rowid)
-    {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 5; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+    const std::uint32_t numDims = size.size();
+    VoxelMask mask(std::move(size));
 
-        _res << std::endl;
-    }
+    const std::size_t recordNumBytes = SparseImageDecoder::record_num_bytes(numDims);
+    const std::size_t blockNumRecords = std::max<std::size_t>(1, SparseImageDecoder::DEFAULT_BLOCK_NUM_BYTES / recordNumBytes);
 
-    //dbuffer.resize(25);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    std::vector<char> block(std::min<std::size_t>(blockNumRecords, numValues) * recordNumBytes);
+    std::vector<std::uint32_t> gridPos(numDims);
 
-    cnt = 0;
-    _res << "\t\t- inverse world matrix with time:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 5; ++rowid)
+    std::size_t numDecoded = 0;
+    while (numDecoded < numValues)
     {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 5; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+        const std::size_t n = std::min<std::size_t>(blockNumRecords, numValues - numDecoded);
 
-        _res << std::endl;
-    }
+        file.read(block.data(), static_cast<std::streamsize>(n * recordNumBytes));
+        const std::size_t numRead = static_cast<std::size_t>(file.gcount()) / recordNumBytes;
 
-    //------------------------------------------------------------------------------------------------------
-    // non-zero values
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numNonZeroValues = 0;
-    file.read(reinterpret_cast<char*>(&numNonZeroValues), sizeof(std::uint32_t));
-    _res << "\t\t- num. non-zero values: " << numNonZeroValues << std::endl;
+        for (std::size_t i = 0; i < numRead; ++i)
+        {
+            const char* r = block.data() + i * recordNumBytes;
+
+            double value = 0;
+            std::memcpy(gridPos.data(), r, numDims * sizeof(std::uint32_t));
+            std::memcpy(&value, r + numDims * sizeof(std::uint32_t), sizeof(double));
 
-    std::vector<std::uint32_t> gridpos(numDims);
+            if (value != 0 && mask.contains(gridPos.data()))
+            { mask.set(mask.index(gridPos.data())); }
+        }
+
+        numDecoded += numRead;
+
+        if (numRead != n)
+        { break; } // truncated file
+    } // while numDecoded < numValues
+
+    return mask;
+}
+
+void ImporterScientific::report(const VoxelMask& mask)
+{
+    _res << "\t\t- num. dimensions: " << mask.num_dims() << std::endl;
 
-    for (unsigned int i = 0; i < numNonZeroValues; ++i)
+    _res << "\t\t- grid size: ";
+    for (unsigned int i = 0; i < mask.num_dims(); ++i)
     {
-        //------------------------------------------------------------------------------------------------------
-        // grid pos
-        //------------------------------------------------------------------------------------------------------
-        file.read(reinterpret_cast<char*>(gridpos.data()), numDims * sizeof(std::uint32_t));
+        _res << mask.size()[i];
+        if (i < mask.num_dims() - 1)
+        { _res << " x "; }
+    }
+    _res << std::endl;
 
-        //------------------------------------------------------------------------------------------------------
-        // value
-        //------------------------------------------------------------------------------------------------------
-        double val = 0;
-        file.read(reinterpret_cast<char*>(&val), sizeof(double));
+    _report_voxel_mask_voxels(mask);
+}
 
-        if (i < NUM_DEMO)
+void ImporterScientific::_report_voxel_mask_voxels(const VoxelMask& mask)
+{
+    _res << "\t\t- num. voxels set: " << mask.count() << " of " << mask.num_voxels() << std::endl;
+
+    std::vector<std::uint32_t> gridPos(mask.num_dims());
+    std::uint64_t index = mask.find_next(0);
+    for (unsigned int i = 0; i < NUM_DEMO && index < mask.num_voxels(); ++i, index = mask.find_next(index + 1))
+    {
+        mask.grid_pos(index, gridPos.data());
+
+        _res << "\t\t\t- " << i << ": [";
+        for (unsigned int k = 0; k < mask.num_dims(); ++k)
         {
-            _res << "\t\t\t- " << i << ": [";
-            for (unsigned int k = 0; k < numDims; ++k)
-            {
-                _res << gridpos[k];
-                if (k < numDims - 1)
-                { _res << ", "; }
-            }
-            _res << "] = " << val << std::endl;
+            _res << gridPos[k];
+            if (k < mask.num_dims() - 1)
+            { _res << ", "; }
         }
+        _res << "]" << std::endl;
     }
     _res << "\t\t\t- ..." << std::endl;
 }
 
-bool ImporterScientific::read_mesh(std::string_view filepath)
+std::optional<SparseImageData> ImporterScientific::load_sparse_image(std::string_view filepath) const
+{ return load_file(filepath, _parse_nd_scalar_image_in_sparse_matrix_style); }
+
+std::optional<VoxelMask> ImporterScientific::load_voxel_mask(std::string_view filepath) const
+{ return load_file(filepath, _parse_voxel_mask); }
+
+std::optional<SparseImageIndex> ImporterScientific::load_sparse_image_index(std::string_view filepath) const
+{
+    return load_file(filepath, [](std::istream& file)
+    { return SparseImageIndex(_parse_nd_scalar_image_in_sparse_matrix_style(file)); });
+}
+
+template<typename T>
+BasicMeshData<T> ImporterScientific::_parse_mesh(std::istream& file)
 {
     /*
      *                           [1] x [uint32] : numPoints
@@ -237,334 +788,229 @@ bool ImporterScientific::read_mesh(std::string_view filepath)
      *               [numPoints * 3] x [double] : mean wss vector : circumferential
      */
 
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- vessel has no mesh (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
-
-    _res << "\t- reading mesh (path \"" << filepath.data() << "\")" << std::endl;
-
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    BasicMeshData<T> mesh;
 
-    if (!file.good())
-    {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+    //------------------------------------------------------------------------------------------------------
+    // points + normals
+    //------------------------------------------------------------------------------------------------------
+    read_value(file, mesh.num_points);
+    read_payload(file, mesh.points, num_values(3, mesh.num_points), "points", mesh.narrowing_errors);
+    read_payload(file, mesh.point_normals, num_values(3, mesh.num_points), "point_normals", mesh.narrowing_errors);
 
     //------------------------------------------------------------------------------------------------------
-    // num points
+    // triangles + normals
     //------------------------------------------------------------------------------------------------------
-    std::uint32_t numPoints = 0;
-    file.read(reinterpret_cast<char*>(&numPoints), sizeof(std::uint32_t));
-    _res << "\t\t- num. points: " << numPoints << std::endl;
+    read_value(file, mesh.num_triangles);
+    read_vector(file, mesh.triangles, num_values(3, mesh.num_triangles));
+    read_payload(file, mesh.triangle_normals, num_values(3, mesh.num_triangles), "triangle_normals", mesh.narrowing_errors);
 
     //------------------------------------------------------------------------------------------------------
-    // list of points
+    // wall shear stress per point over time
     //------------------------------------------------------------------------------------------------------
-    std::vector<double> dbuffer(3 * numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    read_value(file, mesh.num_times);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        const unsigned int off = pointid * 3;
-        _res << "\t\t\t- point" << pointid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
+    const std::uint64_t numValuesPerTime = num_values(mesh.num_points, mesh.num_times);
+    read_payload(file, mesh.wss, numValuesPerTime, "wss", mesh.narrowing_errors);
+    read_payload(file, mesh.wss_axial, numValuesPerTime, "wss_axial", mesh.narrowing_errors);
+    read_payload(file, mesh.wss_circumferential, numValuesPerTime, "wss_circumferential", mesh.narrowing_errors);
+    read_payload(file, mesh.wss_vector, 3 * numValuesPerTime, "wss_vector", mesh.narrowing_errors);
+    read_payload(file, mesh.wss_vector_axial, 3 * numValuesPerTime, "wss_vector_axial", mesh.narrowing_errors);
+    read_payload(file, mesh.wss_vector_circumferential, 3 * numValuesPerTime, "wss_vector_circumferential", mesh.narrowing_errors);
 
     //------------------------------------------------------------------------------------------------------
-    // list of point normals
+    // mean wall shear stress + oscillatory shear index (OSI) per point
     //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(3 * numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    read_payload(file, mesh.mean_wss, mesh.num_points, "mean_wss", mesh.narrowing_errors);
+    read_payload(file, mesh.mean_wss_axial, mesh.num_points, "mean_wss_axial", mesh.narrowing_errors);
+    read_payload(file, mesh.mean_wss_circumferential, mesh.num_points, "mean_wss_circumferential", mesh.narrowing_errors);
+    read_payload(file, mesh.osi, mesh.num_points, "osi", mesh.narrowing_errors);
+    read_payload(file, mesh.osi_axial, mesh.num_points, "osi_axial", mesh.narrowing_errors);
+    read_payload(file, mesh.osi_circumferential, mesh.num_points, "osi_circumferential", mesh.narrowing_errors);
+    read_payload(file, mesh.mean_wss_vector, num_values(3, mesh.num_points), "mean_wss_vector", mesh.narrowing_errors);
+    read_payload(file, mesh.mean_wss_vector_axial, num_values(3, mesh.num_points), "mean_wss_vector_axial", mesh.narrowing_errors);
+    read_payload(file, mesh.mean_wss_vector_circumferential, num_values(3, mesh.num_points), "mean_wss_vector_circumferential", mesh.narrowing_errors);
+
+    return mesh;
+}
+
+template<typename T>
+void ImporterScientific::_report_mesh(const BasicMeshData<T>& mesh)
+{
+    const unsigned int numTimes = mesh.num_times;
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+    const auto report_vec3_per_point = [&](std::string_view name, const std::vector<T>& v)
     {
-        const unsigned int off = pointid * 3;
-        _res << "\t\t\t- normal" << pointid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
+        for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+        {
+            const unsigned int off = pointid * 3;
+            _res << "\t\t\t- " << name << pointid << ": [" << v[off] << ", " << v[off + 1] << ", " << v[off + 2] << "]" << std::endl;
+        }
+        _res << "\t\t\t- ..." << std::endl;
+    };
 
-    //------------------------------------------------------------------------------------------------------
-    // num triangles
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numTriangles = 0;
-    file.read(reinterpret_cast<char*>(&numTriangles), sizeof(std::uint32_t));
+    const auto report_scalar_per_point_per_time = [&](const std::vector<T>& v)
+    {
+        for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+        {
+            _res << "\t\t\t- point" << pointid << ": ";
 
-    //------------------------------------------------------------------------------------------------------
-    // list of triangles
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::uint32_t> ui32buffer(3 * numTriangles);
-    file.read(reinterpret_cast<char*>(ui32buffer.data()), ui32buffer.size() * sizeof(std::uint32_t));
-    _res << "\t\t- num. triangles: " << numTriangles << std::endl;
+            for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
+            {
+                const std::uint64_t off = num_values(pointid, numTimes) + timeid;
+                _res << v[off] << ", ";
+            }
 
-    for (unsigned int cellid = 0; cellid < NUM_DEMO; ++cellid)
+            _res << "..." << std::endl;
+        }
+    };
+
+    const auto report_vec3_per_point_per_time = [&](const std::vector<T>& v)
     {
-        const unsigned int off = cellid * 3;
-        _res << "\t\t\t- triangle" << cellid << ": [" << ui32buffer[off] << ", " << ui32buffer[off + 1] << ", " << ui32buffer[off + 2] << "]" << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
+        for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+        {
+            _res << "\t\t\t- point" << pointid << ": ";
+
+            for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
+            {
+                const std::uint64_t off = num_values(pointid, numTimes) + timeid * 3;
+                _res << "[" << v[off] << ", " << v[off + 1] << ", " << v[off + 2] << "], ";
+            }
+
+            _res << "..." << std::endl;
+        }
+        _res << "\t\t\t- ..." << std::endl;
+    };
+
+    const auto report_scalar_per_point = [&](const std::vector<T>& v)
+    {
+        for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+        { _res << "\t\t\t- point" << pointid << ": " << v[pointid] << std::endl; }
+        _res << "\t\t\t- ..." << std::endl;
+    };
 
     //------------------------------------------------------------------------------------------------------
-    // list of triangle normals
+    // points + normals
     //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(3 * numTriangles);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    _res << "\t\t- num. points: " << mesh.num_points << std::endl;
+    report_vec3_per_point("point", mesh.points);
+    report_vec3_per_point("normal", mesh.point_normals);
+
+    //------------------------------------------------------------------------------------------------------
+    // triangles + normals
+    //------------------------------------------------------------------------------------------------------
+    _res << "\t\t- num. triangles: " << mesh.num_triangles << std::endl;
 
     for (unsigned int cellid = 0; cellid < NUM_DEMO; ++cellid)
     {
         const unsigned int off = cellid * 3;
-        _res << "\t\t\t- normal" << cellid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
+        _res << "\t\t\t- triangle" << cellid << ": [" << mesh.triangles[off] << ", " << mesh.triangles[off + 1] << ", " << mesh.triangles[off + 2] << "]" << std::endl;
     }
     _res << "\t\t\t- ..." << std::endl;
 
+    report_vec3_per_point("normal", mesh.triangle_normals);
+
     //------------------------------------------------------------------------------------------------------
-    // num temporal positions
+    // wall shear stress per point over time
     //------------------------------------------------------------------------------------------------------
-    std::uint32_t numTimes = 0;
-    file.read(reinterpret_cast<char*>(&numTimes), sizeof(std::uint32_t));
     _res << "\t\t- num. temporal positions: " << numTimes << std::endl;
 
-    //------------------------------------------------------------------------------------------------------
-    //  wall shear stress per point over time
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(numPoints * numTimes);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
     _res << "\t\t- WSS per point per time:" << std::endl;
+    report_scalar_per_point_per_time(mesh.wss);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        _res << "\t\t\t- point" << pointid << ": ";
+    _res << "\t\t- Axial WSS per point per time:" << std::endl;
+    report_scalar_per_point_per_time(mesh.wss_axial);
+    _res << "\t\t\t- ..." << std::endl;
 
-        for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
-        {
-            const unsigned int off = pointid * numTimes + timeid;
-            _res << dbuffer[off] << ", ";
-        }
+    _res << "\t\t- Circumferential WSS per point per time:" << std::endl;
+    report_scalar_per_point_per_time(mesh.wss_circumferential);
+    _res << "\t\t\t- ..." << std::endl;
 
-        _res << "..." << std::endl;
-    }
+    _res << "\t\t- WSS vector per point per time:" << std::endl;
+    report_vec3_per_point_per_time(mesh.wss_vector);
+
+    _res << "\t\t- Axial WSS vector per point per time:" << std::endl;
+    report_vec3_per_point_per_time(mesh.wss_vector_axial);
+
+    _res << "\t\t- Circumferential WSS vector per point per time:" << std::endl;
+    report_vec3_per_point_per_time(mesh.wss_vector_circumferential);
 
     //------------------------------------------------------------------------------------------------------
-    // wall shear stress per point over time : AXIAL
+    // mean wall shear stress + oscillatory shear index (OSI) per point
     //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints * numTimes);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Axial WSS per point per time:" << std::endl;
+    _res << "\t\t- Mean WSS per point:" << std::endl;
+    report_scalar_per_point(mesh.mean_wss);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        _res << "\t\t\t- point" << pointid << ": ";
+    _res << "\t\t- Mean axial WSS per point:" << std::endl;
+    report_scalar_per_point(mesh.mean_wss_axial);
 
-        for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
-        {
-            const unsigned int off = pointid * numTimes + timeid;
-            _res << dbuffer[off] << ", ";
-        }
+    _res << "\t\t- Mean circumferential WSS per point:" << std::endl;
+    report_scalar_per_point(mesh.mean_wss_circumferential);
 
-        _res << "..." << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
+    _res << "\t\t- OSI per point:" << std::endl;
+    report_scalar_per_point(mesh.osi);
 
-    //------------------------------------------------------------------------------------------------------
-    // wall shear stress per point over time : CIRCUMFERENTIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints * numTimes);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Circumferential WSS per point per time:" << std::endl;
+    _res << "\t\t- Axial OSI per point:" << std::endl;
+    report_scalar_per_point(mesh.osi_axial);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        _res << "\t\t\t- point" << pointid << ": ";
-
-        for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
-        {
-            const unsigned int off = pointid * numTimes + timeid;
-            _res << dbuffer[off] << ", ";
-        }
-
-        _res << "..." << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // wall shear stress vector per point over time
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(numPoints * numTimes * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- WSS vector per point per time:" << std::endl;
-
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        _res << "\t\t\t- point" << pointid << ": ";
-
-        for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
-        {
-            const unsigned int off = pointid * numTimes + timeid * 3;
-            _res << "[" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "], ";
-        }
-
-        _res << "..." << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // wall shear stress vector per point over time : AXIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints * numTimes * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Axial WSS vector per point per time:" << std::endl;
-
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        _res << "\t\t\t- point" << pointid << ": ";
-
-        for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
-        {
-            const unsigned int off = pointid * numTimes + timeid * 3;
-            _res << "[" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "], ";
-        }
-
-        _res << "..." << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // wall shear stress vector per point over time : CIRCUMFERENTIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints * numTimes * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Circumferential WSS vector per point per time:" << std::endl;
-
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        _res << "\t\t\t- point" << pointid << ": ";
-
-        for (unsigned int timeid = 0; timeid < NUM_DEMO; ++timeid)
-        {
-            const unsigned int off = pointid * numTimes + timeid * 3;
-            _res << "[" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "], ";
-        }
-
-        _res << "..." << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // mean wall shear stress per point
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Mean WSS per point:" << std::endl;
-
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    { _res << "\t\t\t- point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-    _res << "\t\t\t- ..." << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // mean wall shear stress per point : AXIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Mean axial WSS per point:" << std::endl;
-
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    { _res << "\t\t\t- point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-    _res << "\t\t\t- ..." << std::endl;
+    _res << "\t\t- Circumferential OSI per point:" << std::endl;
+    report_scalar_per_point(mesh.osi_circumferential);
 
     //------------------------------------------------------------------------------------------------------
-    // mean wall shear stress per point : CIRCUMFERENTIAL
+    // mean wall shear stress vector per point
     //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Mean circumferential WSS per point:" << std::endl;
+    _res << "\t\t- Mean WSS vector per point:" << std::endl;
+    report_vec3_per_point("point", mesh.mean_wss_vector);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    { _res << "\t\t\t- point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-    _res << "\t\t\t- ..." << std::endl;
+    _res << "\t\t- Mean axial WSS vector per point:" << std::endl;
+    report_vec3_per_point("point", mesh.mean_wss_vector_axial);
 
-    //------------------------------------------------------------------------------------------------------
-    // oscillatory shear index (OSI) per point
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- OSI per point:" << std::endl;
+    _res << "\t\t- Mean circumferential WSS vector per point:" << std::endl;
+    report_vec3_per_point("point", mesh.mean_wss_vector_circumferential);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    { _res << "\t\t\t- point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-    _res << "\t\t\t- ..." << std::endl;
+    _report_narrowing_errors("\t\t", mesh.narrowing_errors);
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // oscillatory shear index (OSI) per point : AXIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Axial OSI per point:" << std::endl;
+void ImporterScientific::report(const MeshData& mesh)
+{ _report_mesh(mesh); }
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    { _res << "\t\t\t- point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-    _res << "\t\t\t- ..." << std::endl;
+void ImporterScientific::report(const MeshDataF& mesh)
+{ _report_mesh(mesh); }
 
-    //------------------------------------------------------------------------------------------------------
-    // oscillatory shear index (OSI) per point : CIRCUMFERENTIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Circumferential OSI per point:" << std::endl;
+std::optional<MeshData> ImporterScientific::load_mesh(std::string_view filepath) const
+{ return load_file(filepath, _parse_mesh<double>, _async_io); }
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    { _res << "\t\t\t- point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-    _res << "\t\t\t- ..." << std::endl;
+std::optional<MeshDataF> ImporterScientific::load_mesh_single_precision(std::string_view filepath) const
+{ return load_file(filepath, _parse_mesh<float>, _async_io); }
 
-    //------------------------------------------------------------------------------------------------------
-    // mean wall shear stress vector per point
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(numPoints * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Mean WSS vector per point:" << std::endl;
+bool ImporterScientific::read_mesh(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+    if (!std::filesystem::exists(filepath.data()))
     {
-        const unsigned int off = pointid * 3;
-        _res << "\t\t\t- point" << pointid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
+        _res << "\t- vessel has no mesh (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
     }
-    _res << "\t\t\t- ..." << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    //  mean wall shear stress vector per point : AXIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Mean axial WSS vector per point:" << std::endl;
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
-    {
-        const unsigned int off = pointid * 3;
-        _res << "\t\t\t- point" << pointid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
-    }
-    _res << "\t\t\t- ..." << std::endl;
+    _res << "\t- reading mesh (path \"" << filepath.data() << "\")" << std::endl;
 
-    //------------------------------------------------------------------------------------------------------
-    // mean wall shear stress vector per point : CIRCUMFERENTIAL
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(numPoints * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- Mean circumferential WSS vector per point:" << std::endl;
+    InputFile file(filepath, _async_io);
 
-    for (unsigned int pointid = 0; pointid < NUM_DEMO; ++pointid)
+    if (!file.good())
     {
-        const unsigned int off = pointid * 3;
-        _res << "\t\t\t- point" << pointid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
     }
-    _res << "\t\t\t- ..." << std::endl;
 
-    file.close();
+    if (_single_precision)
+    { report(_parse_mesh<float>(file.stream())); }
+    else
+    { report(_parse_mesh(file.stream())); }
 
     return true;
 }
 
-bool ImporterScientific::read_centerlines(std::string_view filepath)
+CenterlinesData ImporterScientific::_parse_centerlines(std::istream& file)
 {
     /*
      * [1] x [uint32] : numCenterlines
@@ -576,109 +1022,106 @@ bool ImporterScientific::read_centerlines(std::string_view filepath)
      *          [numPoints * 3 * 3] x [double] : local coordinate system (x,y,z vector) per point
      */
 
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- vessel has no centerlines (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
-
-    _res << "\t- reading centerlines (path \"" << filepath.data() << "\")" << std::endl;
+    CenterlinesData cls;
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    std::uint32_t numCenterlines = 0;
+    read_value(file, numCenterlines);
+    cls.centerlines.resize(numCenterlines);
 
-    if (!file.good())
+    for (Centerline& cl: cls.centerlines)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+        read_value(file, cl.num_points);
+        read_vector(file, cl.points, num_values(cl.num_points, 3));
+        read_vector(file, cl.radii, cl.num_points);
 
-    std::vector<double> dbuffer;
+        //------------------------------------------------------------------------------------------------------
+        // local coordinate system (xyz vector) per point
+        // - x/y are vectors in vessel's cross-section
+        // - z is parallel to the centerline tangent
+        //------------------------------------------------------------------------------------------------------
+        read_vector(file, cl.local_coordinate_systems, num_values(cl.num_points, 9));
+    } // for cl: num centerlines
 
-    //------------------------------------------------------------------------------------------------------
-    // num centerlines
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numCenterlines = 0;
-    file.read(reinterpret_cast<char*>(&numCenterlines), sizeof(std::uint32_t));
-    _res << "\t- num. centerlines: " << numCenterlines << std::endl;
+    return cls;
+}
 
-    for (unsigned int clid = 0; clid < numCenterlines; ++clid)
+void ImporterScientific::report(const CenterlinesData& cls)
+{
+    _res << "\t- num. centerlines: " << cls.centerlines.size() << std::endl;
+
+    for (unsigned int clid = 0; clid < std::min(NUM_DEMO, static_cast<unsigned int>(cls.centerlines.size())); ++clid)
     {
-        //------------------------------------------------------------------------------------------------------
-        // num points
-        //------------------------------------------------------------------------------------------------------
-        std::uint32_t numPoints = 0;
-        file.read(reinterpret_cast<char*>(&numPoints), sizeof(std::uint32_t));
-        if (clid < NUM_DEMO)
-        { _res << "\t\t- num. points of centerline " << clid << ": " << numPoints << std::endl; }
+        const Centerline& cl = cls.centerlines[clid];
+        const unsigned int numPoints = cl.num_points;
+
+        _res << "\t\t- num. points of centerline " << clid << ": " << numPoints << std::endl;
 
         //------------------------------------------------------------------------------------------------------
         // list of points
         //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(numPoints * 3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-
-        if (clid < NUM_DEMO)
+        for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
         {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            {
-                const unsigned int off = pointid * 3;
-                _res << "\t\t\t- point" << pointid << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
-            }
-            _res << "\t\t\t- ..." << std::endl;
+            const unsigned int off = pointid * 3;
+            _res << "\t\t\t- point" << pointid << ": [" << cl.points[off] << ", " << cl.points[off + 1] << ", " << cl.points[off + 2] << "]" << std::endl;
         }
+        _res << "\t\t\t- ..." << std::endl;
 
         //------------------------------------------------------------------------------------------------------
         // vessel radius estimation per point
         //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(numPoints);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-
-        if (clid < NUM_DEMO)
-        {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            { _res << "\t\t\t- point" << pointid << " vessel radius [mm]: " << dbuffer[pointid] << std::endl; }
-            _res << "\t\t\t- ..." << std::endl;
-        }
+        for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
+        { _res << "\t\t\t- point" << pointid << " vessel radius [mm]: " << cl.radii[pointid] << std::endl; }
+        _res << "\t\t\t- ..." << std::endl;
 
         //------------------------------------------------------------------------------------------------------
         // local coordinate system (xyz vector) per point
-        // - x/y are vectors in vessel's cross-section
-        // - z is parallel to the centerline tangent
         //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(numPoints * 9);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-
-        if (clid < NUM_DEMO)
+        const std::vector<double>& lcs = cl.local_coordinate_systems;
+        for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
         {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            {
-                const unsigned int off = pointid * 9;
-                _res << "\t\t\t- LCS at point" << pointid << ": ";
-                _res << "X=[" << dbuffer[off + 0] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "], ";
-                _res << "Y=[" << dbuffer[off + 3] << ", " << dbuffer[off + 4] << ", " << dbuffer[off + 5] << "], ";
-                _res << "Z=[" << dbuffer[off + 6] << ", " << dbuffer[off + 7] << ", " << dbuffer[off + 8] << "]" << std::endl;
-            }
-            _res << "\t\t\t- ..." << std::endl;
+            const unsigned int off = pointid * 9;
+            _res << "\t\t\t- LCS at point" << pointid << ": ";
+            _res << "X=[" << lcs[off + 0] << ", " << lcs[off + 1] << ", " << lcs[off + 2] << "], ";
+            _res << "Y=[" << lcs[off + 3] << ", " << lcs[off + 4] << ", " << lcs[off + 5] << "], ";
+            _res << "Z=[" << lcs[off + 6] << ", " << lcs[off + 7] << ", " << lcs[off + 8] << "]" << std::endl;
         }
+        _res << "\t\t\t- ..." << std::endl;
     } // for clid: num centerlines
+}
+
+std::optional<CenterlinesData> ImporterScientific::load_centerlines(std::string_view filepath) const
+{ return load_file(filepath, _parse_centerlines); }
+
+bool ImporterScientific::read_centerlines(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- vessel has no centerlines (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading centerlines (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
 
-    file.close();
+    report(_parse_centerlines(file));
 
     return true;
 }
 
-bool ImporterScientific::read_landmark_measuring_planes(std::string_view filepath)
+MeasuringPlane ImporterScientific::_parse_measuring_plane(std::istream& file, bool withArrays)
 {
     /*
-     * [1] x [uint32] : num measuring planes
-     * [1] x [uint32] : num measuring planes of land marks
-     * for num measuring planes
-     *      [measuring plane]
-     * for num measuring planes of land marks
-     *      [1] x [uint32] : land mark semantic
-     *      [measuring plane]
-     *
      * measuring plane:
+     * [1] x [uint8] : vessel id
      * [3] x [uint32] : grid size xyt
      * [3] x [double] : scale xyt
      * [3] x [double] : plane center xyz (world coordinates)
@@ -738,7 +1181,7 @@ bool ImporterScientific::read_landmark_measuring_planes(std::string_view filepat
      * [1] x [double] : flow_jet_high_velocity_at_fastest_time
      * [1] x [double] : mean_flow_jet_high_velocity_velocity_weighted
      * [size t * 3] x [double] : flow_jet_position_per_time
-     * [3] x [uint32] : numSamples for uncertainty calculation
+     * [1] x [uint32] : numSamples for uncertainty calculation
      * [numSamples] x [double] : samples_net_flow_volume
      * [numSamples] x [double] : samples_forward_flow_volume
      * [numSamples] x [double] : samples_backward_flow_volume
@@ -746,363 +1189,340 @@ bool ImporterScientific::read_landmark_measuring_planes(std::string_view filepat
      * [numSamples] x [double] : samples_cardiac_output
      */
 
-    std::uint8_t ui8temp = 0;
-    double dtemp = 0;
+    MeasuringPlane mp;
 
-    const auto readMeasuringPlane = [&](std::ifstream& file)
+    const auto read_payload = [&](auto& vec, std::uint64_t n)
     {
-        //------------------------------------------------------------------------------------------------------
-        // vessel id
-        //------------------------------------------------------------------------------------------------------
-        ui8temp = 0;
-        file.read(reinterpret_cast<char*>(&ui8temp), sizeof(std::uint8_t));
-        _res << "\t\t\t- vessel id: " << static_cast<int>(ui8temp) << std::endl;
+        if (withArrays)
+        { read_vector(file, vec, n); }
+        else
+        { skip(file, n * sizeof(vec[0])); }
+    };
 
-        //------------------------------------------------------------------------------------------------------
-        // grid size
-        //   - x/y [0,1] in the plane + time steps [2]
-        //------------------------------------------------------------------------------------------------------
-        std::vector<std::uint32_t> gridsize(3);
-        file.read(reinterpret_cast<char*>(gridsize.data()), gridsize.size() * sizeof(std::uint32_t));
-        _res << "\t\t\t- grid size: [" << gridsize[0] << ", " << gridsize[1] << ", " << gridsize[2] << "]" << std::endl;
+    read_value(file, mp.vessel_id);
 
-        //------------------------------------------------------------------------------------------------------
-        // voxel scale
-        //    - x/y [0,1] in the plane + temporal resolution [2]
-        //------------------------------------------------------------------------------------------------------
-        std::vector<double> dbuffer(3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- voxel scale: " << dbuffer[0] << " x " << dbuffer[1] << " [mm] / " << dbuffer[2] << " [ms]" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // grid size + voxel scale
+    //   - x/y [0,1] in the plane + time steps / temporal resolution [2]
+    //------------------------------------------------------------------------------------------------------
+    read_array(file, mp.size);
+    read_array(file, mp.scale);
 
-        //------------------------------------------------------------------------------------------------------
-        // center
-        //------------------------------------------------------------------------------------------------------
-        // dbuffer.resize(3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- center: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // center + local coordinate system
+    //   - orthonormal
+    //   - nx/ny in the plane; nz is normal
+    //------------------------------------------------------------------------------------------------------
+    read_array(file, mp.center);
+    read_array(file, mp.lcs_x);
+    read_array(file, mp.lcs_y);
+    read_array(file, mp.lcs_z);
 
-        //------------------------------------------------------------------------------------------------------
-        // local coordinate system
-        //   - orthonormal
-        //   - nx/ny in the plane; nz is normal
-        //------------------------------------------------------------------------------------------------------
-        // dbuffer.resize(3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- LCS X: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl;
+    read_value(file, mp.vessel_diameter);
 
-        // dbuffer.resize(3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- LCS Y: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // velocity vector per grid point
+    //    - already rotated for use in world space and venc-scaled
+    //------------------------------------------------------------------------------------------------------
+    const std::uint64_t numGridPoints = num_values(mp.size[0], mp.size[1], mp.size[2]);
+    read_payload(mp.flow_vectors, numGridPoints * 3);
 
-        // dbuffer.resize(3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- LCS Z: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // segmentation
+    //    - static seg.; not time-dependent
+    //------------------------------------------------------------------------------------------------------
+    read_payload(mp.segmentation, num_values(mp.size[0], mp.size[1]));
 
-        //------------------------------------------------------------------------------------------------------
-        // vessel diameter in mm
-        //------------------------------------------------------------------------------------------------------
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- vessel diameter: " << dtemp << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // axial + circumferential velocity per grid point
+    //------------------------------------------------------------------------------------------------------
+    read_payload(mp.axial_velocity, numGridPoints);
+    read_payload(mp.circumferential_velocity, numGridPoints);
 
-        //------------------------------------------------------------------------------------------------------
-        // velocity vector per grid point
-        //    - already rotated for use in world space and venc-scaled
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(gridsize[0] * gridsize[1] * gridsize[2] * 3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    //------------------------------------------------------------------------------------------------------
+    // stats
+    //------------------------------------------------------------------------------------------------------
+    read_value(file, mp.min_flow_rate_per_time);
+    read_value(file, mp.max_flow_rate_per_time);
+    read_value(file, mp.mean_flow_rate_per_time);
+    read_value(file, mp.median_flow_rate_per_time);
+    read_value(file, mp.forward_flow_volume);
+    read_value(file, mp.backward_flow_volume);
+    read_value(file, mp.net_flow_volume);
+    read_value(file, mp.percentaged_back_flow_volume);
+    read_value(file, mp.cardiac_output);
+    read_value(file, mp.max_velocity);
+    read_value(file, mp.min_velocity);
+    read_value(file, mp.mean_velocity);
+    read_value(file, mp.median_velocity);
+    read_value(file, mp.min_velocity_axial);
+    read_value(file, mp.max_velocity_axial);
+    read_value(file, mp.mean_velocity_axial);
+    read_value(file, mp.median_velocity_axial);
+    read_value(file, mp.min_velocity_circumferential);
+    read_value(file, mp.max_velocity_circumferential);
+    read_value(file, mp.mean_velocity_circumferential);
+    read_value(file, mp.median_velocity_circumferential);
+    read_value(file, mp.area_mm2);
 
-        unsigned int cnt = 0;
-        for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
-        {
-            for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
-            {
-                for (unsigned int t = 0; t < gridsize[2] && cnt < NUM_DEMO; ++t, ++cnt)
-                {
-                    const unsigned int off = x * gridsize[1] * gridsize[2] * 3 + y * gridsize[2] * 3 + t * 3;
-                    _res << "\t\t\t- flow vector " << cnt << ": [" << dbuffer[off] << ", " << dbuffer[off+1] << ", " << dbuffer[off+2] << "]" << std::endl;
-                } // for t
-            } // for y
-        } // for x
+    const unsigned int numTimes = mp.size[2];
+    read_payload(mp.flow_rate_per_time, numTimes);
+    read_payload(mp.areal_mean_velocity_per_time, numTimes);
+    read_payload(mp.areal_mean_velocity_axial_per_time, numTimes);
+    read_payload(mp.areal_mean_velocity_circumferential_per_time, numTimes);
 
-        //------------------------------------------------------------------------------------------------------
-        // segmentation
-        //    - static seg.; not time-dependent
-        //------------------------------------------------------------------------------------------------------
-        std::vector<std::uint8_t> ui8buffer(gridsize[0] * gridsize[1]);
-        file.read(reinterpret_cast<char*>(ui8buffer.data()), ui8buffer.size() * sizeof(std::uint8_t));
+    /*
+     * flow jet
+     */
+    read_payload(mp.flow_jet_angle_per_time, numTimes);
+    read_payload(mp.flow_jet_displacement_per_time, numTimes);
+    read_payload(mp.flow_jet_high_velocity_area_percent_per_time, numTimes);
+
+    read_value(file, mp.max_flow_jet_angle_per_time);
+    read_value(file, mp.min_flow_jet_angle_per_time);
+    read_value(file, mp.mean_flow_jet_angle_per_time);
+    read_value(file, mp.median_flow_jet_angle_per_time);
+    read_value(file, mp.flow_jet_angle_at_fastest_time);
+    read_value(file, mp.mean_flow_jet_angle_velocity_weighted);
+    read_value(file, mp.min_flow_jet_displacement_per_time);
+    read_value(file, mp.max_flow_jet_displacement_per_time);
+    read_value(file, mp.mean_flow_jet_displacement_per_time);
+    read_value(file, mp.median_flow_jet_displacement_per_time);
+    read_value(file, mp.flow_jet_displacement_at_fastest_time);
+    read_value(file, mp.mean_flow_jet_displacement_velocity_weighted);
+    read_value(file, mp.min_flow_jet_high_velocity_area_percent_per_time);
+    read_value(file, mp.max_flow_jet_high_velocity_area_percent_per_time);
+    read_value(file, mp.mean_flow_jet_high_velocity_area_percent_per_time);
+    read_value(file, mp.median_flow_jet_high_velocity_area_percent_per_time);
+    read_value(file, mp.flow_jet_high_velocity_at_fastest_time);
+    read_value(file, mp.mean_flow_jet_high_velocity_velocity_weighted);
+
+    read_payload(mp.flow_jet_position_per_time, num_values(numTimes, 3));
+
+    //------------------------------------------------------------------------------------------------------
+    // uncertainty
+    //------------------------------------------------------------------------------------------------------
+    read_value(file, mp.num_samples);
+    read_payload(mp.samples_net_flow_volume, mp.num_samples);
+    read_payload(mp.samples_forward_flow_volume, mp.num_samples);
+    read_payload(mp.samples_backward_flow_volume, mp.num_samples);
+    read_payload(mp.samples_percentaged_backward_flow_volume, mp.num_samples);
+    read_payload(mp.samples_cardiac_output, mp.num_samples);
+
+    return mp;
+}
 
-        cnt = 0;
-        for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
-        {
-            for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
-            {
-                const unsigned int off = x * gridsize[1] * +y;
-                _res << "\t\t\t- seg value " << cnt << ": " << ui8buffer[off] << std::endl;
-            } // for y
-        } // for x
+MeasuringPlanesData ImporterScientific::_parse_measuring_planes(std::istream& file)
+{
+    /*
+     * [1] x [uint32] : num measuring planes
+     * [1] x [uint32] : num measuring planes of land marks
+     * for num measuring planes
+     *      [measuring plane]
+     * for num measuring planes of land marks
+     *      [1] x [uint32] : land mark semantic
+     *      [measuring plane]
+     *
+     * (measuring plane: see _parse_measuring_plane())
+     */
 
-        //------------------------------------------------------------------------------------------------------
-        // axial velocity per grid point
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(gridsize[0] * gridsize[1] * gridsize[2]);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    MeasuringPlanesData mps;
 
-        cnt = 0;
-        for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
-        {
-            for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
-            {
-                for (unsigned int t = 0; t < gridsize[2] && cnt < NUM_DEMO; ++t, ++cnt)
-                {
-                    const unsigned int off = x * gridsize[1] * gridsize[2] + y * gridsize[2] + t;
-                    _res << "\t\t\t- axial velocity " << cnt << ": " << dbuffer[off] << std::endl;
-                } // for t
-            } // for y
-        } // for x
+    std::uint32_t numMeasuringPlanes = 0;
+    read_value(file, numMeasuringPlanes);
 
-        //------------------------------------------------------------------------------------------------------
-        // circumferential velocity per grid point
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(gridsize[0] * gridsize[1] * gridsize[2]);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    std::uint32_t numMeasuringPlanesOfLandMarks = 0;
+    read_value(file, numMeasuringPlanesOfLandMarks);
 
-        cnt = 0;
-        for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
-        {
-            for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
-            {
-                for (unsigned int t = 0; t < gridsize[2] && cnt < NUM_DEMO; ++t, ++cnt)
-                {
-                    const unsigned int off = x * gridsize[1] * gridsize[2] + y * gridsize[2] + t;
-                    _res << "\t\t\t- circumferential velocity " << cnt << ": " << dbuffer[off] << std::endl;
-                } // for t
-            } // for y
-        } // for x
-
-        //------------------------------------------------------------------------------------------------------
-        // stats
-        //------------------------------------------------------------------------------------------------------
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min flow rate per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max flow rate per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow rate per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median flow rate per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- forward flow volume" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- backward flow volume" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- net flow volume" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- percentaged back flow volume" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- cardiac output" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max velocity" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min velocity" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean velocity" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median velocity" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min velocity axial" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max velocity axial" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean velocity axial" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median velocity axial" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min velocity circumferential" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max velocity circumferential" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean velocity circumferential" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median velocity circumferential" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- area mm2" << std::endl;
-
-        dbuffer.resize(gridsize[2]);
-
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- flow rate per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- areal mean velocity per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- areal mean velocity axial per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- areal mean velocity circumferential per time" << std::endl;
-
-        /*
-         * flow jet
-         */
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- flow jet angle per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- flow jet displacement per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        _res << "\t\t\t- flow jet high velocity area percent per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max flow jet angle per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min flow jet angle per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow jet angle per time" << std::endl;
-
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median flow jet angle per time" << std::endl;
+    mps.planes.reserve(numMeasuringPlanes);
+    for (unsigned int i = 0; i < numMeasuringPlanes; ++i)
+    { mps.planes.emplace_back(_parse_measuring_plane(file)); }
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- flow jet angle at fastest time" << std::endl;
+    mps.landmark_semantics.resize(numMeasuringPlanesOfLandMarks);
+    mps.landmark_planes.reserve(numMeasuringPlanesOfLandMarks);
+    for (unsigned int i = 0; i < numMeasuringPlanesOfLandMarks; ++i)
+    {
+        read_value(file, mps.landmark_semantics[i]);
+        mps.landmark_planes.emplace_back(_parse_measuring_plane(file));
+    }
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow jet angle velocity weighted" << std::endl;
+    return mps;
+}
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min flow jet displacement per time" << std::endl;
+void ImporterScientific::report(const MeasuringPlane& mp)
+{
+    const std::array<std::uint32_t, 3>& gridsize = mp.size;
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max flow jet displacement per time" << std::endl;
+    _res << "\t\t\t- vessel id: " << static_cast<int>(mp.vessel_id) << std::endl;
+    _res << "\t\t\t- grid size: [" << gridsize[0] << ", " << gridsize[1] << ", " << gridsize[2] << "]" << std::endl;
+    _res << "\t\t\t- voxel scale: " << mp.scale[0] << " x " << mp.scale[1] << " [mm] / " << mp.scale[2] << " [ms]" << std::endl;
+    _res << "\t\t\t- center: [" << mp.center[0] << ", " << mp.center[1] << ", " << mp.center[2] << "]" << std::endl;
+    _res << "\t\t\t- LCS X: [" << mp.lcs_x[0] << ", " << mp.lcs_x[1] << ", " << mp.lcs_x[2] << "]" << std::endl;
+    _res << "\t\t\t- LCS Y: [" << mp.lcs_y[0] << ", " << mp.lcs_y[1] << ", " << mp.lcs_y[2] << "]" << std::endl;
+    _res << "\t\t\t- LCS Z: [" << mp.lcs_z[0] << ", " << mp.lcs_z[1] << ", " << mp.lcs_z[2] << "]" << std::endl;
+    _res << "\t\t\t- vessel diameter: " << mp.vessel_diameter << std::endl;
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow jet displacement per time" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // velocity vector per grid point
+    //------------------------------------------------------------------------------------------------------
+    unsigned int cnt = 0;
+    for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
+    {
+        for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
+        {
+            for (unsigned int t = 0; t < gridsize[2] && cnt < NUM_DEMO; ++t, ++cnt)
+            {
+                const std::uint64_t off = num_values(x, gridsize[1], gridsize[2], 3) + num_values(y, gridsize[2], 3) + t * 3;
+                _res << "\t\t\t- flow vector " << cnt << ": [" << mp.flow_vectors[off] << ", " << mp.flow_vectors[off + 1] << ", " << mp.flow_vectors[off + 2] << "]" << std::endl;
+            } // for t
+        } // for y
+    } // for x
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median flow jet displacement per time" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // segmentation
+    //------------------------------------------------------------------------------------------------------
+    cnt = 0;
+    for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
+    {
+        for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
+        {
+            const std::uint64_t off = num_values(x, gridsize[1], y);
+            _res << "\t\t\t- seg value " << cnt << ": " << mp.segmentation[off] << std::endl;
+        } // for y
+    } // for x
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- flow jet displacement at fastest time" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // axial + circumferential velocity per grid point
+    //------------------------------------------------------------------------------------------------------
+    const auto report_scalar_per_grid_point = [&](std::string_view name, const std::vector<double>& v)
+    {
+        unsigned int n = 0;
+        for (unsigned int x = 0; x < gridsize[0] && n < NUM_DEMO; ++x)
+        {
+            for (unsigned int y = 0; y < gridsize[1] && n < NUM_DEMO; ++y)
+            {
+                for (unsigned int t = 0; t < gridsize[2] && n < NUM_DEMO; ++t, ++n)
+                {
+                    const std::uint64_t off = num_values(x, gridsize[1], gridsize[2]) + num_values(y, gridsize[2]) + t;
+                    _res << "\t\t\t- " << name << " " << n << ": " << v[off] << std::endl;
+                } // for t
+            } // for y
+        } // for x
+    };
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow jet displacement velocity weighted" << std::endl;
+    report_scalar_per_grid_point("axial velocity", mp.axial_velocity);
+    report_scalar_per_grid_point("circumferential velocity", mp.circumferential_velocity);
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- min flow jet high velocity area percent per time" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // stats
+    //------------------------------------------------------------------------------------------------------
+    for (std::string_view name: {"min flow rate per time", "max flow rate per time", "mean flow rate per time", "median flow rate per time", "forward flow volume", "backward flow volume", "net flow volume", "percentaged back flow volume", "cardiac output", "max velocity", "min velocity", "mean velocity", "median velocity", "min velocity axial", "max velocity axial", "mean velocity axial", "median velocity axial", "min velocity circumferential", "max velocity circumferential", "mean velocity circumferential", "median velocity circumferential", "area mm2", "flow rate per time", "areal mean velocity per time", "areal mean velocity axial per time", "areal mean velocity circumferential per time", "flow jet angle per time", "flow jet displacement per time", "flow jet high velocity area percent per time", "max flow jet angle per time", "min flow jet angle per time", "mean flow jet angle per time", "median flow jet angle per time", "flow jet angle at fastest time", "mean flow jet angle velocity weighted", "min flow jet displacement per time", "max flow jet displacement per time", "mean flow jet displacement per time", "median flow jet displacement per time", "flow jet displacement at fastest time", "mean flow jet displacement velocity weighted", "min flow jet high velocity area percent per time", "max flow jet high velocity area percent per time", "mean flow jet high velocity area percent per time", "median flow jet high velocity area percent per time", "flow jet high velocity at fastest time", "mean flow jet high velocity velocity weighted"})
+    { _res << "\t\t\t- " << name << std::endl; }
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- max flow jet high velocity area percent per time" << std::endl;
+    for (unsigned int t = 0; t < std::min(NUM_DEMO, gridsize[2]); ++t)
+    {
+        const unsigned int off = t * 3;
+        _res << "\t\t\t- flow jet position per time " << t << ": [" << mp.flow_jet_position_per_time[off] << ", " << mp.flow_jet_position_per_time[off + 1] << ", " << mp.flow_jet_position_per_time[off + 2] << "]" << std::endl;
+    }
+    _res << "\t\t\t- ..." << std::endl;
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow jet high velocity area percent per time" << std::endl;
+    //------------------------------------------------------------------------------------------------------
+    // uncertainty
+    //------------------------------------------------------------------------------------------------------
+    const auto report_samples = [&](std::string_view name, const std::vector<double>& v)
+    {
+        _res << "\t\t\t- samples " << name << ": ";
+        for (unsigned int i = 0; i < NUM_DEMO; ++i)
+        { _res << v[i] << ", "; }
+        _res << "..." << std::endl;
+    };
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- median flow jet high velocity area percent per time" << std::endl;
+    report_samples("net flow volume", mp.samples_net_flow_volume);
+    report_samples("forward flow volume", mp.samples_forward_flow_volume);
+    report_samples("backward flow volume", mp.samples_backward_flow_volume);
+    report_samples("percentaged backward flow volume", mp.samples_percentaged_backward_flow_volume);
+    report_samples("cardiac output", mp.samples_cardiac_output);
+}
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- flow jet high velocity at fastest time" << std::endl;
+void ImporterScientific::report(const MeasuringPlanesData& mps)
+{
+    *_console << "\t\t- num. measuring planes: " << mps.planes.size() << std::endl;
+    *_console << "\t\t- num. measuring planes of landmarks: " << mps.landmark_planes.size() << std::endl;
 
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t\t- mean flow jet high velocity velocity weighted" << std::endl;
+    for (unsigned int i = 0; i < mps.planes.size(); ++i)
+    {
+        *_console << "\t\t- measuring plane " << i << ": " << std::endl;
+        report(mps.planes[i]);
+    }
 
-        dbuffer.resize(gridsize[2] * 3);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    for (unsigned int i = 0; i < mps.landmark_planes.size(); ++i)
+    {
+        *_console << "\t\t- measuring plane " << i << " of landmarks: " << std::endl;
 
-        for (unsigned int t = 0; t < gridsize[2]; ++t)
+        const std::uint32_t semantic = mps.landmark_semantics[i];
+        *_console << "\t\t\t- semantic: " << semantic << " (";
+        switch (semantic)
         {
-            if (t < NUM_DEMO)
-            {
-                const unsigned int off = t * 3;
-                _res << "\t\t\t- flow jet position per time " << t << ": [" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
-            }
+            case 1: *_console << "LandMarkSemantic_Aorta_AboveAorticValve"; break;
+            case 2: *_console << "LandMarkSemantic_Aorta_MidAscendingAorta"; break;
+            case 3: *_console << "LandMarkSemantic_Aorta_BeforeBrachiocephalicArtery"; break;
+            case 4: *_console << "LandMarkSemantic_Aorta_BetweenLeftCommonCarotid_and_LeftSubclavianArtery"; break;
+            case 5: *_console << "LandMarkSemantic_Aorta_DistalToLeftSubclavianArtery"; break;
+            case 6: *_console << "LandMarkSemantic_Aorta_MidDescendingAorta"; break;
+            case 7: *_console << "LandMarkSemantic_PulmonaryArtery_AbovePulmonaryValve"; break;
+            case 8: *_console << "LandMarkSemantic_PulmonaryArtery_BeforeJunction"; break;
+            case 9: *_console << "LandMarkSemantic_PulmonaryArtery_LeftPulmonaryArtery_Begin"; break;
+            case 10: *_console << "LandMarkSemantic_PulmonaryArtery_RightPulmonaryArtery_Begin"; break;
+            default: *_console << "None";
         }
-        _res << "\t\t\t- ..." << std::endl;
+        *_console << ")" << std::endl;
 
-        //------------------------------------------------------------------------------------------------------
-        // uncertainty
-        //------------------------------------------------------------------------------------------------------
-        /*
-         * numSamples
-         */
-        std::uint32_t numSamples = 0;
-        file.read(reinterpret_cast<char*>(&numSamples), sizeof(std::uint32_t));
+        report(mps.landmark_planes[i]);
+    }
+}
 
-        dbuffer.resize(numSamples);
+std::optional<MeasuringPlanesData> ImporterScientific::load_landmark_measuring_planes(std::string_view filepath) const
+{ return load_file(filepath, _parse_measuring_planes); }
 
-        /*
-         * samples: net flow volume
-         */
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+std::optional<MeasuringPlanesIndex> ImporterScientific::load_measuring_planes_index(std::string_view filepath) const
+{ return load_file(filepath, _scan_measuring_planes); }
 
-        _res << "\t\t\t- samples net flow volume: ";
-        for (unsigned int i = 0; i < NUM_DEMO; ++i)
-        { _res << dbuffer[i] << ", "; }
-        _res << "..." << std::endl;
+std::optional<MeasuringPlane> ImporterScientific::load_measuring_plane(std::string_view filepath, const MeasuringPlaneRecord& record, bool summaryOnly) const
+{
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
-        /*
-         * samples: forward flow volume
-         */
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    if (!file.good())
+    { return std::nullopt; }
 
-        _res << "\t\t\t- samples forward flow volume: ";
-        for (unsigned int i = 0; i < NUM_DEMO; ++i)
-        { _res << dbuffer[i] << ", "; }
-        _res << "..." << std::endl;
+    file.seekg(static_cast<std::streamoff>(record.offset));
+    MeasuringPlane mp = _parse_measuring_plane(file, !summaryOnly);
 
-        /*
-         * samples: backward flow volume
-         */
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    if (file.fail())
+    { return std::nullopt; }
 
-        _res << "\t\t\t- samples backward flow volume: ";
-        for (unsigned int i = 0; i < NUM_DEMO; ++i)
-        { _res << dbuffer[i] << ", "; }
-        _res << "..." << std::endl;
+    return mp;
+}
 
-        /*
-         * samples: percentaged back flow volume
-         */
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+std::optional<MeasuringPlane> ImporterScientific::load_measuring_plane(std::string_view filepath, const MeasuringPlanesIndex& index, std::size_t planeId, bool summaryOnly) const
+{
+    if (planeId >= index.planes.size())
+    { return std::nullopt; }
 
-        _res << "\t\t\t- samples percentaged backward flow volume: ";
-        for (unsigned int i = 0; i < NUM_DEMO; ++i)
-        { _res << dbuffer[i] << ", "; }
-        _res << "..." << std::endl;
+    return load_measuring_plane(filepath, index.planes[planeId], summaryOnly);
+}
 
-        /*
-         * samples: cardiac output
-         */
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+std::optional<MeasuringPlane> ImporterScientific::load_landmark_measuring_plane(std::string_view filepath, const MeasuringPlanesIndex& index, std::uint32_t semantic, bool summaryOnly) const
+{
+    const MeasuringPlaneRecord* record = index.find_landmark(semantic);
+    if (record == nullptr)
+    { return std::nullopt; }
 
-        _res << "\t\t\t- samples cardiac output: ";
-        for (unsigned int i = 0; i < NUM_DEMO; ++i)
-        { _res << dbuffer[i] << ", "; }
-        _res << "..." << std::endl;
-    }; // readMeasuringPlane()
+    return load_measuring_plane(filepath, *record, summaryOnly);
+}
 
+bool ImporterScientific::read_landmark_measuring_planes(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
     if (!std::filesystem::exists(filepath.data()))
     {
@@ -1121,61 +1541,16 @@ bool ImporterScientific::read_landmark_measuring_planes(std::string_view filepat
         return false;
     }
 
-    // num measuring planes
-    std::uint32_t numMeasuringPlanes = 0;
-    file.read(reinterpret_cast<char*>(&numMeasuringPlanes), sizeof(std::uint32_t));
-    std::cout << "\t\t- num. measuring planes: " << numMeasuringPlanes << std::endl;
-
-    // num measuring planes of land marks
-    std::uint32_t numMeasuringPlanesOfLandMarks = 0;
-    file.read(reinterpret_cast<char*>(&numMeasuringPlanesOfLandMarks), sizeof(std::uint32_t));
-    std::cout << "\t\t- num. measuring planes of landmarks: " << numMeasuringPlanesOfLandMarks << std::endl;
-
-    // measuring planes
-    for (unsigned int i = 0; i < numMeasuringPlanes; ++i)
-    {
-        std::cout << "\t\t- measuring plane " <<i<<": "<< std::endl;
-        readMeasuringPlane(file);
-    }
-
-    // measuring planes of land marks
-    for (unsigned int i = 0; i < numMeasuringPlanesOfLandMarks; ++i)
-    {
-        std::cout << "\t\t- measuring plane " <<i<<" of landmarks: "<< std::endl;
-
-        std::uint32_t semantic = 0;
-        file.read(reinterpret_cast<char*>(&semantic), sizeof(std::uint32_t));
-
-        std::cout << "\t\t\t- semantic: " << semantic << " (";
-        switch (semantic)
-        {
-            case 1: std::cout << "LandMarkSemantic_Aorta_AboveAorticValve"; break;
-            case 2: std::cout << "LandMarkSemantic_Aorta_MidAscendingAorta"; break;
-            case 3: std::cout << "LandMarkSemantic_Aorta_BeforeBrachiocephalicArtery"; break;
-            case 4: std::cout << "LandMarkSemantic_Aorta_BetweenLeftCommonCarotid_and_LeftSubclavianArtery"; break;
-            case 5: std::cout << "LandMarkSemantic_Aorta_DistalToLeftSubclavianArtery"; break;
-            case 6: std::cout << "LandMarkSemantic_Aorta_MidDescendingAorta"; break;
-            case 7: std::cout << "LandMarkSemantic_PulmonaryArtery_AbovePulmonaryValve"; break;
-            case 8: std::cout << "LandMarkSemantic_PulmonaryArtery_BeforeJunction"; break;
-            case 9: std::cout << "LandMarkSemantic_PulmonaryArtery_LeftPulmonaryArtery_Begin"; break;
-            case 10: std::cout << "LandMarkSemantic_PulmonaryArtery_RightPulmonaryArtery_Begin"; break;
-            default: std::cout << "None";
-        }
-        std::cout << ")" << std::endl;
-
-        readMeasuringPlane(file);
-    }
-
-    file.close();
+    report(_parse_measuring_planes(file));
 
     return true;
 }
 
-bool ImporterScientific::read_pathlines(std::string_view filepath)
+PathlinesData ImporterScientific::_parse_pathlines(std::istream& file)
 {
     /*
      *             [1] x [uint32] : numPathlines
-     *             
+     *
      *  for numPathlines
      *                  [1] x [uint32] : numPoints
      *      [numPoints * 4] x [double] : list of points (xyz+time)
@@ -1187,140 +1562,164 @@ bool ImporterScientific::read_pathlines(std::string_view filepath)
      *                  [1] x [double] : attribute : length
      */
 
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- vessel has no pathlines (path \"" << filepath.data() << "\")" << std::endl;
-        _res.flush();
-        return false;
-    }
+    PathlinesData pls;
 
-    _res << "\t- reading pathlines (path \"" << filepath.data() << "\")" << std::endl;
+    std::uint32_t numPathlines = 0;
+    read_value(file, numPathlines);
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    //------------------------------------------------------------------------------------------------------
+    // pass 1: point counts -> offsets (payloads are skipped); a truncated file yields the pathlines that fit completely
+    //------------------------------------------------------------------------------------------------------
+    constexpr std::uint64_t perPathlineNumBytes = sizeof(std::uint32_t) + sizeof(double); // numPoints + length
+    constexpr std::uint64_t perPointNumBytes = (4 + 5) * sizeof(double); // x y z t + attributes
 
-    if (!file.good())
+    const std::istream::pos_type begin = file.tellg();
+    std::uint64_t remainingNumBytes = remaining_num_bytes(file);
+
+    pls.offsets.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(numPathlines, remainingNumBytes / perPathlineNumBytes)) + 1);
+
+    for (std::uint32_t plid = 0; plid < numPathlines; ++plid)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+        std::uint32_t numPoints = 0;
+        read_value(file, numPoints);
+
+        const std::uint64_t numBytes = perPathlineNumBytes + numPoints * perPointNumBytes;
+        if (!file.good() || numBytes > remainingNumBytes)
+        { break; }
 
-    std::vector<double> dbuffer;
+        remainingNumBytes -= numBytes;
+        skip(file, numBytes - sizeof(std::uint32_t));
+
+        pls.offsets.push_back(pls.offsets.back() + numPoints);
+    } // for plid: num pathlines
 
     //------------------------------------------------------------------------------------------------------
-    // num pathlines
+    // pass 2: every column is sized once and filled in place
     //------------------------------------------------------------------------------------------------------
-    std::uint32_t numPathines = 0;
-    file.read(reinterpret_cast<char*>(&numPathines), sizeof(std::uint32_t));
-    _res << "\t- num. pathlines: " << numPathines << std::endl;
+    file.clear();
+    file.seekg(begin);
+
+    for (std::vector<double>* column: {&pls.x, &pls.y, &pls.z, &pls.t, &pls.pressure, &pls.cos_angle_to_centerline, &pls.rotation_direction, &pls.velocity, &pls.axial_velocity})
+    { column->resize(pls.num_points()); }
+
+    pls.length.resize(pls.num_pathlines());
 
-    for (unsigned int plid = 0; plid < numPathines; ++plid)
+    // x y z t are interleaved per point in the file -> split in blocks
+    constexpr std::size_t blockNumPoints = 1 << 14;
+    std::vector<double> points(std::min<std::size_t>(blockNumPoints, pls.num_points()) * 4);
+
+    for (std::size_t plid = 0; plid < pls.num_pathlines(); ++plid)
     {
-        //------------------------------------------------------------------------------------------------------
-        // num points
-        //------------------------------------------------------------------------------------------------------
-        std::uint32_t numPoints = 0;
-        file.read(reinterpret_cast<char*>(&numPoints), sizeof(std::uint32_t));
-        if (plid < NUM_DEMO)
-        { _res << "\t\t- num. points of pathline" << plid << ": " << numPoints << std::endl; }
+        skip(file, sizeof(std::uint32_t)); // numPoints
 
-        //------------------------------------------------------------------------------------------------------
-        // list of points (xyz + time)
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(numPoints * 4); // x y z time
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+        const std::size_t first = pls.offsets[plid];
+        const std::size_t numPoints = pls.num_points(plid);
 
-        if (plid < NUM_DEMO)
+        for (std::size_t i = 0; i < numPoints; i += blockNumPoints)
         {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
+            const std::size_t n = std::min(blockNumPoints, numPoints - i);
+            BulkRead::read(file, points.data(), n * 4 * sizeof(double));
+
+            for (std::size_t k = 0; k < n; ++k)
             {
-                const unsigned int off = pointid * 4;
-                _res << "\t\t\t- point" << pointid << ": [" << /*x=*/dbuffer[off] << ", " << /*y=*/dbuffer[off + 1] << ", " << /*z=*/dbuffer[off + 2] << ", " << /*t=*/dbuffer[off + 3] << "]"
-                     << std::endl;
+                pls.x[first + i + k] = points[k * 4];
+                pls.y[first + i + k] = points[k * 4 + 1];
+                pls.z[first + i + k] = points[k * 4 + 2];
+                pls.t[first + i + k] = points[k * 4 + 3];
             }
-            _res << "\t\t\t- ..." << std::endl;
         }
 
-        //------------------------------------------------------------------------------------------------------
-        // attribute: relative pressure per point
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(numPoints);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+        for (std::vector<double>* column: {&pls.pressure, &pls.cos_angle_to_centerline, &pls.rotation_direction, &pls.velocity, &pls.axial_velocity})
+        { BulkRead::read(file, column->data() + first, numPoints * sizeof(double)); }
 
-        if (plid < NUM_DEMO)
-        {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            { _res << "\t\t\t- relative pressure [mmHg] of point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-            _res << "\t\t\t- ..." << std::endl;
-        }
+        read_value(file, pls.length[plid]);
+    } // for plid: num pathlines
 
-        //------------------------------------------------------------------------------------------------------
-        // attribute: cos(angle) between pathline tangent and centerline per point
-        //------------------------------------------------------------------------------------------------------
-        //dbuffer.resize(numPoints);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    return pls;
+}
 
-        if (plid < NUM_DEMO)
-        {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            { _res << "\t\t\t- cos(angle) pathline/centerline tangent of point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-            _res << "\t\t\t- ..." << std::endl;
-        }
+void ImporterScientific::report(const PathlinesData& pls)
+{
+    _res << "\t- num. pathlines: " << pls.num_pathlines() << std::endl;
 
-        //------------------------------------------------------------------------------------------------------
-        // attribute: rotation direction per point
-        //------------------------------------------------------------------------------------------------------
-        //dbuffer.resize(numPoints);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    const auto report_attribute = [&](std::string_view name, const double* v, unsigned int numPoints)
+    {
+        for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
+        { _res << "\t\t\t- " << name << pointid << ": " << v[pointid] << std::endl; }
+        _res << "\t\t\t- ..." << std::endl;
+    };
 
-        if (plid < NUM_DEMO)
-        {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            { _res << "\t\t\t- rotation direction of point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-            _res << "\t\t\t- ..." << std::endl;
-        }
+    for (unsigned int plid = 0; plid < std::min(NUM_DEMO, static_cast<unsigned int>(pls.num_pathlines())); ++plid)
+    {
+        const std::size_t first = pls.offsets[plid];
+        const unsigned int numPoints = static_cast<unsigned int>(pls.num_points(plid));
 
-        //------------------------------------------------------------------------------------------------------
-        // attribute: velocity per point
-        //------------------------------------------------------------------------------------------------------
-        //dbuffer.resize(numPoints);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+        _res << "\t\t- num. points of pathline" << plid << ": " << numPoints << std::endl;
 
-        if (plid < NUM_DEMO)
+        for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
         {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            { _res << "\t\t\t- velocity [m/s] at point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-            _res << "\t\t\t- ..." << std::endl;
+            const std::size_t off = first + pointid;
+            _res << "\t\t\t- point" << pointid << ": [" << pls.x[off] << ", " << pls.y[off] << ", " << pls.z[off] << ", " << pls.t[off] << "]" << std::endl;
         }
+        _res << "\t\t\t- ..." << std::endl;
 
-        //------------------------------------------------------------------------------------------------------
-        // attribute: axial velocity per point
-        //------------------------------------------------------------------------------------------------------
-        //dbuffer.resize(numPoints);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+        report_attribute("relative pressure [mmHg] of point", pls.pressure.data() + first, numPoints);
+        report_attribute("cos(angle) pathline/centerline tangent of point", pls.cos_angle_to_centerline.data() + first, numPoints);
+        report_attribute("rotation direction of point", pls.rotation_direction.data() + first, numPoints);
+        report_attribute("velocity [m/s] at point", pls.velocity.data() + first, numPoints);
+        report_attribute("axial velocity [m/s] at point", pls.axial_velocity.data() + first, numPoints);
 
-        if (plid < NUM_DEMO)
-        {
-            for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, numPoints); ++pointid)
-            { _res << "\t\t\t- axial velocity [m/s] at point" << pointid << ": " << dbuffer[pointid] << std::endl; }
-            _res << "\t\t\t- ..." << std::endl;
-        }
+        _res << "\t\t\t- spatial length [mm]: " << pls.length[plid] << std::endl;
+    } // for plid: num pathlines
+}
 
-        //------------------------------------------------------------------------------------------------------
-        // pathline length (spatial; temporal component is ignored)
-        //------------------------------------------------------------------------------------------------------
-        double length = 0;
-        file.read(reinterpret_cast<char*>(&length), sizeof(double));
+std::optional<PathlinesData> ImporterScientific::load_pathlines(std::string_view filepath) const
+{ return load_file(filepath, _parse_pathlines); }
 
-        if (plid < NUM_DEMO)
-        { _res << "\t\t\t- spatial length [mm]: " << length << std::endl; }
-    } // for plid: num pathlines
+bool ImporterScientific::read_pathlines(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- vessel has no pathlines (path \"" << filepath.data() << "\")" << std::endl;
+        _res.flush();
+        return false;
+    }
+
+    _res << "\t- reading pathlines (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
 
-    file.close();
+    report(_parse_pathlines(file));
 
     return true;
 }
 
-bool ImporterScientific::read_flowfield(std::string_view filepath)
+FlowFieldHeader ImporterScientific::_parse_flowfield_header(std::istream& file)
+{
+    FlowFieldHeader header;
+
+    read_array(file, header.size);
+    read_array(file, header.scale);
+    read_array(file, header.world_matrix);
+    read_array(file, header.inverse_world_matrix);
+    read_array(file, header.world_matrix_with_time);
+    read_array(file, header.inverse_world_matrix_with_time);
+    read_array(file, header.rotation_matrix);
+    read_array(file, header.inverse_rotation_matrix);
+
+    return header;
+}
+
+template<typename T>
+BasicFlowFieldData<T> ImporterScientific::_parse_flowfield(std::istream& file)
 {
     /*
      *                                 [4] x [uint32] : size x y z t
@@ -1334,171 +1733,129 @@ bool ImporterScientific::read_flowfield(std::string_view filepath)
      * [sizeX * sizeY * sizeZ * sizeT * 3] x [double] : flow vectors (rotated in world coordinates)
      */
 
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- no flow field (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
-
-    _res << "\t- reading flow field (path \"" << filepath.data() << "\")" << std::endl;
-
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
-
-    if (!file.good())
-    {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+    BasicFlowFieldData<T> ff;
+    ff.header = _parse_flowfield_header(file);
 
     //------------------------------------------------------------------------------------------------------
-    // grid size x y z t
+    // flow vectors
+    // - already rotated in world coordinates
+    // - already venc-scaled
     //------------------------------------------------------------------------------------------------------
-    std::vector<std::uint32_t> gridsize(4);
-    file.read(reinterpret_cast<char*>(gridsize.data()), gridsize.size() * sizeof(std::uint32_t));
-    _res << "\t\t- grid size: " << gridsize[0] << " x " << gridsize[1] << " x " << gridsize[2] << " x " << gridsize[3] << std::endl;
+    const std::array<std::uint32_t, 4>& gridsize = ff.header.size;
+    read_payload(file, ff.vectors, num_values(gridsize[0], gridsize[1], gridsize[2], gridsize[3], 3), "flow vectors", ff.narrowing_errors);
 
-    //------------------------------------------------------------------------------------------------------
-    // voxel scale x y z t
-    //------------------------------------------------------------------------------------------------------
-    std::vector<double> dbuffer(4);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-    _res << "\t\t- voxel scale: " << dbuffer[0] << " x " << dbuffer[1] << " x " << dbuffer[2] << " mm / " << dbuffer[3] << " ms" << std::endl;
+    return ff;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // world matrix (4x4 from dicom)
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(16); // 4 x 4
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+void ImporterScientific::_report_flowfield_header(const FlowFieldHeader& header)
+{
+    _res << "\t\t- grid size: " << header.size[0] << " x " << header.size[1] << " x " << header.size[2] << " x " << header.size[3] << std::endl;
+    _res << "\t\t- voxel scale: " << header.scale[0] << " x " << header.scale[1] << " x " << header.scale[2] << " mm / " << header.scale[3] << " ms" << std::endl;
+
+    _report_matrix("\t\t", "world matrix", header.world_matrix.data(), 4);
+    _report_matrix("\t\t", "inverse world matrix", header.inverse_world_matrix.data(), 4);
+    _report_matrix("\t\t", "world matrix with time", header.world_matrix_with_time.data(), 5);
+    _report_matrix("\t\t", "inverse world matrix with time", header.inverse_world_matrix_with_time.data(), 5);
+    _report_matrix("\t\t", "rotational part of world matrix", header.rotation_matrix.data(), 3);
+    _report_matrix("\t\t", "inverse rotational part of world matrix", header.inverse_rotation_matrix.data(), 3);
+}
+
+template<typename T>
+void ImporterScientific::_report_flowfield_vectors(const FlowFieldHeader& header, const T* vectors)
+{
+    const std::array<std::uint32_t, 4>& gridsize = header.size;
 
     unsigned int cnt = 0;
-    _res << "\t\t- world matrix:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 4; ++rowid)
+    unsigned int cntDemo = 0;
+    for (unsigned int x = 0; x < gridsize[0] && cntDemo < NUM_DEMO; ++x)
     {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 4; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
-
-        _res << std::endl;
+        for (unsigned int y = 0; y < gridsize[1] && cntDemo < NUM_DEMO; ++y)
+        {
+            for (unsigned int z = 0; z < gridsize[2] && cntDemo < NUM_DEMO; ++z)
+            {
+                for (unsigned int t = 0; t < gridsize[3] && cntDemo < NUM_DEMO; ++t, ++cntDemo)
+                {
+                    const std::uint64_t off = num_values(x, gridsize[1], gridsize[2], gridsize[3], 3) + num_values(y, gridsize[2], gridsize[3], 3) + num_values(z, gridsize[3], 3) + t * 3;
+                    _res << "\t\t- flow vector" << (cnt++) << " [m/s]: " << "[" << vectors[off] << ", " << vectors[off + 1] << ", " << vectors[off + 2] << "]" << std::endl;
+                }
+            }
+        }
     }
+    _res << "\t\t- ..." << std::endl;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // inverse world matrix
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(16); // 4 x 4
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-
-    cnt = 0;
-    _res << "\t\t- inverse world matrix:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 4; ++rowid)
-    {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 4; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+template<typename T>
+void ImporterScientific::_report_flowfield(const BasicFlowFieldData<T>& ff)
+{
+    _report_flowfield_header(ff.header);
+    _report_flowfield_vectors(ff.header, ff.vectors.data());
+    _report_narrowing_errors("\t\t", ff.narrowing_errors);
+}
 
-        _res << std::endl;
-    }
+void ImporterScientific::report(const FlowFieldData& ff)
+{ _report_flowfield(ff); }
 
-    //------------------------------------------------------------------------------------------------------
-    // world matrix with time (5x5 including time in 4th row/col)
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(25); // 5 x 5
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+void ImporterScientific::report(const FlowFieldDataF& ff)
+{ _report_flowfield(ff); }
 
-    cnt = 0;
-    _res << "\t\t- world matrix with time:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 5; ++rowid)
-    {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 5; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+std::optional<FlowFieldData> ImporterScientific::load_flowfield(std::string_view filepath) const
+{ return load_file(filepath, _parse_flowfield<double>, _async_io); }
 
-        _res << std::endl;
-    }
+std::optional<FlowFieldDataF> ImporterScientific::load_flowfield_single_precision(std::string_view filepath) const
+{ return load_file(filepath, _parse_flowfield<float>, _async_io); }
 
-    //------------------------------------------------------------------------------------------------------
-    // inverse world matrix with time
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(25); // 5 x 5
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+bool ImporterScientific::_read_flowfield_memory_mapped(std::string_view filepath)
+{
+    FlowFieldView view;
 
-    cnt = 0;
-    _res << "\t\t- inverse world matrix with time:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 5; ++rowid)
+    if (!view.open(filepath))
     {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 5; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
-
-        _res << std::endl;
+        _res << "\t\tFAILED! Could not map file!" << std::endl;
+        return false;
     }
 
-    //------------------------------------------------------------------------------------------------------
-    // rotational part of world matrix (3x3; used to transform velocity vectors to world space)
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(9); // 3 x 3
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-
-    cnt = 0;
-    _res << "\t\t- rotational part of world matrix:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 3; ++rowid)
-    {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 3; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
+    // only the demo voxels are touched, i.e., only their pages are read from disk
+    _report_flowfield_header(view.header());
+    _report_flowfield_vectors(view.header(), view.data());
 
-        _res << std::endl;
-    }
+    return true;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // inverse rotational part of world matrix
-    //------------------------------------------------------------------------------------------------------
-    //dbuffer.resize(9); // 3 x 3
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+bool ImporterScientific::read_flowfield(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
-    cnt = 0;
-    _res << "\t\t- inverse rotational part of world matrix:" << std::endl;
-    for (unsigned int rowid = 0; rowid < 3; ++rowid)
+    if (!std::filesystem::exists(filepath.data()))
     {
-        _res << "\t\t\t";
-        for (unsigned int colid = 0; colid < 3; ++colid)
-        { _res << dbuffer[cnt++] << " "; }
-
-        _res << std::endl;
+        _res << "\t- no flow field (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
     }
 
-    //------------------------------------------------------------------------------------------------------
-    // flow vectors
-    // - already rotated in world coordinates
-    // - already venc-scaled 
-    //------------------------------------------------------------------------------------------------------
-    dbuffer.resize(gridsize[0] * gridsize[1] * gridsize[2] * gridsize[3] * 3);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+    _res << "\t- reading flow field (path \"" << filepath.data() << "\")" << std::endl;
 
-    cnt = 0;
-    unsigned int cntDemo = 0;
-    for (unsigned int x = 0; x < gridsize[0] && cntDemo < NUM_DEMO; ++x)
+    if (_flowfield_memory_mapped)
+    { return _read_flowfield_memory_mapped(filepath); }
+
+    InputFile file(filepath, _async_io);
+
+    if (!file.good())
     {
-        for (unsigned int y = 0; y < gridsize[1] && cntDemo < NUM_DEMO; ++y)
-        {
-            for (unsigned int z = 0; z < gridsize[2] && cntDemo < NUM_DEMO; ++z)
-            {
-                for (unsigned int t = 0; t < gridsize[3] && cntDemo < NUM_DEMO; ++t, ++cntDemo)
-                {
-                    const unsigned int off = x * gridsize[1] * gridsize[2] * gridsize[3] * 3 + y * gridsize[2] * gridsize[3] * 3 + z * gridsize[3] * 3 + t * 3;
-                    _res << "\t\t- flow vector" << (cnt++) << " [m/s]: " << "[" << dbuffer[off] << ", " << dbuffer[off + 1] << ", " << dbuffer[off + 2] << "]" << std::endl;
-                }
-            }
-        }
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
     }
-    _res << "\t\t- ..." << std::endl;
 
-    file.close();
+    if (_single_precision)
+    { report(_parse_flowfield<float>(file.stream())); }
+    else
+    { report(_parse_flowfield(file.stream())); }
 
     return true;
 }
 
 bool ImporterScientific::read_pressure_map(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
         _res << "\t- no pressure map (path \"" << filepath.data() << "\")" << std::endl;
@@ -1515,15 +1872,14 @@ bool ImporterScientific::read_pressure_map(std::string_view filepath)
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
 bool ImporterScientific::read_rotation_direction_map(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
     if (!std::filesystem::exists(filepath.data()))
     {
@@ -1541,15 +1897,14 @@ bool ImporterScientific::read_rotation_direction_map(std::string_view filepath)
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
 bool ImporterScientific::read_axial_velocity_map(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
     if (!std::filesystem::exists(filepath.data()))
     {
@@ -1567,15 +1922,14 @@ bool ImporterScientific::read_axial_velocity_map(std::string_view filepath)
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
 bool ImporterScientific::read_cos_angle_to_centerline_map(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
     if (!std::filesystem::exists(filepath.data()))
     {
@@ -1593,15 +1947,14 @@ bool ImporterScientific::read_cos_angle_to_centerline_map(std::string_view filep
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
 bool ImporterScientific::read_turbulent_kinetic_energy_map(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
     if (!std::filesystem::exists(filepath.data()))
     {
@@ -1619,14 +1972,12 @@ bool ImporterScientific::read_turbulent_kinetic_energy_map(std::string_view file
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
-bool ImporterScientific::read_flow_jet(std::string_view filepath)
+FlowJetsData ImporterScientific::_parse_flow_jets(std::istream& file)
 {
     /*
      * [1] x [uint32] : numFlowjets
@@ -1651,6 +2002,110 @@ bool ImporterScientific::read_flow_jet(std::string_view filepath)
      *                 [3] x [double] : y direction of centerline's local coordinate system
      */
 
+    FlowJetsData fjs;
+
+    std::uint32_t numFlowjets = 0;
+    read_value(file, numFlowjets);
+    fjs.flow_jets.resize(numFlowjets);
+
+    for (FlowJet& fj: fjs.flow_jets)
+    {
+        read_value(file, fj.num_points);
+        read_value(file, fj.num_times);
+
+        const std::uint64_t n = num_values(fj.num_points, fj.num_times);
+        fj.peak_velocity_positions.resize(3 * n);
+        fj.peak_velocities.resize(n);
+        fj.area_centers.resize(3 * n);
+        fj.area_dirs0.resize(3 * n);
+        fj.area_radii0.resize(n);
+        fj.area_dirs1.resize(3 * n);
+        fj.area_radii1.resize(n);
+        fj.vessel_centers.resize(3 * fj.num_points);
+        fj.vessel_radii.resize(fj.num_points);
+        fj.lcs_x.resize(3 * fj.num_points);
+        fj.lcs_y.resize(3 * fj.num_points);
+
+        for (unsigned int pointid = 0; pointid < fj.num_points; ++pointid)
+        {
+            for (unsigned int timeid = 0; timeid < fj.num_times; ++timeid)
+            {
+                const std::uint64_t i = num_values(pointid, fj.num_times) + timeid;
+
+                file.read(reinterpret_cast<char*>(fj.peak_velocity_positions.data() + 3 * i), 3 * sizeof(double));
+                read_value(file, fj.peak_velocities[i]);
+                file.read(reinterpret_cast<char*>(fj.area_centers.data() + 3 * i), 3 * sizeof(double));
+                file.read(reinterpret_cast<char*>(fj.area_dirs0.data() + 3 * i), 3 * sizeof(double));
+                read_value(file, fj.area_radii0[i]);
+                file.read(reinterpret_cast<char*>(fj.area_dirs1.data() + 3 * i), 3 * sizeof(double));
+                read_value(file, fj.area_radii1[i]);
+            } // for times
+
+            file.read(reinterpret_cast<char*>(fj.vessel_centers.data() + 3 * pointid), 3 * sizeof(double));
+            read_value(file, fj.vessel_radii[pointid]);
+            file.read(reinterpret_cast<char*>(fj.lcs_x.data() + 3 * pointid), 3 * sizeof(double));
+            file.read(reinterpret_cast<char*>(fj.lcs_y.data() + 3 * pointid), 3 * sizeof(double));
+        } // for points
+    } // for fj: num flow jets
+
+    return fjs;
+}
+
+void ImporterScientific::report(const FlowJetsData& fjs)
+{
+    _res << "\t\t- num. flow jets: " << fjs.flow_jets.size() << std::endl;
+
+    for (unsigned int fjid = 0; fjid < fjs.flow_jets.size(); ++fjid)
+    {
+        const FlowJet& fj = fjs.flow_jets[fjid];
+
+        _res << "\t\t- flow jet " << fjid << ":" << std::endl;
+        _res << "\t\t\t- num points: " << fj.num_points << std::endl;
+        _res << "\t\t\t- num times: " << fj.num_times << std::endl;
+
+        const auto vec3 = [&](const std::vector<double>& v, unsigned int i)
+        { _res << "[" << v[3 * i] << ", " << v[3 * i + 1] << ", " << v[3 * i + 2] << "]" << std::endl; };
+
+        for (unsigned int pointid = 0; pointid < std::min(NUM_DEMO, fj.num_points); ++pointid)
+        {
+            for (unsigned int timeid = 0; timeid < std::min(NUM_DEMO, fj.num_times); ++timeid)
+            {
+                const std::uint64_t i = num_values(pointid, fj.num_times) + timeid;
+
+                _res << "\t\t\t- point " << pointid << " time " << timeid << std::endl;
+                _res << "\t\t\t\t- peak velocity position: ";
+                vec3(fj.peak_velocity_positions, i);
+                _res << "\t\t\t\t- peak velocity [m/s]: " << fj.peak_velocities[i] << std::endl;
+                _res << "\t\t\t\t- area center: ";
+                vec3(fj.area_centers, i);
+                _res << "\t\t\t\t- area dir0: ";
+                vec3(fj.area_dirs0, i);
+                _res << "\t\t\t\t- area radius0 [mm]: " << fj.area_radii0[i] << std::endl;
+                _res << "\t\t\t\t- area dir1: ";
+                vec3(fj.area_dirs1, i);
+                _res << "\t\t\t\t- area radius1 [mm]: " << fj.area_radii1[i] << std::endl;
+            } // for times
+
+            _res << "\t\t\t- ..." << std::endl;
+
+            _res << "\t\t\t- vessel center: ";
+            vec3(fj.vessel_centers, pointid);
+            _res << "\t\t\t- vessel radius [mm]: " << fj.vessel_radii[pointid] << std::endl;
+            _res << "\t\t\t- x direction of local coordinate system: ";
+            vec3(fj.lcs_x, pointid);
+            _res << "\t\t\t- y direction of local coordinate system: ";
+            vec3(fj.lcs_y, pointid);
+        } // for points
+    } // for fjid: num flow jets
+}
+
+std::optional<FlowJetsData> ImporterScientific::load_flow_jet(std::string_view filepath) const
+{ return load_file(filepath, _parse_flow_jets); }
+
+bool ImporterScientific::read_flow_jet(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
         _res << "\t- no flow jet (path \"" << filepath.data() << "\")" << std::endl;
@@ -1667,138 +2122,15 @@ bool ImporterScientific::read_flow_jet(std::string_view filepath)
         return false;
     }
 
-    //------------------------------------------------------------------------------------------------------
-    // num flowjets
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numFlowjets = 0;
-    file.read(reinterpret_cast<char*>(&numFlowjets), sizeof(std::uint32_t));
-    _res << "\t\t- num. flow jets: " << numFlowjets << std::endl;
-
-    for (unsigned int fjid = 0; fjid < numFlowjets; ++fjid)
-    {
-        _res << "\t\t- flow jet " << fjid << ":" << std::endl;
-
-        //------------------------------------------------------------------------------------------------------
-        // num points
-        //------------------------------------------------------------------------------------------------------
-        std::uint32_t numPoints = 0;
-        file.read(reinterpret_cast<char*>(&numPoints), sizeof(std::uint32_t));
-        _res << "\t\t\t- num points: " << numPoints << std::endl;
-
-        //------------------------------------------------------------------------------------------------------
-        // num times
-        //------------------------------------------------------------------------------------------------------
-        std::uint32_t numTimes = 0;
-        file.read(reinterpret_cast<char*>(&numTimes), sizeof(std::uint32_t));
-        _res << "\t\t\t- num times: " << numTimes << std::endl;
-
-        //------------------------------------------------------------------------------------------------------
-        // list of points per time
-        //------------------------------------------------------------------------------------------------------
-        std::vector<double> dbuffer;
-        unsigned int cnt = 0;
-
-        for (unsigned int pointid = 0; pointid < numPoints; ++pointid)
-        {
-            for (unsigned int timeid = 0; timeid < numTimes; ++timeid)
-            {
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t- point " << pointid << " time " << timeid << std::endl; }
-
-                //------------------------------------------------------------------------------------------------------
-                // position of the flow jet tube, which represents the peak velocity position in the cross-section
-                //------------------------------------------------------------------------------------------------------
-                dbuffer.resize(3);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- peak velocity position: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-                //------------------------------------------------------------------------------------------------------
-                // peak velocity in the cross-section
-                //------------------------------------------------------------------------------------------------------
-                dbuffer.resize(1);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- peak velocity [m/s]: " << dbuffer[0] << std::endl; }
-
-                //------------------------------------------------------------------------------------------------------
-                // center of the magenta high-velocity area net
-                //------------------------------------------------------------------------------------------------------
-                dbuffer.resize(3);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- area center: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-                //------------------------------------------------------------------------------------------------------
-                // direction 0 + radius of the high-velocity area
-                //------------------------------------------------------------------------------------------------------
-                dbuffer.resize(3);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- area dir0: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-                dbuffer.resize(1);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- area radius0 [mm]: " << dbuffer[0] << std::endl; }
-
-                //------------------------------------------------------------------------------------------------------
-                // direction 1 + radius of the high-velocity area
-                //------------------------------------------------------------------------------------------------------
-                dbuffer.resize(3);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- area dir1: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-                dbuffer.resize(1);
-                file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-                if (cnt < NUM_DEMO && timeid < NUM_DEMO)
-                { _res << "\t\t\t\t- area radius1 [mm]: " << dbuffer[0] << std::endl; }
-            } // for times
-
-            if (cnt < NUM_DEMO)
-            { _res << "\t\t\t- ..." << std::endl; }
-
-            //------------------------------------------------------------------------------------------------------
-            // vessel center (centerline position) + radius for this cross-section
-            //------------------------------------------------------------------------------------------------------
-            dbuffer.resize(3);
-            file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-            if (cnt < NUM_DEMO)
-            { _res << "\t\t\t- vessel center: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-            dbuffer.resize(1);
-            file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-            if (cnt < NUM_DEMO)
-            { _res << "\t\t\t- vessel radius [mm]: " << dbuffer[0] << std::endl; }
-
-            //------------------------------------------------------------------------------------------------------
-            // x direction of centerline's local coordinate system
-            //------------------------------------------------------------------------------------------------------
-            dbuffer.resize(3);
-            file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-            if (cnt < NUM_DEMO)
-            { _res << "\t\t\t- x direction of local coordinate system: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-            //------------------------------------------------------------------------------------------------------
-            // y direction of centerline's local coordinate system
-            //------------------------------------------------------------------------------------------------------
-            dbuffer.resize(3);
-            file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-            if (cnt < NUM_DEMO)
-            { _res << "\t\t\t- y direction of local coordinate system: [" << dbuffer[0] << ", " << dbuffer[1] << ", " << dbuffer[2] << "]" << std::endl; }
-
-            ++cnt;
-        } // for points
-    } // for fjid: num numFlowjets
-
-    file.close();
+    report(_parse_flow_jets(file));
 
     return true;
 }
 
 bool ImporterScientific::read_ivsd(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
         _res << "\t- no ivsd (path \"" << filepath.data() << "\")" << std::endl;
@@ -1815,15 +2147,15 @@ bool ImporterScientific::read_ivsd(std::string_view filepath)
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
 bool ImporterScientific::read_magnitude_tmip(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
         _res << "\t- no mag tmip (path \"" << filepath.data() << "\")" << std::endl;
@@ -1840,245 +2172,261 @@ bool ImporterScientific::read_magnitude_tmip(std::string_view filepath)
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
     return true;
 }
 
-bool ImporterScientific::read_anatomical_images()
+std::vector<std::string> ImporterScientific::_find_files(std::string_view nameContains) const
 {
-    _res << "\t- reading anatomical images (path \"" << _dir << "\")" << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // find 3d anatomical images
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::string> anatomicalImage3DNames;
+    std::vector<std::string> names;
 
     for (auto& dirIt : std::filesystem::directory_iterator(_dir))
     {
         if (!dirIt.is_regular_file())
         { continue; }
 
-        if (bk::string_utils::contains(dirIt.path().filename().string(), "3d_anatomical_image", false))
-        { anatomicalImage3DNames.emplace_back(dirIt.path().filename().string()); }
-    }
-
-    _res << "\t\t- found " << anatomicalImage3DNames.size() << " 3D anatomical images: ";
-    for (unsigned int i = 0; i < anatomicalImage3DNames.size(); ++i)
-    {
-        _res << anatomicalImage3DNames[i];
-        if (static_cast<int>(i) < static_cast<int>(anatomicalImage3DNames.size()) - 1)
-        { _res << ", "; }
+        if (bk::string_utils::contains(dirIt.path().filename().string(), nameContains.data(), false))
+        { names.emplace_back(dirIt.path().filename().string()); }
     }
-    _res << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // read 3d anatomical images
-    //------------------------------------------------------------------------------------------------------
-    for (const std::string& imgName: anatomicalImage3DNames)
-    {
-        const std::string filepath = _dir + "/" + imgName;
-        std::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
 
-        _read_nd_scalar_image_in_sparse_matrix_style(file);
+    return names;
+}
 
-        file.close();
-    }
+void ImporterScientific::_report_narrowing_errors(std::string_view indent, const std::vector<NarrowingError>& errors)
+{
+    if (errors.empty())
+    { return; }
 
-    //------------------------------------------------------------------------------------------------------
-    // find 3d+t anatomical images
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::string> anatomicalImage3DTNames;
+    const ReportFloatFormat format = _res.float_format();
+    _res.set_float_format(ReportFloatFormat::Scientific);
 
-    for (auto& dirIt : std::filesystem::directory_iterator(_dir))
-    {
-        if (!dirIt.is_regular_file())
-        { continue; }
+    _res << indent << "- single precision (max. abs. / rel. conversion error):" << std::endl;
+    for (const NarrowingError& e: errors)
+    { _res << indent << "\t- " << e.name << ": " << e.max_abs_error << " / " << e.max_rel_error << std::endl; }
 
-        if (bk::string_utils::contains(dirIt.path().filename().string(), "3dt_anatomical_image", false))
-        { anatomicalImage3DTNames.emplace_back(dirIt.path().filename().string()); }
-    }
+    _res.set_float_format(format);
+}
 
-    _res << "\t\t- found " << anatomicalImage3DTNames.size() << " 3D+T anatomical images: ";
-    for (unsigned int i = 0; i < anatomicalImage3DTNames.size(); ++i)
+void ImporterScientific::_report_found_files(std::string_view what, const std::vector<std::string>& names)
+{
+    _res << "\t\t- found " << names.size() << " " << what << ": ";
+    for (unsigned int i = 0; i < names.size(); ++i)
     {
-        _res << anatomicalImage3DTNames[i];
-        if (static_cast<int>(i) < static_cast<int>(anatomicalImage3DTNames.size()) - 1)
+        _res << names[i];
+        if (static_cast<int>(i) < static_cast<int>(names.size()) - 1)
         { _res << ", "; }
     }
     _res << std::endl;
+}
+
+AnatomicalImagesData ImporterScientific::_parse_anatomical_images() const
+{
+    AnatomicalImagesData imgs;
 
     //------------------------------------------------------------------------------------------------------
-    // read 3d+t anatomical images
+    // 3d anatomical images
     //------------------------------------------------------------------------------------------------------
-    for (const std::string& imgName: anatomicalImage3DTNames)
+    imgs.names_3d = _find_files("3d_anatomical_image");
+
+    for (const std::string& imgName: imgs.names_3d)
     {
-        const std::string filepath = _dir + "/" + imgName;
-        std::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
+        std::ifstream file(_dir + "/" + imgName, std::ios_base::in | std::ios_base::binary);
+        imgs.images_3d.emplace_back(_parse_nd_scalar_image_in_sparse_matrix_style(file));
+    }
 
-        _read_nd_scalar_image_in_sparse_matrix_style(file);
+    //------------------------------------------------------------------------------------------------------
+    // 3d+t anatomical images
+    //------------------------------------------------------------------------------------------------------
+    imgs.names_3dt = _find_files("3dt_anatomical_image");
 
-        file.close();
+    for (const std::string& imgName: imgs.names_3dt)
+    {
+        std::ifstream file(_dir + "/" + imgName, std::ios_base::in | std::ios_base::binary);
+        imgs.images_3dt.emplace_back(_parse_nd_scalar_image_in_sparse_matrix_style(file));
     }
 
-    return true;
+    return imgs;
 }
 
-bool ImporterScientific::read_flow2dt_images()
+void ImporterScientific::report(const AnatomicalImagesData& imgs)
 {
-    _res << "\t- searching 2D+T flow images in \"" << _dir << "\"" << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // find 2d+t flow images
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::string> flowImage2DTNames;
+    _report_found_files("3D anatomical images", imgs.names_3d);
+    for (const SparseImageData& img: imgs.images_3d)
+    { report(img); }
 
-    for (auto& dirIt : std::filesystem::directory_iterator(_dir))
-    {
-        if (!dirIt.is_regular_file())
-        { continue; }
+    _report_found_files("3D+T anatomical images", imgs.names_3dt);
+    for (const SparseImageData& img: imgs.images_3dt)
+    { report(img); }
+}
 
-        if (bk::string_utils::contains(dirIt.path().filename().string(), "flowfield_2dt", false))
-        { flowImage2DTNames.emplace_back(dirIt.path().filename().string()); }
-    }
+std::optional<AnatomicalImagesData> ImporterScientific::load_anatomical_images() const
+{ return _parse_anatomical_images(); }
 
-    std::sort(flowImage2DTNames.begin(), flowImage2DTNames.end());
+bool ImporterScientific::read_anatomical_images()
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, _dir);
 
-    _res << "\t\t- found " << flowImage2DTNames.size() << " 2D+T flow images: ";
-    for (unsigned int i = 0; i < flowImage2DTNames.size(); ++i)
-    {
-        _res << flowImage2DTNames[i];
-        if (static_cast<int>(i) < static_cast<int>(flowImage2DTNames.size()) - 1)
-        { _res << ", "; }
-    }
-    _res << std::endl;
+    _res << "\t- reading anatomical images (path \"" << _dir << "\")" << std::endl;
 
-    //------------------------------------------------------------------------------------------------------
-    // read 2d+t flow images
-    //------------------------------------------------------------------------------------------------------
-    for (const std::string& imgName: flowImage2DTNames)
-    {
-        /*
-         *                     [3] x [uint32] : size x y t
-         *                     [3] x [double] : scale x y t
-         *                    [16] x [double] : world matrix (4x4 from dicom)
-         *                    [16] x [double] : inverse world matrix (4x4 from dicom)
-         *                    [25] x [double] : world matrix (5x5 including time in 4th row/col)
-         *                    [25] x [double] : inverse world matrix (5x5 including time in 4th row/col)
-         * [sizeX * sizeY * sizeT] x [double] : flow velocities
-         */
+    report(_parse_anatomical_images());
 
-        const std::string filepath = _dir + "/" + imgName;
-        std::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
-        _res << "\t\t- image " << imgName << ":" << std::endl;
+    return true;
+}
 
-        //------------------------------------------------------------------------------------------------------
-        // grid size
-        //------------------------------------------------------------------------------------------------------
-        std::vector<std::uint32_t> gridsize(3);
-        file.read(reinterpret_cast<char*>(gridsize.data()), gridsize.size() * sizeof(std::uint32_t));
-        _res << "\t\t\t- grid size (xyt): " << gridsize[0] << " x " << gridsize[1] << " x " << gridsize[2] << std::endl;
+template<typename T>
+BasicFlow2DTImagesData<T> ImporterScientific::_parse_flow2dt_images() const
+{
+    /*
+     *                     [3] x [uint32] : size x y t
+     *                     [3] x [double] : scale x y t
+     *                    [16] x [double] : world matrix (4x4 from dicom)
+     *                    [16] x [double] : inverse world matrix (4x4 from dicom)
+     *                    [25] x [double] : world matrix (5x5 including time in 4th row/col)
+     *                    [25] x [double] : inverse world matrix (5x5 including time in 4th row/col)
+     * [sizeX * sizeY * sizeT] x [double] : flow velocities
+     */
 
-        //------------------------------------------------------------------------------------------------------
-        // voxel scale
-        //------------------------------------------------------------------------------------------------------
-        std::vector<double> voxelscale(3);
-        file.read(reinterpret_cast<char*>(voxelscale.data()), voxelscale.size() * sizeof(double));
-        _res << "\t\t\t- voxel scale (xyt): " << voxelscale[0] << " x " << voxelscale[1] << " [mm] / " << voxelscale[2] << " [ms]" << std::endl;
+    BasicFlow2DTImagesData<T> imgs;
 
-        //------------------------------------------------------------------------------------------------------
-        // world matrix
-        //------------------------------------------------------------------------------------------------------
-        std::vector<double> dbuffer(16);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        unsigned int cnt = 0;
-        _res << "\t\t\t- world matrix:" << std::endl;
-        for (unsigned int rowid = 0; rowid < 4; ++rowid)
-        {
-            _res << "\t\t\t\t";
-            for (unsigned int colid = 0; colid < 4; ++colid)
-            { _res << dbuffer[cnt++] << " "; }
+    std::vector<std::string> flowImage2DTNames = _find_files("flowfield_2dt");
+    std::sort(flowImage2DTNames.begin(), flowImage2DTNames.end());
 
-            _res << std::endl;
-        }
+    imgs.images.resize(flowImage2DTNames.size());
 
-        //------------------------------------------------------------------------------------------------------
-        // inverse world matrix
-        //------------------------------------------------------------------------------------------------------
-        //dbuffer.resize(16);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        cnt = 0;
-        _res << "\t\t\t- inverse world matrix:" << std::endl;
-        for (unsigned int rowid = 0; rowid < 4; ++rowid)
-        {
-            _res << "\t\t\t\t";
-            for (unsigned int colid = 0; colid < 4; ++colid)
-            { _res << dbuffer[cnt++] << " "; }
+    for (unsigned int i = 0; i < flowImage2DTNames.size(); ++i)
+    {
+        BasicFlow2DTImage<T>& img = imgs.images[i];
+        img.name = std::move(flowImage2DTNames[i]);
+
+        std::ifstream file(_dir + "/" + img.name, std::ios_base::in | std::ios_base::binary);
+
+        read_array(file, img.size);
+        read_array(file, img.scale);
+        read_array(file, img.world_matrix);
+        read_array(file, img.inverse_world_matrix);
+        read_array(file, img.world_matrix_with_time);
+        read_array(file, img.inverse_world_matrix_with_time);
+        read_payload(file, img.velocities, num_values(img.size[0], img.size[1], img.size[2]), "velocities", img.narrowing_errors);
+    }
 
-            _res << std::endl;
-        }
+    return imgs;
+}
 
-        //------------------------------------------------------------------------------------------------------
-        // world matrix with time
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(25);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        cnt = 0;
-        _res << "\t\t\t- world matrix with time:" << std::endl;
-        for (unsigned int rowid = 0; rowid < 5; ++rowid)
-        {
-            _res << "\t\t\t\t";
-            for (unsigned int colid = 0; colid < 5; ++colid)
-            { _res << dbuffer[cnt++] << " "; }
+template<typename T>
+void ImporterScientific::_report_flow2dt_images(const BasicFlow2DTImagesData<T>& imgs)
+{
+    std::vector<std::string> names;
+    for (const BasicFlow2DTImage<T>& img: imgs.images)
+    { names.emplace_back(img.name); }
 
-            _res << std::endl;
-        }
+    _report_found_files("2D+T flow images", names);
 
-        //------------------------------------------------------------------------------------------------------
-        // inverse world matrix with time
-        //------------------------------------------------------------------------------------------------------
-        //dbuffer.resize(25);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-        cnt = 0;
-        _res << "\t\t\t- inverse world matrix with time:" << std::endl;
-        for (unsigned int rowid = 0; rowid < 5; ++rowid)
-        {
-            _res << "\t\t\t\t";
-            for (unsigned int colid = 0; colid < 5; ++colid)
-            { _res << dbuffer[cnt++] << " "; }
+    for (const BasicFlow2DTImage<T>& img: imgs.images)
+    {
+        _res << "\t\t- image " << img.name << ":" << std::endl;
+        _res << "\t\t\t- grid size (xyt): " << img.size[0] << " x " << img.size[1] << " x " << img.size[2] << std::endl;
+        _res << "\t\t\t- voxel scale (xyt): " << img.scale[0] << " x " << img.scale[1] << " [mm] / " << img.scale[2] << " [ms]" << std::endl;
 
-            _res << std::endl;
-        }
+        _report_matrix("\t\t\t", "world matrix", img.world_matrix.data(), 4);
+        _report_matrix("\t\t\t", "inverse world matrix", img.inverse_world_matrix.data(), 4);
+        _report_matrix("\t\t\t", "world matrix with time", img.world_matrix_with_time.data(), 5);
+        _report_matrix("\t\t\t", "inverse world matrix with time", img.inverse_world_matrix_with_time.data(), 5);
 
-        //------------------------------------------------------------------------------------------------------
-        // flow velocities
-        //------------------------------------------------------------------------------------------------------
-        dbuffer.resize(gridsize[0] * gridsize[1] * gridsize[2]);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
+        const std::array<std::uint32_t, 3>& gridsize = img.size;
 
-        cnt = 0;
+        unsigned int cnt = 0;
         for (unsigned int x = 0; x < gridsize[0] && cnt < NUM_DEMO; ++x)
         {
             for (unsigned int y = 0; y < gridsize[1] && cnt < NUM_DEMO; ++y)
             {
                 for (unsigned int t = 0; t < gridsize[2] && cnt < NUM_DEMO; ++t, ++cnt)
                 {
-                    const unsigned int off = x * gridsize[1] * gridsize[2] + y * gridsize[2] + t;
-                    _res << "\t\t\t- velocity at grid pos [" << x << ", " << y << ", " << t << "] = " << dbuffer[off] << std::endl;
+                    const std::uint64_t off = num_values(x, gridsize[1], gridsize[2]) + num_values(y, gridsize[2]) + t;
+                    _res << "\t\t\t- velocity at grid pos [" << x << ", " << y << ", " << t << "] = " << img.velocities[off] << std::endl;
                 }
             }
         }
 
-        file.close();
+        _report_narrowing_errors("\t\t\t", img.narrowing_errors);
     }
-
-    return true;
 }
 
-bool ImporterScientific::read_flow_statistics(std::string_view filepath)
+void ImporterScientific::report(const Flow2DTImagesData& imgs)
+{ _report_flow2dt_images(imgs); }
+
+void ImporterScientific::report(const Flow2DTImagesDataF& imgs)
+{ _report_flow2dt_images(imgs); }
+
+std::optional<Flow2DTImagesData> ImporterScientific::load_flow2dt_images() const
+{ return _parse_flow2dt_images(); }
+
+std::optional<Flow2DTImagesDataF> ImporterScientific::load_flow2dt_images_single_precision() const
+{ return _parse_flow2dt_images<float>(); }
+
+bool ImporterScientific::read_flow2dt_images()
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, _dir);
+
+    _res << "\t- searching 2D+T flow images in \"" << _dir << "\"" << std::endl;
+
+    if (_single_precision)
+    { report(_parse_flow2dt_images<float>()); }
+    else
+    { report(_parse_flow2dt_images()); }
+
+    return true;
+}
+
+FlowStatisticsData ImporterScientific::_parse_flow_statistics(std::istream& file)
+{
+    /*
+     * [1] x [uint32] : numTimes
+     * for each entry of FLOW_STATISTICS (see top of this file):
+     *      [1] x [double] : value
+     *   or
+     *      [numTimes] x [double] : value per time
+     */
+
+    FlowStatisticsData stats;
+    read_value(file, stats.num_times);
+
+    stats.statistics.reserve(std::size(FLOW_STATISTICS));
+    for (const auto& [name, perTime]: FLOW_STATISTICS)
+    {
+        FlowStatistic& s = stats.statistics.emplace_back();
+        s.name = name;
+        s.per_time = perTime;
+        read_vector(file, s.values, perTime ? stats.num_times : 1);
+    }
+
+    return stats;
+}
+
+void ImporterScientific::report(const FlowStatisticsData& stats)
+{
+    for (const FlowStatistic& s: stats.statistics)
+    {
+        _res << "\t\t- " << s.name << ": ";
+
+        if (s.per_time)
+        {
+            for (unsigned int i = 0; i < NUM_DEMO; ++i)
+            { _res << s.values[i] << ", "; }
+            _res << "..." << std::endl;
+        }
+        else
+        { _res << s.values[0] << std::endl; }
+    }
+}
+
+std::optional<FlowStatisticsData> ImporterScientific::load_flow_statistics(std::string_view filepath) const
+{ return load_file(filepath, _parse_flow_statistics); }
+
+bool ImporterScientific::read_flow_statistics(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
         _res << "\t- no flow statistics (path \"" << filepath.data() << "\")" << std::endl;
@@ -2095,345 +2443,163 @@ bool ImporterScientific::read_flow_statistics(std::string_view filepath)
         return false;
     }
 
-    /*
-     * numTimes
-     */
-    std::uint32_t numTimes = 0;
-    file.read(reinterpret_cast<char*>(&numTimes), sizeof(std::uint32_t));
+    report(_parse_flow_statistics(file));
 
-    /*
-     * helper functions
-     */
-    const auto read_and_print_value = [&](std::string_view name)
+    return true;
+}
+
+bool ImporterScientific::read_segmentation(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
     {
-        double dtemp = 0;
-        file.read(reinterpret_cast<char*>(&dtemp), sizeof(double));
-        _res << "\t\t- " << name << ": " << dtemp << std::endl;
-    };
+        _res << "\t- no segmentation (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading segmentation (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
-    const auto read_and_print_vector = [&](std::string_view name)
+    if (!file.good())
     {
-        std::vector<double> dbuffer(numTimes);
-        file.read(reinterpret_cast<char*>(dbuffer.data()), numTimes * sizeof(double));
-        _res << "\t\t- " << name << ": ";
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
 
-        for (unsigned int i = 0; i < NUM_DEMO; ++i)
-        { _res << dbuffer[i] << ", "; }
-        _res << "..." << std::endl;
-    };
+    report(_parse_nd_scalar_image_in_sparse_matrix_style(file));
 
-    read_and_print_value("vortex pressure threshold");
-    read_and_print_value("volume total in ml");
-    read_and_print_value("section volume in ml");
-    read_and_print_value("section volume in percent");
+    return true;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // diameter
-    //------------------------------------------------------------------------------------------------------
-    read_and_print_value("min diameter in mm");
-    read_and_print_value("max diameter in mm");
-    read_and_print_value("mean diameter in mm");
-    read_and_print_value("median diameter in mm");
+std::vector<std::string> ImporterScientific::_parse_non_empty_lines(std::istream& file)
+{
+    std::vector<std::string> lines;
 
-    //------------------------------------------------------------------------------------------------------
-    // cross-sectional area
-    //------------------------------------------------------------------------------------------------------
-    read_and_print_value("min cross sectional area in mm2");
-    read_and_print_value("max cross sectional area in mm2");
-    read_and_print_value("mean cross sectional area in mm2");
-    read_and_print_value("median cross sectional area in mm2");
+    std::string line;
+    while (!file.eof())
+    {
+        std::getline(file, line);
 
-    //------------------------------------------------------------------------------------------------------
-    // vortex volume
-    //------------------------------------------------------------------------------------------------------
-    read_and_print_vector("vortex volume in ml per time");
-    read_and_print_vector("vortex volume in percent per time");
-
-    read_and_print_value("max vortex volume in ml");
-    read_and_print_value("max vortex volume in percent");
-    read_and_print_value("max vortex volume time in ms");
-    read_and_print_value("mean vortex volume in ml");
-    read_and_print_value("mean vortex volume in percent");
-    read_and_print_value("median vortex volume in ml");
-    read_and_print_value("median vortex volume in percent");
-    read_and_print_value("systolic max vortex volume in ml");
-    read_and_print_value("systolic max vortex volume in percent");
-    read_and_print_value("systolic max vortex volume time in ms");
-    read_and_print_value("systolic mean vortex volume in ml");
-    read_and_print_value("systolic mean vortex volume in percent");
-    read_and_print_value("systolic median vortex volume in ml");
-    read_and_print_value("systolic median vortex volume in percent");
-    read_and_print_value("diastolic max vortex volume in ml");
-    read_and_print_value("diastolic max vortex volume in percent");
-    read_and_print_value("diastolic max vortex volume time in ms");
-    read_and_print_value("diastolic mean vortex volume in ml");
-    read_and_print_value("diastolic mean vortex volume in percent");
-    read_and_print_value("diastolic median vortex volume in ml");
-    read_and_print_value("diastolic median vortex volume in percent");
+        if (line.empty())
+        { continue; }
 
-    //------------------------------------------------------------------------------------------------------
-    // vortex coverage
-    //------------------------------------------------------------------------------------------------------
-    read_and_print_value("vortex coverage in ml");
-    read_and_print_value("vortex coverage in percent");
-    read_and_print_value("systolic vortex coverage in ml");
-    read_and_print_value("systolic vortex coverage in percent");
-    read_and_print_value("diastolic vortex coverage in ml");
-    read_and_print_value("diastolic vortex coverage in percent");
+        lines.emplace_back(std::move(line));
+    }
 
-    //------------------------------------------------------------------------------------------------------
-    // velocity
-    //------------------------------------------------------------------------------------------------------
-    read_and_print_vector("max velocity per time");
-    read_and_print_vector("max axial velocity per time");
-    read_and_print_vector("max circumferential velocity per time");
-    read_and_print_vector("mean velocity per time");
-    read_and_print_vector("mean axial velocity per time");
-    read_and_print_vector("mean circumferential velocity per time");
-    read_and_print_vector("median velocity per time");
-    read_and_print_vector("median axial velocity per time");
-    read_and_print_vector("median circumferential velocity per time");
-
-    read_and_print_value("max mean velocity");
-    read_and_print_value("max mean velocity time in ms");
-    read_and_print_value("max mean axial velocity");
-    read_and_print_value("max mean axial velocity time in ms");
-    read_and_print_value("max mean circumferential velocity");
-    read_and_print_value("max mean circumferential velocity time in ms");
-    read_and_print_value("mean mean velocity");
-    read_and_print_value("mean mean axial velocity");
-    read_and_print_value("mean mean circumferential velocity");
-    read_and_print_value("median mean velocity");
-    read_and_print_value("median mean axial velocity");
-    read_and_print_value("median mean circumferential velocity");
-    read_and_print_value("max overall velocity");
-    read_and_print_value("max overall velocity time in ms");
-    read_and_print_value("max overall velocity q99");
-    read_and_print_value("max overall velocity q99 time in ms");
-    read_and_print_value("max overall axial velocity");
-    read_and_print_value("max overall axial velocity time in ms");
-    read_and_print_value("max overall axial velocity q99");
-    read_and_print_value("max overall axial velocity q99 time in ms");
-    read_and_print_value("max overall circumferential velocity");
-    read_and_print_value("max overall circumferential velocity time in ms");
-    read_and_print_value("max overall circumferential velocity q99");
-    read_and_print_value("max overall circumferential velocity q99 time in ms");
-    read_and_print_value("systolic max mean velocity");
-    read_and_print_value("systolic max mean velocity time in ms");
-    read_and_print_value("systolic max mean axial velocity");
-    read_and_print_value("systolic max mean axial velocity time in ms");
-    read_and_print_value("systolic max mean circumferential velocity");
-    read_and_print_value("systolic max mean circumferential velocity time in ms");
-    read_and_print_value("systolic mean mean velocity");
-    read_and_print_value("systolic mean mean axial velocity");
-    read_and_print_value("systolic mean mean circumferential velocity");
-    read_and_print_value("systolic median mean velocity");
-    read_and_print_value("systolic median mean axial velocity");
-    read_and_print_value("systolic median mean circumferential velocity");
-    read_and_print_value("systolic max overall velocity");
-    read_and_print_value("systolic max overall velocity time in ms");
-    read_and_print_value("systolic max overall velocity q99");
-    read_and_print_value("systolic max overall velocity q99 time in ms");
-    read_and_print_value("systolic max overall axial velocity");
-    read_and_print_value("systolic max overall axial velocity time in ms");
-    read_and_print_value("systolic max overall axial velocity q99");
-    read_and_print_value("systolic max overall axial velocity q99 time in ms");
-    read_and_print_value("systolic max overall circumferential velocity");
-    read_and_print_value("systolic max overall circumferential velocity time in ms");
-    read_and_print_value("systolic max overall circumferential velocity q99");
-    read_and_print_value("systolic max overall circumferential velocity q99 time in ms");
-    read_and_print_value("diastolic max mean velocity");
-    read_and_print_value("diastolic max mean velocity time in ms");
-    read_and_print_value("diastolic max mean axial velocity");
-    read_and_print_value("diastolic max mean axial velocity time in ms");
-    read_and_print_value("diastolic max mean circumferential velocity");
-    read_and_print_value("diastolic max mean circumferential velocity time in ms");
-    read_and_print_value("diastolic mean mean velocity");
-    read_and_print_value("diastolic mean mean axial velocity");
-    read_and_print_value("diastolic mean mean circumferential velocity");
-    read_and_print_value("diastolic median mean velocity");
-    read_and_print_value("diastolic median mean axial velocity");
-    read_and_print_value("diastolic median mean circumferential velocity");
-    read_and_print_value("diastolic max overall velocity");
-    read_and_print_value("diastolic max overall velocity time in ms");
-    read_and_print_value("diastolic max overall velocity q99");
-    read_and_print_value("diastolic max overall velocity q99 time in ms");
-    read_and_print_value("diastolic max overall axial velocity");
-    read_and_print_value("diastolic max overall axial velocity time in ms");
-    read_and_print_value("diastolic max overall axial velocity q99");
-    read_and_print_value("diastolic max overall axial velocity q99 time in ms");
-    read_and_print_value("diastolic max overall circumferential velocity");
-    read_and_print_value("diastolic max overall circumferential velocity time in ms");
-    read_and_print_value("diastolic max overall circumferential velocity q99");
-    read_and_print_value("diastolic max overall circumferential velocity q99 time in ms");
+    return lines;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // rotation
-    //------------------------------------------------------------------------------------------------------
-    read_and_print_vector("left rotation volume in ml per time");
-    read_and_print_vector("left rotation volume in percent per time");
-
-    read_and_print_value("max left rotation volume in ml");
-    read_and_print_value("max left rotation volume in percent");
-    read_and_print_value("max left rotation volume time in ms");
-    read_and_print_value("mean left rotation volume in ml");
-    read_and_print_value("mean left rotation volume in percent");
-    read_and_print_value("median left rotation volume in ml");
-    read_and_print_value("median left rotation volume in percent");
-    read_and_print_value("systolic max left rotation volume in ml");
-    read_and_print_value("systolic max left rotation volume in percent");
-    read_and_print_value("systolic max left rotation volume time in ms");
-    read_and_print_value("systolic mean left rotation volume in ml");
-    read_and_print_value("systolic mean left rotation volume in percent");
-    read_and_print_value("systolic median left rotation volume in ml");
-    read_and_print_value("systolic median left rotation volume in percent");
-    read_and_print_value("diastolic max left rotation volume in ml");
-    read_and_print_value("diastolic max left rotation volume in percent");
-    read_and_print_value("diastolic max left rotation volume time in ms");
-    read_and_print_value("diastolic mean left rotation volume in ml");
-    read_and_print_value("diastolic mean left rotation volume in percent");
-    read_and_print_value("diastolic median left rotation volume in ml");
-    read_and_print_value("diastolic median left rotation volume in percent");
-
-    read_and_print_vector("right rotation volume in ml per time");
-    read_and_print_vector("right rotation volume in percent per time");
-
-    read_and_print_value("max right rotation volume in ml");
-    read_and_print_value("max right rotation volume in percent");
-    read_and_print_value("max right rotation volume time in ms");
-    read_and_print_value("mean right rotation volume in ml");
-    read_and_print_value("mean right rotation volume in percent");
-    read_and_print_value("median right rotation volume in ml");
-    read_and_print_value("median right rotation volume in percent");
-    read_and_print_value("systolic max right rotation volume in ml");
-    read_and_print_value("systolic max right rotation volume in percent");
-    read_and_print_value("systolic max right rotation volume time in ms");
-    read_and_print_value("systolic mean right rotation volume in ml");
-    read_and_print_value("systolic mean right rotation volume in percent");
-    read_and_print_value("systolic median right rotation volume in ml");
-    read_and_print_value("systolic median right rotation volume in percent");
-    read_and_print_value("diastolic max right rotation volume in ml");
-    read_and_print_value("diastolic max right rotation volume in percent");
-    read_and_print_value("diastolic max right rotation volume time in ms");
-    read_and_print_value("diastolic mean right rotation volume in ml");
-    read_and_print_value("diastolic mean right rotation volume in percent");
-    read_and_print_value("diastolic median right rotation volume in ml");
-    read_and_print_value("diastolic median right rotation volume in percent");
+void ImporterScientific::report(const SegmentationInfoData& info)
+{
+    for (const std::string& line: info.lines)
+    { _res << "\t\t-> \"" << line << "\"" << std::endl; }
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // pressure
-    //------------------------------------------------------------------------------------------------------
-    /*
-     * mean pressure per time
-     */
-    read_and_print_vector("mean pressure per time");
+std::optional<SegmentationInfoData> ImporterScientific::load_segmentation_info(std::string_view filepath) const
+{
+    // result is one of the following:
+    //
+    // "The segmentation was performed on the magnitude images' TMIP."
+    // "The segmentation was performed on the LPC."
+    // "The segmentation was performed on 3D anatomical image <id>."
+    // "The segmentation was performed on 3D+T anatomical image <id>."
+    // "The segmentation was performed on the signal intensity image's TMIP."
+    // "The segmentation was performed on the IVSD."
 
-    /*
-     * min max mean median
-     */
-    read_and_print_value("min mean pressure");
-    read_and_print_value("min mean pressure time in ms");
-    read_and_print_value("max mean pressure");
-    read_and_print_value("max mean pressure time in ms");
-    read_and_print_value("mean mean pressure");
-    read_and_print_value("median mean pressure");
+    return load_file(filepath, [](std::istream& file)
+    { return SegmentationInfoData{_parse_non_empty_lines(file)}; }, std::ios_base::in);
+}
 
-    /*
-     * min max mean median : systolic
-     */
-    read_and_print_value("systolic min mean pressure");
-    read_and_print_value("systolic min mean pressure time in ms");
-    read_and_print_value("systolic max mean pressure");
-    read_and_print_value("systolic max mean pressure time in ms");
-    read_and_print_value("systolic mean mean pressure");
-    read_and_print_value("systolic median mean pressure");
+bool ImporterScientific::read_segmentation_info(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
 
-    /*
-     * min max mean median : diastolic
-     */
-    read_and_print_value("diastolic min mean pressure");
-    read_and_print_value("diastolic min mean pressure time in ms");
-    read_and_print_value("diastolic max mean pressure");
-    read_and_print_value("diastolic max mean pressure time in ms");
-    read_and_print_value("diastolic mean mean pressure");
-    read_and_print_value("diastolic median mean pressure");
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no segmentation info (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
 
-    /*
-     * mean pressure per time in vortex region
-     */
-    read_and_print_vector("mean pressure in vortex region per time");
+    _res << "\t- reading segmentation info (path \"" << filepath.data() << "\")" << std::endl;
 
-    /*
-     * min max mean median in vortex region
-     */
-    read_and_print_value("min mean pressure in vortex region");
-    read_and_print_value("min mean pressure in vortex region time in ms");
-    read_and_print_value("max mean pressure in vortex region");
-    read_and_print_value("max mean pressure in vortex region time in ms");
-    read_and_print_value("mean mean pressure in vortex region");
-    read_and_print_value("median mean pressure in vortex region");
+    std::ifstream file(filepath.data(), std::ios_base::in);
 
-    /*
-     * min max mean median in vortex region : systolic
-     */
-    read_and_print_value("systolic min mean pressure in vortex region");
-    read_and_print_value("systolic min mean pressure in vortex region time in ms");
-    read_and_print_value("systolic max mean pressure in vortex region");
-    read_and_print_value("systolic max mean pressure in vortex region time in ms");
-    read_and_print_value("systolic mean mean pressure in vortex region");
-    read_and_print_value("systolic median mean pressure in vortex region");
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
 
-    /*
-     * min max mean median in vortex region : diastolic
-     */
-    read_and_print_value("diastolic min mean pressure in vortex region");
-    read_and_print_value("diastolic min mean pressure in vortex region time in ms");
-    read_and_print_value("diastolic max mean pressure in vortex region");
-    read_and_print_value("diastolic max mean pressure in vortex region time in ms");
-    read_and_print_value("diastolic mean mean pressure in vortex region");
-    read_and_print_value("diastolic median mean pressure in vortex region");
+    report(SegmentationInfoData{_parse_non_empty_lines(file)});
 
-    //------------------------------------------------------------------------------------------------------
-    // flow displacement
-    //------------------------------------------------------------------------------------------------------
-    /*
-     * min max mean median displacement (velocity-weighted)
-     */
-    read_and_print_value("max flow jet displacement velocity weighted");
-    read_and_print_value("min flow jet displacement velocity weighted");
-    read_and_print_value("mean flow jet displacement velocity weighted");
-    read_and_print_value("median flow jet displacement velocity weighted");
+    return true;
+}
 
+SegmentationGraphCutIdsData ImporterScientific::_parse_segmentation_graphcut_inside_outside_ids(std::istream& file)
+{
     /*
-     * min max mean median angle to centerline (velocity-weighted)
+     *                    [1] x [uint32] : numInsideIds
+     *                    [1] x [uint32] : numOutsideIds
+     *  [numInsideIds * 3] x [uint32] : list of inside id triplets (xyz)
+     * [numOutsideIds * 3] x [uint32] : list of outside id triplets (xyz)
      */
-    read_and_print_value("max flow jet angle velocity weighted");
-    read_and_print_value("min flow jet angle velocity weighted");
-    read_and_print_value("mean flow jet angle velocity weighted");
-    read_and_print_value("median flow jet angle velocity weighted");
 
-    /*
-     * min max mean median high-velocity area percent of cross-section (velocity-weighted)
-     */
-    read_and_print_value("max flow jet high velocity area percent velocity weighted");
-    read_and_print_value("min flow jet high velocity area percent velocity weighted");
-    read_and_print_value("mean flow jet high velocity area percent velocity weighted");
-    read_and_print_value("median flow jet high velocity area percent velocity weighted");
+    SegmentationGraphCutIdsData ids;
+
+    std::uint32_t numInsideIds = 0;
+    read_value(file, numInsideIds);
+
+    std::uint32_t numOutsideIds = 0;
+    read_value(file, numOutsideIds);
 
-    file.close();
+    read_vector(file, ids.inside_ids, num_values(numInsideIds, 3));
+    read_vector(file, ids.outside_ids, num_values(numOutsideIds, 3));
 
-    return true;
+    return ids;
 }
 
-bool ImporterScientific::read_segmentation(std::string_view filepath)
+void ImporterScientific::report(const SegmentationGraphCutIdsData& ids)
+{
+    const unsigned int numInsideIds = ids.inside_ids.size() / 3;
+    const unsigned int numOutsideIds = ids.outside_ids.size() / 3;
+
+    _res << "\t\t- num. inside ids: " << numInsideIds << std::endl;
+    _res << "\t\t- num. outside ids: " << numOutsideIds << std::endl;
+
+    for (unsigned int i = 0; i < std::min(NUM_DEMO, numInsideIds); ++i)
+    {
+        const unsigned int off = i * 3;
+        _res << "\t\t- inside grid pos " << i << ": [" << ids.inside_ids[off] << ", " << ids.inside_ids[off + 1] << ", " << ids.inside_ids[off + 2] << "]" << std::endl;
+    }
+    _res << "\t\t- ..." << std::endl;
+
+    for (unsigned int i = 0; i < std::min(NUM_DEMO, numOutsideIds); ++i)
+    {
+        const unsigned int off = i * 3;
+        _res << "\t\t- outside grid pos " << i << ": [" << ids.outside_ids[off] << ", " << ids.outside_ids[off + 1] << ", " << ids.outside_ids[off + 2] << "]" << std::endl;
+    }
+    if (numOutsideIds != 0)
+    { _res << "\t\t- ..." << std::endl; }
+    else
+    { _res << "\t\t- no outside ids specified" << std::endl; }
+}
+
+std::optional<SegmentationGraphCutIdsData> ImporterScientific::load_segmentation_graphcut_inside_outside_ids(std::string_view filepath) const
+{ return load_file(filepath, _parse_segmentation_graphcut_inside_outside_ids); }
+
+bool ImporterScientific::read_segmentation_graphcut_inside_outside_ids(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
-        _res << "\t- no segmentation (path \"" << filepath.data() << "\")" << std::endl;
+        _res << "\t- no segmentation graph cut inside/outside ids (path \"" << filepath.data() << "\")" << std::endl;
         return false;
     }
 
-    _res << "\t- reading segmentation (path \"" << filepath.data() << "\")" << std::endl;
+    _res << "\t- reading segmentation graph cut inside/outside ids (path \"" << filepath.data() << "\")" << std::endl;
 
     std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
@@ -2443,24 +2609,86 @@ bool ImporterScientific::read_segmentation(std::string_view filepath)
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
+    report(_parse_segmentation_graphcut_inside_outside_ids(file));
+
+    return true;
+}
+
+bool ImporterScientific::read_segmentation_in_flowfield_size(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
 
-    file.close();
+    const SparseImageData header = _parse_sparse_image_header(file);
+    _report_sparse_image_header(header);
+    _report_voxel_mask_voxels(_parse_voxel_mask_entries(file, header.grid_size, header.num_values));
 
     return true;
 }
 
-bool ImporterScientific::read_segmentation_info(std::string_view filepath)
+VesselSectionSegmentationData ImporterScientific::_parse_vessel_section_segmentation_in_flowfield_size(std::istream& file)
+{
+    /*
+     * [1] x [uint32] : numSections
+     * for numSections
+     *      [nd scalar image in sparse matrix style]
+     */
+
+    VesselSectionSegmentationData seg;
+
+    std::uint32_t numSections = 0;
+    read_value(file, numSections);
+
+    seg.sections.reserve(numSections);
+    for (unsigned int sectionid = 0; sectionid < numSections; ++sectionid)
+    { seg.sections.emplace_back(_parse_nd_scalar_image_in_sparse_matrix_style(file)); }
+
+    return seg;
+}
+
+void ImporterScientific::report(const VesselSectionSegmentationData& seg)
+{
+    const unsigned int numSections = seg.sections.size();
+    _res << "\t\tnum. sections: " << numSections << std::endl;
+
+    for (unsigned int sectionid = 0; sectionid < numSections; ++sectionid)
+    {
+        _res << "\t\t- section " << sectionid << " of " << numSections << ":" << std::endl;
+        report(seg.sections[sectionid]);
+    }
+}
+
+std::optional<VesselSectionSegmentationData> ImporterScientific::load_vessel_section_segmentation_in_flowfield_size(std::string_view filepath) const
+{ return load_file(filepath, _parse_vessel_section_segmentation_in_flowfield_size); }
+
+bool ImporterScientific::read_vessel_section_segmentation_in_flowfield_size(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
-        _res << "\t- no segmentation info (path \"" << filepath.data() << "\")" << std::endl;
+        _res << "\t- no vessel section segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
         return false;
     }
 
-    _res << "\t- reading segmentation info (path \"" << filepath.data() << "\")" << std::endl;
+    _res << "\t- reading vessel section segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
 
-    std::ifstream file(filepath.data(), std::ios_base::in);
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
     if (!file.good())
     {
@@ -2468,40 +2696,514 @@ bool ImporterScientific::read_segmentation_info(std::string_view filepath)
         return false;
     }
 
-    std::string line;
-    while (!file.eof())
+    report(_parse_vessel_section_segmentation_in_flowfield_size(file));
+
+    return true;
+}
+
+void ImporterScientific::report(const VesselSectionSemanticsData& semantics)
+{
+    for (const std::string& line: semantics.lines)
+    { _res << "\t\t" << line << std::endl; }
+}
+
+std::optional<VesselSectionSemanticsData> ImporterScientific::load_vessel_section_segmentation_semantics(std::string_view filepath) const
+{
+    return load_file(filepath, [](std::istream& file)
+    { return VesselSectionSemanticsData{_parse_non_empty_lines(file)}; }, std::ios_base::in);
+}
+
+bool ImporterScientific::read_vessel_section_segmentation_semantics(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
     {
-        std::getline(file, line);
+        _res << "\t- no vessel section segmentation semantics (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
 
-        if (line.empty())
-        { continue; }
+    _res << "\t- reading vessel section segmentation semantics (path \"" << filepath.data() << "\")" << std::endl;
 
-        _res << "\t\t-> \"" << line << "\"" << std::endl;
+    std::ifstream file(filepath.data(), std::ios_base::in);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
     }
 
-    // result is one of the following:
-    //
-    // "The segmentation was performed on the magnitude images' TMIP."
-    // "The segmentation was performed on the LPC."
-    // "The segmentation was performed on 3D anatomical image <id>."
-    // "The segmentation was performed on 3D+T anatomical image <id>."
-    // "The segmentation was performed on the signal intensity image's TMIP."
-    // "The segmentation was performed on the IVSD."
+    report(VesselSectionSemanticsData{_parse_non_empty_lines(file)});
+
+    return true;
+}
+
+CenterlineSeedTargetIdsData ImporterScientific::_parse_centerline_start_end_ids_on_mesh(std::istream& file)
+{
+    /*
+     * [1] x [uint32] : seedId
+     * [1] x [uint32] : numTargetIds
+     * [numTargetIds] x [uint32] : targetIds
+     */
+
+    CenterlineSeedTargetIdsData ids;
+
+    read_value(file, ids.seed_id);
+
+    std::uint32_t numTargetIds = 0;
+    read_value(file, numTargetIds);
+    read_vector(file, ids.target_ids, numTargetIds);
+
+    return ids;
+}
+
+void ImporterScientific::report(const CenterlineSeedTargetIdsData& ids)
+{
+    _res << "\t\t- seed id: " << ids.seed_id << std::endl;
+
+    _res << "\t\t- target ids: ";
+    for (std::uint32_t tid : ids.target_ids)
+    { _res << tid << " "; }
+    _res << std::endl;
+}
+
+std::optional<CenterlineSeedTargetIdsData> ImporterScientific::load_centerline_start_end_ids_on_mesh(std::string_view filepath) const
+{ return load_file(filepath, _parse_centerline_start_end_ids_on_mesh); }
+
+bool ImporterScientific::read_centerline_start_end_ids_on_mesh(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no centerline start/end ids (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading centerline start/end ids (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
+
+    report(_parse_centerline_start_end_ids_on_mesh(file));
+
+    return true;
+}
+
+bool ImporterScientific::read_static_tissue_mask(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no static tissue mask (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading static tissue mask (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
+
+    const SparseImageData header = _parse_sparse_image_header(file);
+    _report_sparse_image_header(header);
+    _report_voxel_mask_voxels(_parse_voxel_mask_entries(file, header.grid_size, header.num_values));
+
+    return true;
+}
+
+StaticTissueIvsdThresholdsData ImporterScientific::_parse_static_tissue_ivsd_thresholds(std::istream& file)
+{
+    /*
+     * [1] x [double] : lower threshold
+     * [1] x [double] : upper threshold
+     */
+
+    StaticTissueIvsdThresholdsData thresholds;
+    read_value(file, thresholds.lower_threshold);
+    read_value(file, thresholds.upper_threshold);
+
+    return thresholds;
+}
+
+void ImporterScientific::report(const StaticTissueIvsdThresholdsData& thresholds)
+{
+    _res << "\t\t- lower threshold: " << thresholds.lower_threshold << std::endl;
+    _res << "\t\t- upper threshold: " << thresholds.upper_threshold << std::endl;
+}
+
+std::optional<StaticTissueIvsdThresholdsData> ImporterScientific::load_static_tissue_ivsd_thresholds(std::string_view filepath) const
+{ return load_file(filepath, _parse_static_tissue_ivsd_thresholds); }
+
+bool ImporterScientific::read_static_tissue_ivsd_thresholds(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no static tissue ivsd thresholds (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading static tissue ivsd thresholds (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
+
+    report(_parse_static_tissue_ivsd_thresholds(file));
+
+    return true;
+}
+
+DatasetFilterTagsData ImporterScientific::_parse_dataset_filter_tags(std::istream& file)
+{
+    // one line of ';'-separated tags
+    std::string csv;
+    std::getline(file, csv);
+
+    DatasetFilterTagsData tags;
+    tags.tags = bk::string_utils::split(csv, ";");
+    tags.tags.erase(std::remove_if(tags.tags.begin(), tags.tags.end(), [](const std::string& s)
+    { return s.empty(); }));
+
+    return tags;
+}
+
+void ImporterScientific::report(const DatasetFilterTagsData& tags)
+{
+    _res << "\t\t- " << tags.tags.size() << " filter tags: ";
+
+    for (const std::string& s: tags.tags)
+    { _res << s << " "; }
+    _res << std::endl;
+}
+
+std::optional<DatasetFilterTagsData> ImporterScientific::load_dataset_filter_tags(std::string_view filepath) const
+{ return load_file(filepath, _parse_dataset_filter_tags, std::ios_base::in); }
+
+bool ImporterScientific::read_dataset_filter_tags(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no filter tags (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading filter tags (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
+
+    report(_parse_dataset_filter_tags(file));
+
+    return true;
+}
+
+PhaseWrapsData ImporterScientific::_parse_phase_wrapped_voxels(std::istream& file)
+{
+    /*
+     * for 3D+T flow images x y z
+     *                         [1] x [uint32] : numWrappedVoxels
+     *      for numWrappedVoxels
+     *                         [4] x [uint32] : x y z t grid pos
+     *                           [1] x [int8] : wrap factor
+     */
+
+    PhaseWrapsData wraps;
+
+    for (unsigned int dimid = 0; dimid < 3; ++dimid)
+    {
+        std::uint32_t numWrappedVoxels = 0;
+        read_value(file, numWrappedVoxels);
+
+        wraps.grid_pos[dimid].resize(num_values(numWrappedVoxels, 4));
+        wraps.wrap_factors[dimid].resize(numWrappedVoxels);
+
+        for (unsigned int i = 0; i < numWrappedVoxels; ++i)
+        {
+            file.read(reinterpret_cast<char*>(wraps.grid_pos[dimid].data() + num_values(i, 4)), 4 * sizeof(std::uint32_t));
+
+            /*
+             * wrapFactor
+             * - x was corrected via:   x += factor * 2 * venc
+             */
+            read_value(file, wraps.wrap_factors[dimid][i]);
+        } // for i
+    } // for dimid
+
+    return wraps;
+}
+
+void ImporterScientific::report(const PhaseWrapsData& wraps)
+{
+    for (unsigned int dimid = 0; dimid < 3; ++dimid)
+    {
+        const std::vector<std::uint32_t>& gridpos = wraps.grid_pos[dimid];
+        const unsigned int numWrappedVoxels = wraps.wrap_factors[dimid].size();
+        _res << "\t\tnum. wrapped voxels of 3D+T flow image " << dimid << ": " << numWrappedVoxels << std::endl;
+
+        for (unsigned int i = 0; i < std::min(NUM_DEMO, numWrappedVoxels); ++i)
+        {
+            const unsigned int off = i * 4;
+            _res << "\t\t\t- " << i << ": grid pos [" << gridpos[off] << ", " << gridpos[off + 1] << ", " << gridpos[off + 2] << ", " << gridpos[off + 3] << "]";
+            _res << " is wrapped " << static_cast<int>(wraps.wrap_factors[dimid][i]) << "x" << std::endl;
+        } // for i
+        _res << "\t\t\t- ..." << std::endl;
+    } // for dimid
+}
+
+std::optional<PhaseWrapsData> ImporterScientific::load_phase_wrapped_voxels(std::string_view filepath) const
+{ return load_file(filepath, _parse_phase_wrapped_voxels); }
+
+bool ImporterScientific::read_phase_wrapped_voxels(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no phase wraps (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading phase wraps (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
+
+    report(_parse_phase_wrapped_voxels(file));
+
+    return true;
+}
+
+VelocityOffsetCorrectionData ImporterScientific::_parse_velocity_offset_correction_3dt(std::istream& file)
+{
+    /*
+     * [1] x [uint32] : end diastolic time point id
+     * [1] x [double] : ivsd static tissue threshold
+     * for 3D+T flow images x y z
+     *                 [1] x [uint32] : numSlices
+     *     [numSlices * 3] x [double] : plane coefficients per slice
+     */
+
+    VelocityOffsetCorrectionData voc;
+
+    read_value(file, voc.end_diastolic_time_id);
+    read_value(file, voc.ivsd_static_tissue_threshold);
+
+    for (unsigned int v = 0; v < 3; ++v)
+    {
+        std::uint32_t numSlices = 0;
+        read_value(file, numSlices);
+        read_vector(file, voc.plane_coeffs[v], num_values(numSlices, 3));
+    } // for v
+
+    return voc;
+}
+
+void ImporterScientific::report(const VelocityOffsetCorrectionData& voc)
+{
+    _res << "\t\t- end diastolic time point id: " << voc.end_diastolic_time_id << std::endl;
+    _res << "\t\t- ivsd static tissue threshold: " << voc.ivsd_static_tissue_threshold << std::endl;
+
+    for (unsigned int v = 0; v < 3; ++v)
+    {
+        const std::vector<double>& planeCoeffs = voc.plane_coeffs[v];
+        const unsigned int numSlices = planeCoeffs.size() / 3;
+        _res << "\t\t\t- num. slices in flow image " << v << ": " << numSlices << std::endl;
+
+        for (unsigned int z = 0; z < std::min(NUM_DEMO, numSlices); ++z)
+        {
+            const unsigned int off = 3 * z;
+            _res << "\t\t\t- plane coeffs of slice " << z << ": " << planeCoeffs[off] << ", " << planeCoeffs[off + 1] << ", " << planeCoeffs[off + 2] << std::endl;
+        } // for z : numSlices
+        _res << "\t\t\t- ..." << std::endl;
+    } // for v
+}
+
+std::optional<VelocityOffsetCorrectionData> ImporterScientific::load_velocity_offset_correction_3dt(std::string_view filepath) const
+{ return load_file(filepath, _parse_velocity_offset_correction_3dt); }
+
+bool ImporterScientific::read_velocity_offset_correction_3dt(std::string_view filepath)
+{
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
+    if (!std::filesystem::exists(filepath.data()))
+    {
+        _res << "\t- no 3D+T flow images' velocity offset correction (path \"" << filepath.data() << "\")" << std::endl;
+        return false;
+    }
+
+    _res << "\t- reading flow images' velocity offset correction (path \"" << filepath.data() << "\")" << std::endl;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+
+    if (!file.good())
+    {
+        _res << "\t\tFAILED! Could not open file!" << std::endl;
+        return false;
+    }
+
+    report(_parse_velocity_offset_correction_3dt(file));
+
+    return true;
+}
+
+DicomTagsData ImporterScientific::_parse_dicom_tags(std::istream& file)
+{
+    /*
+     * [1] x [uint16] : numImages
+     * for numImages: see below; strings are stored as [1] x [uint16] : length + [length] x [char]
+     */
+
+    const auto read_string = [&](std::string& s)
+    {
+        std::uint16_t len = 0;
+        read_value(file, len);
+
+        s.resize(len);
+        file.read(s.data(), s.length());
+    };
+
+    DicomTagsData tags;
+
+    std::uint16_t numImages = 0;
+    read_value(file, numImages);
+    tags.images.resize(numImages);
+
+    for (DicomImageTags& img: tags.images)
+    {
+        read_value(file, img.dicom_image_id);
+        read_value(file, img.num_dimensions);
+        read_value(file, img.rows);
+        read_value(file, img.columns);
+        read_value(file, img.slices);
+        read_value(file, img.temporal_positions);
+        read_value(file, img.number_of_frames);
+        read_value(file, img.row_spacing);
+        read_value(file, img.col_spacing);
+        read_value(file, img.slice_spacing);
+        read_value(file, img.temporal_resolution);
+        read_string(img.patient_name);
+        read_string(img.patient_id);
+        read_string(img.patient_sex);
+        read_value(file, img.patient_age);
+        read_value(file, img.patient_weight);
+        read_string(img.patient_birth_date);
+        read_string(img.sequence_name);
+        read_string(img.sequence_name_private);
+        read_string(img.patient_position);
+        read_string(img.study_description);
+        read_string(img.series_description);
+        read_string(img.series_instance_uid);
+        read_string(img.study_instance_uid);
+        read_string(img.protocol_name);
+        read_string(img.modality);
+        read_value(file, img.samples_per_pixel);
+        read_value(file, img.largest_image_pixel_value);
+        read_value(file, img.bits_allocated);
+        read_value(file, img.bits_stored);
+        read_value(file, img.high_bit);
+        read_string(img.acquisition_date);
+        read_string(img.institution_name);
+        read_array(file, img.image_orientation_patient_x);
+        read_array(file, img.image_orientation_patient_y);
+        read_array(file, img.world_matrix);
+    } // for image ids
 
-    file.close();
+    return tags;
+}
 
-    return true;
+void ImporterScientific::report(const DicomTagsData& tags)
+{
+    _res << "\t\t- DICOM tags of " << tags.images.size() << " images: " << std::endl;
+
+    for (const DicomImageTags& img: tags.images)
+    {
+        _res << "\t\t- DICOM image ID: " << img.dicom_image_id << std::endl;
+        _res << "\t\t\t- nDimensions: " << img.num_dimensions << std::endl;
+        _res << "\t\t\t- Rows: " << img.rows << std::endl;
+        _res << "\t\t\t- Columns: " << img.columns << std::endl;
+        _res << "\t\t\t- Slices: " << img.slices << std::endl;
+        _res << "\t\t\t- TemporalPositions: " << img.temporal_positions << std::endl;
+        _res << "\t\t\t- NumberOfFrames: " << img.number_of_frames << std::endl;
+        _res << "\t\t\t- RowSpacing: " << img.row_spacing << std::endl;
+        _res << "\t\t\t- ColSpacing: " << img.col_spacing << std::endl;
+        _res << "\t\t\t- SliceSpacing: " << img.slice_spacing << std::endl;
+        _res << "\t\t\t- TemporalResolution: " << img.temporal_resolution << std::endl;
+        _res << "\t\t\t- PatientName: " << img.patient_name << std::endl;
+        _res << "\t\t\t- PatientID: " << img.patient_id << std::endl;
+        _res << "\t\t\t- PatientSex: " << img.patient_sex << std::endl;
+        _res << "\t\t\t- PatientAge: " << static_cast<int>(img.patient_age) << std::endl;
+        _res << "\t\t\t- PatientWeight: " << img.patient_weight << std::endl;
+        _res << "\t\t\t- PatientBirthDate: " << img.patient_birth_date << std::endl;
+        _res << "\t\t\t- SequenceName: " << img.sequence_name << std::endl;
+        _res << "\t\t\t- SequenceName_Private: " << img.sequence_name_private << std::endl;
+        _res << "\t\t\t- PatientPosition: " << img.patient_position << std::endl;
+        _res << "\t\t\t- StudyDescription: " << img.study_description << std::endl;
+        _res << "\t\t\t- SeriesDescription: " << img.series_description << std::endl;
+        _res << "\t\t\t- SeriesInstanceUID: " << img.series_instance_uid << std::endl;
+        _res << "\t\t\t- StudyInstanceUID: " << img.study_instance_uid << std::endl;
+        _res << "\t\t\t- ProtocolName: " << img.protocol_name << std::endl;
+        _res << "\t\t\t- Modality: " << img.modality << std::endl;
+        _res << "\t\t\t- SamplesPerPixel: " << static_cast<int>(img.samples_per_pixel) << std::endl;
+        _res << "\t\t\t- LargestImagePixelValue: " << img.largest_image_pixel_value << std::endl;
+        _res << "\t\t\t- BitsAllocated: " << static_cast<int>(img.bits_allocated) << std::endl;
+        _res << "\t\t\t- BitsStored: " << static_cast<int>(img.bits_stored) << std::endl;
+        _res << "\t\t\t- HighBit: " << static_cast<int>(img.high_bit) << std::endl;
+        _res << "\t\t\t- AcquisitionDate: " << img.acquisition_date << std::endl;
+        _res << "\t\t\t- InstitutionName: " << img.institution_name << std::endl;
+
+        const std::array<double, 3>& iopx = img.image_orientation_patient_x;
+        _res << "\t\t\t- ImageOrientationPatientX: [" << iopx[0] << ", " << iopx[1] << ", " << iopx[2] << "]" << std::endl;
+
+        const std::array<double, 3>& iopy = img.image_orientation_patient_y;
+        _res << "\t\t\t- ImageOrientationPatientY: [" << iopy[0] << ", " << iopy[1] << ", " << iopy[2] << "]" << std::endl;
+
+        _report_matrix("\t\t\t", "world matrix", img.world_matrix.data(), 4);
+    } // for image ids
 }
 
-bool ImporterScientific::read_segmentation_graphcut_inside_outside_ids(std::string_view filepath)
+std::optional<DicomTagsData> ImporterScientific::load_dicom_tags(std::string_view filepath) const
+{ return load_file(filepath, _parse_dicom_tags); }
+
+bool ImporterScientific::read_dicom_tags(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
-        _res << "\t- no segmentation graph cut inside/outside ids (path \"" << filepath.data() << "\")" << std::endl;
+        _res << "\t- no dicom tags (path \"" << filepath.data() << "\")" << std::endl;
         return false;
     }
 
-    _res << "\t- reading segmentation graph cut inside/outside ids (path \"" << filepath.data() << "\")" << std::endl;
+    _res << "\t- reading dicom tags (path \"" << filepath.data() << "\")" << std::endl;
 
     std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
@@ -2511,64 +3213,69 @@ bool ImporterScientific::read_segmentation_graphcut_inside_outside_ids(std::stri
         return false;
     }
 
-    //------------------------------------------------------------------------------------------------------
-    // numInsideIds
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numInsideIds = 0;
-    file.read(reinterpret_cast<char*>(&numInsideIds), sizeof(std::uint32_t));
-    _res << "\t\t- num. inside ids: " << numInsideIds << std::endl;
+    report(_parse_dicom_tags(file));
 
-    //------------------------------------------------------------------------------------------------------
-    // numOutsideIds
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numOutsideIds = 0;
-    file.read(reinterpret_cast<char*>(&numOutsideIds), sizeof(std::uint32_t));
-    _res << "\t\t- num. outside ids: " << numOutsideIds << std::endl;
+    return true;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // list of inside id triplets (xyz)
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::uint32_t> ui32buffer(numInsideIds * 3);
-    file.read(reinterpret_cast<char*>(ui32buffer.data()), ui32buffer.size() * sizeof(std::uint32_t));
+CardiacCycleData ImporterScientific::_parse_cardiac_cycle_definition(std::istream& file)
+{
+    /*
+     * [1] x [uint32] : numTimes
+     * [1] x [uint32] : idSystoleBegin
+     * [1] x [double] : msSystoleBegin
+     * [1] x [uint32] : idSystoleEnd
+     * [1] x [double] : msSystoleEnd
+     * [1] x [uint32] : numVessels
+     * for numVessels
+     *      [numTimes] x [double] : axial velocity per time in vessel
+     */
 
-    for (unsigned int i = 0; i < std::min(NUM_DEMO, numInsideIds); ++i)
-    {
-        const unsigned int off = i * 3;
-        _res << "\t\t- inside grid pos " << i << ": [" << ui32buffer[off] << ", " << ui32buffer[off + 1] << ", " << ui32buffer[off + 2] << "]" << std::endl;
-    }
-    _res << "\t\t- ..." << std::endl;
+    CardiacCycleData cc;
 
-    //------------------------------------------------------------------------------------------------------
-    // list of outside id triplets (xyz)
-    //------------------------------------------------------------------------------------------------------
-    ui32buffer.clear();
-    ui32buffer.resize(numOutsideIds * 3, 0);
-    file.read(reinterpret_cast<char*>(ui32buffer.data()), ui32buffer.size() * sizeof(std::uint32_t));
+    read_value(file, cc.num_times);
+    read_value(file, cc.id_systole_begin);
+    read_value(file, cc.ms_systole_begin);
+    read_value(file, cc.id_systole_end);
+    read_value(file, cc.ms_systole_end);
+    read_value(file, cc.num_vessels);
+    read_vector(file, cc.mean_axial_velocity, num_values(cc.num_vessels, cc.num_times));
 
-    for (unsigned int i = 0; i < std::min(NUM_DEMO, numOutsideIds); ++i)
-    {
-        const unsigned int off = i * 3;
-        _res << "\t\t- outside grid pos " << i << ": [" << ui32buffer[off] << ", " << ui32buffer[off+1] << ", " << ui32buffer[off+2] << "]" << std::endl;
-    }
-    if (numOutsideIds != 0)
-    { _res << "\t\t- ..." << std::endl; }
-    else
-    { _res << "\t\t- no outside ids specified" << std::endl; }
+    return cc;
+}
 
-    file.close();
+void ImporterScientific::report(const CardiacCycleData& cc)
+{
+    _res << "\t\t- num. times: " << cc.num_times << std::endl;
+    _res << "\t\t- systole begin (= diastole end): " << cc.ms_systole_begin << " [ms] (time point id " << cc.id_systole_begin << ")" << std::endl;
+    _res << "\t\t- systole end (= diastole begin): " << cc.ms_systole_end << " [ms] (time point id " << cc.id_systole_end << ")" << std::endl;
+    _res << "\t\t- num. vessels: " << cc.num_vessels << std::endl;
 
-    return true;
+    for (unsigned int vid = 0; vid < cc.num_vessels; ++vid)
+    {
+        const std::uint64_t off = num_values(vid, cc.num_times);
+        _res << "\t\t- mean axial velocity [m/s] per time in vessel " << vid << ": ";
+
+        for (unsigned int t = 0; t < NUM_DEMO; ++t)
+        { _res << cc.mean_axial_velocity[off + t] << ", "; }
+        _res << "..." << std::endl;
+    } // for vid : num vessels
 }
 
-bool ImporterScientific::read_segmentation_in_flowfield_size(std::string_view filepath)
+std::optional<CardiacCycleData> ImporterScientific::load_cardiac_cycle_definition(std::string_view filepath) const
+{ return load_file(filepath, _parse_cardiac_cycle_definition); }
+
+bool ImporterScientific::read_cardiac_cycle_definition(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
-        _res << "\t- no segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
+        _res << "\t- no cardiac cycle definition (path \"" << filepath.data() << "\")" << std::endl;
         return false;
     }
 
-    _res << "\t- reading segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
+    _res << "\t- reading cardiac cycle definition (path \"" << filepath.data() << "\")" << std::endl;
 
     std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
@@ -2578,63 +3285,79 @@ bool ImporterScientific::read_segmentation_in_flowfield_size(std::string_view fi
         return false;
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
-
-    file.close();
+    report(_parse_cardiac_cycle_definition(file));
 
     return true;
 }
 
-bool ImporterScientific::read_vessel_section_segmentation_in_flowfield_size(std::string_view filepath)
+VencData ImporterScientific::_parse_venc(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
+    /*
+     * [1] x [uint16] : dicom image id of 3D+T flow image X (LR)
+     * [1] x [double] : venc 3D+T flow image X (LR)
+     * [1] x [uint16] : dicom image id of 3D+T flow image Y (AP)
+     * [1] x [double] : venc 3D+T flow image Y (AP)
+     * [1] x [uint16] : dicom image id of 3D+T flow image Z (FH)
+     * [1] x [double] : venc 3D+T flow image Z (FH)
+     * [1] x [uint8] : num2DTFlowImages
+     * for num2DTFlowImages
+     *      [1] x [uint16] : dicom image id
+     *      [1] x [double] : venc
+     */
+
+    VencData venc;
+
+    for (unsigned int i = 0; i < 3; ++i)
     {
-        _res << "\t- no vessel section segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
+        read_value(file, venc.dicom_image_ids_3dt[i]);
+        read_value(file, venc.vencs_3dt[i]);
     }
 
-    _res << "\t- reading vessel section segmentation in flow field size (path \"" << filepath.data() << "\")" << std::endl;
+    std::uint8_t num2DTFlowImages = 0;
+    read_value(file, num2DTFlowImages);
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    venc.dicom_image_ids_2dt.resize(num2DTFlowImages);
+    venc.vencs_2dt.resize(num2DTFlowImages);
 
-    if (!file.good())
+    for (unsigned int i = 0; i < num2DTFlowImages; ++i)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
+        read_value(file, venc.dicom_image_ids_2dt[i]);
+        read_value(file, venc.vencs_2dt[i]);
     }
 
-    //------------------------------------------------------------------------------------------------------
-    // numSections
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numSections = 0;
-    file.read(reinterpret_cast<char*>(&numSections), sizeof(std::uint32_t));
-    _res << "\t\tnum. sections: " << numSections << std::endl;
+    return venc;
+}
 
-    //------------------------------------------------------------------------------------------------------
-    // section segmentations sparse matrix style
-    //------------------------------------------------------------------------------------------------------
-    for (unsigned int sectionid = 0; sectionid < numSections; ++sectionid)
-    {
-        _res << "\t\t- section " << sectionid << " of " << numSections << ":" << std::endl;
-        _read_nd_scalar_image_in_sparse_matrix_style(file);
-    }
+void ImporterScientific::report(const VencData& venc)
+{
+    _res << "\t\t- VENCs of 3D+T flow images:" << std::endl;
+    _res << "\t\t\t- X (LR) image (ID " << venc.dicom_image_ids_3dt[0] << "): " << venc.vencs_3dt[0] << " [m/s]" << std::endl;
+    _res << "\t\t\t- Y (AP) image (ID " << venc.dicom_image_ids_3dt[1] << "): " << venc.vencs_3dt[1] << " [m/s]" << std::endl;
+    _res << "\t\t\t- Z (FH) image (ID " << venc.dicom_image_ids_3dt[2] << "): " << venc.vencs_3dt[2] << " [m/s]" << std::endl;
 
-    file.close();
+    const unsigned int num2DTFlowImages = venc.vencs_2dt.size();
+    _res << "\t\t- num. 2D+T flow images: " << num2DTFlowImages << std::endl;
 
-    return true;
+    for (unsigned int i = 0; i < num2DTFlowImages; ++i)
+    { _res << "\t\t\t- Image " << i << " (DICOM image ID" << venc.dicom_image_ids_2dt[i] << ") : VENC " << venc.vencs_2dt[i] << " [m/s]" << std::endl; }
 }
 
-bool ImporterScientific::read_vessel_section_segmentation_semantics(std::string_view filepath)
+std::optional<VencData> ImporterScientific::load_venc(std::string_view filepath) const
+{ return load_file(filepath, _parse_venc); }
+
+bool ImporterScientific::read_venc(std::string_view filepath)
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, filepath);
+
     if (!std::filesystem::exists(filepath.data()))
     {
-        _res << "\t- no vessel section segmentation semantics (path \"" << filepath.data() << "\")" << std::endl;
+        _res << "\t- no venc (path \"" << filepath.data() << "\")" << std::endl;
         return false;
     }
 
-    _res << "\t- reading vessel section segmentation semantics (path \"" << filepath.data() << "\")" << std::endl;
+    _res << "\t- reading venc (path \"" << filepath.data() << "\")" << std::endl;
 
-    std::ifstream file(filepath.data(), std::ios_base::in);
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
 
     if (!file.good())
     {
@@ -2642,710 +3365,879 @@ bool ImporterScientific::read_vessel_section_segmentation_semantics(std::string_
         return false;
     }
 
-    std::string line;
-    while (!file.eof())
-    {
-        std::getline(file, line);
+    report(_parse_venc(file));
 
-        if (line.empty())
-        { continue; }
+    return true;
+}
 
-        _res << "\t\t" << line << std::endl;
-    }
+void ImporterScientific::_clean_dir()
+{
+    _dir = bk::string_utils::replace(_dir, "\\", "/");
+
+    if (bk::string_utils::ends_with(_dir, "/"))
+    { _dir = bk::string_utils::chop_back(_dir, 1); }
+}
 
-    file.close();
+std::vector<std::string> ImporterScientific::_find_vessel_names() const
+{
+    std::vector<std::string> names;
 
-    return true;
+    for (auto& dirIt : std::filesystem::directory_iterator(_dir))
+    {
+        if (dirIt.is_directory())
+        { names.emplace_back(dirIt.path().filename().string()); }
+    }
+
+    return names;
 }
 
-bool ImporterScientific::read_centerline_start_end_ids_on_mesh(std::string_view filepath)
+DatasetData ImporterScientific::load_all()
 {
+    _clean_dir();
+    _vessel_names = _find_vessel_names();
+
+    DatasetData ds;
+    ds.dir = _dir;
+
     /*
-     * [1] x [uint32] : seedId
-     * [1] x [uint32] : numTargetIds
-     * [numTargetIds] x [uint32] : targetIds
+     * read dataset
      */
+    ds.filter_tags = load_dataset_filter_tags(_dir + "/dataset_tags.txt");
+    ds.dicom_tags = load_dicom_tags(_dir + "/dicom_tags_3dt_flow");
+    ds.venc = load_venc(_dir + "/venc");
+    ds.cardiac_cycle = load_cardiac_cycle_definition(_dir + "/cardiac_cycle");
+    ds.static_tissue_mask = load_voxel_mask(_dir + "/static_tissue_mask_in_flowfield_size");
+    ds.static_tissue_ivsd_thresholds = load_static_tissue_ivsd_thresholds(_dir + "/static_tissue_ivsd_thresholds");
+    ds.phase_wraps = load_phase_wrapped_voxels(_dir + "/phase_wraps_3dt");
+    ds.flowfield = load_flowfield(_dir + "/flowfield");
+    ds.velocity_offset_correction = load_velocity_offset_correction_3dt(_dir + "/velocity_offset_correction_3dt.voc");
+    ds.flow2dt_images = load_flow2dt_images();
+    ds.magnitude_tmip = load_sparse_image(_dir + "/magnitude3dt_tmip");
+    ds.anatomical_images = load_anatomical_images();
+    ds.pressure_map = load_sparse_image(_dir + "/pressuremap");
+    ds.rotation_direction_map = load_sparse_image(_dir + "/rotationdirection");
+    ds.axial_velocity_map = load_sparse_image(_dir + "/axialvelocity");
+    ds.cos_angle_to_centerline_map = load_sparse_image(_dir + "/cosangletocenterline");
+    ds.turbulent_kinetic_energy_map = load_sparse_image(_dir + "/tke");
+    ds.ivsd = load_sparse_image(_dir + "/ivsd");
+    ds.flow_statistics = load_flow_statistics(_dir + "/flow_stats");
 
-    if (!std::filesystem::exists(filepath.data()))
+    /*
+     * read vessels
+     */
+    ds.vessels.resize(_vessel_names.size());
+
+    for (unsigned int i = 0; i < _vessel_names.size(); ++i)
     {
-        _res << "\t- no centerline start/end ids (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
+        VesselData& v = ds.vessels[i];
+        v.name = _vessel_names[i];
+
+        const std::string vesselPath = _dir + "/" + v.name + "/";
+
+        v.mesh = load_mesh(vesselPath + "mesh");
+        v.centerline_seed_target_ids = load_centerline_start_end_ids_on_mesh(vesselPath + "centerline_seed_target_ids_on_mesh");
+        v.centerlines = load_centerlines(vesselPath + "centerlines");
+        v.flow_jets = load_flow_jet(vesselPath + "flowjets");
+        v.pathlines = load_pathlines(vesselPath + "pathlines");
+        v.measuring_planes = load_landmark_measuring_planes(vesselPath + "measuring_planes");
+        v.segmentation = load_sparse_image(vesselPath + "segmentation");
+        v.segmentation_info = load_segmentation_info(vesselPath + "segmentation_info.txt");
+        v.segmentation_graphcut_ids = load_segmentation_graphcut_inside_outside_ids(vesselPath + "graphcut_segmentation_inside_outside_ids");
+        v.segmentation_in_flowfield_size = load_voxel_mask(vesselPath + "segmentation_in_flowfield_size");
+        v.vessel_section_segmentation = load_vessel_section_segmentation_in_flowfield_size(vesselPath + "vessel_section_segmentation_in_flowfield_size");
+        v.vessel_section_semantics = load_vessel_section_segmentation_semantics(vesselPath + "vessel_section_info.txt");
+    } // for vessels
+
+    return ds;
+}
 
-    _res << "\t- reading centerline start/end ids (path \"" << filepath.data() << "\")" << std::endl;
+SparseImageMetadata ImporterScientific::_scan_nd_scalar_image_in_sparse_matrix_style(std::istream& file)
+{
+    // see _parse_nd_scalar_image_in_sparse_matrix_style()
+    SparseImageMetadata img;
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    read_value(file, img.num_dims);
 
-    if (!file.good())
+    // the metadata scan must not allocate more than the file holds (pre-flight planning of corrupt files)
+    if (num_values(img.num_dims, sizeof(std::uint32_t) + sizeof(double)) > remaining_num_bytes(file))
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
+        file.setstate(std::ios_base::failbit);
+        return img;
     }
 
-    //------------------------------------------------------------------------------------------------------
-    // seedId
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t seedId = 0;
-    file.read(reinterpret_cast<char*>(&seedId), sizeof(std::uint32_t));
-    _res << "\t\t- seed id: " << seedId << std::endl;
+    read_vector(file, img.grid_size, img.num_dims);
+    read_vector(file, img.voxel_scale, img.num_dims);
+    skip(file, (16 + 16 + 25 + 25) * sizeof(double)); // matrices
 
-    //------------------------------------------------------------------------------------------------------
-    // numTargetIds
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numTargetIds = 0;
-    file.read(reinterpret_cast<char*>(&numTargetIds), sizeof(std::uint32_t));
+    read_value(file, img.num_values);
+    skip(file, static_cast<std::uint64_t>(img.num_values) * (img.num_dims * sizeof(std::uint32_t) + sizeof(double)));
 
-    //------------------------------------------------------------------------------------------------------
-    // targetIds
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::uint32_t> targetIds(numTargetIds);
-    file.read(reinterpret_cast<char*>(targetIds.data()), numTargetIds * sizeof(std::uint32_t));
+    return img;
+}
 
-    _res << "\t\t- target ids: ";
-    for (std::uint32_t tid : targetIds)
-    { _res << tid << " "; }
-    _res << std::endl;
+MeshMetadata ImporterScientific::_scan_mesh(std::istream& file)
+{
+    // see _parse_mesh()
+    MeshMetadata mesh;
 
-    return true;
+    read_value(file, mesh.num_points);
+    skip(file, static_cast<std::uint64_t>(mesh.num_points) * 6 * sizeof(double)); // points + normals
+
+    read_value(file, mesh.num_triangles);
+    skip(file, static_cast<std::uint64_t>(mesh.num_triangles) * 3 * (sizeof(std::uint32_t) + sizeof(double))); // triangles + normals
+
+    read_value(file, mesh.num_times);
+
+    return mesh;
 }
 
-bool ImporterScientific::read_static_tissue_mask(std::string_view filepath)
+PolylinesMetadata ImporterScientific::_scan_centerlines(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
+    // see _parse_centerlines()
+    PolylinesMetadata cls;
+
+    read_value(file, cls.num_lines);
+
+    for (unsigned int i = 0; i < cls.num_lines && file.good(); ++i)
     {
-        _res << "\t- no static tissue mask (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
+        std::uint32_t numPoints = 0;
+        read_value(file, numPoints);
+        cls.num_points += numPoints;
+
+        skip(file, static_cast<std::uint64_t>(numPoints) * (3 + 1 + 9) * sizeof(double)); // points + radius + lcs
     }
 
-    _res << "\t- reading static tissue mask (path \"" << filepath.data() << "\")" << std::endl;
+    return cls;
+}
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+PolylinesMetadata ImporterScientific::_scan_pathlines(std::istream& file)
+{
+    // see _parse_pathlines()
+    PolylinesMetadata pls;
 
-    if (!file.good())
+    read_value(file, pls.num_lines);
+
+    for (unsigned int i = 0; i < pls.num_lines && file.good(); ++i)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
+        std::uint32_t numPoints = 0;
+        read_value(file, numPoints);
+        pls.num_points += numPoints;
+
+        skip(file, static_cast<std::uint64_t>(numPoints) * (4 + 5) * sizeof(double) + sizeof(double)); // points + attributes + length
     }
 
-    _read_nd_scalar_image_in_sparse_matrix_style(file);
+    return pls;
+}
 
-    return true;
+CardiacCycleMetadata ImporterScientific::_scan_cardiac_cycle_definition(std::istream& file)
+{
+    // see _parse_cardiac_cycle_definition(); the mean axial velocities are not needed
+    CardiacCycleMetadata cc;
+
+    read_value(file, cc.num_times);
+    read_value(file, cc.id_systole_begin);
+    read_value(file, cc.ms_systole_begin);
+    read_value(file, cc.id_systole_end);
+    read_value(file, cc.ms_systole_end);
+    read_value(file, cc.num_vessels);
+
+    return cc;
 }
 
-bool ImporterScientific::read_static_tissue_ivsd_thresholds(std::string_view filepath)
+MeasuringPlaneRecord ImporterScientific::_scan_measuring_plane(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- no static tissue ivsd thresholds (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
+    // see _parse_measuring_plane()
+    constexpr std::uint64_t numFrameBytes = (3 + 3 + 3 * 3 + 1) * sizeof(double); // scale + center + lcs + diameter
+    constexpr std::uint64_t numStatsBytes = 22 * sizeof(double);
+    constexpr std::uint64_t numFlowJetStatsBytes = 18 * sizeof(double);
 
-    _res << "\t- reading static tissue ivsd thresholds (path \"" << filepath.data() << "\")" << std::endl;
+    MeasuringPlaneRecord r;
+    r.offset = static_cast<std::uint64_t>(file.tellg());
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    read_value(file, r.vessel_id);
+    read_array(file, r.size);
 
-    if (!file.good())
-    {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+    const std::uint64_t numPlanePoints = static_cast<std::uint64_t>(r.size[0]) * r.size[1];
+    const std::uint64_t numGridPoints = numPlanePoints * r.size[2];
+    const std::uint64_t numTimes = r.size[2];
 
-    double lowerThreshold = 0;
-    file.read(reinterpret_cast<char*>(&lowerThreshold), sizeof(double));
+    skip(file, numFrameBytes
+               + numGridPoints * (3 + 1 + 1) * sizeof(double) // flow vectors + axial + circumferential velocity
+               + numPlanePoints * sizeof(std::uint8_t) // segmentation
+               + numStatsBytes
+               + numTimes * 7 * sizeof(double) // per time vectors
+               + numFlowJetStatsBytes
+               + numTimes * 3 * sizeof(double)); // flow jet positions
 
-    double upperThreshold = 0;
-    file.read(reinterpret_cast<char*>(&upperThreshold), sizeof(double));
+    read_value(file, r.num_samples);
+    skip(file, static_cast<std::uint64_t>(r.num_samples) * 5 * sizeof(double));
 
-    _res << "\t\t- lower threshold: " << lowerThreshold << std::endl;
-    _res << "\t\t- upper threshold: " << upperThreshold << std::endl;
+    r.num_bytes = static_cast<std::uint64_t>(file.tellg()) - r.offset;
 
-    return true;
+    return r;
 }
 
-bool ImporterScientific::read_dataset_filter_tags(std::string_view filepath)
+MeasuringPlanesIndex ImporterScientific::_scan_measuring_planes(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- no filter tags (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
+    // see _parse_measuring_planes()
+    MeasuringPlanesIndex index;
 
-    _res << "\t- reading filter tags (path \"" << filepath.data() << "\")" << std::endl;
+    std::uint32_t numMeasuringPlanes = 0;
+    read_value(file, numMeasuringPlanes);
 
-    std::ifstream file(filepath.data(), std::ios_base::in);
+    std::uint32_t numMeasuringPlanesOfLandMarks = 0;
+    read_value(file, numMeasuringPlanesOfLandMarks);
 
-    if (!file.good())
+    for (unsigned int i = 0; i < numMeasuringPlanes && file.good(); ++i)
+    { index.planes.push_back(_scan_measuring_plane(file)); }
+
+    for (unsigned int i = 0; i < numMeasuringPlanesOfLandMarks && file.good(); ++i)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
+        std::uint32_t semantic = 0;
+        read_value(file, semantic);
+
+        index.landmark_planes.push_back(_scan_measuring_plane(file));
+        index.landmark_planes.back().landmark_semantic = semantic;
     }
 
-    std::string csv;
-    std::getline(file, csv);
+    return index;
+}
 
-    std::vector<std::string> tags = bk::string_utils::split(csv, ";");
-    tags.erase(std::remove_if(tags.begin(), tags.end(), [](const std::string& s)
-    { return s.empty(); }));
+MemoryPlanComponent ImporterScientific::_plan_nd_scalar_image_in_sparse_matrix_style(std::istream& file)
+{
+    // see _parse_nd_scalar_image_in_sparse_matrix_style()
+    const SparseImageMetadata img = _scan_nd_scalar_image_in_sparse_matrix_style(file);
 
-    _res << "\t\t- " << tags.size() << " filter tags: ";
+    MemoryPlanComponent c;
+    c.num_bytes = img.num_dims * (sizeof(std::uint32_t) + sizeof(double)) + sparse_image_values_num_bytes(img); // size + scale, grid pos + value
+    c.expected_file_num_bytes = sparse_image_file_num_bytes(img);
 
-    for (const std::string& s: tags)
-    { _res << s << " "; }
-    _res << std::endl;
+    return c;
+}
+
+MemoryPlanComponent ImporterScientific::_plan_voxel_mask(std::istream& file)
+{
+    // see _parse_voxel_mask()
+    const SparseImageMetadata img = _scan_nd_scalar_image_in_sparse_matrix_style(file);
+
+    MemoryPlanComponent c;
+    c.num_bytes = img.num_dims * sizeof(std::uint32_t) + VoxelMask::num_words(img.grid_size) * sizeof(std::uint64_t);
+    c.expected_file_num_bytes = sparse_image_file_num_bytes(img);
+
+    return c;
+}
+
+MemoryPlanComponent ImporterScientific::_plan_mesh(std::istream& file, std::uint64_t payloadNumBytes)
+{
+    // see _parse_mesh()
+    const MeshMetadata mesh = _scan_mesh(file);
+
+    const std::uint64_t numPointValues = num_values(mesh.num_points, 3 + 3 + 6 + 3 * 3); // points, normals, 6 mean wss/osi, 3 mean wss vectors
+    const std::uint64_t numTriangleValues = num_values(mesh.num_triangles, 3); // normals; the indices are uint32
+    const std::uint64_t numTimeValues = num_values(mesh.num_points, mesh.num_times, 3 + 3 * 3); // 3 wss, 3 wss vectors
+
+    MemoryPlanComponent c;
+    c.num_bytes = (numPointValues + numTriangleValues + numTimeValues) * payloadNumBytes + numTriangleValues * sizeof(std::uint32_t);
+    c.expected_file_num_bytes = 3 * sizeof(std::uint32_t) + (numPointValues + numTriangleValues + numTimeValues) * sizeof(double) + numTriangleValues * sizeof(std::uint32_t);
+
+    return c;
+}
+
+MemoryPlanComponent ImporterScientific::_plan_centerlines(std::istream& file)
+{
+    // see _parse_centerlines()
+    const PolylinesMetadata cls = _scan_centerlines(file);
 
-    return true;
+    MemoryPlanComponent c;
+    c.num_bytes = cls.num_points * (3 + 1 + 9) * sizeof(double); // points + radius + lcs
+    c.expected_file_num_bytes = sizeof(std::uint32_t) + num_values(cls.num_lines, sizeof(std::uint32_t)) + c.num_bytes;
+
+    return c;
 }
 
-bool ImporterScientific::read_phase_wrapped_voxels(std::string_view filepath)
+MemoryPlanComponent ImporterScientific::_plan_measuring_planes(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
+    // see _parse_measuring_planes() and _parse_measuring_plane()
+    const MeasuringPlanesIndex index = _scan_measuring_planes(file);
+
+    MemoryPlanComponent c;
+    c.expected_file_num_bytes = 2 * sizeof(std::uint32_t) + index.landmark_planes.size() * sizeof(std::uint32_t);
+
+    for (const std::vector<MeasuringPlaneRecord>* planes: {&index.planes, &index.landmark_planes})
     {
-        _res << "\t- no phase wraps (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
+        for (const MeasuringPlaneRecord& r: *planes)
+        {
+            c.num_bytes += num_values(r.size[0], r.size[1], r.size[2], 3 + 1 + 1) * sizeof(double) // flow vectors + axial + circumferential velocity
+                           + num_values(r.size[0], r.size[1]) * sizeof(std::uint8_t) // segmentation
+                           + num_values(r.size[2], 7 + 3) * sizeof(double) // per time values + flow jet positions
+                           + num_values(r.num_samples, 5) * sizeof(double);
+            c.expected_file_num_bytes += r.num_bytes;
+        }
     }
 
-    _res << "\t- reading phase wraps (path \"" << filepath.data() << "\")" << std::endl;
+    return c;
+}
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+MemoryPlanComponent ImporterScientific::_plan_pathlines(std::istream& file)
+{
+    // see _parse_pathlines()
+    const PolylinesMetadata pls = _scan_pathlines(file);
 
-    if (!file.good())
-    {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+    MemoryPlanComponent c;
+    c.num_bytes = pls.num_points * (4 + 5) * sizeof(double) // points + attributes
+                  + num_values(pls.num_lines, sizeof(double)) // length
+                  + num_values(pls.num_lines + std::uint64_t(1), sizeof(std::size_t)); // offsets
+    c.expected_file_num_bytes = sizeof(std::uint32_t) + num_values(pls.num_lines, sizeof(std::uint32_t) + sizeof(double)) + pls.num_points * (4 + 5) * sizeof(double);
 
-    for (unsigned int dimid = 0; dimid < 3; ++dimid)
-    {
-        //------------------------------------------------------------------------------------------------------
-        // numWrappedVoxels
-        //------------------------------------------------------------------------------------------------------
-        std::uint32_t numWrappedVoxels = 0;
-        file.read(reinterpret_cast<char*>(&numWrappedVoxels), sizeof(std::uint32_t));
-        _res << "\t\tnum. wrapped voxels of 3D+T flow image " << dimid << ": " << numWrappedVoxels << std::endl;
+    return c;
+}
 
-        for (unsigned int i = 0; i < numWrappedVoxels; ++i)
-        {
-            //------------------------------------------------------------------------------------------------------
-            // x y z t gridPos
-            //------------------------------------------------------------------------------------------------------
-            std::vector<std::uint32_t> gridpos(4);
-            file.read(reinterpret_cast<char*>(gridpos.data()), 4 * sizeof(std::uint32_t));
-            if (i < NUM_DEMO)
-            { _res << "\t\t\t- " << i << ": grid pos [" << gridpos[0] << ", " << gridpos[1] << ", " << gridpos[2] << ", " << gridpos[3] << "]"; }
+MemoryPlanComponent ImporterScientific::_plan_flowfield(std::istream& file, std::uint64_t payloadNumBytes)
+{
+    // see _parse_flowfield()
+    const FlowFieldHeader header = _parse_flowfield_header(file);
+    const std::uint64_t n = num_values(header.size[0], header.size[1], header.size[2], header.size[3], 3);
 
-            /*
-             * wrapFactor
-             * - x was corrected via:   x += factor * 2 * venc
-             */
-            std::int8_t wrapFactor = 0;
-            file.read(reinterpret_cast<char*>(&wrapFactor), sizeof(std::int8_t));
-            if (i < NUM_DEMO)
-            { _res << " is wrapped " << static_cast<int>(wrapFactor) << "x" << std::endl; }
-        } // for i
-        _res << "\t\t\t- ..." << std::endl;
-    } // for dimid
+    MemoryPlanComponent c;
+    c.num_bytes = n * payloadNumBytes;
+    c.expected_file_num_bytes = FlowFieldHeader::num_bytes + n * sizeof(double);
 
-    return true;
+    return c;
 }
 
-bool ImporterScientific::read_velocity_offset_correction_3dt(std::string_view filepath)
+MemoryPlanComponent ImporterScientific::_plan_flow_jets(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- no 3D+T flow images' velocity offset correction (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
+    // see _parse_flow_jets()
+    constexpr std::uint64_t perPointTimeNumBytes = (3 + 1 + 3 + 3 + 1 + 3 + 1) * sizeof(double);
+    constexpr std::uint64_t perPointNumBytes = (3 + 1 + 3 + 3) * sizeof(double);
 
-    _res << "\t- reading flow images' velocity offset correction (path \"" << filepath.data() << "\")" << std::endl;
+    MemoryPlanComponent c;
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    std::uint32_t numFlowjets = 0;
+    read_value(file, numFlowjets);
 
-    if (!file.good())
+    for (unsigned int i = 0; i < numFlowjets && file.good(); ++i)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
-
-    //------------------------------------------------------------------------------------------------------
-    // end diastolic time point
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t end_diastolic_time_id = 0;
-    file.read(reinterpret_cast< char*>(&end_diastolic_time_id), sizeof(std::uint32_t));
-    _res << "\t\t- end diastolic time point id: " << end_diastolic_time_id << std::endl;
+        std::uint32_t numPoints = 0;
+        std::uint32_t numTimes = 0;
+        read_value(file, numPoints);
+        read_value(file, numTimes);
 
-    //------------------------------------------------------------------------------------------------------
-    // ivsd threshold
-    //------------------------------------------------------------------------------------------------------
-    double ivsd_static_tissue_threshold = 0;
-    file.read(reinterpret_cast< char*>(&ivsd_static_tissue_threshold), sizeof(double));
-    _res << "\t\t- ivsd static tissue threshold: " << ivsd_static_tissue_threshold << std::endl;
+        const std::uint64_t numBytes = num_values(numPoints, numTimes, perPointTimeNumBytes) + num_values(numPoints, perPointNumBytes);
+        c.num_bytes += numBytes;
+        skip(file, numBytes);
+    }
 
-    std::vector<double> planeCoeffs(3);
+    c.expected_file_num_bytes = sizeof(std::uint32_t) + num_values(numFlowjets, 2 * sizeof(std::uint32_t)) + c.num_bytes;
 
-    for (unsigned int v = 0; v < 3; ++v)
-    {
-        //------------------------------------------------------------------------------------------------------
-        // number of slices
-        //------------------------------------------------------------------------------------------------------
-        std::uint32_t numSlices = 0;
-        file.read(reinterpret_cast< char*>(&numSlices), sizeof(std::uint32_t));
-        _res << "\t\t\t- num. slices in flow image " << v << ": " << numSlices << std::endl;
+    return c;
+}
 
-        std::vector<double> buf(numSlices * 3);
-        file.read(reinterpret_cast<char*>(buf.data()), buf.size() * sizeof(double));
+MemoryPlanComponent ImporterScientific::_plan_flow2dt_image(std::istream& file, std::uint64_t payloadNumBytes)
+{
+    // see _parse_flow2dt_images()
+    std::array<std::uint32_t, 3> size{};
+    read_array(file, size);
 
-        for (unsigned int z = 0; z < NUM_DEMO/*numSlices*/; ++z)
-        {
-            const unsigned int off = 3 * z;
-            _res << "\t\t\t- plane coeffs of slice " << z << ": " << planeCoeffs[off] << ", " << planeCoeffs[off + 1] << ", " << planeCoeffs[off + 2] << std::endl;
-        } // for z : numSlices
-        _res << "\t\t\t- ..." << std::endl;
-    } // for v
+    const std::uint64_t n = num_values(size[0], size[1], size[2]);
 
-    file.close();
+    MemoryPlanComponent c;
+    c.num_bytes = n * payloadNumBytes;
+    c.expected_file_num_bytes = sizeof(size) + (3 + 16 + 16 + 25 + 25) * sizeof(double) + n * sizeof(double);
 
-    return true;
+    return c;
 }
 
-bool ImporterScientific::read_dicom_tags(std::string_view filepath)
+MemoryPlanComponent ImporterScientific::_plan_flow_statistics(std::istream& file)
 {
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- no dicom tags (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
+    // see _parse_flow_statistics()
+    std::uint32_t numTimes = 0;
+    read_value(file, numTimes);
 
-    _res << "\t- reading dicom tags (path \"" << filepath.data() << "\")" << std::endl;
+    MemoryPlanComponent c;
+    for (const auto& [name, perTime]: FLOW_STATISTICS)
+    { c.num_bytes += (perTime ? numTimes : std::uint64_t(1)) * sizeof(double); }
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    c.expected_file_num_bytes = sizeof(std::uint32_t) + c.num_bytes;
 
-    if (!file.good())
-    {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+    return c;
+}
 
-    const auto read_string = [&]() -> std::string
-    {
-        std::uint16_t len = 0;
-        file.read(reinterpret_cast<char*>(&len), sizeof(std::uint16_t));
+MemoryPlanComponent ImporterScientific::_plan_segmentation_graphcut_inside_outside_ids(std::istream& file)
+{
+    // see _parse_segmentation_graphcut_inside_outside_ids()
+    std::uint32_t numInsideIds = 0;
+    read_value(file, numInsideIds);
 
-        std::string s;
-        s.resize(len);
-        file.read(s.data(), s.length());
+    std::uint32_t numOutsideIds = 0;
+    read_value(file, numOutsideIds);
 
-        return s;
-    };
+    MemoryPlanComponent c;
+    c.num_bytes = num_values(std::uint64_t(numInsideIds) + numOutsideIds, 3, sizeof(std::uint32_t));
+    c.expected_file_num_bytes = 2 * sizeof(std::uint32_t) + c.num_bytes;
 
-    std::uint16_t numImages = 0;
-    file.read(reinterpret_cast<char*>(&numImages), sizeof(std::uint16_t));
+    return c;
+}
+
+MemoryPlanComponent ImporterScientific::_plan_vessel_section_segmentation_in_flowfield_size(std::istream& file)
+{
+    // see _parse_vessel_section_segmentation_in_flowfield_size()
+    std::uint32_t numSections = 0;
+    read_value(file, numSections);
 
-    _res << "\t\t- DICOM tags of " << numImages << " images: " << std::endl;
+    MemoryPlanComponent c;
+    c.expected_file_num_bytes = sizeof(std::uint32_t);
 
-    for (unsigned int i = 0; i < numImages; ++i)
+    for (unsigned int sectionid = 0; sectionid < numSections && file.good(); ++sectionid)
     {
-        std::uint16_t dcmImgId = 0;
-        file.read(reinterpret_cast<char*>(&dcmImgId), sizeof(std::uint16_t));
-        _res << "\t\t- DICOM image ID: " << dcmImgId << std::endl;
+        const MemoryPlanComponent section = _plan_nd_scalar_image_in_sparse_matrix_style(file);
+        c.num_bytes += section.num_bytes;
+        c.expected_file_num_bytes += section.expected_file_num_bytes;
+    }
 
-        std::uint16_t nDimensions = 0;
-        file.read(reinterpret_cast<char*>(&nDimensions), sizeof(std::uint16_t));
-        _res << "\t\t\t- nDimensions: " << nDimensions << std::endl;
+    return c;
+}
 
-        std::uint16_t Rows = 0;
-        file.read(reinterpret_cast<char*>(&Rows), sizeof(std::uint16_t));
-        _res << "\t\t\t- Rows: " << Rows << std::endl;
+MemoryPlanComponent ImporterScientific::_plan_centerline_start_end_ids_on_mesh(std::istream& file)
+{
+    // see _parse_centerline_start_end_ids_on_mesh()
+    skip(file, sizeof(std::uint32_t)); // seed id
 
-        std::uint16_t Columns = 0;
-        file.read(reinterpret_cast<char*>(&Columns), sizeof(std::uint16_t));
-        _res << "\t\t\t- Columns: " << Columns << std::endl;
+    std::uint32_t numTargetIds = 0;
+    read_value(file, numTargetIds);
 
-        std::uint16_t Slices = 0;
-        file.read(reinterpret_cast<char*>(&Slices), sizeof(std::uint16_t));
-        _res << "\t\t\t- Slices: " << Slices << std::endl;
+    MemoryPlanComponent c;
+    c.num_bytes = num_values(numTargetIds, sizeof(std::uint32_t));
+    c.expected_file_num_bytes = 2 * sizeof(std::uint32_t) + c.num_bytes;
 
-        std::uint16_t TemporalPositions = 0;
-        file.read(reinterpret_cast<char*>(&TemporalPositions), sizeof(std::uint16_t));
-        _res << "\t\t\t- TemporalPositions: " << TemporalPositions << std::endl;
+    return c;
+}
 
-        std::uint16_t NumberOfFrames = 0;
-        file.read(reinterpret_cast<char*>(&NumberOfFrames), sizeof(std::uint32_t));
-        _res << "\t\t\t- NumberOfFrames: " << NumberOfFrames << std::endl;
+MemoryPlanComponent ImporterScientific::_plan_static_tissue_ivsd_thresholds(std::istream& /*file*/)
+{
+    // see _parse_static_tissue_ivsd_thresholds(); no arrays
+    MemoryPlanComponent c;
+    c.expected_file_num_bytes = 2 * sizeof(double);
 
-        double RowSpacing = 0;
-        file.read(reinterpret_cast<char*>(&RowSpacing), sizeof(double));
-        _res << "\t\t\t- RowSpacing: " << RowSpacing << std::endl;
+    return c;
+}
 
-        double ColSpacing = 0;
-        file.read(reinterpret_cast<char*>(&ColSpacing), sizeof(double));
-        _res << "\t\t\t- ColSpacing: " << ColSpacing << std::endl;
+MemoryPlanComponent ImporterScientific::_plan_phase_wrapped_voxels(std::istream& file)
+{
+    // see _parse_phase_wrapped_voxels()
+    constexpr std::uint64_t perVoxelNumBytes = 4 * sizeof(std::uint32_t) + sizeof(std::int8_t); // grid pos + wrap factor
 
-        double SliceSpacing = 0;
-        file.read(reinterpret_cast<char*>(&SliceSpacing), sizeof(double));
-        _res << "\t\t\t- SliceSpacing: " << SliceSpacing << std::endl;
+    MemoryPlanComponent c;
+    c.expected_file_num_bytes = 3 * sizeof(std::uint32_t);
 
-        double TemporalResolution = 0;
-        file.read(reinterpret_cast<char*>(&TemporalResolution), sizeof(double));
-        _res << "\t\t\t- TemporalResolution: " << TemporalResolution << std::endl;
+    for (unsigned int dimid = 0; dimid < 3 && file.good(); ++dimid)
+    {
+        std::uint32_t numWrappedVoxels = 0;
+        read_value(file, numWrappedVoxels);
 
-        const std::string PatientName = read_string();
-        _res << "\t\t\t- PatientName: " << PatientName << std::endl;
+        const std::uint64_t numBytes = num_values(numWrappedVoxels, perVoxelNumBytes);
+        c.num_bytes += numBytes;
+        c.expected_file_num_bytes += numBytes;
+        skip(file, numBytes);
+    }
 
-        const std::string PatientID = read_string();
-        _res << "\t\t\t- PatientID: " << PatientID << std::endl;
+    return c;
+}
 
-        const std::string PatientSex = read_string();
-        _res << "\t\t\t- PatientSex: " << PatientSex << std::endl;
+MemoryPlanComponent ImporterScientific::_plan_velocity_offset_correction_3dt(std::istream& file)
+{
+    // see _parse_velocity_offset_correction_3dt()
+    skip(file, sizeof(std::uint32_t) + sizeof(double)); // end diastolic time id + ivsd threshold
 
-        std::uint8_t PatientAge = 0;
-        file.read(reinterpret_cast<char*>(&PatientAge), sizeof(std::uint8_t));
-        _res << "\t\t\t- PatientAge: " << static_cast<int>(PatientAge) << std::endl;
+    MemoryPlanComponent c;
+    c.expected_file_num_bytes = sizeof(std::uint32_t) + sizeof(double) + 3 * sizeof(std::uint32_t);
 
-        double PatientWeight = 0;
-        file.read(reinterpret_cast<char*>(&PatientWeight), sizeof(double));
-        _res << "\t\t\t- PatientWeight: " << PatientWeight << std::endl;
+    for (unsigned int v = 0; v < 3 && file.good(); ++v)
+    {
+        std::uint32_t numSlices = 0;
+        read_value(file, numSlices);
 
-        const std::string PatientBirthDate = read_string();
-        _res << "\t\t\t- PatientBirthDate: " << PatientBirthDate << std::endl;
+        const std::uint64_t numBytes = num_values(numSlices, 3, sizeof(double));
+        c.num_bytes += numBytes;
+        c.expected_file_num_bytes += numBytes;
+        skip(file, numBytes);
+    }
 
-        const std::string SequenceName = read_string();
-        _res << "\t\t\t- SequenceName: " << SequenceName << std::endl;
+    return c;
+}
 
-        const std::string SequenceName_Private = read_string();
-        _res << "\t\t\t- SequenceName_Private: " << SequenceName_Private << std::endl;
+MemoryPlanComponent ImporterScientific::_plan_cardiac_cycle_definition(std::istream& file)
+{
+    // see _parse_cardiac_cycle_definition()
+    const CardiacCycleMetadata cc = _scan_cardiac_cycle_definition(file);
 
-        const std::string PatientPosition = read_string();
-        _res << "\t\t\t- PatientPosition: " << PatientPosition << std::endl;
+    MemoryPlanComponent c;
+    c.num_bytes = num_values(cc.num_vessels, cc.num_times, sizeof(double));
+    c.expected_file_num_bytes = 4 * sizeof(std::uint32_t) + 2 * sizeof(double) + c.num_bytes;
 
-        const std::string StudyDescription = read_string();
-        _res << "\t\t\t- StudyDescription: " << StudyDescription << std::endl;
+    return c;
+}
 
-        const std::string SeriesDescription = read_string();
-        _res << "\t\t\t- SeriesDescription: " << SeriesDescription << std::endl;
+MemoryPlanComponent ImporterScientific::_plan_venc(std::istream& file)
+{
+    // see _parse_venc()
+    constexpr std::uint64_t perImageNumBytes = sizeof(std::uint16_t) + sizeof(double);
+    skip(file, 3 * perImageNumBytes); // 3D+T flow images
 
-        const std::string SeriesInstanceUID = read_string();
-        _res << "\t\t\t- SeriesInstanceUID: " << SeriesInstanceUID << std::endl;
+    std::uint8_t num2DTFlowImages = 0;
+    read_value(file, num2DTFlowImages);
 
-        const std::string StudyInstanceUID = read_string();
-        _res << "\t\t\t- StudyInstanceUID: " << StudyInstanceUID << std::endl;
+    MemoryPlanComponent c;
+    c.num_bytes = num2DTFlowImages * perImageNumBytes;
+    c.expected_file_num_bytes = 3 * perImageNumBytes + sizeof(std::uint8_t) + c.num_bytes;
 
-        const std::string ProtocolName = read_string();
-        _res << "\t\t\t- ProtocolName: " << ProtocolName << std::endl;
+    return c;
+}
 
-        const std::string Modality = read_string();
-        _res << "\t\t\t- Modality: " << Modality << std::endl;
+DatasetMetadata ImporterScientific::scan_all()
+{
+    _clean_dir();
+    _vessel_names = _find_vessel_names();
 
-        std::uint8_t SamplesPerPixel = 0;
-        file.read(reinterpret_cast<char*>(&SamplesPerPixel), sizeof(std::uint8_t));
-        _res << "\t\t\t- SamplesPerPixel: " << static_cast<int>(SamplesPerPixel) << std::endl;
+    DatasetMetadata md;
+    md.dir = _dir;
 
-        std::uint32_t LargestImagePixelValue = 0;
-        file.read(reinterpret_cast<char*>(&LargestImagePixelValue), sizeof(std::uint32_t));
-        _res << "\t\t\t- LargestImagePixelValue: " << LargestImagePixelValue << std::endl;
+    md.flowfield = load_file(_dir + "/flowfield", _parse_flowfield_header);
+    md.venc = load_venc(_dir + "/venc");
+    md.cardiac_cycle = load_file(_dir + "/cardiac_cycle", _scan_cardiac_cycle_definition);
+    md.magnitude_tmip = load_file(_dir + "/magnitude3dt_tmip", _scan_nd_scalar_image_in_sparse_matrix_style);
 
-        std::uint8_t BitsAllocated = 0;
-        file.read(reinterpret_cast<char*>(&BitsAllocated), sizeof(std::uint8_t));
-        _res << "\t\t\t- BitsAllocated: " << static_cast<int>(BitsAllocated) << std::endl;
+    md.vessels.resize(_vessel_names.size());
 
-        std::uint8_t BitsStored = 0;
-        file.read(reinterpret_cast<char*>(&BitsStored), sizeof(std::uint8_t));
-        _res << "\t\t\t- BitsStored: " << static_cast<int>(BitsStored) << std::endl;
+    for (unsigned int i = 0; i < _vessel_names.size(); ++i)
+    {
+        VesselMetadata& v = md.vessels[i];
+        v.name = _vessel_names[i];
 
-        std::uint8_t HighBit = 0;
-        file.read(reinterpret_cast<char*>(&HighBit), sizeof(std::uint8_t));
-        _res << "\t\t\t- HighBit: " << static_cast<int>(HighBit) << std::endl;
+        const std::string vesselPath = _dir + "/" + v.name + "/";
 
-        const std::string AcquisitionDate = read_string();
-        _res << "\t\t\t- AcquisitionDate: " << AcquisitionDate << std::endl;
+        v.mesh = load_file(vesselPath + "mesh", _scan_mesh);
+        v.centerlines = load_file(vesselPath + "centerlines", _scan_centerlines);
+        v.pathlines = load_file(vesselPath + "pathlines", _scan_pathlines);
+        v.measuring_planes = load_file(vesselPath + "measuring_planes", _scan_measuring_planes);
+        v.segmentation_in_flowfield_size = load_file(vesselPath + "segmentation_in_flowfield_size", _scan_nd_scalar_image_in_sparse_matrix_style);
+    } // for vessels
 
-        const std::string InstitutionName = read_string();
-        _res << "\t\t\t- InstitutionName: " << InstitutionName << std::endl;
+    return md;
+}
 
-        std::vector<double> ImageOrientationPatientX(3);
-        file.read(reinterpret_cast<char*>(ImageOrientationPatientX.data()), 3 * sizeof(double));
-        _res << "\t\t\t- ImageOrientationPatientX: [" << ImageOrientationPatientX[0] << ", " << ImageOrientationPatientX[1] << ", " << ImageOrientationPatientX[2] << "]" << std::endl;
+MemoryPlan ImporterScientific::plan_memory()
+{
+    _clean_dir();
+    _vessel_names = _find_vessel_names();
 
-        std::vector<double> ImageOrientationPatientY(3);
-        file.read(reinterpret_cast<char*>(ImageOrientationPatientY.data()), 3 * sizeof(double));
-        _res << "\t\t\t- ImageOrientationPatientY: [" << ImageOrientationPatientY[0] << ", " << ImageOrientationPatientY[1] << ", " << ImageOrientationPatientY[2] << "]" << std::endl;
+    MemoryPlan plan;
+    plan.dir = _dir;
 
-        std::vector<double> worldMatrix(16);
-        file.read(reinterpret_cast<char*>(worldMatrix.data()), 16 * sizeof(double));
-        unsigned int cnt = 0;
-        _res << "\t\t\t- world matrix:" << std::endl;
-        for (unsigned int rowid = 0; rowid < 4; ++rowid)
-        {
-            _res << "\t\t\t\t";
-            for (unsigned int colid = 0; colid < 4; ++colid)
-            { _res << worldMatrix[cnt++] << " "; }
+    const std::uint64_t payloadNumBytes = _single_precision ? sizeof(float) : sizeof(double);
 
-            _res << std::endl;
-        }
-    } // for image ids
+    // one component over all files; missing files are skipped (the readers report them as missing, not as failed); planFile == nullptr: text
+    const auto add = [&](std::string name, const std::vector<std::string>& filepaths, const std::function<MemoryPlanComponent(std::istream&)>& planFile)
+    {
+        MemoryPlanComponent c;
+        c.name = std::move(name);
 
-    file.close();
+        bool found = false;
+        for (const std::string& filepath: filepaths)
+        {
+            std::error_code ec;
+            const std::uintmax_t fileNumBytes = std::filesystem::file_size(filepath, ec);
 
-    return true;
-}
+            if (ec)
+            { continue; }
 
-bool ImporterScientific::read_cardiac_cycle_definition(std::string_view filepath)
-{
-    /*
-     * [1] x [uint32] : numTimes
-     * [1] x [uint32] : idSystoleBegin
-     * [1] x [double] : msSystoleBegin
-     * [1] x [uint32] : idSystoleEnd
-     * [1] x [double] : msSystoleEnd
-     * [1] x [uint32] : numVessels
-     * for numVessels
-     *      [numTimes] x [double] : axial velocity per time in vessel
-     */
+            found = true;
+            c.file_num_bytes += fileNumBytes;
 
-    if (!std::filesystem::exists(filepath.data()))
-    {
-        _res << "\t- no cardiac cycle definition (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
-    }
+            if (!planFile)
+            {
+                c.num_bytes += fileNumBytes;
+                continue;
+            }
 
-    _res << "\t- reading cardiac cycle definition (path \"" << filepath.data() << "\")" << std::endl;
+            std::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
+            const MemoryPlanComponent f = planFile(file);
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+            c.num_bytes += f.num_bytes;
+            c.expected_file_num_bytes += f.expected_file_num_bytes;
+            c.truncated = c.truncated || file.fail() || f.expected_file_num_bytes > fileNumBytes;
+        } // for filepaths
 
-    if (!file.good())
+        if (found)
+        { plan.components.push_back(std::move(c)); }
+    };
+
+    const auto add_file = [&](std::string name, const std::function<MemoryPlanComponent(std::istream&)>& planFile)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+        const std::string filepath = _dir + "/" + name;
+        add(std::move(name), {filepath}, planFile);
+    };
 
-    //------------------------------------------------------------------------------------------------------
-    // numTimes
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numTimes = 0;
-    file.read(reinterpret_cast< char*>(&numTimes), sizeof(std::uint32_t));
-    _res << "\t\t- num. times: " << numTimes << std::endl;
+    const auto add_files = [&](std::string name, std::vector<std::string> names, const std::function<MemoryPlanComponent(std::istream&)>& planFile)
+    {
+        std::sort(names.begin(), names.end());
 
-    //------------------------------------------------------------------------------------------------------
-    // idSystoleBegin
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t idSystoleBegin = 0;
-    file.read(reinterpret_cast<char*>(&idSystoleBegin), sizeof(std::uint32_t));
+        for (std::string& n: names)
+        { n = _dir + "/" + n; }
 
-    //------------------------------------------------------------------------------------------------------
-    // msSystoleBegin
-    //------------------------------------------------------------------------------------------------------
-    double msSystoleBegin = 0;
-    file.read(reinterpret_cast<char*>(&msSystoleBegin), sizeof(double));
+        add(std::move(name), names, planFile);
+    };
 
-    _res << "\t\t- systole begin (= diastole end): " << msSystoleBegin << " [ms] (time point id " << idSystoleBegin << ")" << std::endl;
+    const auto plan_sparse_image = _plan_nd_scalar_image_in_sparse_matrix_style;
 
     //------------------------------------------------------------------------------------------------------
-    // idSystoleEnd
+    // dataset; same files as read_all()
     //------------------------------------------------------------------------------------------------------
-    std::uint32_t idSystoleEnd = 0;
-    file.read(reinterpret_cast<char*>(&idSystoleEnd), sizeof(std::uint32_t));
+    add_file("dataset_tags.txt", nullptr);
+    add_file("dicom_tags_3dt_flow", nullptr); // strings
+    add_file("venc", _plan_venc);
+    add_file("cardiac_cycle", _plan_cardiac_cycle_definition);
+    add_file("static_tissue_mask_in_flowfield_size", _plan_voxel_mask);
+    add_file("static_tissue_ivsd_thresholds", _plan_static_tissue_ivsd_thresholds);
+    add_file("phase_wraps_3dt", _plan_phase_wrapped_voxels);
+    add_file("flowfield", [&](std::istream& file)
+    {
+        MemoryPlanComponent c = _plan_flowfield(file, payloadNumBytes);
+        if (_flowfield_memory_mapped)
+        { c.num_bytes = 0; } // page cache, not heap
 
-    //------------------------------------------------------------------------------------------------------
-    // msSystoleEnd
-    //------------------------------------------------------------------------------------------------------
-    double msSystoleEnd = 0;
-    file.read(reinterpret_cast<char*>(&msSystoleEnd), sizeof(double));
+        return c;
+    });
+    add_file("velocity_offset_correction_3dt.voc", _plan_velocity_offset_correction_3dt);
+    add_files("*flowfield_2dt*", _find_files("flowfield_2dt"), [&](std::istream& file)
+    { return _plan_flow2dt_image(file, payloadNumBytes); });
+    add_file("magnitude3dt_tmip", plan_sparse_image);
 
-    _res << "\t\t- systole end (= diastole begin): " << msSystoleEnd << " [ms] (time point id " << idSystoleEnd << ")" << std::endl;
+    std::vector<std::string> anatomicalNames = _find_files("3d_anatomical_image");
+    for (std::string& n: _find_files("3dt_anatomical_image"))
+    { anatomicalNames.push_back(std::move(n)); }
+    add_files("*anatomical_image*", std::move(anatomicalNames), plan_sparse_image);
 
-    //------------------------------------------------------------------------------------------------------
-    // numVessels
-    //------------------------------------------------------------------------------------------------------
-    std::uint32_t numVessels = 0;
-    file.read(reinterpret_cast<char*>(&numVessels), sizeof(std::uint32_t));
+    for (std::string_view name: {"pressuremap", "rotationdirection", "axialvelocity", "cosangletocenterline", "tke", "ivsd"})
+    { add_file(std::string(name), plan_sparse_image); }
 
-    _res << "\t\t- num. vessels: " << numVessels << std::endl;
+    add_file("flow_stats", _plan_flow_statistics);
 
     //------------------------------------------------------------------------------------------------------
-    // mean axial velocity per vessel
+    // vessels
     //------------------------------------------------------------------------------------------------------
-    std::vector<double> dbuffer(numVessels * numTimes);
-    file.read(reinterpret_cast<char*>(dbuffer.data()), dbuffer.size() * sizeof(double));
-
-    for (unsigned int vid = 0; vid < numVessels; ++vid)
+    for (const std::string& vname: _vessel_names)
     {
-        const unsigned int off = vid * numTimes;
-        _res << "\t\t- mean axial velocity [m/s] per time in vessel " << vid << ": ";
-
-        for (unsigned int t = 0; t < NUM_DEMO; ++t)
-        { _res << dbuffer[off + t] << ", "; }
-        _res << "..." << std::endl;
-    } // for vid : num vessels
-
-    file.close();
+        add_file(vname + "/mesh", [&](std::istream& file)
+        { return _plan_mesh(file, payloadNumBytes); });
+        add_file(vname + "/centerline_seed_target_ids_on_mesh", _plan_centerline_start_end_ids_on_mesh);
+        add_file(vname + "/centerlines", _plan_centerlines);
+        add_file(vname + "/flowjets", _plan_flow_jets);
+        add_file(vname + "/pathlines", _plan_pathlines);
+        add_file(vname + "/measuring_planes", _plan_measuring_planes);
+        add_file(vname + "/segmentation", plan_sparse_image);
+        add_file(vname + "/segmentation_info.txt", nullptr);
+        add_file(vname + "/graphcut_segmentation_inside_outside_ids", _plan_segmentation_graphcut_inside_outside_ids);
+        add_file(vname + "/segmentation_in_flowfield_size", _plan_voxel_mask);
+        add_file(vname + "/vessel_section_segmentation_in_flowfield_size", _plan_vessel_section_segmentation_in_flowfield_size);
+        add_file(vname + "/vessel_section_info.txt", nullptr);
+    } // for vessels
+
+    return plan;
+}
 
-    return true;
+ImporterScientific ImporterScientific::_make_task_importer() const
+{
+    ImporterScientific im;
+    im._dir = _dir;
+    im._vessel_names = _vessel_names;
+    im._flowfield_memory_mapped = _flowfield_memory_mapped;
+    im._single_precision = _single_precision;
+    im._async_io = _async_io;
+    im._profiler = _profiler;
+    im._res.set_float_format(_res.float_format());
+    im._res.set_precision(_res.precision());
+
+    // tasks report into memory and are appended in order; a disabled report stays disabled
+    if (!_res.is_enabled())
+    { im._res.set_sink(&null_report_sink()); }
+
+    return im;
 }
 
-bool ImporterScientific::read_venc(std::string_view filepath)
+void ImporterScientific::_run_tasks(const std::vector<std::function<void(ImporterScientific&)>>& tasks)
 {
-    /*
-     * [1] x [uint16] : dicom image id of 3D+T flow image X (LR)
-     * [1] x [double] : venc 3D+T flow image X (LR)
-     * [1] x [uint16] : dicom image id of 3D+T flow image Y (AP)
-     * [1] x [double] : venc 3D+T flow image Y (AP)
-     * [1] x [uint16] : dicom image id of 3D+T flow image Z (FH)
-     * [1] x [double] : venc 3D+T flow image Z (FH)
-     * [1] x [uint8] : num2DTFlowImages
-     * for num2DTFlowImages
-     *      [1] x [uint16] : dicom image id
-     *      [1] x [double] : venc
-     */
+    const unsigned int numThreads = _num_threads != 0 ? _num_threads : std::thread::hardware_concurrency();
 
-    if (!std::filesystem::exists(filepath.data()))
+    if (_thread_pool == nullptr && numThreads <= 1)
     {
-        _res << "\t- no venc (path \"" << filepath.data() << "\")" << std::endl;
-        return false;
+        for (const std::function<void(ImporterScientific&)>& task: tasks)
+        { task(*this); }
+
+        return;
     }
 
-    _res << "\t- reading venc (path \"" << filepath.data() << "\")" << std::endl;
+    /*
+     * every task reports into the buffers of its own importer;
+     * the buffers are appended in task order so the output does not depend on the schedule
+     */
+    std::unique_ptr<ThreadPool> ownPool;
+    if (_thread_pool == nullptr)
+    { ownPool = std::make_unique<ThreadPool>(std::min(numThreads, static_cast<unsigned int>(tasks.size()))); }
 
-    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    ThreadPool& pool = _thread_pool != nullptr ? *_thread_pool : *ownPool;
 
-    if (!file.good())
+    std::vector<std::future<std::pair<std::string, std::string>>> parts;
+    parts.reserve(tasks.size());
+
+    for (const std::function<void(ImporterScientific&)>& task: tasks)
     {
-        _res << "\t\tFAILED! Could not open file!" << std::endl;
-        return false;
-    }
+        // by value: a shared pool may still run the task after the caller's vector is gone
+        parts.emplace_back(pool.enqueue([this, task]()
+                                        {
+                                            ImporterScientific im = _make_task_importer();
 
-    //------------------------------------------------------------------------------------------------------
-    // vencs of 3D+T flow images
-    //------------------------------------------------------------------------------------------------------
-    _res << "\t\t- VENCs of 3D+T flow images:" << std::endl;
+                                            std::stringstream console;
+                                            im._console = &console;
 
-    std::vector<std::uint16_t> dcmImgIdsFlow3DT(3);
-    std::vector<double> vencsFlow3DT(3);
+                                            task(im);
 
-    for (unsigned int i = 0; i < 3; ++i)
-    {
-        file.read(reinterpret_cast< char*>(&dcmImgIdsFlow3DT[i]), sizeof(std::uint16_t));
-        file.read(reinterpret_cast< char*>(&vencsFlow3DT[i]), sizeof(double));
+                                            return std::make_pair(im._res.str(), console.str());
+                                        }));
     }
 
-    _res << "\t\t\t- X (LR) image (ID " << dcmImgIdsFlow3DT[0] << "): " << vencsFlow3DT[0] << " [m/s]" << std::endl;
-    _res << "\t\t\t- Y (AP) image (ID " << dcmImgIdsFlow3DT[1] << "): " << vencsFlow3DT[1] << " [m/s]" << std::endl;
-    _res << "\t\t\t- Z (FH) image (ID " << dcmImgIdsFlow3DT[2] << "): " << vencsFlow3DT[2] << " [m/s]" << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // num2DTFlowImages
-    //------------------------------------------------------------------------------------------------------
-    std::uint8_t num2DTFlowImages = 0;
-    file.read(reinterpret_cast<char*>(&num2DTFlowImages), sizeof(std::uint8_t));
-    _res << "\t\t- num. 2D+T flow images: " << static_cast<int>(num2DTFlowImages) << std::endl;
-
-    //------------------------------------------------------------------------------------------------------
-    // vencs of 2D+T flow images
-    //------------------------------------------------------------------------------------------------------
-    std::vector<std::uint16_t> dcmImgIdsFlow2DT(num2DTFlowImages);
-    std::vector<double> vencsFlow2DT(num2DTFlowImages);
+    /*
+     * every task refers to this importer -> all of them have to finish before an error is rethrown;
+     * the first error in task order wins
+     */
+    std::exception_ptr error;
 
-    for (unsigned int i = 0; i < num2DTFlowImages; ++i)
+    for (std::future<std::pair<std::string, std::string>>& part: parts)
     {
-        file.read(reinterpret_cast< char*>(&dcmImgIdsFlow2DT[i]), sizeof(std::uint16_t));
-        file.read(reinterpret_cast< char*>(&vencsFlow2DT[i]), sizeof(double));
-    }
-
-    for (unsigned int i = 0; i < num2DTFlowImages; ++i)
-    { _res << "\t\t\t- Image " << i << " (DICOM image ID" << dcmImgIdsFlow2DT[i] << ") : VENC " << vencsFlow2DT[i] << " [m/s]" << std::endl; }
+        try
+        {
+            // the caller may itself be a task of a shared pool -> help instead of blocking
+            const std::pair<std::string, std::string> p = pool.wait(part);
 
-    file.close();
+            if (!error)
+            {
+                _res << p.first;
+                *_console << p.second << std::flush;
+            }
+        }
+        catch (...)
+        {
+            if (!error)
+            { error = std::current_exception(); }
+        }
+    } // for parts
 
-    return true;
+    if (error)
+    { std::rethrow_exception(error); }
 }
 
 std::string ImporterScientific::read_all()
 {
+    const ImportProfiler::Scope profile(_profiler, __func__, _dir);
+
     /*
      * clean up
      */
-    _res.str("");
-    _res << std::fixed;
-    _res.precision(2);
+    _res.clear();
+    _res.set_float_format(ReportFloatFormat::Fixed);
+    _res.set_precision(2);
 
     _vessel_names.clear();
 
     /*
      * clear dir path
      */
-    _dir = bk::string_utils::replace(_dir, "\\", "/");
-
-    if (bk::string_utils::ends_with(_dir, "/"))
-    { _dir = bk::string_utils::chop_back(_dir, 1); }
+    _clean_dir();
 
     _res << "Reading directory \"" << _dir << "\"" << std::endl;
 
     /*
      * iterate directory -> find available vessels
      */
-    for (auto& dirIt : std::filesystem::directory_iterator(_dir))
-    {
-        if (dirIt.is_directory())
-        { _vessel_names.emplace_back(dirIt.path().filename().string()); }
-    }
+    _vessel_names = _find_vessel_names();
 
     _res << "\t- found " << _vessel_names.size() << " vessel(s): ";
     for (std::string_view vname: _vessel_names)
     { _res << "\"" << vname << "\" "; }
     _res << std::endl;
 
+    /*
+     * all readers touch independent files -> one task per reader
+     */
+    std::vector<std::function<void(ImporterScientific&)>> tasks;
+
+    const auto add_reader = [&](bool (ImporterScientific::*read)(std::string_view), std::string filepath)
+    {
+        tasks.emplace_back([read, filepath = std::move(filepath)](ImporterScientific& im)
+                           { (im.*read)(filepath); });
+    };
+
     /*
      * read dataset
      */
-    read_dataset_filter_tags(_dir + "/dataset_tags.txt");
-    read_dicom_tags(_dir + "/dicom_tags_3dt_flow");
-    read_venc(_dir + "/venc");
-    read_cardiac_cycle_definition(_dir + "/cardiac_cycle");
-    read_static_tissue_mask(_dir + "/static_tissue_mask_in_flowfield_size");
-    read_static_tissue_ivsd_thresholds(_dir + "/static_tissue_ivsd_thresholds");
-    read_phase_wrapped_voxels(_dir + "/phase_wraps_3dt");
-    read_flowfield(_dir + "/flowfield");
-    read_velocity_offset_correction_3dt(_dir + "/velocity_offset_correction_3dt.voc");
-    read_flow2dt_images();
-    read_magnitude_tmip(_dir + "/magnitude3dt_tmip");
-    read_anatomical_images();
-    read_pressure_map(_dir + "/pressuremap");
-    read_rotation_direction_map(_dir + "/rotationdirection");
-    read_axial_velocity_map(_dir + "/axialvelocity");
-    read_cos_angle_to_centerline_map(_dir + "/cosangletocenterline");
-    read_turbulent_kinetic_energy_map(_dir + "/tke");
-    read_ivsd(_dir + "/ivsd");
-    //read_dicom_tags(_dir + "/dicom_tags_3dt_anatomical");
-    //read_dicom_tags(_dir + "/dicom_tags_3dt_magnitude");
-    //read_dicom_tags(_dir + "/dicom_tags_3dt_signal_intensity");
-    //read_dicom_tags(_dir + "/dicom_tags_3d_anatomical");
-    //read_dicom_tags(_dir + "/dicom_tags_2dt_flow");
-    //read_dicom_tags(_dir + "/dicom_tags_2dt_anatomical");
-    //read_dicom_tags(_dir + "/dicom_tags_2d_anatomical");
-    read_flow_statistics(_dir + "/flow_stats");
+    add_reader(&ImporterScientific::read_dataset_filter_tags, _dir + "/dataset_tags.txt");
+    add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_3dt_flow");
+    add_reader(&ImporterScientific::read_venc, _dir + "/venc");
+    add_reader(&ImporterScientific::read_cardiac_cycle_definition, _dir + "/cardiac_cycle");
+    add_reader(&ImporterScientific::read_static_tissue_mask, _dir + "/static_tissue_mask_in_flowfield_size");
+    add_reader(&ImporterScientific::read_static_tissue_ivsd_thresholds, _dir + "/static_tissue_ivsd_thresholds");
+    add_reader(&ImporterScientific::read_phase_wrapped_voxels, _dir + "/phase_wraps_3dt");
+    add_reader(&ImporterScientific::read_flowfield, _dir + "/flowfield");
+    add_reader(&ImporterScientific::read_velocity_offset_correction_3dt, _dir + "/velocity_offset_correction_3dt.voc");
+    tasks.emplace_back([](ImporterScientific& im)
+                       { im.read_flow2dt_images(); });
+    add_reader(&ImporterScientific::read_magnitude_tmip, _dir + "/magnitude3dt_tmip");
+    tasks.emplace_back([](ImporterScientific& im)
+                       { im.read_anatomical_images(); });
+    add_reader(&ImporterScientific::read_pressure_map, _dir + "/pressuremap");
+    add_reader(&ImporterScientific::read_rotation_direction_map, _dir + "/rotationdirection");
+    add_reader(&ImporterScientific::read_axial_velocity_map, _dir + "/axialvelocity");
+    add_reader(&ImporterScientific::read_cos_angle_to_centerline_map, _dir + "/cosangletocenterline");
+    add_reader(&ImporterScientific::read_turbulent_kinetic_energy_map, _dir + "/tke");
+    add_reader(&ImporterScientific::read_ivsd, _dir + "/ivsd");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_3dt_anatomical");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_3dt_magnitude");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_3dt_signal_intensity");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_3d_anatomical");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_2dt_flow");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_2dt_anatomical");
+    //add_reader(&ImporterScientific::read_dicom_tags, _dir + "/dicom_tags_2d_anatomical");
+    add_reader(&ImporterScientific::read_flow_statistics, _dir + "/flow_stats");
 
     /*
      * read vessels
      */
-    for (std::string_view vname: _vessel_names)
+    for (const std::string& vname: _vessel_names)
     {
-        const std::string vesselPath = _dir + "/" + vname.data() + "/";
-
-        _res << "-----------------------------------------------------------------------------------------------------------------------" << std::endl;
-        _res << "-----------------------------------------------------------------------------------------------------------------------" << std::endl;
-        _res << "Reading vessel \"" << vname << "\" (path \"" << vesselPath << "\")" << std::endl;
-
-        read_mesh(vesselPath + "mesh");
-        read_centerline_start_end_ids_on_mesh(vesselPath + "centerline_seed_target_ids_on_mesh");
-        read_centerlines(vesselPath + "centerlines");
-        read_flow_jet(vesselPath + "flowjets");
-        read_pathlines(vesselPath + "pathlines");
-        read_landmark_measuring_planes(vesselPath + "measuring_planes");
-        read_segmentation(vesselPath + "segmentation");
-        read_segmentation_info(vesselPath + "segmentation_info.txt");
-        read_segmentation_graphcut_inside_outside_ids(vesselPath + "graphcut_segmentation_inside_outside_ids");
-        read_segmentation_in_flowfield_size(vesselPath + "segmentation_in_flowfield_size");
-        read_vessel_section_segmentation_in_flowfield_size(vesselPath + "vessel_section_segmentation_in_flowfield_size");
-        read_vessel_section_segmentation_semantics(vesselPath + "vessel_section_info.txt");
+        const std::string vesselPath = _dir + "/" + vname + "/";
+
+        tasks.emplace_back([vname, vesselPath](ImporterScientific& im)
+                           {
+                               im._res << "-----------------------------------------------------------------------------------------------------------------------" << std::endl;
+                               im._res << "-----------------------------------------------------------------------------------------------------------------------" << std::endl;
+                               im._res << "Reading vessel \"" << vname << "\" (path \"" << vesselPath << "\")" << std::endl;
+                           });
+
+        add_reader(&ImporterScientific::read_mesh, vesselPath + "mesh");
+        add_reader(&ImporterScientific::read_centerline_start_end_ids_on_mesh, vesselPath + "centerline_seed_target_ids_on_mesh");
+        add_reader(&ImporterScientific::read_centerlines, vesselPath + "centerlines");
+        add_reader(&ImporterScientific::read_flow_jet, vesselPath + "flowjets");
+        add_reader(&ImporterScientific::read_pathlines, vesselPath + "pathlines");
+        add_reader(&ImporterScientific::read_landmark_measuring_planes, vesselPath + "measuring_planes");
+        add_reader(&ImporterScientific::read_segmentation, vesselPath + "segmentation");
+        add_reader(&ImporterScientific::read_segmentation_info, vesselPath + "segmentation_info.txt");
+        add_reader(&ImporterScientific::read_segmentation_graphcut_inside_outside_ids, vesselPath + "graphcut_segmentation_inside_outside_ids");
+        add_reader(&ImporterScientific::read_segmentation_in_flowfield_size, vesselPath + "segmentation_in_flowfield_size");
+        add_reader(&ImporterScientific::read_vessel_section_segmentation_in_flowfield_size, vesselPath + "vessel_section_segmentation_in_flowfield_size");
+        add_reader(&ImporterScientific::read_vessel_section_segmentation_semantics, vesselPath + "vessel_section_info.txt");
     } // for vesselNames
 
+    _run_tasks(tasks);
+
     return _res.str();
-}
\ No newline at end of file
+}
@@ -26,12 +26,23 @@
 #define BLOODLINE_IMPORTERSCIENTIFIC_H
 
 #include <fstream>
+#include <functional>
 #include <memory>
-#include <sstream>
+#include <optional>
+#include <ostream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "FlowFieldView.h"
+#include "ImporterScientificData.h"
+#include "ReportWriter.h"
+#include "SparseImageIndex.h"
+
+class ImportProfiler;
+class ThreadPool;
+
 class ImporterScientific
 {
     //====================================================================================================
@@ -44,7 +55,14 @@ class ImporterScientific
     //====================================================================================================
     std::string _dir;
     std::vector<std::string> _vessel_names;
-    std::stringstream _res;
+    ReportWriter _res;
+    std::ostream* _console; // measuring plane counts/semantics are printed here (std::cout) instead of _res
+    bool _flowfield_memory_mapped;
+    bool _single_precision;
+    bool _async_io;
+    unsigned int _num_threads;
+    ThreadPool* _thread_pool; // not owned
+    ImportProfiler* _profiler; // not owned
 
     //====================================================================================================
     //===== CONSTRUCTORS & DESTRUCTOR
@@ -61,6 +79,9 @@ class ImporterScientific
     //====================================================================================================
     [[nodiscard]] std::string result() const;
 
+    //! name and whether it is a per-time vector of every entry of the "flow_stats" file; in file order
+    [[nodiscard]] static std::vector<std::pair<std::string_view, bool>> flow_statistics_layout();
+
     //====================================================================================================
     //===== SETTER
     //====================================================================================================
@@ -69,10 +90,192 @@ class ImporterScientific
 
     void set_dir(std::string_view dir);
 
+    //! read_flowfield() maps the file (FlowFieldView) instead of reading the whole payload
+    void set_flowfield_memory_mapped(bool b);
+
+    //! read_flowfield(), read_mesh() and read_flow2dt_images() convert the payloads to float while reading and report the conversion error
+    void set_single_precision(bool b);
+
+    //! the mesh and flowfield readers fetch the next byte ranges of the file while parsing the current one (PrefetchStreamBuf)
+    void set_async_io(bool b);
+
+    //! number of threads used by read_all(); 0 = std::thread::hardware_concurrency(), 1 = sequential
+    void set_num_threads(unsigned int n);
+
+    //! read_all() schedules its reader tasks on pool (shared, e.g. by CohortImporter) instead of an own pool; nullptr = own pool
+    void set_thread_pool(ThreadPool* pool);
+
+    //! every read_*() call (and read_all()) is recorded in profiler; nullptr = off (default)
+    void set_profiler(ImportProfiler* profiler);
+
+    //! the report is written to sink instead of being kept in memory (result() and read_all() return ""); not owned; nullptr = in memory (default)
+    void set_report_sink(ReportSink* sink);
+
+    //! measuring plane counts/semantics are printed to console (default: std::cout)
+    void set_console(std::ostream& console);
+
     //====================================================================================================
     //===== FUNCTIONS
     //====================================================================================================
-    void _read_nd_scalar_image_in_sparse_matrix_style(std::ifstream& file);
+    //! parsers only consume the stream; they never write to the report
+    [[nodiscard]] static SparseImageData _parse_nd_scalar_image_in_sparse_matrix_style(std::istream& file);
+    //! everything before the entries; num_values is the number of entries
+    [[nodiscard]] static SparseImageData _parse_sparse_image_header(std::istream& file);
+    //! same file format; every non-zero entry sets its voxel, the entries themselves are not kept
+    [[nodiscard]] static VoxelMask _parse_voxel_mask(std::istream& file);
+    //! the entries after the header; size = grid size
+    [[nodiscard]] static VoxelMask _parse_voxel_mask_entries(std::istream& file, std::vector<std::uint32_t> size, std::uint32_t numValues);
+    //! T = float: payloads are narrowed while reading (see FloatNarrowing)
+    template<typename T = double>
+    [[nodiscard]] static BasicMeshData<T> _parse_mesh(std::istream& file);
+    [[nodiscard]] static CenterlinesData _parse_centerlines(std::istream& file);
+    //! withArrays == false: only the scalar summary; all per grid point, per time and per sample arrays are skipped
+    [[nodiscard]] static MeasuringPlane _parse_measuring_plane(std::istream& file, bool withArrays = true);
+    [[nodiscard]] static MeasuringPlanesData _parse_measuring_planes(std::istream& file);
+    [[nodiscard]] static PathlinesData _parse_pathlines(std::istream& file);
+    [[nodiscard]] static FlowFieldHeader _parse_flowfield_header(std::istream& file);
+    template<typename T = double>
+    [[nodiscard]] static BasicFlowFieldData<T> _parse_flowfield(std::istream& file);
+    [[nodiscard]] static FlowJetsData _parse_flow_jets(std::istream& file);
+    [[nodiscard]] AnatomicalImagesData _parse_anatomical_images() const;
+    template<typename T = double>
+    [[nodiscard]] BasicFlow2DTImagesData<T> _parse_flow2dt_images() const;
+    [[nodiscard]] static FlowStatisticsData _parse_flow_statistics(std::istream& file);
+    [[nodiscard]] static std::vector<std::string> _parse_non_empty_lines(std::istream& file);
+    [[nodiscard]] static SegmentationGraphCutIdsData _parse_segmentation_graphcut_inside_outside_ids(std::istream& file);
+    [[nodiscard]] static VesselSectionSegmentationData _parse_vessel_section_segmentation_in_flowfield_size(std::istream& file);
+    [[nodiscard]] static CenterlineSeedTargetIdsData _parse_centerline_start_end_ids_on_mesh(std::istream& file);
+    [[nodiscard]] static StaticTissueIvsdThresholdsData _parse_static_tissue_ivsd_thresholds(std::istream& file);
+    [[nodiscard]] static DatasetFilterTagsData _parse_dataset_filter_tags(std::istream& file);
+    [[nodiscard]] static PhaseWrapsData _parse_phase_wrapped_voxels(std::istream& file);
+    [[nodiscard]] static VelocityOffsetCorrectionData _parse_velocity_offset_correction_3dt(std::istream& file);
+    [[nodiscard]] static DicomTagsData _parse_dicom_tags(std::istream& file);
+    [[nodiscard]] static CardiacCycleData _parse_cardiac_cycle_definition(std::istream& file);
+    [[nodiscard]] static VencData _parse_venc(std::istream& file);
+
+    //! scanners read only the counts and seek past the payloads
+    [[nodiscard]] static SparseImageMetadata _scan_nd_scalar_image_in_sparse_matrix_style(std::istream& file);
+    [[nodiscard]] static MeshMetadata _scan_mesh(std::istream& file);
+    [[nodiscard]] static PolylinesMetadata _scan_centerlines(std::istream& file);
+    [[nodiscard]] static PolylinesMetadata _scan_pathlines(std::istream& file);
+    [[nodiscard]] static CardiacCycleMetadata _scan_cardiac_cycle_definition(std::istream& file);
+    [[nodiscard]] static MeasuringPlaneRecord _scan_measuring_plane(std::istream& file);
+    [[nodiscard]] static MeasuringPlanesIndex _scan_measuring_planes(std::istream& file);
+
+    //! planners read only the counts and return num_bytes and expected_file_num_bytes of one file (see plan_memory())
+    [[nodiscard]] static MemoryPlanComponent _plan_nd_scalar_image_in_sparse_matrix_style(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_voxel_mask(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_mesh(std::istream& file, std::uint64_t payloadNumBytes);
+    [[nodiscard]] static MemoryPlanComponent _plan_centerlines(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_measuring_planes(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_pathlines(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_flowfield(std::istream& file, std::uint64_t payloadNumBytes);
+    [[nodiscard]] static MemoryPlanComponent _plan_flow_jets(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_flow2dt_image(std::istream& file, std::uint64_t payloadNumBytes);
+    [[nodiscard]] static MemoryPlanComponent _plan_flow_statistics(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_segmentation_graphcut_inside_outside_ids(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_vessel_section_segmentation_in_flowfield_size(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_centerline_start_end_ids_on_mesh(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_static_tissue_ivsd_thresholds(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_phase_wrapped_voxels(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_velocity_offset_correction_3dt(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_cardiac_cycle_definition(std::istream& file);
+    [[nodiscard]] static MemoryPlanComponent _plan_venc(std::istream& file);
+
+    void _clean_dir();
+    [[nodiscard]] ImporterScientific _make_task_importer() const;
+    void _run_tasks(const std::vector<std::function<void(ImporterScientific&)>>& tasks);
+    [[nodiscard]] std::vector<std::string> _find_vessel_names() const;
+    [[nodiscard]] std::vector<std::string> _find_files(std::string_view nameContains) const;
+
+    void _report_matrix(std::string_view indent, std::string_view name, const double* m, unsigned int numRows);
+    void _report_sparse_image_header(const SparseImageData& img);
+    void _report_voxel_mask_voxels(const VoxelMask& mask);
+    void _report_found_files(std::string_view what, const std::vector<std::string>& names);
+    void _report_flowfield_header(const FlowFieldHeader& header);
+    template<typename T>
+    void _report_flowfield_vectors(const FlowFieldHeader& header, const T* vectors);
+    template<typename T>
+    void _report_flowfield(const BasicFlowFieldData<T>& ff);
+    template<typename T>
+    void _report_mesh(const BasicMeshData<T>& mesh);
+    template<typename T>
+    void _report_flow2dt_images(const BasicFlow2DTImagesData<T>& imgs);
+    void _report_narrowing_errors(std::string_view indent, const std::vector<NarrowingError>& errors);
+    bool _read_flowfield_memory_mapped(std::string_view filepath);
+
+    //! load_*() return std::nullopt if the file cannot be opened; nothing is written to the report
+    [[maybe_unused]] [[nodiscard]] std::optional<SparseImageData> load_sparse_image(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<SparseImageIndex> load_sparse_image_index(std::string_view filepath) const;
+    //! binary masks in sparse matrix style (static tissue mask, segmentations in flow field size) as packed bitset
+    [[maybe_unused]] [[nodiscard]] std::optional<VoxelMask> load_voxel_mask(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<MeshData> load_mesh(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<MeshDataF> load_mesh_single_precision(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<CenterlinesData> load_centerlines(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<MeasuringPlanesData> load_landmark_measuring_planes(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<MeasuringPlanesIndex> load_measuring_planes_index(std::string_view filepath) const;
+    //! seeks to the record; summaryOnly: see _parse_measuring_plane()
+    [[maybe_unused]] [[nodiscard]] std::optional<MeasuringPlane> load_measuring_plane(std::string_view filepath, const MeasuringPlaneRecord& record, bool summaryOnly = false) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<MeasuringPlane> load_measuring_plane(std::string_view filepath, const MeasuringPlanesIndex& index, std::size_t planeId, bool summaryOnly = false) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<MeasuringPlane> load_landmark_measuring_plane(std::string_view filepath, const MeasuringPlanesIndex& index, std::uint32_t semantic, bool summaryOnly = false) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<PathlinesData> load_pathlines(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<FlowFieldData> load_flowfield(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<FlowFieldDataF> load_flowfield_single_precision(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<FlowJetsData> load_flow_jet(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<AnatomicalImagesData> load_anatomical_images() const;
+    [[maybe_unused]] [[nodiscard]] std::optional<Flow2DTImagesData> load_flow2dt_images() const;
+    [[maybe_unused]] [[nodiscard]] std::optional<Flow2DTImagesDataF> load_flow2dt_images_single_precision() const;
+    [[maybe_unused]] [[nodiscard]] std::optional<FlowStatisticsData> load_flow_statistics(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<SegmentationInfoData> load_segmentation_info(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<SegmentationGraphCutIdsData> load_segmentation_graphcut_inside_outside_ids(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<VesselSectionSegmentationData> load_vessel_section_segmentation_in_flowfield_size(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<VesselSectionSemanticsData> load_vessel_section_segmentation_semantics(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<CenterlineSeedTargetIdsData> load_centerline_start_end_ids_on_mesh(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<StaticTissueIvsdThresholdsData> load_static_tissue_ivsd_thresholds(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<DatasetFilterTagsData> load_dataset_filter_tags(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<PhaseWrapsData> load_phase_wrapped_voxels(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<VelocityOffsetCorrectionData> load_velocity_offset_correction_3dt(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<DicomTagsData> load_dicom_tags(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<CardiacCycleData> load_cardiac_cycle_definition(std::string_view filepath) const;
+    [[maybe_unused]] [[nodiscard]] std::optional<VencData> load_venc(std::string_view filepath) const;
+
+    //! loads the whole dataset without producing a report
+    [[maybe_unused]] [[nodiscard]] DatasetData load_all();
+
+    //! header-only triage of the dataset: grid sizes, counts, VENCs and cardiac cycle ids; payloads are skipped
+    [[maybe_unused]] [[nodiscard]] DatasetMetadata scan_all();
+
+    //! pre-flight footprint of read_all() (with the current precision / memory mapping) and truncation check against the file sizes; payloads are skipped
+    [[maybe_unused]] [[nodiscard]] MemoryPlan plan_memory();
+
+    //! report() appends the demo printout of an already loaded result to the report
+    void report(const SparseImageData& img);
+    void report(const VoxelMask& mask);
+    void report(const MeshData& mesh);
+    void report(const MeshDataF& mesh);
+    void report(const CenterlinesData& cls);
+    void report(const MeasuringPlane& mp);
+    void report(const MeasuringPlanesData& mps);
+    void report(const PathlinesData& pls);
+    void report(const FlowFieldData& ff);
+    void report(const FlowFieldDataF& ff);
+    void report(const FlowJetsData& fjs);
+    void report(const AnatomicalImagesData& imgs);
+    void report(const Flow2DTImagesData& imgs);
+    void report(const Flow2DTImagesDataF& imgs);
+    void report(const FlowStatisticsData& stats);
+    void report(const SegmentationInfoData& info);
+    void report(const SegmentationGraphCutIdsData& ids);
+    void report(const VesselSectionSegmentationData& seg);
+    void report(const VesselSectionSemanticsData& semantics);
+    void report(const CenterlineSeedTargetIdsData& ids);
+    void report(const StaticTissueIvsdThresholdsData& thresholds);
+    void report(const DatasetFilterTagsData& tags);
+    void report(const PhaseWrapsData& wraps);
+    void report(const VelocityOffsetCorrectionData& voc);
+    void report(const DicomTagsData& tags);
+    void report(const CardiacCycleData& cc);
+    void report(const VencData& venc);
 
     [[maybe_unused]] bool read_mesh(std::string_view filepath);
     [[maybe_unused]] bool read_centerlines(std::string_view filepath);
@@ -0,0 +1,655 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLOODLINE_IMPORTERSCIENTIFICDATA_H
+#define BLOODLINE_IMPORTERSCIENTIFICDATA_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "FlowFieldView.h"
+#include "VoxelMask.h"
+
+/*
+ * Owning results of the ImporterScientific::load_* functions.
+ *
+ * All arrays keep the memory layout of the files (see the format descriptions in
+ * ImporterScientific.cpp), so they are filled by a single read each and can be moved out.
+ */
+
+//====================================================================================================
+//===== IMAGES
+//====================================================================================================
+struct SparseImageData
+{
+    std::uint32_t num_dims = 0;
+    std::vector<std::uint32_t> grid_size; // num_dims
+    std::vector<double> voxel_scale; // num_dims
+    std::array<double, 16> world_matrix{}; // 4x4 from dicom
+    std::array<double, 16> inverse_world_matrix{};
+    std::array<double, 25> world_matrix_with_time{}; // 5x5 including time in 4th row/col
+    std::array<double, 25> inverse_world_matrix_with_time{};
+    std::uint32_t num_values = 0;
+    std::vector<std::vector<std::uint32_t>> grid_pos; // num_dims columns of num_values (structure of arrays)
+    std::vector<double> values; // num_values
+}; // struct SparseImageData
+
+/*
+ * Flow field, 2D+T flow images and mesh are templates on the payload type:
+ * double as stored in the files or float (ImporterScientific::set_single_precision()).
+ * Single precision results list the conversion error of every narrowed array.
+ */
+struct NarrowingError
+{
+    std::string name;
+    double max_abs_error = 0;
+    double max_rel_error = 0;
+}; // struct NarrowingError
+
+template<typename T>
+struct BasicFlowFieldData
+{
+    FlowFieldHeader header;
+    std::vector<T> vectors; // x y z t component
+    std::vector<NarrowingError> narrowing_errors; // single precision only
+}; // struct BasicFlowFieldData
+
+using FlowFieldData = BasicFlowFieldData<double>;
+using FlowFieldDataF = BasicFlowFieldData<float>;
+
+template<typename T>
+struct BasicFlow2DTImage
+{
+    std::string name;
+    std::array<std::uint32_t, 3> size{}; // x y t
+    std::array<double, 3> scale{};
+    std::array<double, 16> world_matrix{};
+    std::array<double, 16> inverse_world_matrix{};
+    std::array<double, 25> world_matrix_with_time{};
+    std::array<double, 25> inverse_world_matrix_with_time{};
+    std::vector<T> velocities; // x y t
+    std::vector<NarrowingError> narrowing_errors; // single precision only
+}; // struct BasicFlow2DTImage
+
+using Flow2DTImage = BasicFlow2DTImage<double>;
+using Flow2DTImageF = BasicFlow2DTImage<float>;
+
+template<typename T>
+struct BasicFlow2DTImagesData
+{
+    std::vector<BasicFlow2DTImage<T>> images;
+}; // struct BasicFlow2DTImagesData
+
+using Flow2DTImagesData = BasicFlow2DTImagesData<double>;
+using Flow2DTImagesDataF = BasicFlow2DTImagesData<float>;
+
+struct AnatomicalImagesData
+{
+    std::vector<std::string> names_3d;
+    std::vector<SparseImageData> images_3d;
+    std::vector<std::string> names_3dt;
+    std::vector<SparseImageData> images_3dt;
+}; // struct AnatomicalImagesData
+
+//====================================================================================================
+//===== VESSEL GEOMETRY
+//====================================================================================================
+template<typename T>
+struct BasicMeshData
+{
+    std::uint32_t num_points = 0;
+    std::uint32_t num_triangles = 0;
+    std::uint32_t num_times = 0;
+
+    std::vector<T> points; // num_points * 3
+    std::vector<T> point_normals; // num_points * 3
+    std::vector<std::uint32_t> triangles; // num_triangles * 3
+    std::vector<T> triangle_normals; // num_triangles * 3
+
+    std::vector<T> wss; // num_points * num_times
+    std::vector<T> wss_axial;
+    std::vector<T> wss_circumferential;
+    std::vector<T> wss_vector; // num_points * num_times * 3
+    std::vector<T> wss_vector_axial;
+    std::vector<T> wss_vector_circumferential;
+    std::vector<T> mean_wss; // num_points
+    std::vector<T> mean_wss_axial;
+    std::vector<T> mean_wss_circumferential;
+    std::vector<T> osi; // num_points
+    std::vector<T> osi_axial;
+    std::vector<T> osi_circumferential;
+    std::vector<T> mean_wss_vector; // num_points * 3
+    std::vector<T> mean_wss_vector_axial;
+    std::vector<T> mean_wss_vector_circumferential;
+
+    std::vector<NarrowingError> narrowing_errors; // single precision only
+}; // struct BasicMeshData
+
+using MeshData = BasicMeshData<double>;
+using MeshDataF = BasicMeshData<float>;
+
+struct Centerline
+{
+    std::uint32_t num_points = 0;
+    std::vector<double> points; // num_points * 3
+    std::vector<double> radii; // num_points
+    std::vector<double> local_coordinate_systems; // num_points * 3 * 3 (x, y, z vector; z is the tangent)
+}; // struct Centerline
+
+struct CenterlinesData
+{
+    std::vector<Centerline> centerlines;
+}; // struct CenterlinesData
+
+struct CenterlineSeedTargetIdsData
+{
+    std::uint32_t seed_id = 0;
+    std::vector<std::uint32_t> target_ids;
+}; // struct CenterlineSeedTargetIdsData
+
+//====================================================================================================
+//===== FLOW
+//====================================================================================================
+/*
+ * All pathlines in compressed sparse row layout: the points of pathline i are
+ * [offsets[i], offsets[i + 1]) in every per point column.
+ *
+ * The columns are contiguous over all pathlines, so x/y/z/t and each attribute can be handed
+ * to a renderer as one vertex buffer and the offsets as draw ranges.
+ */
+struct PathlinesData
+{
+    std::vector<std::uint64_t> offsets{0}; // num_pathlines + 1
+
+    // per point
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> t;
+    std::vector<double> pressure;
+    std::vector<double> cos_angle_to_centerline;
+    std::vector<double> rotation_direction;
+    std::vector<double> velocity;
+    std::vector<double> axial_velocity;
+
+    // per pathline
+    std::vector<double> length; // spatial; temporal component is ignored
+
+    [[nodiscard]] std::size_t num_pathlines() const
+    { return offsets.size() - 1; }
+
+    [[nodiscard]] std::size_t num_points() const
+    { return offsets.back(); }
+
+    [[nodiscard]] std::size_t num_points(std::size_t pathlineId) const
+    { return offsets[pathlineId + 1] - offsets[pathlineId]; }
+
+    //! x y z t interleaved for all points (num_points() * 4)
+    [[nodiscard]] std::vector<float> interleaved_points() const
+    {
+        std::vector<float> v(num_points() * 4);
+
+        for (std::size_t i = 0; i < num_points(); ++i)
+        {
+            v[i * 4] = static_cast<float>(x[i]);
+            v[i * 4 + 1] = static_cast<float>(y[i]);
+            v[i * 4 + 2] = static_cast<float>(z[i]);
+            v[i * 4 + 3] = static_cast<float>(t[i]);
+        }
+
+        return v;
+    }
+}; // struct PathlinesData
+
+struct FlowJet
+{
+    std::uint32_t num_points = 0;
+    std::uint32_t num_times = 0;
+
+    // per point and time (point outermost)
+    std::vector<double> peak_velocity_positions; // * 3
+    std::vector<double> peak_velocities;
+    std::vector<double> area_centers; // * 3
+    std::vector<double> area_dirs0; // * 3
+    std::vector<double> area_radii0;
+    std::vector<double> area_dirs1; // * 3
+    std::vector<double> area_radii1;
+
+    // per point
+    std::vector<double> vessel_centers; // * 3
+    std::vector<double> vessel_radii;
+    std::vector<double> lcs_x; // * 3
+    std::vector<double> lcs_y; // * 3
+}; // struct FlowJet
+
+struct FlowJetsData
+{
+    std::vector<FlowJet> flow_jets;
+}; // struct FlowJetsData
+
+struct MeasuringPlane
+{
+    std::uint8_t vessel_id = 0;
+    std::array<std::uint32_t, 3> size{}; // x y t
+    std::array<double, 3> scale{}; // x y [mm], t [ms]
+    std::array<double, 3> center{};
+    std::array<double, 3> lcs_x{};
+    std::array<double, 3> lcs_y{};
+    std::array<double, 3> lcs_z{}; // normal
+    double vessel_diameter = 0;
+
+    std::vector<double> flow_vectors; // x y t component
+    std::vector<std::uint8_t> segmentation; // x y
+    std::vector<double> axial_velocity; // x y t
+    std::vector<double> circumferential_velocity; // x y t
+
+    double min_flow_rate_per_time = 0;
+    double max_flow_rate_per_time = 0;
+    double mean_flow_rate_per_time = 0;
+    double median_flow_rate_per_time = 0;
+    double forward_flow_volume = 0;
+    double backward_flow_volume = 0;
+    double net_flow_volume = 0;
+    double percentaged_back_flow_volume = 0;
+    double cardiac_output = 0;
+    double max_velocity = 0;
+    double min_velocity = 0;
+    double mean_velocity = 0;
+    double median_velocity = 0;
+    double min_velocity_axial = 0;
+    double max_velocity_axial = 0;
+    double mean_velocity_axial = 0;
+    double median_velocity_axial = 0;
+    double min_velocity_circumferential = 0;
+    double max_velocity_circumferential = 0;
+    double mean_velocity_circumferential = 0;
+    double median_velocity_circumferential = 0;
+    double area_mm2 = 0;
+
+    std::vector<double> flow_rate_per_time; // t
+    std::vector<double> areal_mean_velocity_per_time;
+    std::vector<double> areal_mean_velocity_axial_per_time;
+    std::vector<double> areal_mean_velocity_circumferential_per_time;
+    std::vector<double> flow_jet_angle_per_time;
+    std::vector<double> flow_jet_displacement_per_time;
+    std::vector<double> flow_jet_high_velocity_area_percent_per_time;
+
+    double max_flow_jet_angle_per_time = 0;
+    double min_flow_jet_angle_per_time = 0;
+    double mean_flow_jet_angle_per_time = 0;
+    double median_flow_jet_angle_per_time = 0;
+    double flow_jet_angle_at_fastest_time = 0;
+    double mean_flow_jet_angle_velocity_weighted = 0;
+    double min_flow_jet_displacement_per_time = 0;
+    double max_flow_jet_displacement_per_time = 0;
+    double mean_flow_jet_displacement_per_time = 0;
+    double median_flow_jet_displacement_per_time = 0;
+    double flow_jet_displacement_at_fastest_time = 0;
+    double mean_flow_jet_displacement_velocity_weighted = 0;
+    double min_flow_jet_high_velocity_area_percent_per_time = 0;
+    double max_flow_jet_high_velocity_area_percent_per_time = 0;
+    double mean_flow_jet_high_velocity_area_percent_per_time = 0;
+    double median_flow_jet_high_velocity_area_percent_per_time = 0;
+    double flow_jet_high_velocity_at_fastest_time = 0;
+    double mean_flow_jet_high_velocity_velocity_weighted = 0;
+
+    std::vector<double> flow_jet_position_per_time; // t * 3
+
+    // uncertainty
+    std::uint32_t num_samples = 0;
+    std::vector<double> samples_net_flow_volume;
+    std::vector<double> samples_forward_flow_volume;
+    std::vector<double> samples_backward_flow_volume;
+    std::vector<double> samples_percentaged_backward_flow_volume;
+    std::vector<double> samples_cardiac_output;
+}; // struct MeasuringPlane
+
+struct MeasuringPlanesData
+{
+    std::vector<MeasuringPlane> planes;
+    std::vector<std::uint32_t> landmark_semantics;
+    std::vector<MeasuringPlane> landmark_planes;
+}; // struct MeasuringPlanesData
+
+struct FlowStatistic
+{
+    std::string name;
+    bool per_time = false;
+    std::vector<double> values; // 1 or num_times
+}; // struct FlowStatistic
+
+struct FlowStatisticsData
+{
+    std::uint32_t num_times = 0;
+    std::vector<FlowStatistic> statistics;
+}; // struct FlowStatisticsData
+
+//====================================================================================================
+//===== SEGMENTATION
+//====================================================================================================
+struct SegmentationInfoData
+{
+    std::vector<std::string> lines;
+}; // struct SegmentationInfoData
+
+struct SegmentationGraphCutIdsData
+{
+    std::vector<std::uint32_t> inside_ids; // xyz triplets
+    std::vector<std::uint32_t> outside_ids; // xyz triplets
+}; // struct SegmentationGraphCutIdsData
+
+struct VesselSectionSegmentationData
+{
+    std::vector<SparseImageData> sections;
+}; // struct VesselSectionSegmentationData
+
+struct VesselSectionSemanticsData
+{
+    std::vector<std::string> lines;
+}; // struct VesselSectionSemanticsData
+
+struct StaticTissueIvsdThresholdsData
+{
+    double lower_threshold = 0;
+    double upper_threshold = 0;
+}; // struct StaticTissueIvsdThresholdsData
+
+//====================================================================================================
+//===== DATASET
+//====================================================================================================
+struct DatasetFilterTagsData
+{
+    std::vector<std::string> tags;
+}; // struct DatasetFilterTagsData
+
+struct PhaseWrapsData
+{
+    // per 3D+T flow image
+    std::array<std::vector<std::uint32_t>, 3> grid_pos; // x y z t per wrapped voxel
+    std::array<std::vector<std::int8_t>, 3> wrap_factors; // x was corrected via: x += factor * 2 * venc
+}; // struct PhaseWrapsData
+
+struct VelocityOffsetCorrectionData
+{
+    std::uint32_t end_diastolic_time_id = 0;
+    double ivsd_static_tissue_threshold = 0;
+    std::array<std::vector<double>, 3> plane_coeffs; // per 3D+T flow image: 3 per slice
+}; // struct VelocityOffsetCorrectionData
+
+struct DicomImageTags
+{
+    std::uint16_t dicom_image_id = 0;
+    std::uint16_t num_dimensions = 0;
+    std::uint16_t rows = 0;
+    std::uint16_t columns = 0;
+    std::uint16_t slices = 0;
+    std::uint16_t temporal_positions = 0;
+    std::uint32_t number_of_frames = 0;
+    double row_spacing = 0;
+    double col_spacing = 0;
+    double slice_spacing = 0;
+    double temporal_resolution = 0;
+    std::string patient_name;
+    std::string patient_id;
+    std::string patient_sex;
+    std::uint8_t patient_age = 0;
+    double patient_weight = 0;
+    std::string patient_birth_date;
+    std::string sequence_name;
+    std::string sequence_name_private;
+    std::string patient_position;
+    std::string study_description;
+    std::string series_description;
+    std::string series_instance_uid;
+    std::string study_instance_uid;
+    std::string protocol_name;
+    std::string modality;
+    std::uint8_t samples_per_pixel = 0;
+    std::uint32_t largest_image_pixel_value = 0;
+    std::uint8_t bits_allocated = 0;
+    std::uint8_t bits_stored = 0;
+    std::uint8_t high_bit = 0;
+    std::string acquisition_date;
+    std::string institution_name;
+    std::array<double, 3> image_orientation_patient_x{};
+    std::array<double, 3> image_orientation_patient_y{};
+    std::array<double, 16> world_matrix{};
+}; // struct DicomImageTags
+
+struct DicomTagsData
+{
+    std::vector<DicomImageTags> images;
+}; // struct DicomTagsData
+
+struct CardiacCycleData
+{
+    std::uint32_t num_times = 0;
+    std::uint32_t id_systole_begin = 0;
+    double ms_systole_begin = 0;
+    std::uint32_t id_systole_end = 0;
+    double ms_systole_end = 0;
+    std::uint32_t num_vessels = 0;
+    std::vector<double> mean_axial_velocity; // num_vessels * num_times
+}; // struct CardiacCycleData
+
+struct VencData
+{
+    std::array<std::uint16_t, 3> dicom_image_ids_3dt{}; // X (LR), Y (AP), Z (FH)
+    std::array<double, 3> vencs_3dt{};
+    std::vector<std::uint16_t> dicom_image_ids_2dt;
+    std::vector<double> vencs_2dt;
+}; // struct VencData
+
+//====================================================================================================
+//===== ALL
+//====================================================================================================
+struct VesselData
+{
+    std::string name;
+    std::optional<MeshData> mesh;
+    std::optional<CenterlineSeedTargetIdsData> centerline_seed_target_ids;
+    std::optional<CenterlinesData> centerlines;
+    std::optional<FlowJetsData> flow_jets;
+    std::optional<PathlinesData> pathlines;
+    std::optional<MeasuringPlanesData> measuring_planes;
+    std::optional<SparseImageData> segmentation;
+    std::optional<SegmentationInfoData> segmentation_info;
+    std::optional<SegmentationGraphCutIdsData> segmentation_graphcut_ids;
+    std::optional<VoxelMask> segmentation_in_flowfield_size;
+    std::optional<VesselSectionSegmentationData> vessel_section_segmentation;
+    std::optional<VesselSectionSemanticsData> vessel_section_semantics;
+}; // struct VesselData
+
+struct DatasetData
+{
+    std::string dir;
+    std::optional<DatasetFilterTagsData> filter_tags;
+    std::optional<DicomTagsData> dicom_tags;
+    std::optional<VencData> venc;
+    std::optional<CardiacCycleData> cardiac_cycle;
+    std::optional<VoxelMask> static_tissue_mask;
+    std::optional<StaticTissueIvsdThresholdsData> static_tissue_ivsd_thresholds;
+    std::optional<PhaseWrapsData> phase_wraps;
+    std::optional<FlowFieldData> flowfield;
+    std::optional<VelocityOffsetCorrectionData> velocity_offset_correction;
+    std::optional<Flow2DTImagesData> flow2dt_images;
+    std::optional<SparseImageData> magnitude_tmip;
+    std::optional<AnatomicalImagesData> anatomical_images;
+    std::optional<SparseImageData> pressure_map;
+    std::optional<SparseImageData> rotation_direction_map;
+    std::optional<SparseImageData> axial_velocity_map;
+    std::optional<SparseImageData> cos_angle_to_centerline_map;
+    std::optional<SparseImageData> turbulent_kinetic_energy_map;
+    std::optional<SparseImageData> ivsd;
+    std::optional<FlowStatisticsData> flow_statistics;
+    std::vector<VesselData> vessels;
+}; // struct DatasetData
+
+//====================================================================================================
+//===== METADATA (ImporterScientific::scan_*)
+//====================================================================================================
+/*
+ * Header-only records. The scanners parse the counts and seek past the payloads,
+ * so they never read (or allocate) the bulk data.
+ */
+struct SparseImageMetadata
+{
+    std::uint32_t num_dims = 0;
+    std::vector<std::uint32_t> grid_size; // num_dims
+    std::vector<double> voxel_scale; // num_dims
+    std::uint32_t num_values = 0;
+}; // struct SparseImageMetadata
+
+struct MeshMetadata
+{
+    std::uint32_t num_points = 0;
+    std::uint32_t num_triangles = 0;
+    std::uint32_t num_times = 0;
+}; // struct MeshMetadata
+
+struct PolylinesMetadata
+{
+    std::uint32_t num_lines = 0;
+    std::uint64_t num_points = 0; // sum over all lines
+}; // struct PolylinesMetadata
+
+struct CardiacCycleMetadata
+{
+    std::uint32_t num_times = 0;
+    std::uint32_t id_systole_begin = 0;
+    double ms_systole_begin = 0;
+    std::uint32_t id_systole_end = 0;
+    double ms_systole_end = 0;
+    std::uint32_t num_vessels = 0;
+}; // struct CardiacCycleMetadata
+
+//! position of one measuring plane record in the "measuring_planes" file
+struct MeasuringPlaneRecord
+{
+    std::uint64_t offset = 0; // of the plane itself (after the land mark semantic)
+    std::uint64_t num_bytes = 0;
+    std::uint32_t landmark_semantic = 0; // 0 = no land mark
+    std::uint8_t vessel_id = 0;
+    std::array<std::uint32_t, 3> size{}; // x y t
+    std::uint32_t num_samples = 0;
+}; // struct MeasuringPlaneRecord
+
+struct MeasuringPlanesIndex
+{
+    std::vector<MeasuringPlaneRecord> planes;
+    std::vector<MeasuringPlaneRecord> landmark_planes;
+
+    //! nullptr if there is no land mark plane with this semantic
+    [[nodiscard]] const MeasuringPlaneRecord* find_landmark(std::uint32_t semantic) const
+    {
+        for (const MeasuringPlaneRecord& r: landmark_planes)
+        {
+            if (r.landmark_semantic == semantic)
+            { return &r; }
+        }
+
+        return nullptr;
+    }
+}; // struct MeasuringPlanesIndex
+
+struct VesselMetadata
+{
+    std::string name;
+    std::optional<MeshMetadata> mesh;
+    std::optional<PolylinesMetadata> centerlines;
+    std::optional<PolylinesMetadata> pathlines;
+    std::optional<MeasuringPlanesIndex> measuring_planes;
+    std::optional<SparseImageMetadata> segmentation_in_flowfield_size;
+}; // struct VesselMetadata
+
+struct DatasetMetadata
+{
+    std::string dir;
+    std::optional<FlowFieldHeader> flowfield;
+    std::optional<VencData> venc;
+    std::optional<CardiacCycleMetadata> cardiac_cycle;
+    std::optional<SparseImageMetadata> magnitude_tmip;
+    std::vector<VesselMetadata> vessels;
+}; // struct DatasetMetadata
+
+//====================================================================================================
+//===== MEMORY PLAN (ImporterScientific::plan_memory())
+//====================================================================================================
+/*
+ * Footprint of read_all() per file, derived from the count fields only.
+ *
+ * num_bytes is the size of the arrays the parser allocates (vector payloads; fixed-size members and
+ * allocator overhead are not counted). Text files are charged with their file size and are not
+ * checked for truncation.
+ */
+struct MemoryPlanComponent
+{
+    std::string name; // relative to the dataset directory; a pattern if the component has several files
+    std::uint64_t num_bytes = 0;
+    std::uint64_t file_num_bytes = 0; // on disk
+    std::uint64_t expected_file_num_bytes = 0; // required by the count fields; 0 = not checked
+    bool truncated = false; // the file ends before its count fields or the payloads they announce
+}; // struct MemoryPlanComponent
+
+struct MemoryPlan
+{
+    std::string dir;
+    std::vector<MemoryPlanComponent> components; // in read_all() order
+
+    //! everything at once (load_all())
+    [[nodiscard]] std::uint64_t total_num_bytes() const
+    {
+        std::uint64_t n = 0;
+        for (const MemoryPlanComponent& c: components)
+        { n += c.num_bytes; }
+
+        return n;
+    }
+
+    //! read_all() keeps one component per running reader task: the numThreads largest ones
+    [[nodiscard]] std::uint64_t peak_num_bytes(unsigned int numThreads) const
+    {
+        std::vector<std::uint64_t> n;
+        n.reserve(components.size());
+        for (const MemoryPlanComponent& c: components)
+        { n.push_back(c.num_bytes); }
+
+        const std::size_t k = std::min<std::size_t>(std::max(1U, numThreads), n.size());
+        std::partial_sort(n.begin(), n.begin() + k, n.end(), std::greater<>());
+
+        return std::accumulate(n.begin(), n.begin() + k, std::uint64_t(0));
+    }
+
+    [[nodiscard]] std::size_t num_truncated() const
+    { return static_cast<std::size_t>(std::count_if(components.begin(), components.end(), [](const MemoryPlanComponent& c) { return c.truncated; })); }
+}; // struct MemoryPlan
+
+#endif //BLOODLINE_IMPORTERSCIENTIFICDATA_H
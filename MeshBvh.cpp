@@ -0,0 +1,812 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "MeshBvh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include "ImportProfiler.h"
+#include "ThreadPool.h"
+
+namespace
+{
+  constexpr unsigned int NUM_BINS = 16;
+  constexpr std::uint32_t MAX_LEAF_SIZE = 8;
+  constexpr std::size_t MIN_SUBTREE_SIZE = 4096; // triangles per parallel subtree task
+  constexpr unsigned int MAX_STACK_SIZE = 64;
+  constexpr std::uint32_t MAX_DEPTH = MAX_STACK_SIZE - 2; // deeper nodes become leaves, so traversal stacks never overflow
+
+  //------------------------------------------------------------------------------------------------------
+  // vector helpers
+  //------------------------------------------------------------------------------------------------------
+  inline double dot(const double* a, const double* b)
+  { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+  inline void cross(const double* a, const double* b, double* res)
+  {
+      res[0] = a[1] * b[2] - a[2] * b[1];
+      res[1] = a[2] * b[0] - a[0] * b[2];
+      res[2] = a[0] * b[1] - a[1] * b[0];
+  }
+
+  inline void sub(const double* a, const double* b, double* res)
+  {
+      res[0] = a[0] - b[0];
+      res[1] = a[1] - b[1];
+      res[2] = a[2] - b[2];
+  }
+
+  struct Box
+  {
+      std::array<double, 3> lower{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+      std::array<double, 3> upper{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+
+      void extend(const std::array<double, 3>& lo, const std::array<double, 3>& hi)
+      {
+          for (unsigned int a = 0; a < 3; ++a)
+          {
+              lower[a] = std::min(lower[a], lo[a]);
+              upper[a] = std::max(upper[a], hi[a]);
+          }
+      }
+
+      [[nodiscard]] double half_area() const
+      {
+          if (lower[0] > upper[0])
+          { return 0; }
+
+          const double dx = upper[0] - lower[0];
+          const double dy = upper[1] - lower[1];
+          const double dz = upper[2] - lower[2];
+          return dx * dy + dy * dz + dz * dx;
+      }
+  }; // struct Box
+
+  //! per-triangle bounds and centroids (mesh order)
+  struct TriangleBounds
+  {
+      std::vector<std::array<double, 3>> lower;
+      std::vector<std::array<double, 3>> upper;
+      std::vector<std::array<double, 3>> centroid;
+  }; // struct TriangleBounds
+
+  //! subtree whose node has bounds but still has to be split
+  struct PendingSubtree
+  {
+      std::uint32_t node;
+      std::uint32_t first;
+      std::uint32_t last;
+      std::uint32_t depth;
+  }; // struct PendingSubtree
+
+  /*
+   * top-down binned SAH build of the triangles ids[first, last) below node rootNode;
+   * nodes with at most maxPendingSize triangles are not split but appended to pending (if not nullptr)
+   */
+  template<typename NodeT>
+  void build_subtree(std::vector<NodeT>& nodes, const PendingSubtree& root, const TriangleBounds& tb, std::uint32_t* ids, std::vector<PendingSubtree>* pending, std::size_t maxPendingSize)
+  {
+      std::vector<PendingSubtree> stack{root};
+
+      while (!stack.empty())
+      {
+          const PendingSubtree task = stack.back();
+          stack.pop_back();
+
+          const std::uint32_t count = task.last - task.first;
+
+          Box bounds;
+          Box centroidBounds;
+          for (std::uint32_t i = task.first; i < task.last; ++i)
+          {
+              bounds.extend(tb.lower[ids[i]], tb.upper[ids[i]]);
+              centroidBounds.extend(tb.centroid[ids[i]], tb.centroid[ids[i]]);
+          }
+
+          nodes[task.node].lower = bounds.lower;
+          nodes[task.node].upper = bounds.upper;
+          nodes[task.node].first = task.first;
+          nodes[task.node].count = count;
+
+          if (count <= 2 || task.depth >= MAX_DEPTH)
+          { continue; }
+
+          if (pending != nullptr && count <= maxPendingSize)
+          {
+              pending->push_back(task);
+              continue;
+          }
+
+          //------------------------------------------------------------------------------------------------------
+          // best binned SAH split over all axes
+          //------------------------------------------------------------------------------------------------------
+          double bestCost = std::numeric_limits<double>::max();
+          unsigned int bestAxis = 0;
+          unsigned int bestBin = 0;
+
+          for (unsigned int axis = 0; axis < 3; ++axis)
+          {
+              const double extent = centroidBounds.upper[axis] - centroidBounds.lower[axis];
+              if (!(extent > 0))
+              { continue; }
+
+              const double binScale = NUM_BINS / extent;
+
+              std::array<Box, NUM_BINS> binBounds;
+              std::array<std::uint32_t, NUM_BINS> binCounts{};
+
+              for (std::uint32_t i = task.first; i < task.last; ++i)
+              {
+                  const unsigned int b = std::min(NUM_BINS - 1, static_cast<unsigned int>((tb.centroid[ids[i]][axis] - centroidBounds.lower[axis]) * binScale));
+                  ++binCounts[b];
+                  binBounds[b].extend(tb.lower[ids[i]], tb.upper[ids[i]]);
+              }
+
+              // right-to-left sweep: area * count of bins [b, NUM_BINS)
+              std::array<double, NUM_BINS> rightCost{};
+              Box right;
+              std::uint32_t rightCount = 0;
+              for (unsigned int b = NUM_BINS - 1; b > 0; --b)
+              {
+                  right.extend(binBounds[b].lower, binBounds[b].upper);
+                  rightCount += binCounts[b];
+                  rightCost[b] = right.half_area() * rightCount;
+              }
+
+              Box left;
+              std::uint32_t leftCount = 0;
+              for (unsigned int b = 1; b < NUM_BINS; ++b)
+              {
+                  left.extend(binBounds[b - 1].lower, binBounds[b - 1].upper);
+                  leftCount += binCounts[b - 1];
+
+                  const double cost = left.half_area() * leftCount + rightCost[b];
+                  if (leftCount != 0 && leftCount != count && cost < bestCost)
+                  {
+                      bestCost = cost;
+                      bestAxis = axis;
+                      bestBin = b;
+                  }
+              }
+          } // for axis
+
+          if (bestCost == std::numeric_limits<double>::max())
+          { continue; } // all centroids coincide
+
+          // traversal cost 1, intersection cost 1
+          const double leafCost = count;
+          const double splitCost = 1 + bestCost / bounds.half_area();
+          if (count <= MAX_LEAF_SIZE && splitCost >= leafCost)
+          { continue; }
+
+          const double binScale = NUM_BINS / (centroidBounds.upper[bestAxis] - centroidBounds.lower[bestAxis]);
+          std::uint32_t* mid = std::partition(ids + task.first, ids + task.last, [&](std::uint32_t id)
+          { return std::min(NUM_BINS - 1, static_cast<unsigned int>((tb.centroid[id][bestAxis] - centroidBounds.lower[bestAxis]) * binScale)) < bestBin; });
+
+          const std::uint32_t left = static_cast<std::uint32_t>(nodes.size());
+          nodes.resize(nodes.size() + 2);
+
+          nodes[task.node].first = left;
+          nodes[task.node].count = 0;
+
+          const std::uint32_t split = static_cast<std::uint32_t>(mid - ids);
+          stack.push_back({left + 1, split, task.last, task.depth + 1});
+          stack.push_back({left, task.first, split, task.depth + 1});
+      } // while stack
+  }
+
+  //------------------------------------------------------------------------------------------------------
+  // primitives
+  //------------------------------------------------------------------------------------------------------
+  //! squared distance between a point and an axis-aligned box (0 inside)
+  inline double box_distance_squared(const double* p, const std::array<double, 3>& lower, const std::array<double, 3>& upper)
+  {
+      double d2 = 0;
+      for (unsigned int a = 0; a < 3; ++a)
+      {
+          const double d = std::max({lower[a] - p[a], 0.0, p[a] - upper[a]});
+          d2 += d * d;
+      }
+
+      return d2;
+  }
+
+  //! entry distance of the ray into the box or infinity if it misses within [0, tMax)
+  inline double ray_box(const double* origin, const double* invDirection, const std::array<double, 3>& lower, const std::array<double, 3>& upper, double tMax)
+  {
+      double tNear = 0;
+      double tFar = tMax;
+
+      for (unsigned int a = 0; a < 3; ++a)
+      {
+          double t0 = (lower[a] - origin[a]) * invDirection[a];
+          double t1 = (upper[a] - origin[a]) * invDirection[a];
+          if (t0 > t1)
+          { std::swap(t0, t1); }
+
+          // NaN (0 * inf) compares false and leaves the interval unchanged
+          tNear = t0 > tNear ? t0 : tNear;
+          tFar = t1 < tFar ? t1 : tFar;
+      }
+
+      return tNear <= tFar ? tNear : std::numeric_limits<double>::infinity();
+  }
+
+  //! Moeller-Trumbore; false if the ray misses or is parallel to the triangle
+  inline bool ray_triangle(const double* origin, const double* direction, const double* v, double& t, double& u, double& w)
+  {
+      double e1[3];
+      double e2[3];
+      sub(v + 3, v, e1);
+      sub(v + 6, v, e2);
+
+      double p[3];
+      cross(direction, e2, p);
+
+      const double det = dot(e1, p);
+      if (det == 0)
+      { return false; }
+
+      const double invDet = 1 / det;
+
+      double s[3];
+      sub(origin, v, s);
+
+      u = dot(s, p) * invDet;
+      if (u < 0 || u > 1)
+      { return false; }
+
+      double q[3];
+      cross(s, e1, q);
+
+      w = dot(direction, q) * invDet;
+      if (w < 0 || u + w > 1)
+      { return false; }
+
+      t = dot(e2, q) * invDet;
+      return true;
+  }
+
+  //! closest point on triangle v (9 values) to p (Ericson, Real-Time Collision Detection, 5.1.5)
+  inline void closest_point_on_triangle(const double* p, const double* v, double* res)
+  {
+      const double* a = v;
+      const double* b = v + 3;
+      const double* c = v + 6;
+
+      double ab[3];
+      double ac[3];
+      double ap[3];
+      sub(b, a, ab);
+      sub(c, a, ac);
+      sub(p, a, ap);
+
+      const auto set = [res](const double* x, double s, const double* dx, double r, const double* dy)
+      {
+          for (unsigned int i = 0; i < 3; ++i)
+          { res[i] = x[i] + s * dx[i] + r * dy[i]; }
+      };
+
+      const double d1 = dot(ab, ap);
+      const double d2 = dot(ac, ap);
+      if (d1 <= 0 && d2 <= 0)
+      { return set(a, 0, ab, 0, ac); }
+
+      double bp[3];
+      sub(p, b, bp);
+      const double d3 = dot(ab, bp);
+      const double d4 = dot(ac, bp);
+      if (d3 >= 0 && d4 <= d3)
+      { return set(b, 0, ab, 0, ac); }
+
+      const double vc = d1 * d4 - d3 * d2;
+      if (vc <= 0 && d1 >= 0 && d3 <= 0)
+      { return set(a, d1 / (d1 - d3), ab, 0, ac); }
+
+      double cp[3];
+      sub(p, c, cp);
+      const double d5 = dot(ab, cp);
+      const double d6 = dot(ac, cp);
+      if (d6 >= 0 && d5 <= d6)
+      { return set(c, 0, ab, 0, ac); }
+
+      const double vb = d5 * d2 - d1 * d6;
+      if (vb <= 0 && d2 >= 0 && d6 <= 0)
+      { return set(a, 0, ab, d2 / (d2 - d6), ac); }
+
+      const double va = d3 * d6 - d5 * d4;
+      if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+      {
+          double bc[3];
+          sub(c, b, bc);
+          return set(b, (d4 - d3) / ((d4 - d3) + (d5 - d6)), bc, 0, ab);
+      }
+
+      const double denom = 1 / (va + vb + vc);
+      return set(a, vb * denom, ab, vc * denom, ac);
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+MeshBvh::MeshBvh() = default;
+
+MeshBvh::MeshBvh(const MeshData& mesh, unsigned int numThreads)
+    : MeshBvh()
+{ build(mesh, numThreads); }
+
+MeshBvh::~MeshBvh() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::size_t MeshBvh::num_triangles() const
+{ return _triangle_ids.size(); }
+
+std::size_t MeshBvh::num_nodes() const
+{ return _nodes.size(); }
+
+bool MeshBvh::is_empty() const
+{ return _triangle_ids.empty(); }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void MeshBvh::build(const MeshData& mesh, unsigned int numThreads)
+{ build(mesh.points.data(), mesh.num_points, mesh.triangles.data(), mesh.num_triangles, numThreads); }
+
+void MeshBvh::build(const double* points, std::size_t numPoints, const std::uint32_t* triangles, std::size_t numTriangles, unsigned int numThreads)
+{
+    if (numThreads == 1)
+    {
+        _build(points, numPoints, triangles, numTriangles, nullptr);
+        return;
+    }
+
+    ThreadPool pool(numThreads);
+    _build(points, numPoints, triangles, numTriangles, &pool);
+}
+
+void MeshBvh::build(const double* points, std::size_t numPoints, const std::uint32_t* triangles, std::size_t numTriangles, ThreadPool& pool)
+{ _build(points, numPoints, triangles, numTriangles, &pool); }
+
+void MeshBvh::_build(const double* points, std::size_t numPoints, const std::uint32_t* triangles, std::size_t numTriangles, ThreadPool* pool)
+{
+    _nodes.clear();
+    _triangle_ids.clear();
+    _vertices.clear();
+
+    const unsigned int numThreads = pool != nullptr ? pool->num_threads() : 1;
+
+    // triangles with invalid point ids are skipped
+    for (std::size_t i = 0; i < numTriangles; ++i)
+    {
+        const std::uint32_t* tri = triangles + i * 3;
+        if (tri[0] < numPoints && tri[1] < numPoints && tri[2] < numPoints)
+        { _triangle_ids.push_back(static_cast<std::uint32_t>(i)); }
+    }
+
+    if (_triangle_ids.empty())
+    { return; }
+
+    const std::size_t n = _triangle_ids.size();
+
+    //------------------------------------------------------------------------------------------------------
+    // triangle bounds (indexed by mesh triangle id)
+    //------------------------------------------------------------------------------------------------------
+    TriangleBounds tb;
+    tb.lower.resize(numTriangles);
+    tb.upper.resize(numTriangles);
+    tb.centroid.resize(numTriangles);
+
+    ThreadPool::parallel_for(pool, n, MIN_SUBTREE_SIZE, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const std::uint32_t id = _triangle_ids[i];
+            const std::uint32_t* tri = triangles + static_cast<std::size_t>(id) * 3;
+
+            for (unsigned int a = 0; a < 3; ++a)
+            {
+                const double x = points[static_cast<std::size_t>(tri[0]) * 3 + a];
+                const double y = points[static_cast<std::size_t>(tri[1]) * 3 + a];
+                const double z = points[static_cast<std::size_t>(tri[2]) * 3 + a];
+
+                tb.lower[id][a] = std::min({x, y, z});
+                tb.upper[id][a] = std::max({x, y, z});
+                tb.centroid[id][a] = (x + y + z) / 3;
+            }
+        }
+    });
+
+    //------------------------------------------------------------------------------------------------------
+    // upper levels in this thread, then independent subtrees in parallel
+    //------------------------------------------------------------------------------------------------------
+    _nodes.resize(1);
+
+    std::vector<PendingSubtree> pending;
+    const std::size_t maxPendingSize = std::max(MIN_SUBTREE_SIZE, n / (4 * numThreads));
+    build_subtree(_nodes, {0, 0, static_cast<std::uint32_t>(n), 0}, tb, _triangle_ids.data(), numThreads > 1 ? &pending : nullptr, maxPendingSize);
+
+    std::vector<std::vector<Node>> subtrees(pending.size());
+    ThreadPool::parallel_for(pool, pending.size(), 1, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            subtrees[i].resize(1);
+            build_subtree(subtrees[i], {0, pending[i].first, pending[i].last, pending[i].depth}, tb, _triangle_ids.data(), nullptr, 0);
+        }
+    });
+
+    // local node 0 replaces the pending node; local node i > 0 is appended at base + i - 1
+    for (std::size_t i = 0; i < pending.size(); ++i)
+    {
+        const std::uint32_t base = static_cast<std::uint32_t>(_nodes.size());
+        const auto remap = [base](Node nd)
+        {
+            if (nd.count == 0)
+            { nd.first = base + nd.first - 1; }
+
+            return nd;
+        };
+
+        _nodes[pending[i].node] = remap(subtrees[i][0]);
+        for (std::size_t j = 1; j < subtrees[i].size(); ++j)
+        { _nodes.push_back(remap(subtrees[i][j])); }
+    }
+
+    //------------------------------------------------------------------------------------------------------
+    // vertices in leaf order
+    //------------------------------------------------------------------------------------------------------
+    _vertices.resize(n * 9);
+
+    ThreadPool::parallel_for(pool, n, MIN_SUBTREE_SIZE, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const std::uint32_t* tri = triangles + static_cast<std::size_t>(_triangle_ids[i]) * 3;
+            for (unsigned int k = 0; k < 3; ++k)
+            { std::copy_n(points + static_cast<std::size_t>(tri[k]) * 3, 3, _vertices.data() + i * 9 + k * 3); }
+        }
+    });
+}
+
+MeshClosestPoint MeshBvh::closest_point(const double* position, double maxDistance) const
+{
+    MeshClosestPoint res;
+    if (_nodes.empty())
+    { return res; }
+
+    double best = maxDistance * maxDistance;
+
+    std::uint32_t stack[MAX_STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize != 0)
+    {
+        const Node& nd = _nodes[stack[--stackSize]];
+        if (box_distance_squared(position, nd.lower, nd.upper) > best)
+        { continue; }
+
+        if (nd.count != 0)
+        {
+            for (std::uint32_t i = nd.first; i < nd.first + nd.count; ++i)
+            {
+                double q[3];
+                closest_point_on_triangle(position, _vertices.data() + i * 9, q);
+
+                double d[3];
+                sub(q, position, d);
+
+                const double d2 = dot(d, d);
+                if (d2 <= best)
+                {
+                    best = d2;
+                    res.found = true;
+                    res.triangle = _triangle_ids[i];
+                    res.point = {q[0], q[1], q[2]};
+                }
+            }
+
+            continue;
+        }
+
+        // nearer child on top
+        const double dl = box_distance_squared(position, _nodes[nd.first].lower, _nodes[nd.first].upper);
+        const double dr = box_distance_squared(position, _nodes[nd.first + 1].lower, _nodes[nd.first + 1].upper);
+        const std::uint32_t nearChild = dl <= dr ? nd.first : nd.first + 1;
+        const std::uint32_t farChild = dl <= dr ? nd.first + 1 : nd.first;
+
+        if (std::max(dl, dr) <= best)
+        { stack[stackSize++] = farChild; }
+        if (std::min(dl, dr) <= best)
+        { stack[stackSize++] = nearChild; }
+    } // while stack
+
+    if (res.found)
+    { res.distance = std::sqrt(best); }
+
+    return res;
+}
+
+MeshRayHit MeshBvh::intersect(const double* origin, const double* direction, double tMax) const
+{
+    MeshRayHit res;
+    if (_nodes.empty())
+    { return res; }
+
+    const double invDirection[3] = {1 / direction[0], 1 / direction[1], 1 / direction[2]};
+
+    std::uint32_t stack[MAX_STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    double best = tMax;
+
+    while (stackSize != 0)
+    {
+        const Node& nd = _nodes[stack[--stackSize]];
+        if (ray_box(origin, invDirection, nd.lower, nd.upper, best) == std::numeric_limits<double>::infinity())
+        { continue; }
+
+        if (nd.count != 0)
+        {
+            for (std::uint32_t i = nd.first; i < nd.first + nd.count; ++i)
+            {
+                double t = 0;
+                double u = 0;
+                double v = 0;
+                if (ray_triangle(origin, direction, _vertices.data() + i * 9, t, u, v) && t >= 0 && t < best)
+                {
+                    best = t;
+                    res.hit = true;
+                    res.triangle = _triangle_ids[i];
+                    res.t = t;
+                    res.u = u;
+                    res.v = v;
+                }
+            }
+
+            continue;
+        }
+
+        const double tl = ray_box(origin, invDirection, _nodes[nd.first].lower, _nodes[nd.first].upper, best);
+        const double tr = ray_box(origin, invDirection, _nodes[nd.first + 1].lower, _nodes[nd.first + 1].upper, best);
+
+        // nearer child on top
+        if (tl <= tr)
+        {
+            if (tr != std::numeric_limits<double>::infinity())
+            { stack[stackSize++] = nd.first + 1; }
+            if (tl != std::numeric_limits<double>::infinity())
+            { stack[stackSize++] = nd.first; }
+        }
+        else
+        {
+            if (tl != std::numeric_limits<double>::infinity())
+            { stack[stackSize++] = nd.first; }
+            stack[stackSize++] = nd.first + 1;
+        }
+    } // while stack
+
+    return res;
+}
+
+std::size_t MeshBvh::_count_hits(const double* origin, const double* direction) const
+{
+    if (_nodes.empty())
+    { return 0; }
+
+    const double invDirection[3] = {1 / direction[0], 1 / direction[1], 1 / direction[2]};
+
+    std::uint32_t stack[MAX_STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    std::size_t numHits = 0;
+
+    while (stackSize != 0)
+    {
+        const Node& nd = _nodes[stack[--stackSize]];
+        if (ray_box(origin, invDirection, nd.lower, nd.upper, std::numeric_limits<double>::infinity()) == std::numeric_limits<double>::infinity())
+        { continue; }
+
+        if (nd.count != 0)
+        {
+            for (std::uint32_t i = nd.first; i < nd.first + nd.count; ++i)
+            {
+                double t = 0;
+                double u = 0;
+                double v = 0;
+                if (ray_triangle(origin, direction, _vertices.data() + i * 9, t, u, v) && t > 0)
+                { ++numHits; }
+            }
+
+            continue;
+        }
+
+        stack[stackSize++] = nd.first;
+        stack[stackSize++] = nd.first + 1;
+    } // while stack
+
+    return numHits;
+}
+
+bool MeshBvh::inside(const double* position) const
+{
+    // skewed direction: rays along axes or diagonals would often graze edges of regular meshes
+    static const double direction[3] = {0.5773502691896258, 0.5773869213870961, 0.5773136141290516};
+    return _count_hits(position, direction) % 2 == 1;
+}
+
+void MeshBvh::closest_points(std::size_t numQueries, const double* positions, MeshClosestPoint* results, unsigned int numThreads) const
+{
+    ThreadPool::parallel_for(numQueries, 1024, numThreads, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { results[i] = closest_point(positions + i * 3); }
+    });
+}
+
+void MeshBvh::intersect(std::size_t numQueries, const double* origins, const double* directions, MeshRayHit* results, unsigned int numThreads) const
+{
+    ThreadPool::parallel_for(numQueries, 1024, numThreads, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { results[i] = intersect(origins + i * 3, directions + i * 3); }
+    });
+}
+
+void MeshBvh::inside(std::size_t numQueries, const double* positions, std::uint8_t* results, unsigned int numThreads) const
+{
+    ThreadPool::parallel_for(numQueries, 1024, numThreads, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { results[i] = inside(positions + i * 3) ? 1 : 0; }
+    });
+}
+
+void MeshBvh::closest_points(std::size_t numQueries, const double* positions, MeshClosestPoint* results, ThreadPool& pool) const
+{
+    ThreadPool::parallel_for(pool, numQueries, 1024, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { results[i] = closest_point(positions + i * 3); }
+    });
+}
+
+void MeshBvh::intersect(std::size_t numQueries, const double* origins, const double* directions, MeshRayHit* results, ThreadPool& pool) const
+{
+    ThreadPool::parallel_for(pool, numQueries, 1024, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { results[i] = intersect(origins + i * 3, directions + i * 3); }
+    });
+}
+
+void MeshBvh::inside(std::size_t numQueries, const double* positions, std::uint8_t* results, ThreadPool& pool) const
+{
+    ThreadPool::parallel_for(pool, numQueries, 1024, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        { results[i] = inside(positions + i * 3) ? 1 : 0; }
+    });
+}
+
+MeshBvhBenchmark MeshBvh::benchmark(std::size_t numTriangles, std::size_t numQueries, unsigned int numThreads, unsigned int seed)
+{
+    //------------------------------------------------------------------------------------------------------
+    // closed, vessel-like tube along z with a wavy radius and fan caps:
+    // (numRings - 1) * numSlices * 2 + numSlices * 2 triangles
+    //------------------------------------------------------------------------------------------------------
+    const std::uint32_t numSlices = std::max<std::uint32_t>(3, static_cast<std::uint32_t>(std::sqrt(numTriangles / 8.0)));
+    const std::uint32_t numRings = std::max<std::uint32_t>(2, static_cast<std::uint32_t>(numTriangles / (2 * numSlices)));
+
+    const double pi = 3.14159265358979323846;
+    const double length = 100; // [mm]
+
+    std::vector<double> points;
+    for (std::uint32_t k = 0; k < numRings; ++k)
+    {
+        const double z = length * k / (numRings - 1);
+        for (std::uint32_t s = 0; s < numSlices; ++s)
+        {
+            const double phi = 2 * pi * s / numSlices;
+            const double r = 10 + 2 * std::sin(z / 7) + std::cos(3 * phi + z / 11);
+            points.insert(points.end(), {r * std::cos(phi), r * std::sin(phi), z});
+        }
+    }
+    points.insert(points.end(), {0, 0, 0});
+    points.insert(points.end(), {0, 0, length});
+
+    const std::uint32_t numPoints = static_cast<std::uint32_t>(points.size() / 3);
+    const auto ring = [numSlices](std::uint32_t k, std::uint32_t s)
+    { return k * numSlices + s % numSlices; };
+
+    std::vector<std::uint32_t> triangles;
+    for (std::uint32_t s = 0; s < numSlices; ++s)
+    {
+        triangles.insert(triangles.end(), {numPoints - 2, ring(0, s + 1), ring(0, s)});
+        for (std::uint32_t k = 0; k + 1 < numRings; ++k)
+        {
+            triangles.insert(triangles.end(), {ring(k, s), ring(k, s + 1), ring(k + 1, s + 1)});
+            triangles.insert(triangles.end(), {ring(k, s), ring(k + 1, s + 1), ring(k + 1, s)});
+        }
+        triangles.insert(triangles.end(), {numPoints - 1, ring(numRings - 1, s), ring(numRings - 1, s + 1)});
+    }
+
+    MeshBvhBenchmark res;
+    res.num_triangles = triangles.size() / 3;
+
+    // one pool for all phases; starting its threads is not timed
+    ThreadPool pool(numThreads);
+
+    MeshBvh bvh;
+    auto start = std::chrono::steady_clock::now();
+    bvh.build(points.data(), numPoints, triangles.data(), res.num_triangles, pool);
+    res.build_seconds = ImportProfiler::seconds_since(start);
+
+    //------------------------------------------------------------------------------------------------------
+    // random queries in the bounding box
+    //------------------------------------------------------------------------------------------------------
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> position(-13, 13);
+    std::uniform_real_distribution<double> positionZ(0, length);
+    std::normal_distribution<double> direction(0, 1);
+
+    std::vector<double> positions(numQueries * 3);
+    std::vector<double> directions(numQueries * 3);
+    for (std::size_t i = 0; i < numQueries * 3; ++i)
+    {
+        positions[i] = i % 3 == 2 ? positionZ(rng) : position(rng);
+        directions[i] = direction(rng);
+    }
+
+    const auto per_second = [numQueries](double seconds)
+    { return seconds > 0 ? numQueries / seconds : 0; };
+
+    std::vector<MeshClosestPoint> closest(numQueries);
+    start = std::chrono::steady_clock::now();
+    bvh.closest_points(numQueries, positions.data(), closest.data(), pool);
+    res.closest_point_queries_per_second = per_second(ImportProfiler::seconds_since(start));
+
+    std::vector<MeshRayHit> hits(numQueries);
+    start = std::chrono::steady_clock::now();
+    bvh.intersect(numQueries, positions.data(), directions.data(), hits.data(), pool);
+    res.ray_queries_per_second = per_second(ImportProfiler::seconds_since(start));
+
+    std::vector<std::uint8_t> isInside(numQueries);
+    start = std::chrono::steady_clock::now();
+    bvh.inside(numQueries, positions.data(), isInside.data(), pool);
+    res.inside_queries_per_second = per_second(ImportProfiler::seconds_since(start));
+
+    return res;
+}
@@ -0,0 +1,154 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_MESHBVH_H
+#define BLOODLINE_MESHBVH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ImporterScientificData.h"
+
+class ThreadPool;
+
+struct MeshClosestPoint
+{
+    bool found = false;
+    std::uint32_t triangle = 0; // id in the mesh's triangle list
+    std::array<double, 3> point{};
+    double distance = std::numeric_limits<double>::infinity();
+}; // struct MeshClosestPoint
+
+struct MeshRayHit
+{
+    bool hit = false;
+    std::uint32_t triangle = 0; // id in the mesh's triangle list
+    double t = std::numeric_limits<double>::infinity(); // hit point = origin + t * direction
+    double u = 0; // barycentric coordinates of the hit point w.r.t. vertices 1 and 2
+    double v = 0;
+}; // struct MeshRayHit
+
+struct MeshBvhBenchmark
+{
+    std::size_t num_triangles = 0;
+    double build_seconds = 0;
+    double closest_point_queries_per_second = 0;
+    double ray_queries_per_second = 0;
+    double inside_queries_per_second = 0;
+}; // struct MeshBvhBenchmark
+
+/*
+ * Bounding volume hierarchy over the triangles of a mesh (e.g. the vessel wall).
+ *
+ * The tree is built top-down with binned SAH splits. The upper levels are split in the calling
+ * thread until there are enough independent subtrees, which are then built in parallel.
+ * Triangle vertices are copied in leaf order, so queries do not touch the mesh afterwards.
+ *
+ * inside() counts the crossings of a fixed, skewed ray and therefore expects a closed mesh;
+ * the orientation of the triangles does not matter.
+ */
+class MeshBvh
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    struct Node
+    {
+        std::array<double, 3> lower;
+        std::array<double, 3> upper;
+        std::uint32_t first; // leaf: first triangle; inner: left child (right child is first + 1)
+        std::uint32_t count; // leaf: number of triangles; inner: 0
+    }; // struct Node
+
+    std::vector<Node> _nodes; // root at 0
+    std::vector<std::uint32_t> _triangle_ids; // leaf order -> mesh triangle id
+    std::vector<double> _vertices; // leaf order, 9 per triangle
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    MeshBvh();
+    explicit MeshBvh(const MeshData& mesh, unsigned int numThreads = 0);
+    MeshBvh(const MeshBvh&) = default;
+    MeshBvh(MeshBvh&&) noexcept = default;
+
+    ~MeshBvh();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] std::size_t num_triangles() const;
+    [[nodiscard]] std::size_t num_nodes() const;
+    [[nodiscard]] bool is_empty() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] MeshBvh& operator=(const MeshBvh&) = default;
+    [[maybe_unused]] MeshBvh& operator=(MeshBvh&&) noexcept = default;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! numThreads == 0 -> std::thread::hardware_concurrency()
+    void build(const MeshData& mesh, unsigned int numThreads = 0);
+    //! points: numPoints * 3; triangles: numTriangles * 3 point ids
+    void build(const double* points, std::size_t numPoints, const std::uint32_t* triangles, std::size_t numTriangles, unsigned int numThreads = 0);
+    //! uses an existing pool (may be called from a task of that pool)
+    void build(const double* points, std::size_t numPoints, const std::uint32_t* triangles, std::size_t numTriangles, ThreadPool& pool);
+
+    //! single queries; position/origin/direction: 3 values
+    [[nodiscard]] MeshClosestPoint closest_point(const double* position, double maxDistance = std::numeric_limits<double>::infinity()) const;
+    [[nodiscard]] MeshRayHit intersect(const double* origin, const double* direction, double tMax = std::numeric_limits<double>::infinity()) const;
+    [[nodiscard]] bool inside(const double* position) const;
+
+    //! batched queries (numQueries * 3 values per input array)
+    void closest_points(std::size_t numQueries, const double* positions, MeshClosestPoint* results, unsigned int numThreads = 0) const;
+    void intersect(std::size_t numQueries, const double* origins, const double* directions, MeshRayHit* results, unsigned int numThreads = 0) const;
+    void inside(std::size_t numQueries, const double* positions, std::uint8_t* results, unsigned int numThreads = 0) const;
+    //! uses an existing pool (may be called from a task of that pool)
+    void closest_points(std::size_t numQueries, const double* positions, MeshClosestPoint* results, ThreadPool& pool) const;
+    void intersect(std::size_t numQueries, const double* origins, const double* directions, MeshRayHit* results, ThreadPool& pool) const;
+    void inside(std::size_t numQueries, const double* positions, std::uint8_t* results, ThreadPool& pool) const;
+
+    /*!
+     * builds a BVH over a closed, vessel-like tube with about numTriangles triangles and runs numQueries
+     * queries of each kind from random positions around it
+     */
+    [[nodiscard]] static MeshBvhBenchmark benchmark(std::size_t numTriangles = 1 << 20, std::size_t numQueries = 1 << 18, unsigned int numThreads = 0, unsigned int seed = 0);
+
+  private:
+    //! pool == nullptr -> single-threaded
+    void _build(const double* points, std::size_t numPoints, const std::uint32_t* triangles, std::size_t numTriangles, ThreadPool* pool);
+
+    //! number of triangles hit by the ray (t > 0)
+    [[nodiscard]] std::size_t _count_hits(const double* origin, const double* direction) const;
+}; // class MeshBvh
+
+#endif //BLOODLINE_MESHBVH_H
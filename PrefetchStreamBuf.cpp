@@ -0,0 +1,301 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "PrefetchStreamBuf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <istream>
+
+#include "FloatNarrowing.h"
+
+namespace
+{
+  //! consumer of the benchmark: reads numBytes in blocks and narrows them
+  [[nodiscard]] double narrow_stream(std::istream& file, std::uint64_t numBytes, std::size_t blockNumBytes)
+  {
+      const std::size_t blockNumValues = std::max<std::size_t>(1, blockNumBytes / sizeof(double));
+      std::vector<double> block(blockNumValues);
+      std::vector<float> narrowed(blockNumValues);
+      FloatNarrowing::Error err;
+
+      const auto t0 = std::chrono::steady_clock::now();
+
+      for (std::uint64_t remaining = numBytes / sizeof(double); remaining != 0 && file.good();)
+      {
+          const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, blockNumValues));
+
+          file.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(n * sizeof(double)));
+          FloatNarrowing::narrow(block.data(), n, narrowed.data(), err);
+
+          remaining -= n;
+      }
+
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+      return file.good() && seconds > 0 ? numBytes / seconds * 1e-9 : 0;
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+PrefetchStreamBuf::PrefetchStreamBuf()
+    : _current(0),
+      _active(false),
+      _next_offset(0),
+      _restart_offset(0)
+{ /* do nothing */ }
+
+PrefetchStreamBuf::~PrefetchStreamBuf()
+{ close(); }
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+bool PrefetchStreamBuf::is_open() const
+{ return _reader.is_open(); }
+
+AsyncFileReader::Backend PrefetchStreamBuf::backend() const
+{ return _reader.backend(); }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool PrefetchStreamBuf::open(std::string_view filepath, AsyncFileReader::Backend backend, unsigned int queueDepth, std::size_t rangeNumBytes)
+{
+    close();
+
+    if (!_reader.open(filepath, backend, queueDepth))
+    { return false; }
+
+    _slots.resize(_reader.queue_depth());
+    for (Slot& s: _slots)
+    { s.data.resize(std::max<std::size_t>(1, rangeNumBytes)); }
+
+    _restart(0);
+
+    return true;
+}
+
+void PrefetchStreamBuf::close()
+{
+    _drain();
+    _reader.close();
+    _slots.clear();
+    _current = 0;
+    _active = false;
+    _next_offset = 0;
+    _restart_offset = 0;
+    setg(nullptr, nullptr, nullptr);
+}
+
+void PrefetchStreamBuf::_request(std::size_t slotId)
+{
+    Slot& s = _slots[slotId];
+    s.offset = _next_offset;
+    s.num_bytes = 0;
+    s.ok = true;
+    s.pending = false;
+
+    if (_next_offset >= _reader.file_num_bytes())
+    { return; } // past the end: empty slot
+
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(s.data.size(), _reader.file_num_bytes() - _next_offset));
+
+    s.pending = _reader.submit(_next_offset, s.data.data(), n, slotId);
+    s.ok = s.pending;
+    _next_offset += n;
+}
+
+bool PrefetchStreamBuf::_wait_for(std::size_t slotId)
+{
+    // completions of other slots are recorded on the way
+    while (_slots[slotId].pending)
+    {
+        std::uint64_t tag = 0;
+        std::size_t numBytesRead = 0;
+        const bool ok = _reader.wait(tag, numBytesRead);
+
+        Slot& s = _slots[tag];
+        s.pending = false;
+        s.num_bytes = numBytesRead;
+        s.ok = ok;
+    }
+
+    return _slots[slotId].ok;
+}
+
+bool PrefetchStreamBuf::_advance()
+{
+    // the consumed slot fetches the range after the last requested one
+    if (_active)
+    {
+        _request(_current);
+        _current = (_current + 1) % _slots.size();
+    }
+
+    _active = false;
+    setg(nullptr, nullptr, nullptr);
+
+    if (!_wait_for(_current))
+    { return false; }
+
+    Slot& s = _slots[_current];
+    setg(s.data.data(), s.data.data(), s.data.data() + s.num_bytes);
+    _active = true;
+
+    return s.num_bytes != 0;
+}
+
+void PrefetchStreamBuf::_drain()
+{
+    while (_reader.num_in_flight() != 0)
+    {
+        std::uint64_t tag = 0;
+        std::size_t numBytesRead = 0;
+        static_cast<void>(_reader.wait(tag, numBytesRead));
+        _slots[tag].pending = false;
+    }
+}
+
+void PrefetchStreamBuf::_restart(std::uint64_t offset)
+{
+    _drain();
+
+    _active = false;
+    setg(nullptr, nullptr, nullptr);
+
+    _current = 0;
+    _next_offset = offset;
+    _restart_offset = offset;
+
+    for (std::size_t i = 0; i < _slots.size(); ++i)
+    { _request(i); }
+}
+
+std::uint64_t PrefetchStreamBuf::_tell() const
+{ return _active ? _slots[_current].offset + static_cast<std::uint64_t>(gptr() - eback()) : _restart_offset; }
+
+PrefetchStreamBuf::int_type PrefetchStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+    { return traits_type::to_int_type(*gptr()); }
+
+    if (!is_open())
+    { return traits_type::eof(); }
+
+    _restart_offset = _tell();
+    if (!_advance())
+    { return traits_type::eof(); }
+
+    return traits_type::to_int_type(*gptr());
+}
+
+PrefetchStreamBuf::pos_type PrefetchStreamBuf::_seek(std::uint64_t target)
+{
+    // forward into requested ranges: consume them instead of dropping the read-ahead
+    if (_active)
+    {
+        while (target >= _slots[_current].offset + _slots[_current].num_bytes && target < _next_offset)
+        {
+            if (!_advance())
+            { break; }
+        }
+
+        Slot& s = _slots[_current];
+        if (_active && target >= s.offset && target <= s.offset + s.num_bytes)
+        {
+            setg(s.data.data(), s.data.data() + (target - s.offset), s.data.data() + s.num_bytes);
+            return pos_type(static_cast<off_type>(target));
+        }
+    }
+
+    _restart(target);
+    return pos_type(static_cast<off_type>(target));
+}
+
+PrefetchStreamBuf::pos_type PrefetchStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!is_open() || (which & std::ios_base::in) == 0)
+    { return pos_type(off_type(-1)); }
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+    { base = static_cast<off_type>(_tell()); }
+    else if (dir == std::ios_base::end)
+    { base = static_cast<off_type>(_reader.file_num_bytes()); }
+
+    // like std::filebuf, positions past the end are allowed; reads there hit the end of the file
+    const off_type target = base + off;
+    if (target < 0)
+    { return pos_type(off_type(-1)); }
+
+    // tellg()
+    if (dir == std::ios_base::cur && off == 0)
+    { return pos_type(target); }
+
+    return _seek(static_cast<std::uint64_t>(target));
+}
+
+PrefetchStreamBuf::pos_type PrefetchStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{ return seekoff(off_type(pos), std::ios_base::beg, which); }
+
+PrefetchBenchmark PrefetchStreamBuf::benchmark(std::string_view filepath, unsigned int queueDepth, std::size_t rangeNumBytes)
+{
+    PrefetchBenchmark res;
+
+    std::ifstream file(filepath.data(), std::ios_base::in | std::ios_base::binary);
+    if (!file.good())
+    { return res; }
+
+    file.seekg(0, std::ios_base::end);
+    res.num_bytes = static_cast<std::uint64_t>(file.tellg());
+
+    const auto run_ifstream = [&]()
+    {
+        file.clear();
+        file.seekg(0);
+        return narrow_stream(file, res.num_bytes, rangeNumBytes);
+    };
+
+    const auto run_prefetched = [&](AsyncFileReader::Backend backend)
+    {
+        PrefetchStreamBuf buf;
+        if (!buf.open(filepath, backend, queueDepth, rangeNumBytes) || buf.backend() != backend)
+        { return 0.0; }
+
+        std::istream stream(&buf);
+        return narrow_stream(stream, res.num_bytes, rangeNumBytes);
+    };
+
+    static_cast<void>(run_ifstream()); // page cache
+
+    res.ifstream_gb_per_second = run_ifstream();
+    res.io_uring_gb_per_second = run_prefetched(AsyncFileReader::Backend::IoUring);
+    res.thread_pool_gb_per_second = run_prefetched(AsyncFileReader::Backend::ThreadPool);
+
+    return res;
+}
@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_PREFETCHSTREAMBUF_H
+#define BLOODLINE_PREFETCHSTREAMBUF_H
+
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+#include "AsyncFileReader.h"
+
+struct PrefetchBenchmark
+{
+    std::uint64_t num_bytes = 0;
+    double ifstream_gb_per_second = 0; // current path: blocking std::ifstream::read
+    double io_uring_gb_per_second = 0; // 0 if io_uring is not available
+    double thread_pool_gb_per_second = 0;
+}; // struct PrefetchBenchmark
+
+/*
+ * Read-only stream buffer that keeps the next byte ranges of a file in flight (AsyncFileReader).
+ *
+ * Used as std::istream(&buf) in place of std::ifstream: while the parser decodes one range,
+ * the following queue_depth - 1 ranges are being fetched. Seeking inside the ranges that are
+ * already requested consumes them; any other seek restarts the read-ahead at the target.
+ */
+class PrefetchStreamBuf : public std::streambuf
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+    struct Slot
+    {
+        std::vector<char> data;
+        std::uint64_t offset = 0;
+        std::size_t num_bytes = 0;
+        bool pending = false;
+        bool ok = true;
+    }; // struct Slot
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    AsyncFileReader _reader;
+    std::vector<Slot> _slots; // ring; _slots[_current] holds the get area
+    std::size_t _current;
+    bool _active; // get area is set to _slots[_current]
+    std::uint64_t _next_offset; // of the next range to request
+    std::uint64_t _restart_offset;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    PrefetchStreamBuf();
+    PrefetchStreamBuf(const PrefetchStreamBuf&) = delete;
+    PrefetchStreamBuf(PrefetchStreamBuf&&) = delete;
+
+    ~PrefetchStreamBuf() override;
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] AsyncFileReader::Backend backend() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] PrefetchStreamBuf& operator=(const PrefetchStreamBuf&) = delete;
+    [[maybe_unused]] PrefetchStreamBuf& operator=(PrefetchStreamBuf&&) = delete;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    [[nodiscard]] bool open(std::string_view filepath, AsyncFileReader::Backend backend = AsyncFileReader::Backend::IoUring, unsigned int queueDepth = AsyncFileReader::DEFAULT_QUEUE_DEPTH, std::size_t rangeNumBytes = AsyncFileReader::DEFAULT_RANGE_NUM_BYTES);
+    void close();
+
+    /*!
+     * reads the whole file in rangeNumBytes blocks and narrows each block to float (as the single precision
+     * parsers do) through std::ifstream and through both backends; the page cache is warmed first; GB = 1e9 bytes
+     */
+    [[nodiscard]] static PrefetchBenchmark benchmark(std::string_view filepath, unsigned int queueDepth = AsyncFileReader::DEFAULT_QUEUE_DEPTH, std::size_t rangeNumBytes = AsyncFileReader::DEFAULT_RANGE_NUM_BYTES);
+
+  protected:
+    int_type underflow() override;
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+  private:
+    void _request(std::size_t slotId);
+    [[nodiscard]] bool _wait_for(std::size_t slotId);
+    [[nodiscard]] bool _advance();
+    void _drain();
+    void _restart(std::uint64_t offset);
+    [[nodiscard]] std::uint64_t _tell() const;
+    [[nodiscard]] pos_type _seek(std::uint64_t target);
+}; // class PrefetchStreamBuf
+
+#endif //BLOODLINE_PREFETCHSTREAMBUF_H
@@ -0,0 +1,348 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ReportSink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace
+{
+  [[nodiscard]] bool is_digit(char c)
+  { return c >= '0' && c <= '9'; }
+
+  //! -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+  [[nodiscard]] bool is_json_number(std::string_view s)
+  {
+      std::size_t i = 0;
+      const auto digits = [&]()
+      {
+          const std::size_t first = i;
+          while (i < s.size() && is_digit(s[i]))
+          { ++i; }
+
+          return i - first;
+      };
+
+      if (i < s.size() && s[i] == '-')
+      { ++i; }
+
+      const std::size_t intFirst = i;
+      const std::size_t numIntDigits = digits();
+      if (numIntDigits == 0 || (numIntDigits > 1 && s[intFirst] == '0'))
+      { return false; }
+
+      if (i < s.size() && s[i] == '.')
+      {
+          ++i;
+          if (digits() == 0)
+          { return false; }
+      }
+
+      if (i < s.size() && (s[i] == 'e' || s[i] == 'E'))
+      {
+          ++i;
+          if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+          { ++i; }
+
+          if (digits() == 0)
+          { return false; }
+      }
+
+      return i == s.size();
+  }
+
+  //! length of the valid UTF-8 sequence at the begin of s; 0 if invalid
+  [[nodiscard]] std::size_t utf8_sequence_length(std::string_view s)
+  {
+      const auto byte = [&](std::size_t i)
+      { return static_cast<unsigned char>(s[i]); };
+
+      const unsigned char c = byte(0);
+      const std::size_t n = c >= 0xF0 && c <= 0xF4 ? 4 : c >= 0xE0 ? 3 : c >= 0xC2 && c <= 0xDF ? 2 : 0;
+
+      if (n == 0 || s.size() < n)
+      { return 0; }
+
+      for (std::size_t i = 1; i < n; ++i)
+      {
+          if ((byte(i) & 0xC0) != 0x80)
+          { return 0; }
+      }
+
+      // overlong, surrogates, > U+10FFFF
+      if ((c == 0xE0 && byte(1) < 0xA0) || (c == 0xED && byte(1) > 0x9F) || (c == 0xF0 && byte(1) < 0x90) || (c == 0xF4 && byte(1) > 0x8F))
+      { return 0; }
+
+      return n;
+  }
+
+  //! invalid UTF-8 (e.g. uninitialized or binary characters) becomes U+FFFD
+  void append_json_string(std::string& out, std::string_view s)
+  {
+      static constexpr char HEX[] = "0123456789abcdef";
+
+      out += '"';
+
+      for (std::size_t i = 0; i < s.size(); ++i)
+      {
+          const char c = s[i];
+
+          if (static_cast<unsigned char>(c) >= 0x80)
+          {
+              const std::size_t n = utf8_sequence_length(s.substr(i));
+
+              if (n == 0)
+              { out += "\ufffd"; }
+              else
+              {
+                  out += s.substr(i, n);
+                  i += n - 1;
+              }
+          }
+          else if (c == '"' || c == '\\')
+          {
+              out += '\\';
+              out += c;
+          }
+          else if (c == '\t')
+          { out += "\\t"; }
+          else if (static_cast<unsigned char>(c) < 0x20)
+          {
+              out += "\\u00";
+              out += HEX[(c >> 4) & 0xF];
+              out += HEX[c & 0xF];
+          }
+          else
+          { out += c; }
+      }
+
+      out += '"';
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== ReportSink
+//====================================================================================================
+ReportSink::~ReportSink() = default;
+
+bool ReportSink::is_enabled() const
+{ return true; }
+
+void ReportSink::flush()
+{ /* do nothing */ }
+
+//====================================================================================================
+//===== NullReportSink
+//====================================================================================================
+bool NullReportSink::is_enabled() const
+{ return false; }
+
+void NullReportSink::write(std::string_view /*text*/)
+{ /* do nothing */ }
+
+//====================================================================================================
+//===== BufferedReportSink
+//====================================================================================================
+BufferedReportSink::BufferedReportSink()
+    : BufferedReportSink(-1)
+{ /* do nothing */ }
+
+BufferedReportSink::BufferedReportSink(int fd)
+    : _fd(fd),
+      _good(true)
+{
+    if (_fd >= 0)
+    { _buffer.reserve(BUFFER_NUM_BYTES + BUFFER_NUM_BYTES / 4); }
+}
+
+BufferedReportSink::~BufferedReportSink()
+{ BufferedReportSink::flush(); }
+
+std::string_view BufferedReportSink::str() const
+{ return _buffer; }
+
+std::size_t BufferedReportSink::size() const
+{ return _buffer.size(); }
+
+bool BufferedReportSink::good() const
+{ return _good; }
+
+void BufferedReportSink::flush()
+{
+    if (_fd < 0 || _buffer.empty())
+    { return; }
+
+    const char* p = _buffer.data();
+    std::size_t numBytesLeft = _buffer.size();
+
+    while (_good && numBytesLeft != 0)
+    {
+      #ifdef _WIN32
+        const int n = ::_write(_fd, p, static_cast<unsigned int>(std::min<std::size_t>(numBytesLeft, INT_MAX)));
+      #else
+        const ssize_t n = ::write(_fd, p, numBytesLeft);
+
+        if (n < 0 && errno == EINTR)
+        { continue; }
+      #endif
+
+        if (n <= 0)
+        {
+            _good = false;
+            break;
+        }
+
+        p += n;
+        numBytesLeft -= static_cast<std::size_t>(n);
+    }
+
+    _buffer.clear();
+}
+
+void BufferedReportSink::clear()
+{ _buffer.clear(); }
+
+void BufferedReportSink::_append(std::string_view text)
+{
+    _buffer.append(text);
+
+    if (_fd >= 0 && _buffer.size() >= BUFFER_NUM_BYTES)
+    { flush(); }
+}
+
+//====================================================================================================
+//===== TextReportSink
+//====================================================================================================
+TextReportSink::TextReportSink() = default;
+
+TextReportSink::TextReportSink(int fd)
+    : BufferedReportSink(fd)
+{ /* do nothing */ }
+
+void TextReportSink::write(std::string_view text)
+{ _append(text); }
+
+//====================================================================================================
+//===== JsonReportSink
+//====================================================================================================
+JsonReportSink::JsonReportSink() = default;
+
+JsonReportSink::JsonReportSink(int fd)
+    : BufferedReportSink(fd)
+{ /* do nothing */ }
+
+JsonReportSink::~JsonReportSink()
+{
+    if (!_line.empty())
+    { _write_line(_line); }
+}
+
+void JsonReportSink::write(std::string_view text)
+{
+    for (;;)
+    {
+        const std::size_t end = text.find('\n');
+
+        if (end == std::string_view::npos)
+        {
+            _line.append(text);
+            return;
+        }
+
+        if (_line.empty())
+        { _write_line(text.substr(0, end)); }
+        else
+        {
+            _line.append(text.substr(0, end));
+            _write_line(_line);
+            _line.clear();
+        }
+
+        text.remove_prefix(end + 1);
+    }
+}
+
+void JsonReportSink::clear()
+{
+    _line.clear();
+    BufferedReportSink::clear();
+}
+
+void JsonReportSink::_write_line(std::string_view line)
+{
+    std::size_t level = 0;
+    while (level < line.size() && line[level] == '\t')
+    { ++level; }
+
+    line.remove_prefix(level);
+
+    if (line.size() >= 2 && line[0] == '-' && line[1] == ' ')
+    { line.remove_prefix(2); }
+
+    while (!line.empty() && (line.back() == ' ' || line.back() == '\r'))
+    { line.remove_suffix(1); }
+
+    std::string out = "{\"level\":" + std::to_string(level);
+
+    const std::size_t sep = line.find(": ");
+
+    if (sep != std::string_view::npos)
+    {
+        std::string_view value = line.substr(sep + 2);
+        while (!value.empty() && value.front() == ' ')
+        { value.remove_prefix(1); }
+
+        out += ",\"key\":";
+        append_json_string(out, line.substr(0, sep));
+        out += ",\"value\":";
+
+        if (is_json_number(value))
+        { out += value; }
+        else
+        { append_json_string(out, value); }
+    }
+    else if (!line.empty() && line.back() == ':')
+    {
+        out += ",\"key\":";
+        append_json_string(out, line.substr(0, line.size() - 1));
+    }
+    else
+    {
+        out += ",\"text\":";
+        append_json_string(out, line);
+    }
+
+    out += "}\n";
+
+    _append(out);
+}
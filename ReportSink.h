@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_REPORTSINK_H
+#define BLOODLINE_REPORTSINK_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+ * Destination of the text report of ImporterScientific (see ReportWriter).
+ *
+ * The report is a sequence of lines: "\t" per level, optionally "- ", then "key: value" or text.
+ */
+class ReportSink
+{
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    ReportSink() = default;
+    ReportSink(const ReportSink&) = delete;
+    ReportSink(ReportSink&&) = delete;
+
+    virtual ~ReportSink();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    //! false: the writer skips all formatting and never calls write()
+    [[nodiscard]] virtual bool is_enabled() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] ReportSink& operator=(const ReportSink&) = delete;
+    [[maybe_unused]] ReportSink& operator=(ReportSink&&) = delete;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! appends text; lines end with '\n'
+    virtual void write(std::string_view text) = 0;
+
+    virtual void flush();
+}; // class ReportSink
+
+//! discards the report
+class NullReportSink : public ReportSink
+{
+  public:
+    [[nodiscard]] bool is_enabled() const override;
+
+    void write(std::string_view text) override;
+}; // class NullReportSink
+
+/*
+ * Append-only output buffer of a sink: kept in memory, or written to a file descriptor (not owned)
+ * whenever BUFFER_NUM_BYTES are pending, on flush() and on destruction.
+ */
+class BufferedReportSink : public ReportSink
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    static constexpr std::size_t BUFFER_NUM_BYTES = std::size_t(64) << 10;
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+  private:
+    std::string _buffer;
+    int _fd; // -1 = memory
+    bool _good;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  protected:
+    BufferedReportSink();
+    explicit BufferedReportSink(int fd);
+
+  public:
+    ~BufferedReportSink() override;
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    //! everything in memory mode; the part that has not been written to the file descriptor yet otherwise
+    [[nodiscard]] std::string_view str() const;
+    [[nodiscard]] std::size_t size() const;
+
+    //! false after a failed write to the file descriptor
+    [[nodiscard]] bool good() const;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    void flush() override;
+
+    //! drops the buffered output (memory mode: all of it)
+    virtual void clear();
+
+  protected:
+    void _append(std::string_view text);
+}; // class BufferedReportSink
+
+//! the report as text
+class TextReportSink : public BufferedReportSink
+{
+  public:
+    TextReportSink();
+    explicit TextReportSink(int fd);
+
+    void write(std::string_view text) override;
+}; // class TextReportSink
+
+/*
+ * The report as JSON Lines: one object per report line, written as soon as the line is complete.
+ *
+ *    "\t\t- num. points: 5000"  ->  {"level":2,"key":"num. points","value":5000}
+ *    "\t- reading mesh (...)"   ->  {"level":1,"text":"reading mesh (...)"}
+ *
+ * Values that are a single number are written as JSON numbers, all others as strings.
+ */
+class JsonReportSink : public BufferedReportSink
+{
+    std::string _line;
+
+  public:
+    JsonReportSink();
+    explicit JsonReportSink(int fd);
+
+    //! writes an incomplete last line
+    ~JsonReportSink() override;
+
+    void write(std::string_view text) override;
+    void clear() override;
+
+  private:
+    void _write_line(std::string_view line);
+}; // class JsonReportSink
+
+#endif //BLOODLINE_REPORTSINK_H
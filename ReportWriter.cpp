@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ReportWriter.h"
+
+#include <algorithm>
+#include <utility>
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+ReportWriter::ReportWriter()
+    : _text(std::make_unique<TextReportSink>()),
+      _sink(_text.get()),
+      _enabled(true),
+      _float_format(ReportFloatFormat::General),
+      _precision(6)
+{ /* do nothing */ }
+
+// _sink stays valid: _text is on the heap
+ReportWriter::ReportWriter(ReportWriter&&) noexcept = default;
+
+ReportWriter::~ReportWriter() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::string ReportWriter::str() const
+{ return _sink == _text.get() ? std::string(_text->str()) : std::string(); }
+
+bool ReportWriter::is_enabled() const
+{ return _enabled; }
+
+ReportFloatFormat ReportWriter::float_format() const
+{ return _float_format; }
+
+int ReportWriter::precision() const
+{ return _precision; }
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+ReportWriter& ReportWriter::operator=(ReportWriter&&) noexcept = default;
+
+void ReportWriter::set_sink(ReportSink* sink)
+{
+    _sink = sink != nullptr ? sink : _text.get();
+    _enabled = _sink->is_enabled();
+}
+
+void ReportWriter::set_float_format(ReportFloatFormat format)
+{ _float_format = format; }
+
+void ReportWriter::set_precision(int precision)
+{ _precision = std::clamp(precision, 0, MAX_PRECISION); }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void ReportWriter::clear()
+{ _text->clear(); }
+
+void ReportWriter::flush()
+{ _sink->flush(); }
+
+ReportWriter& ReportWriter::operator<<(std::string_view s)
+{
+    if (_enabled)
+    { _sink->write(s); }
+
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(const std::string& s)
+{ return *this << std::string_view(s); }
+
+ReportWriter& ReportWriter::operator<<(const char* s)
+{ return *this << std::string_view(s); }
+
+ReportWriter& ReportWriter::operator<<(char c)
+{ return *this << std::string_view(&c, 1); }
+
+ReportWriter& ReportWriter::operator<<(signed char c)
+{ return *this << static_cast<char>(c); }
+
+ReportWriter& ReportWriter::operator<<(unsigned char c)
+{ return *this << static_cast<char>(c); }
+
+ReportWriter& ReportWriter::operator<<(bool b)
+{ return *this << (b ? '1' : '0'); }
+
+ReportWriter& ReportWriter::operator<<(std::ostream& (*manipulator)(std::ostream&))
+{
+    if (manipulator == static_cast<std::ostream& (*)(std::ostream&)>(std::endl))
+    { *this << '\n'; }
+    else if (manipulator == static_cast<std::ostream& (*)(std::ostream&)>(std::flush))
+    { flush(); }
+
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(std::ios_base& (*manipulator)(std::ios_base&))
+{
+    if (manipulator == static_cast<std::ios_base& (*)(std::ios_base&)>(std::fixed))
+    { _float_format = ReportFloatFormat::Fixed; }
+    else if (manipulator == static_cast<std::ios_base& (*)(std::ios_base&)>(std::scientific))
+    { _float_format = ReportFloatFormat::Scientific; }
+    else if (manipulator == static_cast<std::ios_base& (*)(std::ios_base&)>(std::defaultfloat))
+    { _float_format = ReportFloatFormat::General; }
+
+    return *this;
+}
+
+void ReportWriter::_write_floating_point(double value)
+{
+    // fixed: up to 309 integer digits + sign + point + MAX_PRECISION
+    char buf[512];
+
+    std::chars_format format = std::chars_format::general;
+    switch (_float_format)
+    {
+        case ReportFloatFormat::General: format = std::chars_format::general; break;
+        case ReportFloatFormat::Fixed: format = std::chars_format::fixed; break;
+        case ReportFloatFormat::Scientific: format = std::chars_format::scientific; break;
+    }
+
+    const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value, format, _precision);
+
+    if (r.ec == std::errc())
+    { _sink->write(std::string_view(buf, static_cast<std::size_t>(r.ptr - buf))); }
+}
@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_REPORTWRITER_H
+#define BLOODLINE_REPORTWRITER_H
+
+#include <charconv>
+#include <ios>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "ReportSink.h"
+
+enum class ReportFloatFormat
+{
+    General, // std::defaultfloat
+    Fixed, // std::fixed
+    Scientific // std::scientific
+}; // enum class ReportFloatFormat
+
+/*
+ * Stream-like front end of a ReportSink; formats numbers with std::to_chars as std::ostream would
+ * (same float formats and precision, chars as characters, bool as 0/1).
+ *
+ * std::endl ends the line without flushing; std::flush flushes the sink. Nothing is formatted
+ * if the sink is disabled (NullReportSink).
+ *
+ * Without a sink the report is kept in memory (see str()).
+ */
+class ReportWriter
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+    static constexpr int MAX_PRECISION = 64;
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    std::unique_ptr<TextReportSink> _text; // in memory
+    ReportSink* _sink; // _text or not owned
+    bool _enabled;
+    ReportFloatFormat _float_format;
+    int _precision;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    ReportWriter();
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter(ReportWriter&&) noexcept;
+
+    ~ReportWriter();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    //! the report kept in memory; empty if a sink is set
+    [[nodiscard]] std::string str() const;
+
+    [[nodiscard]] bool is_enabled() const;
+    [[nodiscard]] ReportFloatFormat float_format() const;
+    [[nodiscard]] int precision() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] ReportWriter& operator=(const ReportWriter&) = delete;
+    [[maybe_unused]] ReportWriter& operator=(ReportWriter&&) noexcept;
+
+    //! not owned; nullptr = in memory (default)
+    void set_sink(ReportSink* sink);
+
+    void set_float_format(ReportFloatFormat format);
+
+    //! digits as std::ios_base::precision(); clamped to [0, 64]
+    void set_precision(int precision);
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! drops the report kept in memory
+    void clear();
+
+    void flush();
+
+    ReportWriter& operator<<(std::string_view s);
+    ReportWriter& operator<<(const std::string& s);
+    ReportWriter& operator<<(const char* s);
+    ReportWriter& operator<<(char c);
+    ReportWriter& operator<<(signed char c);
+    ReportWriter& operator<<(unsigned char c);
+    ReportWriter& operator<<(bool b);
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    ReportWriter& operator<<(T value)
+    {
+        if (_enabled)
+        {
+            char buf[24];
+            const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value);
+            _sink->write(std::string_view(buf, static_cast<std::size_t>(r.ptr - buf)));
+        }
+
+        return *this;
+    }
+
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    ReportWriter& operator<<(T value)
+    {
+        if (_enabled)
+        { _write_floating_point(static_cast<double>(value)); }
+
+        return *this;
+    }
+
+    //! std::endl, std::flush
+    ReportWriter& operator<<(std::ostream& (*manipulator)(std::ostream&));
+
+    //! std::defaultfloat, std::fixed, std::scientific
+    ReportWriter& operator<<(std::ios_base& (*manipulator)(std::ios_base&));
+
+  private:
+    void _write_floating_point(double value);
+}; // class ReportWriter
+
+#endif //BLOODLINE_REPORTWRITER_H
@@ -0,0 +1,191 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "SparseImageDecoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+std::size_t SparseImageDecoder::record_num_bytes(std::uint32_t numDims)
+{ return numDims * sizeof(std::uint32_t) + sizeof(double); }
+
+void SparseImageDecoder::deinterleave(const char* records, std::size_t n, std::uint32_t numDims, std::uint32_t* const* coords, double* values)
+{
+    const std::size_t recordNumBytes = record_num_bytes(numDims);
+
+    std::size_t i = 0;
+
+  #ifdef __SSE2__
+    //------------------------------------------------------------------------------------------------------
+    // 3D/4D: load the first 16 bytes of 4 records and transpose the 4x4 uint32 block
+    // - 3D: x y z + low half of the value; the value is copied separately
+    //------------------------------------------------------------------------------------------------------
+    if (numDims == 3 || numDims == 4)
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            const char* r = records + i * recordNumBytes;
+
+            const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+            const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + recordNumBytes));
+            const __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + 2 * recordNumBytes));
+            const __m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + 3 * recordNumBytes));
+
+            const __m128i xy01 = _mm_unpacklo_epi32(a0, a1);
+            const __m128i xy23 = _mm_unpacklo_epi32(a2, a3);
+            const __m128i zw01 = _mm_unpackhi_epi32(a0, a1);
+            const __m128i zw23 = _mm_unpackhi_epi32(a2, a3);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(coords[0] + i), _mm_unpacklo_epi64(xy01, xy23));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(coords[1] + i), _mm_unpackhi_epi64(xy01, xy23));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(coords[2] + i), _mm_unpacklo_epi64(zw01, zw23));
+
+            if (numDims == 4)
+            { _mm_storeu_si128(reinterpret_cast<__m128i*>(coords[3] + i), _mm_unpackhi_epi64(zw01, zw23)); }
+
+            for (unsigned int k = 0; k < 4; ++k)
+            { std::memcpy(values + i + k, r + k * recordNumBytes + numDims * sizeof(std::uint32_t), sizeof(double)); }
+        } // for i : groups of 4
+    }
+  #endif
+
+    for (; i < n; ++i)
+    {
+        const char* r = records + i * recordNumBytes;
+
+        for (std::uint32_t k = 0; k < numDims; ++k)
+        { std::memcpy(coords[k] + i, r + k * sizeof(std::uint32_t), sizeof(std::uint32_t)); }
+
+        std::memcpy(values + i, r + numDims * sizeof(std::uint32_t), sizeof(double));
+    }
+}
+
+bool SparseImageDecoder::decode(std::istream& file, std::uint32_t numDims, std::uint32_t numValues, std::vector<std::vector<std::uint32_t>>& coords, std::vector<double>& values, std::size_t blockNumBytes)
+{
+    coords.assign(numDims, std::vector<std::uint32_t>(numValues));
+    values.assign(numValues, 0);
+
+    const std::size_t recordNumBytes = record_num_bytes(numDims);
+    const std::size_t blockNumRecords = std::max<std::size_t>(1, blockNumBytes / recordNumBytes);
+
+    std::vector<char> block(std::min<std::size_t>(blockNumRecords, numValues) * recordNumBytes);
+    std::vector<std::uint32_t*> columns(numDims);
+
+    std::size_t numDecoded = 0;
+    while (numDecoded < numValues)
+    {
+        const std::size_t n = std::min<std::size_t>(blockNumRecords, numValues - numDecoded);
+
+        file.read(block.data(), static_cast<std::streamsize>(n * recordNumBytes));
+        const std::size_t numRead = static_cast<std::size_t>(file.gcount()) / recordNumBytes;
+
+        for (std::uint32_t k = 0; k < numDims; ++k)
+        { columns[k] = coords[k].data() + numDecoded; }
+
+        deinterleave(block.data(), numRead, numDims, columns.data(), values.data() + numDecoded);
+        numDecoded += numRead;
+
+        if (numRead != n)
+        { return false; } // truncated file
+    } // while numDecoded < numValues
+
+    return true;
+}
+
+SparseImageDecoder::Benchmark SparseImageDecoder::benchmark(std::uint32_t numDims, std::uint32_t numValues, unsigned int seed)
+{
+    //------------------------------------------------------------------------------------------------------
+    // random records
+    //------------------------------------------------------------------------------------------------------
+    const std::size_t recordNumBytes = record_num_bytes(numDims);
+
+    std::mt19937 rng(seed);
+    std::string bytes(numValues * recordNumBytes, '\0');
+
+    for (std::uint32_t i = 0; i < numValues; ++i)
+    {
+        char* r = bytes.data() + i * recordNumBytes;
+
+        for (std::uint32_t k = 0; k < numDims; ++k)
+        {
+            const std::uint32_t id = rng() % 512;
+            std::memcpy(r + k * sizeof(std::uint32_t), &id, sizeof(std::uint32_t));
+        }
+
+        const double value = std::uniform_real_distribution<double>(-1, 1)(rng);
+        std::memcpy(r + numDims * sizeof(std::uint32_t), &value, sizeof(double));
+    }
+
+    const auto entries_per_second = [&](auto&& f)
+    {
+        std::istringstream file(bytes);
+
+        const auto start = std::chrono::steady_clock::now();
+        f(file);
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+        return seconds.count() > 0 ? numValues / seconds.count() : 0;
+    };
+
+    Benchmark b;
+
+    //------------------------------------------------------------------------------------------------------
+    // former implementation: two reads per entry into interleaved grid ids
+    //------------------------------------------------------------------------------------------------------
+    b.per_entry_reads = entries_per_second([&](std::istream& file)
+                                           {
+                                               std::vector<std::uint32_t> gridPos(static_cast<std::size_t>(numValues) * numDims);
+                                               std::vector<double> values(numValues);
+
+                                               for (std::uint32_t i = 0; i < numValues; ++i)
+                                               {
+                                                   file.read(reinterpret_cast<char*>(gridPos.data() + static_cast<std::size_t>(i) * numDims), numDims * sizeof(std::uint32_t));
+                                                   file.read(reinterpret_cast<char*>(&values[i]), sizeof(double));
+                                               }
+                                           });
+
+    //------------------------------------------------------------------------------------------------------
+    // block decoder
+    //------------------------------------------------------------------------------------------------------
+    b.block_decoder = entries_per_second([&](std::istream& file)
+                                         {
+                                             std::vector<std::vector<std::uint32_t>> coords;
+                                             std::vector<double> values;
+                                             decode(file, numDims, numValues, coords, values);
+                                         });
+
+    return b;
+}
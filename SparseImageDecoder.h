@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_SPARSEIMAGEDECODER_H
+#define BLOODLINE_SPARSEIMAGEDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+/*
+ * Bulk decoder for the non-zero entries of the nd scalar image in sparse matrix style
+ * (see ImporterScientific::_parse_nd_scalar_image_in_sparse_matrix_style):
+ *
+ *      for numNonZeroValues:
+ *              [numDims] x [uint32] : grid id
+ *                    [1] x [double] : value
+ *
+ * The records are read in large blocks and de-interleaved into one column per dimension plus
+ * a value column. 3D and 4D records are transposed with SSE2 shuffles, 4 records at a time.
+ */
+class SparseImageDecoder
+{
+  public:
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+    static constexpr std::size_t DEFAULT_BLOCK_NUM_BYTES = 1 << 20;
+
+    struct Benchmark
+    {
+        double per_entry_reads = 0; // entries/s; two istream::read per entry (former implementation)
+        double block_decoder = 0; // entries/s
+    }; // struct Benchmark
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! record size in bytes
+    [[nodiscard]] static std::size_t record_num_bytes(std::uint32_t numDims);
+
+    //! splits n packed records into coords[numDims][n] and values[n]
+    static void deinterleave(const char* records, std::size_t n, std::uint32_t numDims, std::uint32_t* const* coords, double* values);
+
+    /*!
+     * reads numValues records from file; coords is resized to numDims columns of numValues
+     * @return false if the stream ended early (the missing entries stay zero)
+     */
+    static bool decode(std::istream& file, std::uint32_t numDims, std::uint32_t numValues, std::vector<std::vector<std::uint32_t>>& coords, std::vector<double>& values, std::size_t blockNumBytes = DEFAULT_BLOCK_NUM_BYTES);
+
+    //! decodes numValues random in-memory records of numDims dimensions with both methods
+    [[nodiscard]] static Benchmark benchmark(std::uint32_t numDims, std::uint32_t numValues, unsigned int seed = 0);
+}; // class SparseImageDecoder
+
+#endif //BLOODLINE_SPARSEIMAGEDECODER_H
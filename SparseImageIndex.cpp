@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "SparseImageIndex.h"
+
+#include <numeric>
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+SparseImageIndex::SparseImageIndex()
+    : _num_out_of_range(0)
+{ /* do nothing */ }
+
+SparseImageIndex::SparseImageIndex(const SparseImageData& img)
+    : SparseImageIndex()
+{ build(img); }
+
+SparseImageIndex::~SparseImageIndex() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::uint32_t SparseImageIndex::num_dims() const
+{ return _size.size(); }
+
+const std::vector<std::uint32_t>& SparseImageIndex::size() const
+{ return _size; }
+
+std::size_t SparseImageIndex::num_values() const
+{ return _keys.size(); }
+
+const std::vector<std::uint64_t>& SparseImageIndex::keys() const
+{ return _keys; }
+
+const std::vector<double>& SparseImageIndex::values() const
+{ return _values; }
+
+std::size_t SparseImageIndex::num_out_of_range() const
+{ return _num_out_of_range; }
+
+std::uint64_t SparseImageIndex::key(const std::uint32_t* gridPos) const
+{
+    std::uint64_t k = 0;
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    { k += gridPos[d] * _stride[d]; }
+
+    return k;
+}
+
+void SparseImageIndex::grid_pos(std::uint64_t key, std::uint32_t* gridPos) const
+{
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    {
+        gridPos[d] = static_cast<std::uint32_t>(key % _size[d]);
+        key /= _size[d];
+    }
+}
+
+std::optional<double> SparseImageIndex::find(const std::uint32_t* gridPos) const
+{
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    {
+        if (gridPos[d] >= _size[d])
+        { return std::nullopt; }
+    }
+
+    const std::uint64_t k = key(gridPos);
+    const auto it = std::lower_bound(_keys.begin(), _keys.end(), k);
+
+    if (it == _keys.end() || *it != k)
+    { return std::nullopt; }
+
+    return _values[it - _keys.begin()];
+}
+
+double SparseImageIndex::value_at(const std::uint32_t* gridPos, double background) const
+{ return find(gridPos).value_or(background); }
+
+std::pair<std::size_t, std::size_t> SparseImageIndex::time_step_range(std::uint32_t t) const
+{
+    if (_size.size() < 4)
+    { return {0, _keys.size()}; }
+
+    const std::uint64_t timeStride = _stride.back();
+    const auto first = std::lower_bound(_keys.begin(), _keys.end(), t * timeStride);
+    const auto last = std::lower_bound(first, _keys.end(), (t + 1) * timeStride);
+
+    return {static_cast<std::size_t>(first - _keys.begin()), static_cast<std::size_t>(last - _keys.begin())};
+}
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void SparseImageIndex::build(const SparseImageData& img)
+{
+    _size = img.grid_size;
+
+    _stride.resize(_size.size());
+    std::uint64_t stride = 1;
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    {
+        _stride[d] = stride;
+        stride *= _size[d];
+    }
+
+    //------------------------------------------------------------------------------------------------------
+    // keys in file order -> sorted permutation
+    //------------------------------------------------------------------------------------------------------
+    const std::size_t n = img.values.size();
+
+    // entries outside of grid_size (corrupt file) are skipped: their key would alias another voxel
+    std::vector<bool> inRange(n, true);
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    {
+        const std::vector<std::uint32_t>& column = img.grid_pos[d];
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (column[i] >= _size[d])
+            { inRange[i] = false; }
+        }
+    }
+
+    std::vector<std::uint64_t> keys(n, 0);
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    {
+        const std::vector<std::uint32_t>& column = img.grid_pos[d];
+        for (std::size_t i = 0; i < n; ++i)
+        { keys[i] += column[i] * _stride[d]; }
+    }
+
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (inRange[i])
+        { order.push_back(i); }
+    }
+
+    _num_out_of_range = n - order.size();
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+    { return keys[a] < keys[b]; });
+
+    _keys.clear();
+    _values.clear();
+    _keys.reserve(n);
+    _values.reserve(n);
+
+    for (std::size_t i: order)
+    {
+        if (!_keys.empty() && _keys.back() == keys[i])
+        { continue; } // duplicate
+
+        _keys.push_back(keys[i]);
+        _values.push_back(img.values[i]);
+    }
+}
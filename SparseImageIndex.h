@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_SPARSEIMAGEINDEX_H
+#define BLOODLINE_SPARSEIMAGEINDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ImporterScientificData.h"
+
+/*
+ * Sorted lookup structure for the nd scalar images in sparse matrix style (pressure map, tke,
+ * ivsd, segmentations, ...).
+ *
+ * Entries are keyed by the linearized grid index with the first dimension fastest:
+ *
+ *      key = g[0] + size[0] * (g[1] + size[1] * (g[2] + size[2] * g[3]))
+ *
+ * and stored sorted by key, so
+ * - a point lookup is a binary search (O(log n))
+ * - all entries of one time step (last dimension) are one contiguous range
+ * - a bounding box is one contiguous range per row along the first dimension
+ */
+class SparseImageIndex
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    std::vector<std::uint32_t> _size;
+    std::vector<std::uint64_t> _stride;
+    std::vector<std::uint64_t> _keys;
+    std::vector<double> _values;
+    std::size_t _num_out_of_range;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    SparseImageIndex();
+    explicit SparseImageIndex(const SparseImageData& img);
+    SparseImageIndex(const SparseImageIndex&) = default;
+    SparseImageIndex(SparseImageIndex&&) noexcept = default;
+
+    ~SparseImageIndex();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] std::uint32_t num_dims() const;
+    [[nodiscard]] const std::vector<std::uint32_t>& size() const;
+    [[nodiscard]] std::size_t num_values() const;
+
+    //! sorted
+    [[nodiscard]] const std::vector<std::uint64_t>& keys() const;
+    [[nodiscard]] const std::vector<double>& values() const;
+
+    //! entries of the last build() whose grid position is outside of the image size; they are not indexed
+    [[nodiscard]] std::size_t num_out_of_range() const;
+
+    //! gridPos has num_dims() values
+    [[nodiscard]] std::uint64_t key(const std::uint32_t* gridPos) const;
+    void grid_pos(std::uint64_t key, std::uint32_t* gridPos) const;
+
+    //! std::nullopt if the voxel is not stored (i.e. zero)
+    [[nodiscard]] std::optional<double> find(const std::uint32_t* gridPos) const;
+    [[nodiscard]] double value_at(const std::uint32_t* gridPos, double background = 0) const;
+
+    //! [first, last) entry ids of time step t (last dimension); all entries if num_dims() < 4
+    [[nodiscard]] std::pair<std::size_t, std::size_t> time_step_range(std::uint32_t t) const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] SparseImageIndex& operator=(const SparseImageIndex&) = default;
+    [[maybe_unused]] SparseImageIndex& operator=(SparseImageIndex&&) noexcept = default;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! duplicate grid positions keep the first value in file order; out-of-range grid positions are skipped
+    void build(const SparseImageData& img);
+
+    //! f(const std::uint32_t* gridPos, double value) for every entry of time step t, in key order
+    template<typename F>
+    void for_each_in_time_step(std::uint32_t t, F f) const
+    {
+        const auto [first, last] = time_step_range(t);
+
+        std::vector<std::uint32_t> gridPos(_size.size());
+        for (std::size_t i = first; i < last; ++i)
+        {
+            grid_pos(_keys[i], gridPos.data());
+            f(static_cast<const std::uint32_t*>(gridPos.data()), _values[i]);
+        }
+    }
+
+    /*!
+     * f(const std::uint32_t* gridPos, double value) for every entry with lower <= gridPos <= upper
+     * (per dimension, inclusive; clamped to the image size), in key order
+     */
+    template<typename F>
+    void for_each_in_box(const std::uint32_t* lower, const std::uint32_t* upper, F f) const
+    {
+        const std::size_t numDims = _size.size();
+        if (numDims == 0 || _keys.empty())
+        { return; }
+
+        std::vector<std::uint32_t> lo(numDims);
+        std::vector<std::uint32_t> hi(numDims);
+        for (std::size_t d = 0; d < numDims; ++d)
+        {
+            if (_size[d] == 0 || lower[d] > upper[d] || lower[d] >= _size[d])
+            { return; }
+
+            lo[d] = lower[d];
+            hi[d] = std::min(upper[d], _size[d] - 1);
+        }
+
+        //------------------------------------------------------------------------------------------------------
+        // odometer over dimensions 1..n-1; each row along dimension 0 is a contiguous key range
+        //------------------------------------------------------------------------------------------------------
+        std::vector<std::uint32_t> row(lo);
+        std::vector<std::uint32_t> gridPos(numDims);
+
+        for (;;)
+        {
+            row[0] = lo[0];
+            const std::uint64_t first = key(row.data());
+            const std::uint64_t last = first + (hi[0] - lo[0]);
+
+            for (auto it = std::lower_bound(_keys.begin(), _keys.end(), first); it != _keys.end() && *it <= last; ++it)
+            {
+                grid_pos(*it, gridPos.data());
+                f(static_cast<const std::uint32_t*>(gridPos.data()), _values[it - _keys.begin()]);
+            }
+
+            std::size_t d = 1;
+            for (; d < numDims; ++d)
+            {
+                if (row[d] < hi[d])
+                {
+                    ++row[d];
+                    break;
+                }
+
+                row[d] = lo[d];
+            }
+
+            if (d == numDims)
+            { break; }
+        } // for ever
+    }
+}; // class SparseImageIndex
+
+#endif //BLOODLINE_SPARSEIMAGEINDEX_H
@@ -0,0 +1,588 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "SyntheticDataset.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+#include "ImporterScientific.h"
+
+namespace
+{
+  constexpr std::size_t BLOCK_NUM_VALUES = 1 << 16;
+
+  /*
+   * binary writer with its own random values;
+   * std::uniform_*_distribution is implementation-defined, hence the explicit mappings
+   */
+  class Writer
+  {
+      std::ofstream _file;
+      std::mt19937_64& _rng;
+      std::vector<char> _block;
+
+    public:
+      Writer(const std::filesystem::path& path, std::mt19937_64& rng)
+          : _file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc),
+            _rng(rng)
+      { /* do nothing */ }
+
+      [[nodiscard]] bool good() const
+      { return _file.good(); }
+
+      //! uniform in [lo, hi)
+      [[nodiscard]] double uniform(double lo = -5, double hi = 5)
+      { return lo + (hi - lo) * static_cast<double>(_rng() >> 11) * 0x1.0p-53; }
+
+      //! uniform in [0, n)
+      [[nodiscard]] std::uint32_t index(std::uint32_t n)
+      { return static_cast<std::uint32_t>(((_rng() >> 32) * n) >> 32); }
+
+      template<typename T>
+      void value(T v)
+      { _file.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+
+      void string16(std::string_view s)
+      {
+          value(static_cast<std::uint16_t>(s.size()));
+          _file.write(s.data(), static_cast<std::streamsize>(s.size()));
+      }
+
+      void random_doubles(std::uint64_t n)
+      {
+          _block.resize(BLOCK_NUM_VALUES * sizeof(double));
+
+          while (n != 0)
+          {
+              const std::size_t num = static_cast<std::size_t>(std::min<std::uint64_t>(n, BLOCK_NUM_VALUES));
+
+              for (std::size_t i = 0; i < num; ++i)
+              {
+                  const double v = uniform();
+                  std::memcpy(_block.data() + i * sizeof(double), &v, sizeof(double));
+              }
+
+              _file.write(_block.data(), static_cast<std::streamsize>(num * sizeof(double)));
+              n -= num;
+          }
+      }
+
+      //! n ids in [0, idRange)
+      void random_ids(std::uint64_t n, std::uint32_t idRange)
+      {
+          for (std::uint64_t i = 0; i < n; ++i)
+          { value(index(idRange)); }
+      }
+
+      //! see ImporterScientific::_parse_nd_scalar_image_in_sparse_matrix_style(); returns the number of values
+      std::uint32_t sparse_image(const std::vector<std::uint32_t>& dims, double fill)
+      {
+          std::uint64_t numVoxels = 1;
+          value(static_cast<std::uint32_t>(dims.size()));
+          for (const std::uint32_t d: dims)
+          {
+              value(d);
+              numVoxels *= d;
+          }
+
+          random_doubles(dims.size() + 16 + 16 + 25 + 25);
+
+          const std::uint32_t n = static_cast<std::uint32_t>(std::min<double>(std::ceil(fill * static_cast<double>(numVoxels)), 0xFFFFFFFFu));
+          value(n);
+
+          for (std::uint32_t i = 0; i < n; ++i)
+          {
+              for (const std::uint32_t d: dims)
+              { value(index(d)); }
+
+              value(uniform());
+          }
+
+          return n;
+      }
+  }; // class Writer
+} // anonymous namespace
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+SyntheticDatasetSize SyntheticDataset::size(SyntheticScale scale)
+{
+    SyntheticDatasetSize s;
+    s.num_vessels = 2;
+    s.num_flow_jets = 2;
+    s.sparse_fill = 0.05;
+
+    switch (scale)
+    {
+        case SyntheticScale::Small:
+        {
+            s.grid_size = {32, 32, 24, 20};
+            s.num_mesh_points = 5000;
+            s.num_centerlines = 4;
+            s.num_centerline_points = 200;
+            s.num_pathlines = 1000;
+            s.num_pathline_points = 50;
+            s.num_flow_jet_points = 50;
+            s.num_measuring_planes = 2;
+            s.measuring_plane_size = 16;
+            s.num_uncertainty_samples = 100;
+            s.num_dicom_images = 3;
+            break;
+        }
+        case SyntheticScale::Medium:
+        {
+            s.grid_size = {96, 96, 64, 25};
+            s.num_mesh_points = 100000;
+            s.num_centerlines = 8;
+            s.num_centerline_points = 1000;
+            s.num_pathlines = 20000;
+            s.num_pathline_points = 100;
+            s.num_flow_jet_points = 200;
+            s.num_measuring_planes = 4;
+            s.measuring_plane_size = 48;
+            s.num_uncertainty_samples = 1000;
+            s.num_dicom_images = 10;
+            break;
+        }
+        case SyntheticScale::Huge:
+        {
+            s.grid_size = {192, 192, 128, 30};
+            s.num_mesh_points = 1000000;
+            s.num_centerlines = 16;
+            s.num_centerline_points = 5000;
+            s.num_pathlines = 200000;
+            s.num_pathline_points = 200;
+            s.num_flow_jet_points = 1000;
+            s.num_measuring_planes = 8;
+            s.measuring_plane_size = 96;
+            s.num_uncertainty_samples = 10000;
+            s.num_dicom_images = 100;
+            break;
+        }
+    }
+
+    return s;
+}
+
+std::string_view SyntheticDataset::name(SyntheticScale scale)
+{
+    switch (scale)
+    {
+        case SyntheticScale::Small: return "small";
+        case SyntheticScale::Medium: return "medium";
+        case SyntheticScale::Huge: return "huge";
+    }
+
+    return "";
+}
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+std::vector<SyntheticFile> SyntheticDataset::generate(std::string_view dir, SyntheticScale scale, std::uint64_t seed)
+{ return generate(dir, size(scale), seed); }
+
+std::vector<SyntheticFile> SyntheticDataset::generate(std::string_view dir, const SyntheticDatasetSize& size, std::uint64_t seed)
+{
+    namespace fs = std::filesystem;
+
+    std::vector<SyntheticFile> files;
+    std::error_code ec;
+
+    const fs::path root(dir);
+    fs::create_directories(root, ec);
+    if (ec)
+    { return files; }
+
+    std::mt19937_64 rng(seed);
+    bool success = true;
+
+    const auto [X, Y, Z, T] = size.grid_size;
+    const std::uint64_t numVoxels = static_cast<std::uint64_t>(X) * Y * Z;
+    const std::vector<std::uint32_t> dims3 = {X, Y, Z};
+    const std::vector<std::uint32_t> dims4 = {X, Y, Z, T};
+
+    // calls write(Writer&) -> number of items and records the file
+    const auto add = [&](const std::string& path, std::string_view reader, std::string_view itemName, auto&& write)
+    {
+        Writer w(root / path, rng);
+        const std::uint64_t numItems = write(w);
+
+        success = success && w.good();
+        files.push_back({path, std::string(reader), std::string(itemName), numItems});
+    };
+
+    const auto add_text = [&](const std::string& path, std::string_view reader, std::string_view itemName, const std::string& text, std::uint64_t numItems)
+    {
+        std::ofstream file(root / path, std::ios_base::out | std::ios_base::trunc);
+        file << text;
+
+        success = success && file.good();
+        files.push_back({path, std::string(reader), std::string(itemName), numItems});
+    };
+
+    //------------------------------------------------------------------------------------------------------
+    // dataset
+    //------------------------------------------------------------------------------------------------------
+    {
+        std::string tags;
+        for (unsigned int i = 0; i < 8; ++i)
+        { tags += "tag" + std::to_string(i) + ";"; }
+
+        add_text("dataset_tags.txt", "read_dataset_filter_tags", "tags", tags, 8);
+    }
+
+    add("dicom_tags_3dt_flow", "read_dicom_tags", "images", [&](Writer& w)
+    {
+        w.value(static_cast<std::uint16_t>(size.num_dicom_images));
+
+        for (std::uint32_t i = 0; i < size.num_dicom_images; ++i)
+        {
+            w.value(static_cast<std::uint16_t>(i));
+            w.value(static_cast<std::uint16_t>(3));
+            w.value(static_cast<std::uint16_t>(X));
+            w.value(static_cast<std::uint16_t>(Y));
+            w.value(static_cast<std::uint16_t>(Z));
+            w.value(static_cast<std::uint16_t>(T));
+            w.value(static_cast<std::uint32_t>(Z * T));
+            w.random_doubles(4);
+            w.string16("Name");
+            w.string16("ID");
+            w.string16("M");
+            w.value(static_cast<std::uint8_t>(42));
+            w.random_doubles(1);
+            for (const std::string_view s: {"19700101", "seq", "seqp", "HFS", "study", "series", "1.2.3", "4.5.6", "proto", "MR"})
+            { w.string16(s); }
+            w.value(static_cast<std::uint8_t>(1));
+            w.value(static_cast<std::uint32_t>(4095));
+            w.value(static_cast<std::uint8_t>(16));
+            w.value(static_cast<std::uint8_t>(12));
+            w.value(static_cast<std::uint8_t>(11));
+            w.string16("20200101");
+            w.string16("inst");
+            w.random_doubles(3 + 3 + 16);
+        }
+
+        return size.num_dicom_images;
+    });
+
+    add("venc", "read_venc", "vencs", [&](Writer& w)
+    {
+        for (std::uint16_t i = 1; i <= 3; ++i)
+        {
+            w.value(i);
+            w.random_doubles(1);
+        }
+
+        w.value(static_cast<std::uint8_t>(2));
+        for (std::uint16_t i = 7; i <= 8; ++i)
+        {
+            w.value(i);
+            w.random_doubles(1);
+        }
+
+        return 5;
+    });
+
+    add("cardiac_cycle", "read_cardiac_cycle_definition", "values", [&](Writer& w)
+    {
+        w.value(T);
+        w.value(std::uint32_t(1));
+        w.random_doubles(1);
+        w.value(std::min(T - 1, std::uint32_t(3)));
+        w.random_doubles(1);
+        w.value(size.num_vessels);
+        w.random_doubles(static_cast<std::uint64_t>(size.num_vessels) * T);
+
+        return static_cast<std::uint64_t>(size.num_vessels) * T;
+    });
+
+    add("static_tissue_mask_in_flowfield_size", "read_static_tissue_mask", "values", [&](Writer& w)
+    { return w.sparse_image(dims3, size.sparse_fill); });
+
+    add("static_tissue_ivsd_thresholds", "read_static_tissue_ivsd_thresholds", "thresholds", [&](Writer& w)
+    {
+        w.random_doubles(2);
+        return 2;
+    });
+
+    add("phase_wraps_3dt", "read_phase_wrapped_voxels", "voxels", [&](Writer& w)
+    {
+        const std::uint32_t n = static_cast<std::uint32_t>(std::ceil(1e-3 * numVoxels * T));
+
+        for (unsigned int c = 0; c < 3; ++c)
+        {
+            w.value(n);
+            for (std::uint32_t i = 0; i < n; ++i)
+            {
+                for (const std::uint32_t d: dims4)
+                { w.value(w.index(d)); }
+
+                w.value(static_cast<std::int8_t>(w.index(2) == 0 ? -1 : 1));
+            }
+        }
+
+        return std::uint64_t(3) * n;
+    });
+
+    add("flowfield", "read_flowfield", "vectors", [&](Writer& w)
+    {
+        for (const std::uint32_t s: size.grid_size)
+        { w.value(s); }
+
+        w.random_doubles(4 + 16 + 16 + 25 + 25 + 9 + 9);
+        w.random_doubles(numVoxels * T * 3);
+
+        return numVoxels * T;
+    });
+
+    add("velocity_offset_correction_3dt.voc", "read_velocity_offset_correction_3dt", "slices", [&](Writer& w)
+    {
+        w.value(std::min(T - 1, std::uint32_t(2)));
+        w.random_doubles(1);
+
+        for (unsigned int c = 0; c < 3; ++c)
+        {
+            w.value(Z);
+            w.random_doubles(std::uint64_t(Z) * 3);
+        }
+
+        return std::uint64_t(3) * Z;
+    });
+
+    for (const std::string_view name: {"flowfield_2dt_a", "flowfield_2dt_b"})
+    {
+        add(std::string(name), "read_flow2dt_images", "pixels", [&](Writer& w)
+        {
+            w.value(X);
+            w.value(Y);
+            w.value(T);
+            w.random_doubles(3 + 16 + 16 + 25 + 25);
+            w.random_doubles(std::uint64_t(X) * Y * T);
+
+            return std::uint64_t(X) * Y * T;
+        });
+    }
+
+    add("magnitude3dt_tmip", "read_magnitude_tmip", "values", [&](Writer& w)
+    { return w.sparse_image(dims3, size.sparse_fill); });
+
+    add("3d_anatomical_image_0", "read_anatomical_images", "values", [&](Writer& w)
+    { return w.sparse_image(dims3, size.sparse_fill); });
+
+    add("3dt_anatomical_image_0", "read_anatomical_images", "values", [&](Writer& w)
+    { return w.sparse_image(dims4, size.sparse_fill); });
+
+    for (const auto& [name, reader]: {std::pair<std::string_view, std::string_view>{"pressuremap", "read_pressure_map"},
+                                      {"rotationdirection", "read_rotation_direction_map"},
+                                      {"axialvelocity", "read_axial_velocity_map"},
+                                      {"cosangletocenterline", "read_cos_angle_to_centerline_map"},
+                                      {"tke", "read_turbulent_kinetic_energy_map"},
+                                      {"ivsd", "read_ivsd"}})
+    {
+        add(std::string(name), reader, "values", [&](Writer& w)
+        { return w.sparse_image(dims4, size.sparse_fill); });
+    }
+
+    add("flow_stats", "read_flow_statistics", "statistics", [&](Writer& w)
+    {
+        const std::vector<std::pair<std::string_view, bool>> layout = ImporterScientific::flow_statistics_layout();
+
+        w.value(T);
+        for (const auto& [name, perTime]: layout)
+        { w.random_doubles(perTime ? T : 1); }
+
+        return layout.size();
+    });
+
+    //------------------------------------------------------------------------------------------------------
+    // vessels
+    //------------------------------------------------------------------------------------------------------
+    for (std::uint32_t v = 0; v < size.num_vessels; ++v)
+    {
+        const std::string vessel = "vessel" + std::string(1, static_cast<char>('A' + v % 26)) + (v >= 26 ? std::to_string(v) : "") + "/";
+        fs::create_directories(root / vessel, ec);
+        success = success && !ec;
+
+        const std::uint32_t P = size.num_mesh_points;
+        const std::uint32_t numTriangles = 2 * P;
+
+        add(vessel + "mesh", "read_mesh", "points", [&](Writer& w)
+        {
+            const std::uint64_t numValuesPerTime = static_cast<std::uint64_t>(P) * T;
+
+            w.value(P);
+            w.random_doubles(std::uint64_t(6) * P);
+            w.value(numTriangles);
+            w.random_ids(std::uint64_t(3) * numTriangles, P);
+            w.random_doubles(std::uint64_t(3) * numTriangles);
+            w.value(T);
+            w.random_doubles(3 * numValuesPerTime + 9 * numValuesPerTime);
+            w.random_doubles(std::uint64_t(6) * P + std::uint64_t(9) * P);
+
+            return P;
+        });
+
+        add(vessel + "centerline_seed_target_ids_on_mesh", "read_centerline_start_end_ids_on_mesh", "ids", [&](Writer& w)
+        {
+            w.value(w.index(P));
+            w.value(size.num_centerlines);
+            w.random_ids(size.num_centerlines, P);
+
+            return size.num_centerlines + 1;
+        });
+
+        add(vessel + "centerlines", "read_centerlines", "points", [&](Writer& w)
+        {
+            const std::uint32_t n = size.num_centerline_points;
+
+            w.value(size.num_centerlines);
+            for (std::uint32_t c = 0; c < size.num_centerlines; ++c)
+            {
+                w.value(n);
+                w.random_doubles(std::uint64_t(3 + 1 + 9) * n);
+            }
+
+            return static_cast<std::uint64_t>(size.num_centerlines) * n;
+        });
+
+        add(vessel + "flowjets", "read_flow_jet", "points", [&](Writer& w)
+        {
+            const std::uint32_t n = size.num_flow_jet_points;
+
+            w.value(size.num_flow_jets);
+            for (std::uint32_t f = 0; f < size.num_flow_jets; ++f)
+            {
+                w.value(n);
+                w.value(T);
+
+                for (std::uint32_t p = 0; p < n; ++p)
+                {
+                    w.random_doubles(std::uint64_t(3 + 1 + 3 + 3 + 1 + 3 + 1) * T);
+                    w.random_doubles(3 + 1 + 3 + 3);
+                }
+            }
+
+            return static_cast<std::uint64_t>(size.num_flow_jets) * n * T;
+        });
+
+        add(vessel + "pathlines", "read_pathlines", "points", [&](Writer& w)
+        {
+            const std::uint32_t n = size.num_pathline_points;
+
+            w.value(size.num_pathlines);
+            for (std::uint32_t p = 0; p < size.num_pathlines; ++p)
+            {
+                w.value(n);
+                w.random_doubles(std::uint64_t(4 + 5) * n + 1);
+            }
+
+            return static_cast<std::uint64_t>(size.num_pathlines) * n;
+        });
+
+        add(vessel + "measuring_planes", "read_landmark_measuring_planes", "planes", [&](Writer& w)
+        {
+            const std::uint32_t g = size.measuring_plane_size;
+            const std::uint64_t numPixels = static_cast<std::uint64_t>(g) * g;
+            const std::uint32_t numSamples = size.num_uncertainty_samples;
+
+            const auto plane = [&]()
+            {
+                w.value(static_cast<std::uint8_t>(v));
+                w.value(g);
+                w.value(g);
+                w.value(T);
+                w.random_doubles(3 + 3 + 9 + 1);
+                w.random_doubles(numPixels * T * 3);
+                for (std::uint64_t i = 0; i < numPixels; ++i)
+                { w.value(static_cast<std::uint8_t>('A' + w.index(5))); }
+                w.random_doubles(numPixels * T * 2);
+                w.random_doubles(22);
+                w.random_doubles(std::uint64_t(7) * T);
+                w.random_doubles(18);
+                w.random_doubles(std::uint64_t(3) * T);
+                w.value(numSamples);
+                w.random_doubles(std::uint64_t(5) * numSamples);
+            };
+
+            w.value(size.num_measuring_planes);
+            w.value(size.num_measuring_planes);
+
+            for (std::uint32_t i = 0; i < size.num_measuring_planes; ++i)
+            { plane(); }
+
+            for (std::uint32_t i = 0; i < size.num_measuring_planes; ++i)
+            {
+                w.value(i);
+                plane();
+            }
+
+            return std::uint64_t(2) * size.num_measuring_planes;
+        });
+
+        add(vessel + "segmentation", "read_segmentation", "values", [&](Writer& w)
+        { return w.sparse_image(dims3, size.sparse_fill); });
+
+        add_text(vessel + "segmentation_info.txt", "read_segmentation_info", "lines", "The segmentation was performed on the LPC.\n\nline2\n", 2);
+
+        add(vessel + "graphcut_segmentation_inside_outside_ids", "read_segmentation_graphcut_inside_outside_ids", "ids", [&](Writer& w)
+        {
+            const std::uint32_t n = static_cast<std::uint32_t>(std::ceil(size.sparse_fill * numVoxels));
+
+            w.value(n);
+            w.value(n);
+            for (std::uint64_t i = 0; i < std::uint64_t(2) * n; ++i)
+            {
+                for (const std::uint32_t d: dims3)
+                { w.value(w.index(d)); }
+            }
+
+            return std::uint64_t(2) * n;
+        });
+
+        add(vessel + "segmentation_in_flowfield_size", "read_segmentation_in_flowfield_size", "values", [&](Writer& w)
+        { return w.sparse_image(dims3, size.sparse_fill); });
+
+        add(vessel + "vessel_section_segmentation_in_flowfield_size", "read_vessel_section_segmentation_in_flowfield_size", "values", [&](Writer& w)
+        {
+            w.value(std::uint32_t(2));
+            return std::uint64_t(w.sparse_image(dims3, 0.5 * size.sparse_fill)) + w.sparse_image(dims3, 0.5 * size.sparse_fill);
+        });
+
+        add_text(vessel + "vessel_section_info.txt", "read_vessel_section_segmentation_semantics", "sections", "section 0: asc\nsection 1: desc\n", 2);
+    } // for vessels
+
+    if (!success)
+    { files.clear(); }
+
+    return files;
+}
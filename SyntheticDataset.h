@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_SYNTHETICDATASET_H
+#define BLOODLINE_SYNTHETICDATASET_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class SyntheticScale
+{
+    Small, // ~ 40 MB
+    Medium, // ~ 1.3 GB
+    Huge // ~ 16 GB; flowfield > 2 GiB
+}; // enum class SyntheticScale
+
+struct SyntheticDatasetSize
+{
+    std::array<std::uint32_t, 4> grid_size{}; // flowfield x y z t; also the size of all images
+    double sparse_fill = 0; // fraction of voxels stored in the sparse images
+    std::uint32_t num_vessels = 0;
+    std::uint32_t num_mesh_points = 0; // 2 triangles per point
+    std::uint32_t num_centerlines = 0;
+    std::uint32_t num_centerline_points = 0; // per centerline
+    std::uint32_t num_pathlines = 0;
+    std::uint32_t num_pathline_points = 0; // per pathline
+    std::uint32_t num_flow_jets = 0;
+    std::uint32_t num_flow_jet_points = 0; // per flow jet
+    std::uint32_t num_measuring_planes = 0; // + as many landmark planes
+    std::uint32_t measuring_plane_size = 0; // grid x and y
+    std::uint32_t num_uncertainty_samples = 0; // per measuring plane
+    std::uint32_t num_dicom_images = 0;
+}; // struct SyntheticDatasetSize
+
+//! one generated file and the reader that parses it
+struct SyntheticFile
+{
+    std::string path; // relative to the dataset directory
+    std::string reader; // name of the ImporterScientific::read_*() function
+    std::string item_name; // what num_items counts
+    std::uint64_t num_items = 0;
+}; // struct SyntheticFile
+
+/*
+ * Deterministic generator of complete datasets in the formats documented in ImporterScientific.cpp.
+ *
+ * Contents are random (but valid: ids are in range, counts match the payloads); the same seed
+ * produces the same bytes on every platform.
+ */
+class SyntheticDataset
+{
+  public:
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] static SyntheticDatasetSize size(SyntheticScale scale);
+    [[nodiscard]] static std::string_view name(SyntheticScale scale);
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! writes the dataset to dir (created if missing); in read_all() order; empty on failure
+    [[nodiscard]] static std::vector<SyntheticFile> generate(std::string_view dir, const SyntheticDatasetSize& size, std::uint64_t seed = 0);
+    [[nodiscard]] static std::vector<SyntheticFile> generate(std::string_view dir, SyntheticScale scale, std::uint64_t seed = 0);
+}; // class SyntheticDataset
+
+#endif //BLOODLINE_SYNTHETICDATASET_H
@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace
+{
+  // identifies the worker that runs the calling thread
+  thread_local const ThreadPool* t_pool = nullptr;
+  thread_local unsigned int t_queue_id = 0;
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+ThreadPool::ThreadPool(unsigned int numThreads)
+    : _num_pending(0),
+      _stop(false)
+{
+    if (numThreads == 0)
+    { numThreads = std::max(1U, std::thread::hardware_concurrency()); }
+
+    _queues.reserve(numThreads + 1);
+    for (unsigned int i = 0; i <= numThreads; ++i)
+    { _queues.emplace_back(std::make_unique<Queue>()); }
+
+    _workers.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i)
+    { _workers.emplace_back(&ThreadPool::_work, this, i); }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _cv.notify_all();
+
+    for (std::thread& w: _workers)
+    { w.join(); }
+}
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+unsigned int ThreadPool::num_threads() const
+{ return _workers.size(); }
+
+bool ThreadPool::is_worker() const
+{ return t_pool == this; }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+bool ThreadPool::run_pending_task()
+{
+    std::function<void()> task;
+
+    if (!_pop(task))
+    { return false; }
+
+    task();
+    return true;
+}
+
+void ThreadPool::_push(std::function<void()> task)
+{
+    Queue& q = is_worker() ? *_queues[t_queue_id] : *_queues.back();
+
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.emplace_back(std::move(task));
+        ++_num_pending;
+    }
+
+    // a worker checks _num_pending under _mutex before it sleeps -> no lost wake-up
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+
+    _cv.notify_one();
+}
+
+bool ThreadPool::_pop(std::function<void()>& task)
+{
+    const bool isWorker = is_worker();
+    const std::size_t numQueues = _queues.size();
+    const std::size_t injectionQueueId = numQueues - 1;
+
+    // own deque: newest first
+    if (isWorker)
+    {
+        Queue& q = *_queues[t_queue_id];
+        std::lock_guard<std::mutex> lock(q.mutex);
+
+        if (!q.tasks.empty())
+        {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            --_num_pending;
+            return true;
+        }
+    }
+
+    // steal from the other workers, then the injection queue; oldest first
+    for (std::size_t i = 0; i < numQueues; ++i)
+    {
+        const std::size_t queueId = i < injectionQueueId ? ((isWorker ? t_queue_id : 0) + i) % injectionQueueId : injectionQueueId;
+        if (isWorker && queueId == t_queue_id)
+        { continue; }
+
+        Queue& q = *_queues[queueId];
+        std::lock_guard<std::mutex> lock(q.mutex);
+
+        if (!q.tasks.empty())
+        {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            --_num_pending;
+            return true;
+        }
+    } // for i
+
+    return false;
+}
+
+void ThreadPool::_work(unsigned int queueId)
+{
+    t_pool = this;
+    t_queue_id = queueId;
+
+    for (;;)
+    {
+        std::function<void()> task;
+
+        if (_pop(task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]()
+        { return _stop || _num_pending != 0; });
+
+        if (_stop && _num_pending == 0)
+        { return; }
+    } // for ever
+}
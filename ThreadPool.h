@@ -0,0 +1,209 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_THREADPOOL_H
+#define BLOODLINE_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Fixed-size, work-stealing pool of worker threads.
+ *
+ * Every worker owns a task deque. Tasks enqueued by a worker go to the back of its own deque
+ * and are taken from there (LIFO, cache-warm); tasks enqueued by other threads go to a shared
+ * injection queue (FIFO). An idle worker steals from the front of the other workers' deques
+ * before it takes from the injection queue, so the subtasks of one large task spread over all
+ * threads and running tasks finish before new ones start.
+ *
+ * A task that waits for its subtasks has to use wait(), which runs pending tasks in the
+ * meantime; a blocking future::get() inside a task can deadlock the pool. Threads outside the
+ * pool only block in wait(), so they never run unrelated work on their stack.
+ *
+ * The destructor finishes all pending tasks before joining the workers.
+ */
+class ThreadPool
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+    static constexpr unsigned int WAIT_POLL_MICROSECONDS = 100;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    }; // struct Queue
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<Queue>> _queues; // one per worker + injection queue (last)
+    std::atomic<std::size_t> _num_pending;
+    std::mutex _mutex; // sleeping workers only
+    std::condition_variable _cv;
+    bool _stop;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    //! numThreads == 0 -> std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned int numThreads = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+
+    ~ThreadPool();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] unsigned int num_threads() const;
+
+    //! true if the calling thread is a worker of this pool
+    [[nodiscard]] bool is_worker() const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] ThreadPool& operator=(const ThreadPool&) = delete;
+    [[maybe_unused]] ThreadPool& operator=(ThreadPool&&) = delete;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! exceptions thrown by f are rethrown by the returned future's get()
+    template<typename F>
+    [[nodiscard]] auto enqueue(F&& f) -> std::future<std::invoke_result_t<F>>
+    {
+        using result_type = std::invoke_result_t<F>;
+
+        // std::function requires a copyable callable, hence the shared_ptr
+        auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(f));
+        std::future<result_type> res = task->get_future();
+
+        _push([task]()
+              { (*task)(); });
+
+        return res;
+    }
+
+    //! executes one pending task in the calling thread; false if there is none
+    bool run_pending_task();
+
+    //! f.get(), but a worker of this pool runs pending tasks while f is not ready (required inside tasks of this pool)
+    template<typename T>
+    T wait(std::future<T>& f)
+    {
+        if (!is_worker())
+        { return f.get(); }
+
+        while (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!run_pending_task())
+            { f.wait_for(std::chrono::microseconds(WAIT_POLL_MICROSECONDS)); }
+        }
+
+        return f.get();
+    }
+
+    /*!
+     * calls f(first, last) for consecutive blocks of [0, n) with at most blockSize elements each;
+     * numThreads == 0 -> std::thread::hardware_concurrency(), <= 1 or a single block -> runs in the calling thread
+     */
+    template<typename F>
+    static void parallel_for(std::size_t n, std::size_t blockSize, unsigned int numThreads, F&& f)
+    {
+        if (numThreads == 0)
+        { numThreads = std::max(1U, std::thread::hardware_concurrency()); }
+
+        blockSize = std::max<std::size_t>(1, blockSize);
+        const std::size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+        if (numThreads == 1 || numBlocks <= 1)
+        {
+            if (n != 0)
+            { f(std::size_t(0), n); }
+
+            return;
+        }
+
+        ThreadPool pool(static_cast<unsigned int>(std::min<std::size_t>(numThreads, numBlocks)));
+        parallel_for(pool, n, blockSize, f);
+    }
+
+    //! as above, but on the workers of an existing pool (may be called from a task of that pool); a single worker or block -> runs in the calling thread
+    template<typename F>
+    static void parallel_for(ThreadPool& pool, std::size_t n, std::size_t blockSize, F&& f)
+    { parallel_for(&pool, n, blockSize, f); }
+
+    //! pool == nullptr -> runs in the calling thread
+    template<typename F>
+    static void parallel_for(ThreadPool* pool, std::size_t n, std::size_t blockSize, F&& f)
+    {
+        blockSize = std::max<std::size_t>(1, blockSize);
+        const std::size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+        if (pool == nullptr || pool->num_threads() <= 1 || numBlocks <= 1)
+        {
+            if (n != 0)
+            { f(std::size_t(0), n); }
+
+            return;
+        }
+
+        std::vector<std::future<void>> blocks;
+        blocks.reserve(numBlocks);
+
+        for (std::size_t first = 0; first < n; first += blockSize)
+        {
+            const std::size_t last = std::min(n, first + blockSize);
+            blocks.emplace_back(pool->enqueue([&f, first, last]()
+                                              { f(first, last); }));
+        }
+
+        for (std::future<void>& b: blocks)
+        { pool->wait(b); }
+    }
+
+  private:
+    void _push(std::function<void()> task);
+    [[nodiscard]] bool _pop(std::function<void()>& task);
+    void _work(unsigned int queueId);
+}; // class ThreadPool
+
+#endif //BLOODLINE_THREADPOOL_H
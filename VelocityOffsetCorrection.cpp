@@ -0,0 +1,270 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "VelocityOffsetCorrection.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <thread>
+
+#include "ThreadPool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BLOODLINE_VELOCITYOFFSETCORRECTION_AVX
+    #include <immintrin.h>
+#endif
+
+namespace
+{
+  //! p[3 * t + c] -= offsets[c] for t < numTimes
+  template<typename T>
+  void subtract_run_scalar(T* p, std::size_t numTimes, const std::array<T, 3>& offsets)
+  {
+      for (std::size_t t = 0; t < numTimes; ++t, p += 3)
+      {
+          p[0] -= offsets[0];
+          p[1] -= offsets[1];
+          p[2] -= offsets[2];
+      }
+  }
+
+#ifdef BLOODLINE_VELOCITYOFFSETCORRECTION_AVX
+  // 3 registers hold lcm(3, 4) values -> the period-3 offset pattern repeats every 4 time steps
+  __attribute__((target("avx")))
+  void subtract_run_avx(double* p, std::size_t numTimes, const std::array<double, 3>& offsets)
+  {
+      alignas(32) double pattern[12];
+      for (unsigned int i = 0; i < 12; ++i)
+      { pattern[i] = offsets[i % 3]; }
+
+      const __m256d o0 = _mm256_load_pd(pattern);
+      const __m256d o1 = _mm256_load_pd(pattern + 4);
+      const __m256d o2 = _mm256_load_pd(pattern + 8);
+
+      const std::size_t n = 3 * numTimes;
+      std::size_t i = 0;
+      for (; i + 12 <= n; i += 12)
+      {
+          _mm256_storeu_pd(p + i, _mm256_sub_pd(_mm256_loadu_pd(p + i), o0));
+          _mm256_storeu_pd(p + i + 4, _mm256_sub_pd(_mm256_loadu_pd(p + i + 4), o1));
+          _mm256_storeu_pd(p + i + 8, _mm256_sub_pd(_mm256_loadu_pd(p + i + 8), o2));
+      }
+
+      subtract_run_scalar(p + i, (n - i) / 3, offsets);
+  }
+
+  // 3 registers hold lcm(3, 8) values -> the pattern repeats every 8 time steps
+  __attribute__((target("avx")))
+  void subtract_run_avx(float* p, std::size_t numTimes, const std::array<float, 3>& offsets)
+  {
+      alignas(32) float pattern[24];
+      for (unsigned int i = 0; i < 24; ++i)
+      { pattern[i] = offsets[i % 3]; }
+
+      const __m256 o0 = _mm256_load_ps(pattern);
+      const __m256 o1 = _mm256_load_ps(pattern + 8);
+      const __m256 o2 = _mm256_load_ps(pattern + 16);
+
+      const std::size_t n = 3 * numTimes;
+      std::size_t i = 0;
+      for (; i + 24 <= n; i += 24)
+      {
+          _mm256_storeu_ps(p + i, _mm256_sub_ps(_mm256_loadu_ps(p + i), o0));
+          _mm256_storeu_ps(p + i + 8, _mm256_sub_ps(_mm256_loadu_ps(p + i + 8), o1));
+          _mm256_storeu_ps(p + i + 16, _mm256_sub_ps(_mm256_loadu_ps(p + i + 16), o2));
+      }
+
+      subtract_run_scalar(p + i, (n - i) / 3, offsets);
+  }
+#endif
+
+  [[nodiscard]] bool has_avx()
+  {
+    #ifdef BLOODLINE_VELOCITYOFFSETCORRECTION_AVX
+      static const bool b = __builtin_cpu_supports("avx");
+      return b;
+    #else
+      return false;
+    #endif
+  }
+
+  template<typename T>
+  [[nodiscard]] bool is_applicable(const VelocityOffsetCorrectionData& voc, const BasicFlowFieldData<T>& ff)
+  {
+      const std::array<std::uint32_t, 4>& size = ff.header.size;
+
+      if (ff.vectors.size() != static_cast<std::size_t>(size[0]) * size[1] * size[2] * size[3] * 3)
+      { return false; }
+
+      for (const std::vector<double>& planeCoeffs: voc.plane_coeffs)
+      {
+          if (!planeCoeffs.empty() && planeCoeffs.size() != static_cast<std::size_t>(size[2]) * 3)
+          { return false; }
+      }
+
+      return true;
+  }
+
+  template<typename T>
+  void correct_slice(const VelocityOffsetCorrectionData& voc, BasicFlowFieldData<T>& ff, std::uint32_t z, bool avx)
+  {
+      const std::array<std::uint32_t, 4>& size = ff.header.size;
+      const std::size_t runLength = static_cast<std::size_t>(size[3]) * 3;
+
+      for (std::uint32_t x = 0; x < size[0]; ++x)
+      {
+          for (std::uint32_t y = 0; y < size[1]; ++y)
+          {
+              std::array<T, 3> offsets{};
+              for (unsigned int v = 0; v < 3; ++v)
+              {
+                  if (!voc.plane_coeffs[v].empty())
+                  { offsets[v] = static_cast<T>(VelocityOffsetCorrection::plane_offset(voc.plane_coeffs[v], z, x, y)); }
+              }
+
+              T* run = ff.vectors.data() + ((static_cast<std::size_t>(x) * size[1] + y) * size[2] + z) * runLength;
+
+            #ifdef BLOODLINE_VELOCITYOFFSETCORRECTION_AVX
+              if (avx)
+              {
+                  subtract_run_avx(run, size[3], offsets);
+                  continue;
+              }
+            #endif
+
+              subtract_run_scalar(run, size[3], offsets);
+          } // for y
+      } // for x
+  }
+
+  template<typename T>
+  bool apply_with_pool(const VelocityOffsetCorrectionData& voc, BasicFlowFieldData<T>& ff, ThreadPool& pool)
+  {
+      if (!is_applicable(voc, ff))
+      { return false; }
+
+      const bool avx = has_avx();
+
+      // slices touch disjoint runs of the payload
+      std::vector<std::future<void>> slices;
+      slices.reserve(ff.header.size[2]);
+
+      for (std::uint32_t z = 0; z < ff.header.size[2]; ++z)
+      {
+          slices.emplace_back(pool.enqueue([&voc, &ff, z, avx]()
+                                           { correct_slice(voc, ff, z, avx); }));
+      }
+
+      for (std::future<void>& slice: slices)
+      { pool.wait(slice); }
+
+      return true;
+  }
+
+  template<typename T>
+  bool apply_with_num_threads(const VelocityOffsetCorrectionData& voc, BasicFlowFieldData<T>& ff, unsigned int numThreads)
+  {
+      if (numThreads == 0)
+      { numThreads = std::thread::hardware_concurrency(); }
+
+      numThreads = std::min(numThreads, static_cast<unsigned int>(ff.header.size[2]));
+
+      if (numThreads > 1)
+      {
+          ThreadPool pool(numThreads);
+          return apply_with_pool(voc, ff, pool);
+      }
+
+      if (!is_applicable(voc, ff))
+      { return false; }
+
+      const bool avx = has_avx();
+
+      for (std::uint32_t z = 0; z < ff.header.size[2]; ++z)
+      { correct_slice(voc, ff, z, avx); }
+
+      return true;
+  }
+
+  template<typename T>
+  bool apply_reference(const VelocityOffsetCorrectionData& voc, BasicFlowFieldData<T>& ff)
+  {
+      if (!is_applicable(voc, ff))
+      { return false; }
+
+      const std::array<std::uint32_t, 4>& size = ff.header.size;
+
+      for (std::uint32_t x = 0; x < size[0]; ++x)
+      {
+          for (std::uint32_t y = 0; y < size[1]; ++y)
+          {
+              for (std::uint32_t z = 0; z < size[2]; ++z)
+              {
+                  for (unsigned int v = 0; v < 3; ++v)
+                  {
+                      if (voc.plane_coeffs[v].empty())
+                      { continue; }
+
+                      const T offset = static_cast<T>(VelocityOffsetCorrection::plane_offset(voc.plane_coeffs[v], z, x, y));
+
+                      for (std::uint32_t t = 0; t < size[3]; ++t)
+                      { ff.vectors[((((static_cast<std::size_t>(x) * size[1] + y) * size[2] + z) * size[3] + t) * 3) + v] -= offset; }
+                  } // for v
+              } // for z
+          } // for y
+      } // for x
+
+      return true;
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+double VelocityOffsetCorrection::plane_offset(const std::vector<double>& planeCoeffs, std::uint32_t z, std::uint32_t x, std::uint32_t y)
+{
+    const double* c = planeCoeffs.data() + 3 * static_cast<std::size_t>(z);
+    return c[0] * x + c[1] * y + c[2];
+}
+
+bool VelocityOffsetCorrection::apply(const VelocityOffsetCorrectionData& voc, FlowFieldData& ff, unsigned int numThreads)
+{ return apply_with_num_threads(voc, ff, numThreads); }
+
+bool VelocityOffsetCorrection::apply(const VelocityOffsetCorrectionData& voc, FlowFieldDataF& ff, unsigned int numThreads)
+{ return apply_with_num_threads(voc, ff, numThreads); }
+
+bool VelocityOffsetCorrection::apply(const VelocityOffsetCorrectionData& voc, FlowFieldData& ff, ThreadPool& pool)
+{ return apply_with_pool(voc, ff, pool); }
+
+bool VelocityOffsetCorrection::apply(const VelocityOffsetCorrectionData& voc, FlowFieldDataF& ff, ThreadPool& pool)
+{ return apply_with_pool(voc, ff, pool); }
+
+bool VelocityOffsetCorrection::apply_scalar(const VelocityOffsetCorrectionData& voc, FlowFieldData& ff)
+{ return apply_reference(voc, ff); }
+
+bool VelocityOffsetCorrection::apply_scalar(const VelocityOffsetCorrectionData& voc, FlowFieldDataF& ff)
+{ return apply_reference(voc, ff); }
@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_VELOCITYOFFSETCORRECTION_H
+#define BLOODLINE_VELOCITYOFFSETCORRECTION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ImporterScientificData.h"
+
+class ThreadPool;
+
+/*
+ * In-place application of the 3D+T velocity offset correction (background phase correction)
+ * to a loaded flow field.
+ *
+ * For every slice z and flow image v, voc.plane_coeffs[v] holds a linear plane
+ *
+ *      offset(x, y) = c[0] * x + c[1] * y + c[2],  c = &plane_coeffs[v][3 * z],
+ *
+ * in grid coordinates. It is subtracted from velocity component v of all voxels of the slice
+ * at every time step. Flow images without coefficients stay unchanged.
+ *
+ * The slices are processed in parallel. Since the payload is stored as x y z t component,
+ * the contiguous unit of a voxel is its run of size[3] * 3 values (t component); this run is
+ * corrected with AVX (one period-3 offset pattern per register) if the CPU supports it.
+ * The offsets are subtracted in payload precision, so the result is bitwise identical to
+ * apply_scalar().
+ */
+class VelocityOffsetCorrection
+{
+  public:
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    [[nodiscard]] static double plane_offset(const std::vector<double>& planeCoeffs, std::uint32_t z, std::uint32_t x, std::uint32_t y);
+
+    /*!
+     * @param numThreads 0 -> std::thread::hardware_concurrency()
+     * @return false (and leaves ff unchanged) if the number of slices does not match ff.header.size[2]
+     */
+    static bool apply(const VelocityOffsetCorrectionData& voc, FlowFieldData& ff, unsigned int numThreads = 0);
+    static bool apply(const VelocityOffsetCorrectionData& voc, FlowFieldDataF& ff, unsigned int numThreads = 0);
+    //! uses an existing pool (may be called from a task of that pool)
+    static bool apply(const VelocityOffsetCorrectionData& voc, FlowFieldData& ff, ThreadPool& pool);
+    static bool apply(const VelocityOffsetCorrectionData& voc, FlowFieldDataF& ff, ThreadPool& pool);
+
+    //! single-threaded reference without AVX
+    static bool apply_scalar(const VelocityOffsetCorrectionData& voc, FlowFieldData& ff);
+    static bool apply_scalar(const VelocityOffsetCorrectionData& voc, FlowFieldDataF& ff);
+}; // class VelocityOffsetCorrection
+
+#endif //BLOODLINE_VELOCITYOFFSETCORRECTION_H
+
@@ -0,0 +1,380 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "VoxelMask.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BLOODLINE_VOXELMASK_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace
+{
+  enum class BitOp
+  {
+      And,
+      Or,
+      AndNot // a & ~b
+  }; // enum class BitOp
+
+  template<BitOp Op>
+  [[nodiscard]] std::uint64_t apply(std::uint64_t a, std::uint64_t b)
+  {
+      if constexpr (Op == BitOp::And)
+      { return a & b; }
+      else if constexpr (Op == BitOp::Or)
+      { return a | b; }
+      else
+      { return a & ~b; }
+  }
+
+  template<BitOp Op>
+  void apply_scalar(std::uint64_t* dst, const std::uint64_t* src, std::size_t n)
+  {
+      for (std::size_t i = 0; i < n; ++i)
+      { dst[i] = apply<Op>(dst[i], src[i]); }
+  }
+
+#ifdef BLOODLINE_VOXELMASK_AVX2
+  /*
+   * popcount of 4 words per iteration: the set bits of every nibble are looked up with a byte
+   * shuffle (vpshufb) and the byte counts are summed into the 4 64 bit lanes (vpsadbw)
+   */
+  __attribute__((target("avx2")))
+  [[nodiscard]] __m256i popcount_lanes(__m256i v)
+  {
+      const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                              0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+      const __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+
+      const __m256i lo = _mm256_and_si256(v, lowNibbles);
+      const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles);
+      const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+
+      return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+  }
+
+  __attribute__((target("avx2")))
+  [[nodiscard]] std::uint64_t sum_lanes(__m256i v)
+  {
+      alignas(32) std::uint64_t lanes[4];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+
+      return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+
+  __attribute__((target("avx2")))
+  [[nodiscard]] std::uint64_t popcount_avx2(const std::uint64_t* words, std::size_t n)
+  {
+      __m256i sum = _mm256_setzero_si256();
+
+      std::size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      { sum = _mm256_add_epi64(sum, popcount_lanes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i)))); }
+
+      return sum_lanes(sum) + VoxelMask::popcount_scalar(words + i, n - i);
+  }
+
+  __attribute__((target("avx2")))
+  [[nodiscard]] std::uint64_t popcount_and_avx2(const std::uint64_t* a, const std::uint64_t* b, std::size_t n)
+  {
+      __m256i sum = _mm256_setzero_si256();
+
+      std::size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+          const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+          const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+          sum = _mm256_add_epi64(sum, popcount_lanes(_mm256_and_si256(va, vb)));
+      }
+
+      std::uint64_t n1 = sum_lanes(sum);
+      for (; i < n; ++i)
+      {
+          const std::uint64_t w = a[i] & b[i];
+          n1 += VoxelMask::popcount_scalar(&w, 1);
+      }
+
+      return n1;
+  }
+
+  template<BitOp Op>
+  __attribute__((target("avx2")))
+  void apply_avx2(std::uint64_t* dst, const std::uint64_t* src, std::size_t n)
+  {
+      std::size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+          const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+          const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+          __m256i r;
+          if constexpr (Op == BitOp::And)
+          { r = _mm256_and_si256(a, b); }
+          else if constexpr (Op == BitOp::Or)
+          { r = _mm256_or_si256(a, b); }
+          else
+          { r = _mm256_andnot_si256(b, a); }
+
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+      }
+
+      apply_scalar<Op>(dst + i, src + i, n - i);
+  }
+#endif
+
+  [[nodiscard]] bool has_avx2()
+  {
+    #ifdef BLOODLINE_VOXELMASK_AVX2
+      static const bool b = __builtin_cpu_supports("avx2");
+      return b;
+    #else
+      return false;
+    #endif
+  }
+
+  template<BitOp Op>
+  void apply_words(std::uint64_t* dst, const std::uint64_t* src, std::size_t n)
+  {
+    #ifdef BLOODLINE_VOXELMASK_AVX2
+      if (has_avx2())
+      {
+          apply_avx2<Op>(dst, src, n);
+          return;
+      }
+    #endif
+
+      apply_scalar<Op>(dst, src, n);
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+VoxelMask::VoxelMask()
+    : _num_voxels(0)
+{ /* do nothing */ }
+
+VoxelMask::VoxelMask(std::vector<std::uint32_t> size)
+    : _size(std::move(size)),
+      _num_voxels(0)
+{
+    if (!_size.empty())
+    {
+        _num_voxels = 1;
+        for (const std::uint32_t s: _size)
+        { _num_voxels *= s; }
+    }
+
+    _words.assign(num_words(_size), 0);
+}
+
+VoxelMask::~VoxelMask() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::uint32_t VoxelMask::num_dims() const
+{ return _size.size(); }
+
+const std::vector<std::uint32_t>& VoxelMask::size() const
+{ return _size; }
+
+std::uint64_t VoxelMask::num_voxels() const
+{ return _num_voxels; }
+
+std::size_t VoxelMask::num_words() const
+{ return _words.size(); }
+
+const std::vector<std::uint64_t>& VoxelMask::words() const
+{ return _words; }
+
+bool VoxelMask::contains(const std::uint32_t* gridPos) const
+{
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    {
+        if (gridPos[d] >= _size[d])
+        { return false; }
+    }
+
+    return true;
+}
+
+std::uint64_t VoxelMask::index(const std::uint32_t* gridPos) const
+{
+    std::uint64_t i = 0;
+    for (std::size_t d = 0; d < _size.size(); ++d)
+    { i = i * _size[d] + gridPos[d]; }
+
+    return i;
+}
+
+void VoxelMask::grid_pos(std::uint64_t index, std::uint32_t* gridPos) const
+{
+    for (std::size_t d = _size.size(); d-- > 0;)
+    {
+        gridPos[d] = static_cast<std::uint32_t>(index % _size[d]);
+        index /= _size[d];
+    }
+}
+
+bool VoxelMask::test(std::uint64_t index) const
+{ return (_words[index / WORD_NUM_BITS] >> (index % WORD_NUM_BITS)) & 1; }
+
+bool VoxelMask::same_size(const VoxelMask& other) const
+{ return _size == other._size; }
+
+std::uint64_t VoxelMask::find_next(std::uint64_t first) const
+{
+    if (first >= _num_voxels)
+    { return _num_voxels; }
+
+    std::size_t w = static_cast<std::size_t>(first / WORD_NUM_BITS);
+    std::uint64_t word = _words[w] & (~std::uint64_t(0) << (first % WORD_NUM_BITS));
+
+    while (word == 0)
+    {
+        if (++w == _words.size())
+        { return _num_voxels; }
+
+        word = _words[w];
+    }
+
+    return w * WORD_NUM_BITS + _lowest_bit(word);
+}
+
+//====================================================================================================
+//===== SETTER
+//====================================================================================================
+void VoxelMask::set(std::uint64_t index)
+{ _words[index / WORD_NUM_BITS] |= std::uint64_t(1) << (index % WORD_NUM_BITS); }
+
+void VoxelMask::reset(std::uint64_t index)
+{ _words[index / WORD_NUM_BITS] &= ~(std::uint64_t(1) << (index % WORD_NUM_BITS)); }
+
+void VoxelMask::clear()
+{ std::fill(_words.begin(), _words.end(), 0); }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+std::size_t VoxelMask::num_words(const std::vector<std::uint32_t>& size)
+{
+    if (size.empty())
+    { return 0; }
+
+    std::uint64_t n = 1;
+    for (const std::uint32_t s: size)
+    { n *= s; }
+
+    return static_cast<std::size_t>((n + WORD_NUM_BITS - 1) / WORD_NUM_BITS);
+}
+
+std::uint64_t VoxelMask::popcount_scalar(const std::uint64_t* words, std::size_t n)
+{
+    std::uint64_t cnt = 0;
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      #ifdef __GNUC__
+        cnt += static_cast<std::uint64_t>(__builtin_popcountll(words[i]));
+      #else
+        // SWAR: bit counts of 2, 4 and 8 bit fields, then the sum of all bytes
+        std::uint64_t w = words[i];
+        w = w - ((w >> 1) & 0x5555555555555555ULL);
+        w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+        w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        cnt += (w * 0x0101010101010101ULL) >> 56;
+      #endif
+    }
+
+    return cnt;
+}
+
+std::uint64_t VoxelMask::popcount(const std::uint64_t* words, std::size_t n)
+{
+  #ifdef BLOODLINE_VOXELMASK_AVX2
+    if (has_avx2())
+    { return popcount_avx2(words, n); }
+  #endif
+
+    return popcount_scalar(words, n);
+}
+
+std::uint64_t VoxelMask::count() const
+{ return popcount(_words.data(), _words.size()); }
+
+std::uint64_t VoxelMask::count_and(const VoxelMask& other) const
+{
+    if (!same_size(other))
+    { return 0; }
+
+  #ifdef BLOODLINE_VOXELMASK_AVX2
+    if (has_avx2())
+    { return popcount_and_avx2(_words.data(), other._words.data(), _words.size()); }
+  #endif
+
+    std::uint64_t cnt = 0;
+    for (std::size_t i = 0; i < _words.size(); ++i)
+    {
+        const std::uint64_t w = _words[i] & other._words[i];
+        cnt += popcount_scalar(&w, 1);
+    }
+
+    return cnt;
+}
+
+bool VoxelMask::and_with(const VoxelMask& other)
+{
+    if (!same_size(other))
+    { return false; }
+
+    apply_words<BitOp::And>(_words.data(), other._words.data(), _words.size());
+
+    return true;
+}
+
+bool VoxelMask::or_with(const VoxelMask& other)
+{
+    if (!same_size(other))
+    { return false; }
+
+    apply_words<BitOp::Or>(_words.data(), other._words.data(), _words.size());
+
+    return true;
+}
+
+bool VoxelMask::andnot_with(const VoxelMask& other)
+{
+    if (!same_size(other))
+    { return false; }
+
+    apply_words<BitOp::AndNot>(_words.data(), other._words.data(), _words.size());
+
+    return true;
+}
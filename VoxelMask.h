@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_VOXELMASK_H
+#define BLOODLINE_VOXELMASK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Binary voxel mask as a packed bitset (static tissue mask, segmentations in flow field size).
+ *
+ * Bit i belongs to the voxel with the linear index of the flow field payload (first dimension
+ * slowest, see ImporterScientific::_parse_flowfield()):
+ *
+ *      i = ((g[0] * size[1] + g[1]) * size[2] + g[2]) * size[3] + g[3]
+ *
+ * so bit i of a 3D mask in flow field size selects the vectors [i * sizeT, (i + 1) * sizeT) of the
+ * flow field. Bit i is bit (i % 64) of word (i / 64); the bits after num_voxels() are always zero.
+ *
+ * count() and the set operations process 4 words per iteration with AVX2 if the CPU supports it.
+ */
+class VoxelMask
+{
+    //====================================================================================================
+    //===== DEFINITIONS
+    //====================================================================================================
+  public:
+    static constexpr std::uint64_t WORD_NUM_BITS = 64;
+
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+  private:
+    std::vector<std::uint32_t> _size;
+    std::uint64_t _num_voxels;
+    std::vector<std::uint64_t> _words;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    VoxelMask();
+    //! all voxels unset
+    explicit VoxelMask(std::vector<std::uint32_t> size);
+    VoxelMask(const VoxelMask&) = default;
+    VoxelMask(VoxelMask&&) noexcept = default;
+
+    ~VoxelMask();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] std::uint32_t num_dims() const;
+    [[nodiscard]] const std::vector<std::uint32_t>& size() const;
+    [[nodiscard]] std::uint64_t num_voxels() const;
+    [[nodiscard]] std::size_t num_words() const;
+    [[nodiscard]] const std::vector<std::uint64_t>& words() const;
+
+    //! gridPos has num_dims() values
+    [[nodiscard]] bool contains(const std::uint32_t* gridPos) const;
+    [[nodiscard]] std::uint64_t index(const std::uint32_t* gridPos) const;
+    void grid_pos(std::uint64_t index, std::uint32_t* gridPos) const;
+
+    [[nodiscard]] bool test(std::uint64_t index) const;
+
+    //! same grid size as other (required by the set operations)
+    [[nodiscard]] bool same_size(const VoxelMask& other) const;
+
+    //! first set voxel with index >= first; num_voxels() if there is none
+    [[nodiscard]] std::uint64_t find_next(std::uint64_t first) const;
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] VoxelMask& operator=(const VoxelMask&) = default;
+    [[maybe_unused]] VoxelMask& operator=(VoxelMask&&) noexcept = default;
+
+    void set(std::uint64_t index);
+    void reset(std::uint64_t index);
+
+    //! unsets all voxels
+    void clear();
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    [[nodiscard]] static std::size_t num_words(const std::vector<std::uint32_t>& size);
+
+    //! number of set bits of n words
+    [[nodiscard]] static std::uint64_t popcount(const std::uint64_t* words, std::size_t n);
+    [[nodiscard]] static std::uint64_t popcount_scalar(const std::uint64_t* words, std::size_t n);
+
+    //! number of set voxels
+    [[nodiscard]] std::uint64_t count() const;
+    //! number of voxels set in both masks, without a temporary mask; 0 if the sizes differ
+    [[nodiscard]] std::uint64_t count_and(const VoxelMask& other) const;
+
+    //! in-place this &= other, this |= other, this &= ~other; false (and unchanged) if the sizes differ
+    bool and_with(const VoxelMask& other);
+    bool or_with(const VoxelMask& other);
+    bool andnot_with(const VoxelMask& other);
+
+    //! f(std::uint64_t index) for every set voxel with first <= index < last, in ascending order
+    template<typename F>
+    void for_each_in_range(std::uint64_t first, std::uint64_t last, F f) const
+    {
+        last = last < _num_voxels ? last : _num_voxels;
+        if (first >= last)
+        { return; }
+
+        const std::size_t firstWord = static_cast<std::size_t>(first / WORD_NUM_BITS);
+        const std::size_t lastWord = static_cast<std::size_t>((last - 1) / WORD_NUM_BITS);
+
+        for (std::size_t w = firstWord; w <= lastWord; ++w)
+        {
+            std::uint64_t word = _words[w];
+
+            if (w == firstWord)
+            { word &= ~std::uint64_t(0) << (first % WORD_NUM_BITS); }
+
+            if (w == lastWord && last % WORD_NUM_BITS != 0)
+            { word &= ~(~std::uint64_t(0) << (last % WORD_NUM_BITS)); }
+
+            for (; word != 0; word &= word - 1)
+            { f(w * WORD_NUM_BITS + _lowest_bit(word)); }
+        }
+    }
+
+    //! f(std::uint64_t index) for every set voxel, in ascending order
+    template<typename F>
+    void for_each(F f) const
+    { for_each_in_range(0, _num_voxels, f); }
+
+    //! f(std::uint64_t index) for every voxel set in both masks, in ascending order; nothing if the sizes differ
+    template<typename F>
+    void for_each_and(const VoxelMask& other, F f) const
+    {
+        if (!same_size(other))
+        { return; }
+
+        for (std::size_t w = 0; w < _words.size(); ++w)
+        {
+            for (std::uint64_t word = _words[w] & other._words[w]; word != 0; word &= word - 1)
+            { f(w * WORD_NUM_BITS + _lowest_bit(word)); }
+        }
+    }
+
+  private:
+    //! word != 0
+    [[nodiscard]] static unsigned int _lowest_bit(std::uint64_t word)
+    {
+      #ifdef __GNUC__
+        return static_cast<unsigned int>(__builtin_ctzll(word));
+      #else
+        unsigned int i = 0;
+        for (; (word & 1) == 0; word >>= 1)
+        { ++i; }
+        return i;
+      #endif
+    }
+}; // class VoxelMask
+
+#endif //BLOODLINE_VOXELMASK_H
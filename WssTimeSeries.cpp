@@ -0,0 +1,263 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "WssTimeSeries.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "ThreadPool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BLOODLINE_WSSTIMESERIES_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace
+{
+  constexpr std::size_t BLOCK_NUM_POINTS = 4096;
+
+  //! s += v; smag += |v| for n points
+  void accumulate_scalar(const double* x, const double* y, const double* z, std::size_t n, double* sx, double* sy, double* sz, double* smag)
+  {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          sx[i] += x[i];
+          sy[i] += y[i];
+          sz[i] += z[i];
+          smag[i] += std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+      }
+  }
+
+#ifdef BLOODLINE_WSSTIMESERIES_AVX2
+  __attribute__((target("avx2,fma")))
+  void accumulate_avx2(const double* x, const double* y, const double* z, std::size_t n, double* sx, double* sy, double* sz, double* smag)
+  {
+      std::size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+          const __m256d vx = _mm256_loadu_pd(x + i);
+          const __m256d vy = _mm256_loadu_pd(y + i);
+          const __m256d vz = _mm256_loadu_pd(z + i);
+
+          _mm256_storeu_pd(sx + i, _mm256_add_pd(_mm256_loadu_pd(sx + i), vx));
+          _mm256_storeu_pd(sy + i, _mm256_add_pd(_mm256_loadu_pd(sy + i), vy));
+          _mm256_storeu_pd(sz + i, _mm256_add_pd(_mm256_loadu_pd(sz + i), vz));
+
+          const __m256d sq = _mm256_fmadd_pd(vz, vz, _mm256_fmadd_pd(vy, vy, _mm256_mul_pd(vx, vx)));
+          _mm256_storeu_pd(smag + i, _mm256_add_pd(_mm256_loadu_pd(smag + i), _mm256_sqrt_pd(sq)));
+      }
+
+      accumulate_scalar(x + i, y + i, z + i, n - i, sx + i, sy + i, sz + i, smag + i);
+  }
+#endif
+
+  using accumulate_function = void (*)(const double*, const double*, const double*, std::size_t, double*, double*, double*, double*);
+
+  [[nodiscard]] accumulate_function select_accumulate()
+  {
+    #ifdef BLOODLINE_WSSTIMESERIES_AVX2
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      { return accumulate_avx2; }
+    #endif
+
+      return accumulate_scalar;
+  }
+} // anonymous namespace
+
+//====================================================================================================
+//===== CONSTRUCTORS & DESTRUCTOR
+//====================================================================================================
+WssTimeSeries::WssTimeSeries()
+    : _num_points(0),
+      _num_times(0)
+{ /* do nothing */ }
+
+WssTimeSeries::~WssTimeSeries() = default;
+
+//====================================================================================================
+//===== GETTER
+//====================================================================================================
+std::uint32_t WssTimeSeries::num_points() const
+{ return _num_points; }
+
+std::uint32_t WssTimeSeries::num_times() const
+{ return _num_times; }
+
+const std::vector<double>& WssTimeSeries::component(unsigned int c) const
+{ return _components[c]; }
+
+//====================================================================================================
+//===== FUNCTIONS
+//====================================================================================================
+void WssTimeSeries::build(const std::vector<double>& wssVectors, std::uint32_t numPoints, std::uint32_t numTimes, unsigned int numThreads)
+{
+    if (numThreads == 1)
+    {
+        _build(wssVectors, numPoints, numTimes, nullptr);
+        return;
+    }
+
+    ThreadPool pool(numThreads);
+    _build(wssVectors, numPoints, numTimes, &pool);
+}
+
+void WssTimeSeries::build(const std::vector<double>& wssVectors, std::uint32_t numPoints, std::uint32_t numTimes, ThreadPool& pool)
+{ _build(wssVectors, numPoints, numTimes, &pool); }
+
+void WssTimeSeries::_build(const std::vector<double>& wssVectors, std::uint32_t numPoints, std::uint32_t numTimes, ThreadPool* pool)
+{
+    _num_points = numPoints;
+    _num_times = numTimes;
+
+    for (std::vector<double>& c: _components)
+    { c.resize(static_cast<std::size_t>(numPoints) * numTimes); }
+
+    // (point, time, component) -> component[time][point]
+    ThreadPool::parallel_for(pool, numPoints, BLOCK_NUM_POINTS, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t p = first; p < last; ++p)
+        {
+            const double* src = wssVectors.data() + p * numTimes * 3;
+
+            for (std::size_t t = 0; t < numTimes; ++t, src += 3)
+            {
+                const std::size_t dst = t * numPoints + p;
+                _components[0][dst] = src[0];
+                _components[1][dst] = src[1];
+                _components[2][dst] = src[2];
+            }
+        }
+    });
+}
+
+WssMetrics WssTimeSeries::compute(std::uint32_t firstTime, std::uint32_t lastTime, unsigned int numThreads) const
+{
+    if (numThreads == 1)
+    { return _compute(firstTime, lastTime, nullptr); }
+
+    ThreadPool pool(numThreads);
+    return _compute(firstTime, lastTime, &pool);
+}
+
+WssMetrics WssTimeSeries::compute(std::uint32_t firstTime, std::uint32_t lastTime, ThreadPool& pool) const
+{ return _compute(firstTime, lastTime, &pool); }
+
+WssMetrics WssTimeSeries::_compute(std::uint32_t firstTime, std::uint32_t lastTime, ThreadPool* pool) const
+{
+    lastTime = std::min(lastTime, _num_times);
+    firstTime = std::min(firstTime, lastTime);
+
+    WssMetrics m;
+    m.mean_wss.assign(_num_points, 0);
+    m.mean_wss_vector.resize(static_cast<std::size_t>(_num_points) * 3);
+    m.mean_wss_vector_magnitude.resize(_num_points);
+    m.osi.resize(_num_points);
+
+    const accumulate_function accumulate = select_accumulate();
+    const double invNumTimes = lastTime > firstTime ? 1.0 / (lastTime - firstTime) : 0.0;
+
+    ThreadPool::parallel_for(pool, _num_points, BLOCK_NUM_POINTS, [&](std::size_t first, std::size_t last)
+    {
+        const std::size_t n = last - first;
+
+        std::vector<double> sx(n, 0);
+        std::vector<double> sy(n, 0);
+        std::vector<double> sz(n, 0);
+        double* smag = m.mean_wss.data() + first;
+
+        for (std::size_t t = firstTime; t < lastTime; ++t)
+        {
+            const std::size_t off = t * _num_points + first;
+            accumulate(_components[0].data() + off, _components[1].data() + off, _components[2].data() + off, n, sx.data(), sy.data(), sz.data(), smag);
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t p = first + i;
+
+            const double mx = sx[i] * invNumTimes;
+            const double my = sy[i] * invNumTimes;
+            const double mz = sz[i] * invNumTimes;
+            const double meanWss = smag[i] * invNumTimes;
+            const double vecMag = std::sqrt(mx * mx + my * my + mz * mz);
+
+            m.mean_wss[p] = meanWss;
+            m.mean_wss_vector[p * 3] = mx;
+            m.mean_wss_vector[p * 3 + 1] = my;
+            m.mean_wss_vector[p * 3 + 2] = mz;
+            m.mean_wss_vector_magnitude[p] = vecMag;
+            m.osi[p] = meanWss > 0 ? 0.5 * (1 - vecMag / meanWss) : 0;
+        }
+    });
+
+    return m;
+}
+
+WssMetrics WssTimeSeries::compute(unsigned int numThreads) const
+{ return compute(0, _num_times, numThreads); }
+
+WssDeviation WssTimeSeries::max_deviation(const WssMetrics& m, const std::vector<double>& meanWss, const std::vector<double>& meanWssVector, const std::vector<double>& osi)
+{
+    const auto max_abs_diff = [](const std::vector<double>& a, const std::vector<double>& b)
+    {
+        double d = 0;
+        for (std::size_t i = 0; i < std::min(a.size(), b.size()); ++i)
+        { d = std::max(d, std::abs(a[i] - b[i])); }
+
+        return d;
+    };
+
+    WssDeviation dev;
+    dev.mean_wss = max_abs_diff(m.mean_wss, meanWss);
+    dev.mean_wss_vector = max_abs_diff(m.mean_wss_vector, meanWssVector);
+    dev.osi = max_abs_diff(m.osi, osi);
+
+    return dev;
+}
+
+MeshWssValidation WssTimeSeries::validate(const MeshData& mesh, unsigned int numThreads)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    MeshWssValidation res;
+    WssTimeSeries ts;
+    ThreadPool pool(numThreads);
+
+    ts.build(mesh.wss_vector, mesh.num_points, mesh.num_times, pool);
+    res.total = max_deviation(ts.compute(0, ts.num_times(), pool), mesh.mean_wss, mesh.mean_wss_vector, mesh.osi);
+
+    ts.build(mesh.wss_vector_axial, mesh.num_points, mesh.num_times, pool);
+    res.axial = max_deviation(ts.compute(0, ts.num_times(), pool), mesh.mean_wss_axial, mesh.mean_wss_vector_axial, mesh.osi_axial);
+
+    ts.build(mesh.wss_vector_circumferential, mesh.num_points, mesh.num_times, pool);
+    res.circumferential = max_deviation(ts.compute(0, ts.num_times(), pool), mesh.mean_wss_circumferential, mesh.mean_wss_vector_circumferential, mesh.osi_circumferential);
+
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    res.seconds = seconds.count();
+
+    return res;
+}
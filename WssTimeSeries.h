@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018-2019 Benjamin Köhler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLOODLINE_WSSTIMESERIES_H
+#define BLOODLINE_WSSTIMESERIES_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ImporterScientificData.h"
+
+class ThreadPool;
+
+//! per-point results of WssTimeSeries::compute()
+struct WssMetrics
+{
+    std::vector<double> mean_wss; // mean over time of |wss vector|
+    std::vector<double> mean_wss_vector; // num_points * 3
+    std::vector<double> mean_wss_vector_magnitude;
+    std::vector<double> osi; // 0.5 * (1 - |mean wss vector| / mean wss)
+}; // struct WssMetrics
+
+//! maximum absolute deviation of recomputed from stored values
+struct WssDeviation
+{
+    double mean_wss = 0;
+    double mean_wss_vector = 0; // over all components
+    double osi = 0;
+}; // struct WssDeviation
+
+struct MeshWssValidation
+{
+    WssDeviation total;
+    WssDeviation axial;
+    WssDeviation circumferential;
+    double seconds = 0;
+}; // struct MeshWssValidation
+
+/*
+ * WSS vectors of all mesh points over time, stored as structure of arrays:
+ * one array per component, time-major ([t * num_points + p]), so that the points of one time
+ * step are contiguous and can be processed with SIMD.
+ *
+ * compute() runs in parallel over blocks of points; the per-time accumulation uses AVX2 if
+ * the CPU supports it.
+ */
+class WssTimeSeries
+{
+    //====================================================================================================
+    //===== MEMBERS
+    //====================================================================================================
+    std::uint32_t _num_points;
+    std::uint32_t _num_times;
+    std::array<std::vector<double>, 3> _components;
+
+    //====================================================================================================
+    //===== CONSTRUCTORS & DESTRUCTOR
+    //====================================================================================================
+  public:
+    WssTimeSeries();
+    WssTimeSeries(const WssTimeSeries&) = default;
+    WssTimeSeries(WssTimeSeries&&) noexcept = default;
+
+    ~WssTimeSeries();
+
+    //====================================================================================================
+    //===== GETTER
+    //====================================================================================================
+    [[nodiscard]] std::uint32_t num_points() const;
+    [[nodiscard]] std::uint32_t num_times() const;
+
+    //! num_times() * num_points() values, time-major
+    [[nodiscard]] const std::vector<double>& component(unsigned int c) const;
+
+    [[nodiscard]] double at(std::uint32_t pointId, std::uint32_t timeId, unsigned int c) const
+    { return _components[c][static_cast<std::size_t>(timeId) * _num_points + pointId]; }
+
+    //====================================================================================================
+    //===== SETTER
+    //====================================================================================================
+    [[maybe_unused]] WssTimeSeries& operator=(const WssTimeSeries&) = default;
+    [[maybe_unused]] WssTimeSeries& operator=(WssTimeSeries&&) noexcept = default;
+
+    //====================================================================================================
+    //===== FUNCTIONS
+    //====================================================================================================
+    //! wssVectors as stored in the mesh file: [numPoints * numTimes * 3] (point, time, component)
+    void build(const std::vector<double>& wssVectors, std::uint32_t numPoints, std::uint32_t numTimes, unsigned int numThreads = 0);
+    //! uses an existing pool (may be called from a task of that pool)
+    void build(const std::vector<double>& wssVectors, std::uint32_t numPoints, std::uint32_t numTimes, ThreadPool& pool);
+
+    //! over time steps [firstTime, lastTime); numThreads == 0 -> hardware concurrency
+    [[nodiscard]] WssMetrics compute(std::uint32_t firstTime, std::uint32_t lastTime, unsigned int numThreads = 0) const;
+    [[nodiscard]] WssMetrics compute(unsigned int numThreads = 0) const;
+    //! uses an existing pool (may be called from a task of that pool)
+    [[nodiscard]] WssMetrics compute(std::uint32_t firstTime, std::uint32_t lastTime, ThreadPool& pool) const;
+
+    [[nodiscard]] static WssDeviation max_deviation(const WssMetrics& m, const std::vector<double>& meanWss, const std::vector<double>& meanWssVector, const std::vector<double>& osi);
+
+    //! recomputes mean wss, mean wss vector and osi (total, axial, circumferential) over all time steps and compares with the stored arrays
+    [[nodiscard]] static MeshWssValidation validate(const MeshData& mesh, unsigned int numThreads = 0);
+
+  private:
+    //! pool == nullptr -> single-threaded
+    void _build(const std::vector<double>& wssVectors, std::uint32_t numPoints, std::uint32_t numTimes, ThreadPool* pool);
+    [[nodiscard]] WssMetrics _compute(std::uint32_t firstTime, std::uint32_t lastTime, ThreadPool* pool) const;
+}; // class WssTimeSeries
+
+#endif //BLOODLINE_WSSTIMESERIES_H